@@ -183,9 +183,7 @@ void UIEngine::GetScreenshot(UChar4Image* dest) const {
 }
 
 void UIEngine::SkipFrames(int number_of_frames_to_skip) {
-	for (int i_frame = 0; i_frame < number_of_frames_to_skip && image_source_engine->HasMoreImages(); i_frame++) {
-		image_source_engine->GetImages(*input_RGB_image, *input_raw_depth_image);
-	}
+	image_source_engine->SkipImages(number_of_frames_to_skip);
 	this->current_frame_index += number_of_frames_to_skip;
 }
 
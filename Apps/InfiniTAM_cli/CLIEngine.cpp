@@ -3,6 +3,8 @@
 //stdlib
 #include <cstring>
 #include <filesystem>
+#include <future>
+#include <utility>
 
 //local
 #include "CLIEngine.h"
@@ -44,6 +46,9 @@ void CLIEngine::Initialise(ImageSourceEngine *image_source, IMUSourceEngine *imu
 	input_RGB_image = new UChar4Image(image_source->GetRGBImageSize(), true, allocate_GPU);
 	input_raw_depth_image = new ShortImage(image_source->GetDepthImageSize(), true, allocate_GPU);
 	input_IMU_measurement = new IMUMeasurement();
+	next_input_RGB_image = new UChar4Image(image_source->GetRGBImageSize(), true, allocate_GPU);
+	next_input_raw_depth_image = new ShortImage(image_source->GetDepthImageSize(), true, allocate_GPU);
+	next_input_IMU_measurement = new IMUMeasurement();
 
 	this->current_frame_index = 0;
 	if (automatic_run_settings.index_of_frame_to_start_at > 0) {
@@ -53,6 +58,7 @@ void CLIEngine::Initialise(ImageSourceEngine *image_source, IMUSourceEngine *imu
 
 	this->save_after_automatic_run = automatic_run_settings.save_volumes_and_camera_matrix_after_processing;
 	this->index_of_frame_to_end_before = automatic_run_settings.index_of_frame_to_end_before;
+	this->pipeline_frame_processing = automatic_run_settings.pipeline_frame_processing;
 
 	if (automatic_run_settings.load_volume_and_camera_matrix_before_processing) {
 		std::string frame_path = this->GenerateCurrentFrameOutputPath();
@@ -68,15 +74,21 @@ void CLIEngine::Initialise(ImageSourceEngine *image_source, IMUSourceEngine *imu
 	printf("initialised.\n");
 }
 
-bool CLIEngine::ProcessFrame()
+bool CLIEngine::ReadFrame(UChar4Image* rgb_image, ShortImage* raw_depth_image, IMUMeasurement* imu_measurement)
 {
 	if (!image_source->HasMoreImages()) return false;
-	image_source->GetImages(*input_RGB_image, *input_raw_depth_image);
+	image_source->GetImages(*rgb_image, *raw_depth_image);
 
 	if (imu_source != nullptr) {
 		if (!imu_source->hasMoreMeasurements()) return false;
-		else imu_source->getMeasurement(input_IMU_measurement);
+		else imu_source->getMeasurement(imu_measurement);
 	}
+	return true;
+}
+
+bool CLIEngine::ProcessFrame()
+{
+	if (!ReadFrame(input_RGB_image, input_raw_depth_image, input_IMU_measurement)) return false;
 
 	sdkResetTimer(&timer_instant);
 	sdkStartTimer(&timer_instant); sdkStartTimer(&timer_average);
@@ -102,12 +114,64 @@ bool CLIEngine::ProcessFrame()
 
 void CLIEngine::Run()
 {
+	if (pipeline_frame_processing) {
+		RunPipelined();
+		return;
+	}
 	while (this->index_of_frame_to_end_before <= 0 || this->current_frame_index < this->index_of_frame_to_end_before) {
 		if (!ProcessFrame()) break;
 		current_frame_index++;
 	}
 }
 
+void CLIEngine::RunPipelined()
+{
+	// Frame N+1 is read (and, if the engine supports it, preprocessed) on a separate thread while frame N is aligned &
+	// fused. Devices are synchronized only at the end, so the reported per-frame times are host-side times.
+	const bool engine_prepares_frames = main_engine->CanPrepareFrames();
+	auto read_and_prepare_frame = [this, engine_prepares_frames](UChar4Image* rgb_image, ShortImage* raw_depth_image,
+	                                                             IMUMeasurement* imu_measurement) {
+		if (!ReadFrame(rgb_image, raw_depth_image, imu_measurement)) return false;
+		if (engine_prepares_frames) {
+			main_engine->PrepareFrame(rgb_image, raw_depth_image, imu_source != nullptr ? imu_measurement : nullptr);
+		}
+		return true;
+	};
+	auto frame_in_range = [this](int frame_index) {
+		return this->index_of_frame_to_end_before <= 0 || frame_index < this->index_of_frame_to_end_before;
+	};
+
+	bool frame_available = frame_in_range(current_frame_index) &&
+	                       read_and_prepare_frame(input_RGB_image, input_raw_depth_image, input_IMU_measurement);
+	while (frame_available) {
+		std::future<bool> next_frame_available;
+		const bool next_frame_in_range = frame_in_range(current_frame_index + 1);
+		if (next_frame_in_range) {
+			next_frame_available = std::async(std::launch::async, read_and_prepare_frame, next_input_RGB_image,
+			                                  next_input_raw_depth_image, next_input_IMU_measurement);
+		}
+
+		sdkResetTimer(&timer_instant);
+		sdkStartTimer(&timer_instant); sdkStartTimer(&timer_average);
+		if (engine_prepares_frames) main_engine->ProcessPreparedFrame();
+		else if (imu_source != nullptr) main_engine->ProcessFrame(input_RGB_image, input_raw_depth_image, input_IMU_measurement);
+		else main_engine->ProcessFrame(input_RGB_image, input_raw_depth_image);
+		sdkStopTimer(&timer_instant); sdkStopTimer(&timer_average);
+
+		printf("frame %i: time %.2f, avg %.2f\n", current_frame_index, sdkGetTimerValue(&timer_instant),
+		       sdkGetAverageTimerValue(&timer_average));
+		current_frame_index++;
+
+		frame_available = next_frame_in_range && next_frame_available.get();
+		std::swap(input_RGB_image, next_input_RGB_image);
+		std::swap(input_raw_depth_image, next_input_raw_depth_image);
+		std::swap(input_IMU_measurement, next_input_IMU_measurement);
+	}
+#ifndef COMPILE_WITHOUT_CUDA
+	ORcudaSafeCall(cudaDeviceSynchronize());
+#endif
+}
+
 void CLIEngine::Shutdown()
 {
 	if(this->save_after_automatic_run){
@@ -121,12 +185,13 @@ void CLIEngine::Shutdown()
 	delete input_RGB_image;
 	delete input_raw_depth_image;
 	delete input_IMU_measurement;
+	delete next_input_RGB_image;
+	delete next_input_raw_depth_image;
+	delete next_input_IMU_measurement;
 }
 
 void CLIEngine::SkipFrames(int number_of_frames_to_skip) {
-	for (int i_frame = 0; i_frame < number_of_frames_to_skip && image_source->HasMoreImages(); i_frame++) {
-		image_source->GetImages(*input_RGB_image, *input_raw_depth_image);
-	}
+	image_source->SkipImages(number_of_frames_to_skip);
 	this->current_frame_index += number_of_frames_to_skip;
 }
 
@@ -27,14 +27,20 @@ namespace InfiniTAM
 		private:
 			UChar4Image *input_RGB_image; ShortImage *input_raw_depth_image;
 			ITMLib::IMUMeasurement *input_IMU_measurement;
+			// second set of input buffers, which the next frame is read into while the current one is processed
+			UChar4Image *next_input_RGB_image; ShortImage *next_input_raw_depth_image;
+			ITMLib::IMUMeasurement *next_input_IMU_measurement;
 
 			int current_frame_index;
 			int index_of_frame_to_end_before = 0;
 			bool save_after_automatic_run = false;
+			bool pipeline_frame_processing = false;
 
 			std::string output_path;
 
 			void SkipFrames(int number_of_frames_to_skip);
+			bool ReadFrame(UChar4Image* rgb_image, ShortImage* raw_depth_image, ITMLib::IMUMeasurement* imu_measurement);
+			void RunPipelined();
 			std::string GenerateCurrentFrameOutputPath() const;
 			std::string GeneratePreviousFrameOutputPath() const;
 		public:
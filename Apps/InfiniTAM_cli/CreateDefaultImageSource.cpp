@@ -42,7 +42,7 @@ void CreateDefaultImageSource(ImageSourceEngine*& imageSource, IMUSourceEngine*&
 		if (inputPaths.imu_input_path.empty()) {
 			ImageMaskPathGenerator pathGenerator(inputPaths.rgb_image_path_mask.c_str(), inputPaths.depth_image_path_mask.c_str(),
 			                                     inputPaths.mask_image_path_mask.empty() ? nullptr : inputPaths.mask_image_path_mask.c_str());
-			imageSource = new ImageFileReader<ImageMaskPathGenerator>(inputPaths.calibration_file_path.c_str(), pathGenerator);
+			imageSource = new PrefetchingImageFileReader<ImageMaskPathGenerator>(inputPaths.calibration_file_path.c_str(), pathGenerator);
 		} else {
 			printf("using imu data: %s\n", inputPaths.imu_input_path.c_str());
 			imageSource = new RawFileReader(inputPaths.calibration_file_path.c_str(), inputPaths.rgb_image_path_mask.c_str(),
@@ -25,6 +25,7 @@
 #include "../../InputSource/RealSenseEngine.h"
 #include "../../InputSource/FFMPEGReader.h"
 #include "../../InputSource/IMUSourceEngine.h"
+#include "../../InputSource/PrefetchingImageFileReader.h"
 
 #include "../../ITMLib/Utils/Configuration/Configuration.h"
 
@@ -2,63 +2,117 @@
 
 #include "RelocDatabase.h"
 
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
 
+#ifdef WITH_AVX2
+#include <immintrin.h>
+#endif
+
 using namespace FernRelocLib;
 
+namespace
+{
+	// Missing codes are stored as different values in the database and in the query, so that they never match.
+	const unsigned char MISSING_ENTRY_CODE = 0xFF;
+	const unsigned char MISSING_QUERY_CODE = 0xFE;
+	const int CODE_ROW_ALIGNMENT = 32;
+
+	void packCodes(const char *codeFragments, int codeLength, unsigned char missingCode, unsigned char *codes)
+	{
+		for (int f = 0; f < codeLength; f++)
+			codes[f] = codeFragments[f] < 0 ? missingCode : static_cast<unsigned char>(codeFragments[f]);
+	}
+
+	/** Orders candidates (similarity, id) best-first; among equally similar entries, the newer one ranks higher. */
+	bool isBetterCandidate(const std::pair<int, int> &a, const std::pair<int, int> &b)
+	{
+		return a.first != b.first ? a.first > b.first : a.second > b.second;
+	}
+}
+
 RelocDatabase::RelocDatabase(int codeLength, int codeFragmentDim)
 {
 	mTotalEntries = 0;
-	mCodeLength = codeLength;
 	mCodeFragmentDim = codeFragmentDim;
-
-	mIds = new std::vector<int>[codeLength*codeFragmentDim];
+	setCodeLength(codeLength);
 }
 
 RelocDatabase::~RelocDatabase()
 {
-	delete[] mIds;
+}
+
+void RelocDatabase::setCodeLength(int codeLength)
+{
+	mCodeLength = codeLength;
+	mCodeStride = (codeLength + CODE_ROW_ALIGNMENT - 1) / CODE_ROW_ALIGNMENT * CODE_ROW_ALIGNMENT;
+	mQueryCodes.assign(mCodeStride, MISSING_QUERY_CODE);
+}
+
+int RelocDatabase::countMatches(const unsigned char *entryCodes) const
+{
+	const unsigned char *queryCodes = mQueryCodes.data();
+	int matches = 0;
+#ifdef WITH_AVX2
+	for (int offset = 0; offset < mCodeStride; offset += 32)
+	{
+		__m256i entry = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(entryCodes + offset));
+		__m256i query = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(queryCodes + offset));
+		unsigned int equalMask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(entry, query)));
+		matches += static_cast<int>(std::bitset<32>(equalMask).count());
+	}
+#else
+	// eight codes at a time: after the xor, exactly the bytes that were equal are zero, and get their high bit set
+	const std::uint64_t lowBits = 0x7F7F7F7F7F7F7F7FULL;
+	for (int offset = 0; offset < mCodeStride; offset += 8)
+	{
+		std::uint64_t entry, query;
+		memcpy(&entry, entryCodes + offset, sizeof(entry));
+		memcpy(&query, queryCodes + offset, sizeof(query));
+		std::uint64_t difference = entry ^ query;
+		std::uint64_t equalMask = ~(((difference & lowBits) + lowBits) | difference | lowBits);
+		matches += static_cast<int>(std::bitset<64>(equalMask).count());
+	}
+#endif
+	return matches;
 }
 
 int RelocDatabase::findMostSimilar(const char *codeFragments, int nearestNeighbours[], float distances[], int k)
 {
 	int foundNN = 0;
-	if (mTotalEntries > 0)
+	if (mTotalEntries > 0 && k > 0)
 	{
-		int *similarities = new int[mTotalEntries];
-		for (int i = 0; i < mTotalEntries; ++i) similarities[i] = 0;
-
-		for (int f = 0; f < mCodeLength; f++)
-		{
-			if (codeFragments[f] < 0) continue;
-			const std::vector<int> *sameCode = &(mIds[f * mCodeFragmentDim + codeFragments[f]]);
-
-			for (unsigned int i = 0; i < sameCode->size(); ++i) similarities[(*sameCode)[i]]++;
-		}
+		packCodes(codeFragments, mCodeLength, MISSING_QUERY_CODE, mQueryCodes.data());
 
+		// keep the k best candidates seen so far in a heap with the worst of them on top
+		mTopCandidates.clear();
 		for (int i = 0; i < mTotalEntries; ++i)
 		{
-			float distance = ((float)mCodeLength - (float)similarities[i]) / (float)mCodeLength;
-
-			int j;
-			for (j = foundNN; j > 0; --j)
+			std::pair<int, int> candidate(countMatches(&mCodes[static_cast<size_t>(i) * mCodeStride]), i);
+			if (static_cast<int>(mTopCandidates.size()) < k)
 			{
-				if (distances[j - 1] < distance) break;
-				if (j == k) continue;
-				distances[j] = distances[j - 1];
-				nearestNeighbours[j] = nearestNeighbours[j - 1];
+				mTopCandidates.push_back(candidate);
+				std::push_heap(mTopCandidates.begin(), mTopCandidates.end(), isBetterCandidate);
 			}
-
-			if (j != k)
+			else if (isBetterCandidate(candidate, mTopCandidates.front()))
 			{
-				distances[j] = distance;
-				nearestNeighbours[j] = i;
-				if (foundNN < k) ++foundNN;
+				std::pop_heap(mTopCandidates.begin(), mTopCandidates.end(), isBetterCandidate);
+				mTopCandidates.back() = candidate;
+				std::push_heap(mTopCandidates.begin(), mTopCandidates.end(), isBetterCandidate);
 			}
 		}
+		std::sort_heap(mTopCandidates.begin(), mTopCandidates.end(), isBetterCandidate);
 
-		delete[] similarities;
+		foundNN = static_cast<int>(mTopCandidates.size());
+		for (int i = 0; i < foundNN; ++i)
+		{
+			distances[i] = ((float)mCodeLength - (float)mTopCandidates[i].first) / (float)mCodeLength;
+			nearestNeighbours[i] = mTopCandidates[i].second;
+		}
 	}
 
 	for (int i = foundNN; i < k; ++i)
@@ -74,13 +128,8 @@ int RelocDatabase::findMostSimilar(const char *codeFragments, int nearestNeighbo
 int RelocDatabase::addEntry(const char *codeFragments)
 {
 	int newId = mTotalEntries++;
-	for (int f = 0; f < mCodeLength; f++)
-	{
-		if (codeFragments[f] < 0) continue;
-		std::vector<int> *sameCode = &(mIds[f * mCodeFragmentDim + codeFragments[f]]);
-
-		sameCode->push_back(newId);
-	}
+	mCodes.resize(static_cast<size_t>(mTotalEntries) * mCodeStride, MISSING_ENTRY_CODE);
+	packCodes(codeFragments, mCodeLength, MISSING_ENTRY_CODE, &mCodes[static_cast<size_t>(newId) * mCodeStride]);
 
 	return newId;
 }
@@ -90,13 +139,25 @@ void RelocDatabase::SaveToFile(const std::string &framesFileName) const
 	std::ofstream ofs(framesFileName.c_str());
 	if (!ofs) throw std::runtime_error("Could not open " + framesFileName + " for reading");
 
+	// the file lists, for every fern and code, the ids of the entries having that code
 	ofs << mCodeLength << " " << mCodeFragmentDim << " " << mTotalEntries << "\n";
-	int dimTotal = mCodeLength * mCodeFragmentDim;
-	for (int i = 0; i < dimTotal; i++)
+	std::vector<std::vector<int> > idsByCode(mCodeFragmentDim);
+	for (int f = 0; f < mCodeLength; f++)
 	{
-		ofs << mIds[i].size() << " ";
-		for (size_t j = 0; j < mIds[i].size(); j++) ofs << mIds[i][j] << " ";
-		ofs << "\n";
+		for (int code = 0; code < mCodeFragmentDim; code++) idsByCode[code].clear();
+		for (int id = 0; id < mTotalEntries; id++)
+		{
+			unsigned char code = mCodes[static_cast<size_t>(id) * mCodeStride + f];
+			if (code < mCodeFragmentDim) idsByCode[code].push_back(id);
+		}
+
+		for (int code = 0; code < mCodeFragmentDim; code++)
+		{
+			const std::vector<int> &sameCode = idsByCode[code];
+			ofs << sameCode.size() << " ";
+			for (size_t j = 0; j < sameCode.size(); j++) ofs << sameCode[j] << " ";
+			ofs << "\n";
+		}
 	}
 }
 
@@ -105,16 +166,20 @@ void RelocDatabase::LoadFromFile(const std::string &filename)
 	std::ifstream ifs(filename.c_str());
 	if (!ifs) throw std::runtime_error("unable to load " + filename);
 
-	ifs >> mCodeLength >> mCodeFragmentDim >> mTotalEntries;
+	int codeLength = 0;
+	ifs >> codeLength >> mCodeFragmentDim >> mTotalEntries;
+	setCodeLength(codeLength);
+	mCodes.assign(static_cast<size_t>(mTotalEntries) * mCodeStride, MISSING_ENTRY_CODE);
+
 	int len = 0, id = 0, dimTotal = mCodeFragmentDim * mCodeLength;
 	for (int i = 0; i < dimTotal; i++)
 	{
 		ifs >> len;
-		std::vector<int> *sameCode = &(mIds[i]);
 		for (int j = 0; j < len; j++)
 		{
 			ifs >> id;
-			sameCode->push_back(id);
+			mCodes[static_cast<size_t>(id) * mCodeStride + i / mCodeFragmentDim] =
+					static_cast<unsigned char>(i % mCodeFragmentDim);
 		}
 	}
 }
@@ -4,9 +4,17 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 
 namespace FernRelocLib
 {
+	/**
+	 * Keyframe database searched by fern code similarity, i.e. the number of ferns whose codes agree.
+	 *
+	 * The codes of each entry are kept as one byte per fern, in rows padded to a multiple of 32 bytes, so that a
+	 * query is scored against an entry with wide byte-wise compares followed by a popcount of the match mask.
+	 * The k most similar entries are selected with a bounded heap, and all per-query scratch storage is reused.
+	 */
 	class RelocDatabase
 	{
 	public:
@@ -25,9 +33,19 @@ namespace FernRelocLib
 		void LoadFromFile(const std::string &filename);
 
 	private:
+		void setCodeLength(int codeLength);
+		int countMatches(const unsigned char *entryCodes) const;
+
 		int mTotalEntries;
 
 		int mCodeLength, mCodeFragmentDim;
-		std::vector<int> *mIds;
+		/** Row length of mCodes in bytes: mCodeLength rounded up to a multiple of 32. */
+		int mCodeStride;
+		/** mTotalEntries rows of mCodeStride fern codes. */
+		std::vector<unsigned char> mCodes;
+
+		// scratch storage for findMostSimilar
+		std::vector<unsigned char> mQueryCodes;
+		std::vector<std::pair<int, int> > mTopCandidates;
 	};
 }
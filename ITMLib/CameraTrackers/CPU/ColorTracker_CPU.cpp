@@ -2,6 +2,7 @@
 
 #include "ColorTracker_CPU.h"
 #include "../Shared/ColorTracker_Shared.h"
+#include "TrackerReduction_CPU.h"
 
 using namespace ITMLib;
 
@@ -30,12 +31,16 @@ int ColorTracker_CPU::F_oneLevel(float *f, ORUtils::SE3Pose *pose)
 	Vector4f *colours = trackingState->point_cloud->colors->GetData(MEMORYDEVICE_CPU);
 	Vector4u *rgb = viewHierarchy->GetLevel(levelId)->rgb->GetData(MEMORYDEVICE_CPU);
 
-	final_f = 0; countedPoints_valid = 0;
-	for (int locId = 0; locId < point_count; locId++)
+	TrackerGradientHessianSums sums = ReduceInChunks_CPU<TrackerGradientHessianSums>(
+			point_count, [&](TrackerGradientHessianSums& chunk_sums, int begin, int end)
 	{
-		float color_difference_squared = getColorDifferenceSq(locations, colours, rgb, rgb_image_size, locId, rgb_camera_projection_parameters, M);
-		if (color_difference_squared >= 0) { final_f += color_difference_squared; countedPoints_valid++; }
-	}
+		for (int locId = begin; locId < end; locId++)
+		{
+			float color_difference_squared = getColorDifferenceSq(locations, colours, rgb, rgb_image_size, locId, rgb_camera_projection_parameters, M);
+			if (color_difference_squared >= 0) { chunk_sums.f += color_difference_squared; chunk_sums.valid_point_count++; }
+		}
+	});
+	final_f = sums.f; countedPoints_valid = sums.valid_point_count;
 
 	if (countedPoints_valid == 0) { final_f = 1e10; scale_for_occlusions = 1.0; }
 	else { scale_for_occlusions = (float)point_count / countedPoints_valid; }
@@ -62,32 +67,26 @@ void ColorTracker_CPU::G_oneLevel(float *gradient, float *hessian, ORUtils::SE3P
 	bool rotationOnly = iterationType == TRACKER_ITERATION_ROTATION;
 	int numPara = rotationOnly ? 3 : 6, startPara = rotationOnly ? 3 : 0, numParaSQ = rotationOnly ? 3 + 2 + 1 : 6 + 5 + 4 + 3 + 2 + 1;
 
-	float globalGradient[6], globalHessian[21];
-	for (int i = 0; i < numPara; i++) globalGradient[i] = 0.0f;
-	for (int i = 0; i < numParaSQ; i++) globalHessian[i] = 0.0f;
-
 	Vector4f *locations = trackingState->point_cloud->locations->GetData(MEMORYDEVICE_CPU);
 	Vector4f *colours = trackingState->point_cloud->colors->GetData(MEMORYDEVICE_CPU);
 	Vector4u *rgb = viewHierarchy->GetLevel(levelId)->rgb->GetData(MEMORYDEVICE_CPU);
 	Vector4s *gx = viewHierarchy->GetLevel(levelId)->gradientX_rgb->GetData(MEMORYDEVICE_CPU);
 	Vector4s *gy = viewHierarchy->GetLevel(levelId)->gradientY_rgb->GetData(MEMORYDEVICE_CPU);
 
-	for (int locId = 0; locId < noTotalPoints; locId++)
+	TrackerGradientHessianSums sums = ReduceInChunks_CPU<TrackerGradientHessianSums>(
+			noTotalPoints, [&](TrackerGradientHessianSums& chunkSums, int begin, int end)
 	{
 		float localGradient[6], localHessian[21];
 
-		computePerPointGH_rt_Color(localGradient, localHessian, locations, colours, rgb, imgSize, locId,
-			projParams, M, gx, gy, 6, 0);
-
-		bool isValidPoint = computePerPointGH_rt_Color(localGradient, localHessian, locations, colours, rgb, imgSize, locId,
-			projParams, M, gx, gy, numPara, startPara);
-
-		if (isValidPoint)
+		for (int locId = begin; locId < end; locId++)
 		{
-			for (int i = 0; i < numPara; i++) globalGradient[i] += localGradient[i];
-			for (int i = 0; i < numParaSQ; i++) globalHessian[i] += localHessian[i];
+			bool isValidPoint = computePerPointGH_rt_Color(localGradient, localHessian, locations, colours, rgb, imgSize, locId,
+				projParams, M, gx, gy, numPara, startPara);
+
+			if (isValidPoint) chunkSums.AddPoint(0.0f, localGradient, localHessian, numPara, numParaSQ);
 		}
-	}
+	});
+	const float *globalGradient = sums.nabla, *globalHessian = sums.hessian;
 
 	scaleForOcclusions = (float)noTotalPoints / countedPoints_valid;
 	if (countedPoints_valid == 0) { scaleForOcclusions = 1.0f; }
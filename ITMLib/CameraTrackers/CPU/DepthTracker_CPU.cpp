@@ -2,6 +2,7 @@
 
 #include "DepthTracker_CPU.h"
 #include "../Shared/DepthTracker_Shared.h"
+#include "TrackerReduction_CPU.h"
 
 using namespace ITMLib;
 
@@ -35,54 +36,48 @@ int DepthTracker_CPU::ComputeGandH(float &f, float *nabla, float *hessian, Matri
 
 	bool shortIteration = (iterationType == TRACKER_ITERATION_ROTATION) || (iterationType == TRACKER_ITERATION_TRANSLATION);
 
-	float sumHessian[6 * 6], sumNabla[6], sumF; int noValidPoints;
 	int noPara = shortIteration ? 3 : 6, noParaSQ = shortIteration ? 3 + 2 + 1 : 6 + 5 + 4 + 3 + 2 + 1;
+	const TrackerIterationType currentIterationType = iterationType;
+	const float currentDistThresh = distThresh[levelId];
 
-	noValidPoints = 0; sumF = 0.0f;
-	memset(sumHessian, 0, sizeof(float) * noParaSQ);
-	memset(sumNabla, 0, sizeof(float) * noPara);
-
-	for (int y = 0; y < viewImageSize.y; y++) for (int x = 0; x < viewImageSize.x; x++)
+	TrackerGradientHessianSums sums = ReduceInChunks_CPU<TrackerGradientHessianSums>(
+			viewImageSize.x * viewImageSize.y, [&](TrackerGradientHessianSums& chunkSums, int begin, int end)
 	{
 		float localHessian[6 + 5 + 4 + 3 + 2 + 1], localNabla[6], localF = 0;
 
-		for (int i = 0; i < noPara; i++) localNabla[i] = 0.0f;
-		for (int i = 0; i < noParaSQ; i++) localHessian[i] = 0.0f;
-
-		bool isValidPoint;
-        
-		switch (iterationType)
+		for (int locId = begin; locId < end; locId++)
 		{
-		case TRACKER_ITERATION_ROTATION:
-			isValidPoint = computePerPointGH_Depth<true, true>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], viewImageSize,
-				viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, distThresh[levelId]);
-			break;
-		case TRACKER_ITERATION_TRANSLATION:
-			isValidPoint = computePerPointGH_Depth<true, false>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], viewImageSize,
-				viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, distThresh[levelId]);
-			break;
-		case TRACKER_ITERATION_BOTH:
-			isValidPoint = computePerPointGH_Depth<false, false>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], viewImageSize,
-				viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, distThresh[levelId]);
-			break;
-		default:
-			isValidPoint = false;
-			break;
+			int x = locId % viewImageSize.x, y = locId / viewImageSize.x;
+			bool isValidPoint;
+
+			switch (currentIterationType)
+			{
+			case TRACKER_ITERATION_ROTATION:
+				isValidPoint = computePerPointGH_Depth<true, true>(localNabla, localHessian, localF, x, y, depth[locId], viewImageSize,
+					viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentDistThresh);
+				break;
+			case TRACKER_ITERATION_TRANSLATION:
+				isValidPoint = computePerPointGH_Depth<true, false>(localNabla, localHessian, localF, x, y, depth[locId], viewImageSize,
+					viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentDistThresh);
+				break;
+			case TRACKER_ITERATION_BOTH:
+				isValidPoint = computePerPointGH_Depth<false, false>(localNabla, localHessian, localF, x, y, depth[locId], viewImageSize,
+					viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentDistThresh);
+				break;
+			default:
+				isValidPoint = false;
+				break;
+			}
+
+			if (isValidPoint) chunkSums.AddPoint(localF, localNabla, localHessian, noPara, noParaSQ);
 		}
+	});
 
-		if (isValidPoint)
-		{
-			noValidPoints++; sumF += localF;
-			for (int i = 0; i < noPara; i++) sumNabla[i] += localNabla[i];
-			for (int i = 0; i < noParaSQ; i++) sumHessian[i] += localHessian[i];
-		}
-	}
+	int noValidPoints = sums.valid_point_count;
+	sums.CopyHessianTo(hessian, noPara, 6);
 
-	for (int r = 0, counter = 0; r < noPara; r++) for (int c = 0; c <= r; c++, counter++) hessian[r + c * 6] = sumHessian[counter];
-	for (int r = 0; r < noPara; ++r) for (int c = r + 1; c < noPara; c++) hessian[r + c * 6] = hessian[c + r * 6];
-	
-	memcpy(nabla, sumNabla, noPara * sizeof(float));
-	f = (noValidPoints > 100) ? sumF / noValidPoints : 1e5f;
+	memcpy(nabla, sums.nabla, noPara * sizeof(float));
+	f = (noValidPoints > 100) ? sums.f / noValidPoints : 1e5f;
 
 	return noValidPoints;
 }
@@ -2,6 +2,7 @@
 
 #include "ExtendedTracker_CPU.h"
 #include "../Shared/ExtendedTracker_Shared.h"
+#include "TrackerReduction_CPU.h"
 
 using namespace ITMLib;
 
@@ -66,95 +67,80 @@ int ExtendedTracker_CPU::ComputeGandH_Depth(float &f, float *nabla, float *hessi
 	bool shortIteration = (currentIterationType == TRACKER_ITERATION_ROTATION)
 						   || (currentIterationType == TRACKER_ITERATION_TRANSLATION);
 
-	float sumHessian[6 * 6], sumNabla[6], sumF; int noValidPoints;
 	int noPara = shortIteration ? 3 : 6, noParaSQ = shortIteration ? 3 + 2 + 1 : 6 + 5 + 4 + 3 + 2 + 1;
+	const float currentSpaceThresh = spaceThresh[currentLevelId];
 
-	noValidPoints = 0; sumF = 0.0f;
-	memset(sumHessian, 0, sizeof(float) * noParaSQ);
-	memset(sumNabla, 0, sizeof(float) * noPara);
-
-	for (int y = 0; y < viewImageSize.y; y++) for (int x = 0; x < viewImageSize.x; x++)
+	TrackerGradientHessianSums sums = ReduceInChunks_CPU<TrackerGradientHessianSums>(
+			viewImageSize.x * viewImageSize.y, [&](TrackerGradientHessianSums& chunkSums, int begin, int end)
 	{
 		float localHessian[6 + 5 + 4 + 3 + 2 + 1], localNabla[6], localF = 0;
 
-		for (int i = 0; i < noPara; i++) localNabla[i] = 0.0f;
-		for (int i = 0; i < noParaSQ; i++) localHessian[i] = 0.0f;
-
-		bool isValidPoint;
+		for (int locId = begin; locId < end; locId++)
+		{
+			int x = locId % viewImageSize.x, y = locId / viewImageSize.x;
+			bool isValidPoint;
 
-		float depthWeight;
+			float depthWeight;
 
-		if (framesProcessed < 100)
-		{
-			switch (currentIterationType)
+			if (framesProcessed < 100)
 			{
-			case TRACKER_ITERATION_ROTATION:
-				isValidPoint = computePerPointGH_exDepth<true, true, false>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], depthWeight,
-					viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, spaceThresh[currentLevelId],
-					viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
-				break;
-			case TRACKER_ITERATION_TRANSLATION:
-				isValidPoint = computePerPointGH_exDepth<true, false, false>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], depthWeight,
-					viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, spaceThresh[currentLevelId],
-					viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
-				break;
-			case TRACKER_ITERATION_BOTH:
-				isValidPoint = computePerPointGH_exDepth<false, false, false>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], depthWeight,
-					viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, spaceThresh[currentLevelId],
-					viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
-				break;
-			default:
-				isValidPoint = false;
-				break;
+				switch (currentIterationType)
+				{
+				case TRACKER_ITERATION_ROTATION:
+					isValidPoint = computePerPointGH_exDepth<true, true, false>(localNabla, localHessian, localF, x, y, depth[locId], depthWeight,
+						viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentSpaceThresh,
+						viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
+					break;
+				case TRACKER_ITERATION_TRANSLATION:
+					isValidPoint = computePerPointGH_exDepth<true, false, false>(localNabla, localHessian, localF, x, y, depth[locId], depthWeight,
+						viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentSpaceThresh,
+						viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
+					break;
+				case TRACKER_ITERATION_BOTH:
+					isValidPoint = computePerPointGH_exDepth<false, false, false>(localNabla, localHessian, localF, x, y, depth[locId], depthWeight,
+						viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentSpaceThresh,
+						viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
+					break;
+				default:
+					isValidPoint = false;
+					break;
+				}
 			}
-		}
-		else
-		{
-			switch (currentIterationType)
+			else
 			{
-			case TRACKER_ITERATION_ROTATION:
-				isValidPoint = computePerPointGH_exDepth<true, true, true>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], depthWeight,
-					viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, spaceThresh[currentLevelId],
-					viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
-				break;
-			case TRACKER_ITERATION_TRANSLATION:
-				isValidPoint = computePerPointGH_exDepth<true, false, true>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], depthWeight,
-					viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, spaceThresh[currentLevelId],
-					viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
-				break;
-			case TRACKER_ITERATION_BOTH:
-				isValidPoint = computePerPointGH_exDepth<false, false, true>(localNabla, localHessian, localF, x, y, depth[x + y * viewImageSize.x], depthWeight,
-					viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, spaceThresh[currentLevelId],
-					viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
-				break;
-			default:
-				isValidPoint = false;
-				break;
+				switch (currentIterationType)
+				{
+				case TRACKER_ITERATION_ROTATION:
+					isValidPoint = computePerPointGH_exDepth<true, true, true>(localNabla, localHessian, localF, x, y, depth[locId], depthWeight,
+						viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentSpaceThresh,
+						viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
+					break;
+				case TRACKER_ITERATION_TRANSLATION:
+					isValidPoint = computePerPointGH_exDepth<true, false, true>(localNabla, localHessian, localF, x, y, depth[locId], depthWeight,
+						viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentSpaceThresh,
+						viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
+					break;
+				case TRACKER_ITERATION_BOTH:
+					isValidPoint = computePerPointGH_exDepth<false, false, true>(localNabla, localHessian, localF, x, y, depth[locId], depthWeight,
+						viewImageSize, viewIntrinsics, sceneImageSize, sceneIntrinsics, approxInvPose, scenePose, pointsMap, normalsMap, currentSpaceThresh,
+						viewFrustum_min, viewFrustum_max, tukeyCutOff, framesToSkip, framesToWeight);
+					break;
+				default:
+					isValidPoint = false;
+					break;
+				}
 			}
-		}
 
-		if (isValidPoint)
-		{
-			noValidPoints++;
-			sumF += localF;
-			for (int i = 0; i < noPara; i++) sumNabla[i] += localNabla[i];
-			for (int i = 0; i < noParaSQ; i++) sumHessian[i] += localHessian[i];
+			if (isValidPoint) chunkSums.AddPoint(localF, localNabla, localHessian, noPara, noParaSQ);
 		}
-	}
-
-	// Copy the lower triangular part of the matrix.
-	for (int r = 0, counter = 0; r < noPara; r++)
-		for (int c = 0; c <= r; c++, counter++)
-			hessian[r + c * 6] = sumHessian[counter];
+	});
 
-	// Transpose to fill the upper triangle.
-	for (int r = 0; r < noPara; ++r)
-		for (int c = r + 1; c < noPara; c++)
-			hessian[r + c * 6] = hessian[c + r * 6];
+	int noValidPoints = sums.valid_point_count;
+	sums.CopyHessianTo(hessian, noPara, 6);
 
-	memcpy(nabla, sumNabla, noPara * sizeof(float));
+	memcpy(nabla, sums.nabla, noPara * sizeof(float));
 
-	f = sumF;
+	f = sums.f;
 
 	return noValidPoints;
 }
@@ -177,124 +163,109 @@ int ExtendedTracker_CPU::ComputeGandH_RGB(float &f, float *nabla, float *hessian
 	bool shortIteration = (currentIterationType == TRACKER_ITERATION_ROTATION)
 						   || (currentIterationType == TRACKER_ITERATION_TRANSLATION);
 
-	float sumHessian[6 * 6], sumNabla[6], sumF;
-	int noValidPoints;
 	int noPara = shortIteration ? 3 : 6, noParaSQ = shortIteration ? 3 + 2 + 1 : 6 + 5 + 4 + 3 + 2 + 1;
+	const Matrix4f depthToRGBScenePose = depthToRGBTransform * scenePose;
+	const float currentColourThresh = colourThresh[currentLevelId];
 
-	noValidPoints = 0; sumF = 0.0f;
-	memset(sumHessian, 0, sizeof(float) * noParaSQ);
-	memset(sumNabla, 0, sizeof(float) * noPara);
-
-	for (int y = 0; y < viewImageSize_depth.y; y++) for (int x = 0; x < viewImageSize_depth.x; x++)
+	TrackerGradientHessianSums sums = ReduceInChunks_CPU<TrackerGradientHessianSums>(
+			viewImageSize_depth.x * viewImageSize_depth.y, [&](TrackerGradientHessianSums& chunkSums, int begin, int end)
 	{
 		float localHessian[6 + 5 + 4 + 3 + 2 + 1], localNabla[6], localF = 0;
 
-		for (int i = 0; i < noPara; i++) localNabla[i] = 0.0f;
-		for (int i = 0; i < noParaSQ; i++) localHessian[i] = 0.0f;
-
-		bool isValidPoint = false;
-
-		switch (currentIterationType)
+		for (int locId = begin; locId < end; locId++)
 		{
-		case TRACKER_ITERATION_ROTATION:
-			isValidPoint = computePerPointGH_exRGB_inv_Ab<true, true>(
-					localF,
-					localNabla,
-					localHessian,
-					x,
-					y,
-					points_curr,
-					intensities_current,
-					intensities_prev,
-					gradients,
-					viewImageSize_depth,
-					viewImageSize_rgb,
-					projParams_depth,
-					projParams_rgb,
-					approxInvPose,
-					depthToRGBTransform * scenePose,
-					colourThresh[currentLevelId],
-					minColourGradient,
-					viewFrustum_min,
-					viewFrustum_max,
-					tukeyCutOff
-					);
-			break;
-		case TRACKER_ITERATION_TRANSLATION:
-			isValidPoint = computePerPointGH_exRGB_inv_Ab<true, false>(
-					localF,
-					localNabla,
-					localHessian,
-					x,
-					y,
-					points_curr,
-					intensities_current,
-					intensities_prev,
-					gradients,
-					viewImageSize_depth,
-					viewImageSize_rgb,
-					projParams_depth,
-					projParams_rgb,
-					approxInvPose,
-					depthToRGBTransform * scenePose,
-					colourThresh[currentLevelId],
-					minColourGradient,
-					viewFrustum_min,
-					viewFrustum_max,
-					tukeyCutOff
-					);
-			break;
-		case TRACKER_ITERATION_BOTH:
-			isValidPoint = computePerPointGH_exRGB_inv_Ab<false, false>(
-					localF,
-					localNabla,
-					localHessian,
-					x,
-					y,
-					points_curr,
-					intensities_current,
-					intensities_prev,
-					gradients,
-					viewImageSize_depth,
-					viewImageSize_rgb,
-					projParams_depth,
-					projParams_rgb,
-					approxInvPose,
-					depthToRGBTransform * scenePose,
-					colourThresh[currentLevelId],
-					minColourGradient,
-					viewFrustum_min,
-					viewFrustum_max,
-					tukeyCutOff
-					);
-			break;
-		default:
-			isValidPoint = false;
-			break;
-		}
+			int x = locId % viewImageSize_depth.x, y = locId / viewImageSize_depth.x;
+			bool isValidPoint = false;
 
-		if (isValidPoint)
-		{
-			noValidPoints++;
-			sumF += localF;
-			for (int i = 0; i < noPara; i++) sumNabla[i] += localNabla[i];
-			for (int i = 0; i < noParaSQ; i++) sumHessian[i] += localHessian[i];
-		}
-	}
+			switch (currentIterationType)
+			{
+			case TRACKER_ITERATION_ROTATION:
+				isValidPoint = computePerPointGH_exRGB_inv_Ab<true, true>(
+						localF,
+						localNabla,
+						localHessian,
+						x,
+						y,
+						points_curr,
+						intensities_current,
+						intensities_prev,
+						gradients,
+						viewImageSize_depth,
+						viewImageSize_rgb,
+						projParams_depth,
+						projParams_rgb,
+						approxInvPose,
+						depthToRGBScenePose,
+						currentColourThresh,
+						minColourGradient,
+						viewFrustum_min,
+						viewFrustum_max,
+						tukeyCutOff
+						);
+				break;
+			case TRACKER_ITERATION_TRANSLATION:
+				isValidPoint = computePerPointGH_exRGB_inv_Ab<true, false>(
+						localF,
+						localNabla,
+						localHessian,
+						x,
+						y,
+						points_curr,
+						intensities_current,
+						intensities_prev,
+						gradients,
+						viewImageSize_depth,
+						viewImageSize_rgb,
+						projParams_depth,
+						projParams_rgb,
+						approxInvPose,
+						depthToRGBScenePose,
+						currentColourThresh,
+						minColourGradient,
+						viewFrustum_min,
+						viewFrustum_max,
+						tukeyCutOff
+						);
+				break;
+			case TRACKER_ITERATION_BOTH:
+				isValidPoint = computePerPointGH_exRGB_inv_Ab<false, false>(
+						localF,
+						localNabla,
+						localHessian,
+						x,
+						y,
+						points_curr,
+						intensities_current,
+						intensities_prev,
+						gradients,
+						viewImageSize_depth,
+						viewImageSize_rgb,
+						projParams_depth,
+						projParams_rgb,
+						approxInvPose,
+						depthToRGBScenePose,
+						currentColourThresh,
+						minColourGradient,
+						viewFrustum_min,
+						viewFrustum_max,
+						tukeyCutOff
+						);
+				break;
+			default:
+				isValidPoint = false;
+				break;
+			}
 
-	// Copy the lower triangular part of the matrix.
-	for (int r = 0, counter = 0; r < noPara; r++)
-		for (int c = 0; c <= r; c++, counter++)
-			hessian[r + c * 6] = sumHessian[counter];
+			if (isValidPoint) chunkSums.AddPoint(localF, localNabla, localHessian, noPara, noParaSQ);
+		}
+	});
 
-	// Transpose to fill the upper triangle.
-	for (int r = 0; r < noPara; ++r)
-		for (int c = r + 1; c < noPara; c++)
-			hessian[r + c * 6] = hessian[c + r * 6];
+	int noValidPoints = sums.valid_point_count;
+	sums.CopyHessianTo(hessian, noPara, 6);
 
-	memcpy(nabla, sumNabla, noPara * sizeof(float));
+	memcpy(nabla, sums.nabla, noPara * sizeof(float));
 
-	f = sumF;
+	f = sums.f;
 
 	return noValidPoints;
 }
@@ -318,6 +289,9 @@ void ExtendedTracker_CPU::ProjectCurrentIntensityFrame(Float4Image *points_out,
 	Vector4f *pointsOut = points_out->GetData(MEMORYDEVICE_CPU);
 	float *intensityOut = intensity_out->GetData(MEMORYDEVICE_CPU);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 0; y < imageSize_depth.y; y++) for (int x = 0; x < imageSize_depth.x; x++)
 		projectPoint_exRGB(x, y, pointsOut, intensityOut, intensityIn, depths, imageSize_rgb, imageSize_depth, intrinsics_rgb, intrinsics_depth, scenePose);
 }
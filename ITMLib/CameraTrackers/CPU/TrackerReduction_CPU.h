@@ -0,0 +1,84 @@
+#pragma once
+
+//stdlib
+#include <vector>
+
+namespace ITMLib {
+
+// number of pixels (or points) that one task of a parallel tracker reduction accumulates sequentially
+#define TRACKER_REDUCTION_CHUNK_SIZE 4096
+
+/**
+ * \brief Sums of the per-point objective values, gradients, and lower-triangular Hessian entries of a tracker
+ * iteration, along with the count of points that contributed.
+ */
+struct TrackerGradientHessianSums {
+	int valid_point_count = 0;
+	float f = 0.0f;
+	float nabla[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+	float hessian[6 + 5 + 4 + 3 + 2 + 1] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+	                                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+	void AddPoint(float local_f, const float* local_nabla, const float* local_hessian,
+	              int parameter_count, int hessian_entry_count) {
+		valid_point_count++;
+		f += local_f;
+		for (int i = 0; i < parameter_count; i++) nabla[i] += local_nabla[i];
+		for (int i = 0; i < hessian_entry_count; i++) hessian[i] += local_hessian[i];
+	}
+
+	void Add(const TrackerGradientHessianSums& other) {
+		valid_point_count += other.valid_point_count;
+		f += other.f;
+		for (int i = 0; i < 6; i++) nabla[i] += other.nabla[i];
+		for (int i = 0; i < 6 + 5 + 4 + 3 + 2 + 1; i++) hessian[i] += other.hessian[i];
+	}
+
+	/** Write the full symmetric parameter_count x parameter_count Hessian into a column-major matrix with the given row stride. */
+	void CopyHessianTo(float* full_hessian, int parameter_count, int row_stride) const {
+		for (int r = 0, counter = 0; r < parameter_count; r++)
+			for (int c = 0; c <= r; c++, counter++)
+				full_hessian[r + c * row_stride] = hessian[counter];
+		for (int r = 0; r < parameter_count; ++r)
+			for (int c = r + 1; c < parameter_count; c++)
+				full_hessian[r + c * row_stride] = full_hessian[c + r * row_stride];
+	}
+};
+
+/**
+ * \brief Parallel reduction over element_count elements (pixels or points) for the CPU trackers.
+ * \details The range is cut into chunks of TRACKER_REDUCTION_CHUNK_SIZE elements, which are accumulated in parallel by
+ * accumulate_chunk(TSums& chunk_sums, int begin, int end) into default-constructed TSums. The chunk sums are then
+ * combined pairwise in a fixed tree with TSums::Add. Neither the chunking nor the combination order depend on the
+ * number of threads or on scheduling, so the floating-point result is reproducible from run to run and machine to
+ * machine, and the pairwise combination keeps rounding error lower than one long running sum would.
+ * Only the reduction is parallel: within a chunk, points still go one by one through the per-point residual, gradient
+ * and Hessian functions the CPU trackers share with the CUDA ones. Those functions branch on point validity and look up
+ * the scene maps at projected (i.e. scattered) locations, so they are not vectorized across points.
+ */
+template<typename TSums, typename TAccumulateChunk>
+TSums ReduceInChunks_CPU(const int element_count, TAccumulateChunk&& accumulate_chunk) {
+	const int chunk_count = (element_count + TRACKER_REDUCTION_CHUNK_SIZE - 1) / TRACKER_REDUCTION_CHUNK_SIZE;
+	if (chunk_count == 0) return TSums();
+	std::vector<TSums> chunk_sums(chunk_count);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) default(none) shared(chunk_sums, accumulate_chunk) \
+	firstprivate(chunk_count, element_count)
+#endif
+	for (int i_chunk = 0; i_chunk < chunk_count; i_chunk++) {
+		const int begin = i_chunk * TRACKER_REDUCTION_CHUNK_SIZE;
+		const int end = begin + TRACKER_REDUCTION_CHUNK_SIZE < element_count ? begin + TRACKER_REDUCTION_CHUNK_SIZE
+		                                                                     : element_count;
+		accumulate_chunk(chunk_sums[i_chunk], begin, end);
+	}
+
+	for (int stride = 1; stride < chunk_count; stride *= 2) {
+		for (int i_chunk = 0; i_chunk + stride < chunk_count; i_chunk += 2 * stride) {
+			chunk_sums[i_chunk].Add(chunk_sums[i_chunk + stride]);
+		}
+	}
+	return chunk_sums[0];
+}
+
+} // namespace ITMLib
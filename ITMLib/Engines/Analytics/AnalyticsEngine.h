@@ -52,6 +52,13 @@ public:
 
 	double SumNonTruncatedVoxelAbsSdf(const VoxelVolume <TVoxel, TIndex>* volume) override;
 	double SumTruncatedVoxelAbsSdf(const VoxelVolume<TVoxel, TIndex>* volume) override;
+	void ComputeVoxelCategoryStatistics(const VoxelVolume<TVoxel, TIndex>* volume,
+	                                    unsigned int& non_truncated_voxel_count, unsigned int& plus_one_voxel_count,
+	                                    double& non_truncated_abs_sdf_sum, double& truncated_abs_sdf_sum) override;
+	void CountVoxelsAndHashBlocksWithDepthWeightInRanges(
+			const VoxelVolume<TVoxel, TIndex>* volume, const std::array<Extent2Di, depth_weight_range_count>& ranges,
+			std::array<unsigned int, depth_weight_range_count>& voxel_counts,
+			std::array<unsigned int, depth_weight_range_count>& hash_block_counts) override;
 
 	double ComputeWarpUpdateMin(const VoxelVolume<TVoxel, TIndex>* volume) override;
 	double ComputeWarpUpdateMax(const VoxelVolume <TVoxel, TIndex>* volume) override;
@@ -88,6 +88,57 @@ AnalyticsEngine<TVoxel, TIndex, TMemoryDeviceType>::SumTruncatedVoxelAbsSdf(
 	compute(volume, VoxelFlags::VOXEL_TRUNCATED);
 }
 
+template<typename TVoxel, typename TIndex, MemoryDeviceType TMemoryDeviceType>
+void AnalyticsEngine<TVoxel, TIndex, TMemoryDeviceType>::ComputeVoxelCategoryStatistics(
+		const VoxelVolume<TVoxel, TIndex>* volume,
+		unsigned int& non_truncated_voxel_count, unsigned int& plus_one_voxel_count,
+		double& non_truncated_abs_sdf_sum, double& truncated_abs_sdf_sum) {
+	if (!TVoxel::hasSemanticInformation || !TVoxel::hasSDFInformation) {
+		DIEWITHEXCEPTION_REPORTLOCATION("Voxels need to have SDF and semantic information to compute voxel category statistics.");
+	}
+	typedef RetrieveHasVoxelFlags<TVoxel, unsigned int, TVoxel::hasSemanticInformation> FlagRetrievalFunctorType;
+	typedef RetrieveIsVoxelSdfEqualTo<TVoxel, unsigned int, TVoxel::hasSDFInformation> SdfValueRetrievalFunctorType;
+	typedef RetrieveAbsSdfIfVoxelHasFlags<TVoxel, TVoxel::hasSemanticInformation> AbsSdfRetrievalFunctorType;
+
+	SumStatistic<FlagRetrievalFunctorType, unsigned int> non_truncated_count(FlagRetrievalFunctorType{VoxelFlags::VOXEL_NONTRUNCATED});
+	SumStatistic<SdfValueRetrievalFunctorType, unsigned int> plus_one_count(SdfValueRetrievalFunctorType{1.0f});
+	SumStatistic<AbsSdfRetrievalFunctorType, double> non_truncated_sum(AbsSdfRetrievalFunctorType{VoxelFlags::VOXEL_NONTRUNCATED});
+	SumStatistic<AbsSdfRetrievalFunctorType, double> truncated_sum(AbsSdfRetrievalFunctorType{VoxelFlags::VOXEL_TRUNCATED});
+	VolumeReductionEngine<TVoxel, TIndex, TMemoryDeviceType>::ReduceUtilizedStatistics(
+			volume, non_truncated_count, plus_one_count, non_truncated_sum, truncated_sum);
+
+	non_truncated_voxel_count = non_truncated_count.sum;
+	plus_one_voxel_count = plus_one_count.sum;
+	non_truncated_abs_sdf_sum = non_truncated_sum.sum;
+	truncated_abs_sdf_sum = truncated_sum.sum;
+}
+
+template<typename TVoxel, typename TIndex, MemoryDeviceType TMemoryDeviceType>
+void AnalyticsEngine<TVoxel, TIndex, TMemoryDeviceType>::CountVoxelsAndHashBlocksWithDepthWeightInRanges(
+		const VoxelVolume<TVoxel, TIndex>* volume, const std::array<Extent2Di, depth_weight_range_count>& ranges,
+		std::array<unsigned int, depth_weight_range_count>& voxel_counts,
+		std::array<unsigned int, depth_weight_range_count>& hash_block_counts) {
+	static_assert(depth_weight_range_count == 3, "The statistics below need to be kept in sync with depth_weight_range_count.");
+	if (!TVoxel::hasWeightInformation) {
+		DIEWITHEXCEPTION_REPORTLOCATION("Voxels need to have depth weight information to be counted by depth weight.");
+	}
+	typedef RetrieveIsVoxelInDepthWeightRange<TVoxel, unsigned int, TVoxel::hasWeightInformation> RetrievalFunctorType;
+	typedef SumStatistic<RetrievalFunctorType, unsigned int> VoxelCountStatisticType;
+	typedef BlockCountStatistic<RetrievalFunctorType> BlockCountStatisticType;
+
+	VoxelCountStatisticType voxel_count0(RetrievalFunctorType{ranges[0]});
+	VoxelCountStatisticType voxel_count1(RetrievalFunctorType{ranges[1]});
+	VoxelCountStatisticType voxel_count2(RetrievalFunctorType{ranges[2]});
+	BlockCountStatisticType block_count0(RetrievalFunctorType{ranges[0]});
+	BlockCountStatisticType block_count1(RetrievalFunctorType{ranges[1]});
+	BlockCountStatisticType block_count2(RetrievalFunctorType{ranges[2]});
+	VolumeReductionEngine<TVoxel, TIndex, TMemoryDeviceType>::ReduceUtilizedStatistics(
+			volume, voxel_count0, voxel_count1, voxel_count2, block_count0, block_count1, block_count2);
+
+	voxel_counts = {voxel_count0.sum, voxel_count1.sum, voxel_count2.sum};
+	hash_block_counts = {block_count0.count, block_count1.count, block_count2.count};
+}
+
 template<typename TVoxel, typename TIndex, MemoryDeviceType TMemoryDeviceType>
 unsigned int AnalyticsEngine<TVoxel, TIndex, TMemoryDeviceType>::CountVoxelsWithDepthWeightInRange(
 		const VoxelVolume<TVoxel, TIndex>* volume, Extent2Di range) {
@@ -16,6 +16,7 @@
 #pragma once
 
 
+#include <array>
 #include <vector>
 #include "../../Objects/Volume/VoxelVolume.h"
 #include "../../Utils/Enums/WarpType.h"
@@ -23,6 +24,9 @@
 #include "../../Utils/Analytics/Histogram.h"
 
 namespace ITMLib {
+// number of depth weight ranges handled by AnalyticsEngineInterface::CountVoxelsAndHashBlocksWithDepthWeightInRanges
+constexpr int depth_weight_range_count = 3;
+
 template<typename TVoxel, typename TIndex>
 class AnalyticsEngineInterface {
 public:
@@ -43,6 +47,22 @@ public:
 	virtual double SumNonTruncatedVoxelAbsSdf(const VoxelVolume<TVoxel, TIndex>* volume) = 0;
 	virtual double SumTruncatedVoxelAbsSdf(const VoxelVolume<TVoxel, TIndex>* volume) = 0;
 
+	/**
+	 * \brief Computes, in a single pass over the volume, the number of non-truncated voxels, the number of voxels with an SDF value of
+	 * exactly 1.0, and the sums of absolute SDF values over non-truncated and over truncated voxels.
+	 */
+	virtual void ComputeVoxelCategoryStatistics(const VoxelVolume<TVoxel, TIndex>* volume,
+	                                            unsigned int& non_truncated_voxel_count, unsigned int& plus_one_voxel_count,
+	                                            double& non_truncated_abs_sdf_sum, double& truncated_abs_sdf_sum) = 0;
+	/**
+	 * \brief For each range, counts voxels with depth weight in the range and hash blocks with all voxels' depth weights in the range,
+	 * all in a single pass over the volume. Hash block counts remain zero for volumes indexed by plain voxel arrays.
+	 */
+	virtual void CountVoxelsAndHashBlocksWithDepthWeightInRanges(
+			const VoxelVolume<TVoxel, TIndex>* volume, const std::array<Extent2Di, depth_weight_range_count>& ranges,
+			std::array<unsigned int, depth_weight_range_count>& voxel_counts,
+			std::array<unsigned int, depth_weight_range_count>& hash_block_counts) = 0;
+
 	virtual double ComputeWarpUpdateMin(const VoxelVolume<TVoxel,TIndex>* volume) = 0;
 	virtual double ComputeWarpUpdateMax(const VoxelVolume<TVoxel,TIndex>* volume) = 0;
 	virtual double ComputeWarpUpdateMean(const VoxelVolume<TVoxel,TIndex>* volume) = 0;
@@ -271,6 +271,74 @@ struct RetrieveIsVoxelNotInDepthWeightRange<TVoxel, TOutput, false> {
 	}
 };
 
+template<typename TVoxel, typename TOutput, bool THasSemanticInformation>
+struct RetrieveHasVoxelFlags;
+
+template<typename TVoxel, typename TOutput>
+struct RetrieveHasVoxelFlags<TVoxel, TOutput, true> {
+	VoxelFlags flags;
+	_CPU_AND_GPU_CODE_
+	inline TOutput retrieve(const TVoxel& voxel) const {
+		return static_cast<VoxelFlags>(voxel.flags) == flags;
+	}
+};
+
+template<typename TVoxel, typename TOutput>
+struct RetrieveHasVoxelFlags<TVoxel, TOutput, false> {
+	VoxelFlags flags;
+	_CPU_AND_GPU_CODE_
+	inline TOutput retrieve(const TVoxel& voxel) const {
+		DIEWITHEXCEPTION_REPORTLOCATION("Voxel doesn't have semantic information.");
+		return TOutput();
+	}
+};
+
+template<typename TVoxel, bool THasSemanticInformation>
+struct RetrieveAbsSdfIfVoxelHasFlags;
+
+template<typename TVoxel>
+struct RetrieveAbsSdfIfVoxelHasFlags<TVoxel, true> {
+	VoxelFlags flags;
+	_CPU_AND_GPU_CODE_
+	inline double retrieve(const TVoxel& voxel) const {
+		if (static_cast<VoxelFlags>(voxel.flags) != flags) return 0.0;
+		const double sdf = static_cast<double>(TVoxel::valueToFloat(voxel.sdf));
+		return ORUTILS_ABS(sdf);
+	}
+};
+
+template<typename TVoxel>
+struct RetrieveAbsSdfIfVoxelHasFlags<TVoxel, false> {
+	VoxelFlags flags;
+	_CPU_AND_GPU_CODE_
+	inline double retrieve(const TVoxel& voxel) const {
+		DIEWITHEXCEPTION_REPORTLOCATION("Voxel doesn't have semantic information.");
+		return 0.0;
+	}
+};
+
+template<typename TVoxel, typename TOutput, bool THasSDFInformation>
+struct RetrieveIsVoxelSdfEqualTo;
+
+template<typename TVoxel, typename TOutput>
+struct RetrieveIsVoxelSdfEqualTo<TVoxel, TOutput, true> {
+	float value;
+	_CPU_AND_GPU_CODE_
+	inline TOutput retrieve(const TVoxel& voxel) const {
+		return TVoxel::valueToFloat(voxel.sdf) == value;
+	}
+};
+
+template<typename TVoxel, typename TOutput>
+struct RetrieveIsVoxelSdfEqualTo<TVoxel, TOutput, false> {
+	float value;
+	_CPU_AND_GPU_CODE_
+	inline TOutput retrieve(const TVoxel& voxel) const {
+		DIEWITHEXCEPTION_REPORTLOCATION("Voxel doesn't have SDF information.");
+		return TOutput();
+	}
+};
+
 template<typename TVoxel, typename TIndex, typename TOutput>
 struct ReduceSumFunctor {
 public:
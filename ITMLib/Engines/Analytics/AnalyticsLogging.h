@@ -16,6 +16,7 @@
 #pragma once
 
 //stdlib
+#include <array>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -143,40 +144,19 @@ void LogTSDFVolumeStatistics(VoxelVolume<TVoxel, TIndex>* volume, const std::str
 #ifdef GET_DEPTH_WEIGHT_STATISTICS
 		if (configuration::Get().device_type == MEMORYDEVICE_CUDA &&
 		    indexing_method == INDEX_HASH) {
-			//_DEBUG
-			Extent2Di low_weight_range0(0, 50);
-			unsigned int low_weight_range_count0 =
-					calculator.CountVoxelsWithDepthWeightInRange(volume, low_weight_range0);
-			unsigned int low_weight_range_hb_count0 =
-					calculator.CountHashBlocksWithDepthWeightInRange(volume, low_weight_range0);
-			LOG4CPLUS_PER_FRAME(logging::GetLogger(), "    [w_depth in [0, 50)] % voxels: "
-					<< 100.0 * static_cast<double>(low_weight_range_count0) / static_cast<double>(utilized_voxel_count)
-					<< "; % hash blocks: "
-					<< 100.0 * static_cast<double>(low_weight_range_hb_count0) /
-					   static_cast<double>(utilized_hash_block_count)
-			);
-			Extent2Di low_weight_range1(0, 20);
-			unsigned int low_weight_range_count1 =
-					calculator.CountVoxelsWithDepthWeightInRange(volume, low_weight_range1);
-			unsigned int low_weight_range_hb_count1 =
-					calculator.CountHashBlocksWithDepthWeightInRange(volume, low_weight_range1);
-			LOG4CPLUS_PER_FRAME(logging::GetLogger(), "    [w_depth in [0, 20)] % voxels: "
-					<< 100.0 * static_cast<double>(low_weight_range_count1) / static_cast<double>(utilized_voxel_count)
-					<< "; % hash blocks: "
-					<< 100.0 * static_cast<double>(low_weight_range_hb_count1) /
-					   static_cast<double>(utilized_hash_block_count)
-			);
-			Extent2Di low_weight_range2(0, 10);
-			unsigned int low_weight_range_count2 =
-					calculator.CountVoxelsWithDepthWeightInRange(volume, low_weight_range2);
-			unsigned int low_weight_range_hb_count2 =
-					calculator.CountHashBlocksWithDepthWeightInRange(volume, low_weight_range2);
-			LOG4CPLUS_PER_FRAME(logging::GetLogger(), "    [w_depth in [0, 10)] % voxels: "
-					<< 100.0 * static_cast<double>(low_weight_range_count2) / static_cast<double>(utilized_voxel_count)
-					<< "; % hash blocks: "
-					<< 100.0 * static_cast<double>(low_weight_range_hb_count2) /
-					   static_cast<double>(utilized_hash_block_count)
-			);
+			const std::array<Extent2Di, depth_weight_range_count> low_weight_ranges = {Extent2Di(0, 50), Extent2Di(0, 20), Extent2Di(0, 10)};
+			std::array<unsigned int, depth_weight_range_count> low_weight_range_counts, low_weight_range_hb_counts;
+			calculator.CountVoxelsAndHashBlocksWithDepthWeightInRanges(volume, low_weight_ranges, low_weight_range_counts,
+			                                                           low_weight_range_hb_counts);
+			for (int i_range = 0; i_range < depth_weight_range_count; i_range++) {
+				LOG4CPLUS_PER_FRAME(logging::GetLogger(), "    [w_depth in [" << low_weight_ranges[i_range].from << ", "
+						<< low_weight_ranges[i_range].to << ")] % voxels: "
+						<< 100.0 * static_cast<double>(low_weight_range_counts[i_range]) / static_cast<double>(utilized_voxel_count)
+						<< "; % hash blocks: "
+						<< 100.0 * static_cast<double>(low_weight_range_hb_counts[i_range]) /
+						   static_cast<double>(utilized_hash_block_count)
+				);
+			}
 		}
 #endif
 	}
@@ -0,0 +1,202 @@
+#pragma once
+
+//stdlib
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#ifdef WITH_AVX2
+#include <immintrin.h>
+#endif
+
+//local
+#include "../../Utils/Math.h"
+
+namespace ITMLib {
+
+// region ===================================== BLOCK KERNEL DETECTION =================================================
+
+/*
+ * Functors may provide a block kernel, ProcessBlock(voxels..., voxel_count), in addition to the per-voxel operator() or
+ * static run(...). The CPU traversal engines hand block kernels whole contiguous runs of at most VOXEL_BLOCK_SIZE3
+ * voxels (one voxel hash block, or one chunk of a plain voxel array) instead of visiting voxels one by one. A block
+ * kernel must yield the same result as the per-voxel version; it isn't passed voxel positions.
+ */
+namespace internal {
+template<typename TEnable, typename TFunctor, typename... TVoxelPointers>
+struct HasBlockKernel_Impl : std::false_type {};
+
+template<typename TFunctor, typename... TVoxelPointers>
+struct HasBlockKernel_Impl<decltype(std::declval<TFunctor&>().ProcessBlock(std::declval<TVoxelPointers>()..., 0), void()),
+		TFunctor, TVoxelPointers...> : std::true_type {};
+} // namespace internal
+
+/**
+ * \brief std::true_type if TFunctor (dynamic or static) has a block kernel accepting the given voxel pointer types,
+ * std::false_type otherwise.
+ */
+template<typename TFunctor, typename... TVoxelPointers>
+using HasBlockKernel = internal::HasBlockKernel_Impl<void, TFunctor, TVoxelPointers...>;
+
+namespace internal {
+template<typename TStaticFunctor, typename TVoxelPointer>
+inline void RunStaticFunctorOnVoxels(TVoxelPointer voxels, const int voxel_count, std::true_type) {
+	TStaticFunctor::ProcessBlock(voxels, voxel_count);
+}
+
+template<typename TStaticFunctor, typename TVoxelPointer>
+inline void RunStaticFunctorOnVoxels(TVoxelPointer voxels, const int voxel_count, std::false_type) {
+	for (int i_voxel = 0; i_voxel < voxel_count; i_voxel++) {
+		TStaticFunctor::run(voxels[i_voxel]);
+	}
+}
+} // namespace internal
+
+/**
+ * \brief Run a static functor on voxel_count consecutive voxels, through its block kernel if it has one for this voxel
+ * pointer type, or by calling TStaticFunctor::run on every voxel otherwise.
+ */
+template<typename TStaticFunctor, typename TVoxelPointer>
+inline void RunStaticFunctorOnVoxels(TVoxelPointer voxels, const int voxel_count) {
+	internal::RunStaticFunctorOnVoxels<TStaticFunctor>(voxels, voxel_count, HasBlockKernel<TStaticFunctor, TVoxelPointer>());
+}
+
+// endregion
+// region ============================== VECTOR3F FIELD KERNELS FOR ALL-FLOAT VOXELS ===================================
+
+/**
+ * \brief Byte offset of a Vector3f member within TVoxel
+ */
+template<typename TVoxel>
+inline std::size_t Vector3fFieldOffset(Vector3f TVoxel::* field) {
+	const TVoxel voxel;
+	return static_cast<std::size_t>(reinterpret_cast<const char*>(&(voxel.*field)) - reinterpret_cast<const char*>(&voxel));
+}
+
+namespace internal {
+struct ClearVector3fFieldOperation {
+#ifdef WITH_AVX2
+	static inline __m256 Apply(__m256 target, __m256 source, __m256 factor) { return _mm256_setzero_ps(); }
+#endif
+	static inline float Apply(float target, float source, float factor) { return 0.0f; }
+};
+
+struct AddVector3fFieldOperation {
+#ifdef WITH_AVX2
+	static inline __m256 Apply(__m256 target, __m256 source, __m256 factor) { return _mm256_add_ps(target, source); }
+#endif
+	static inline float Apply(float target, float source, float factor) { return target + source; }
+};
+
+struct SubtractScaledVector3fFieldOperation {
+#ifdef WITH_AVX2
+	static inline __m256 Apply(__m256 target, __m256 source, __m256 factor) {
+		return _mm256_sub_ps(target, _mm256_mul_ps(factor, source));
+	}
+#endif
+	static inline float Apply(float target, float source, float factor) { return target - factor * source; }
+};
+} // namespace internal
+
+/**
+ * \brief Streaming arithmetic on one Vector3f field (the target) of voxels that consist of floats only, such as the
+ * warp voxels, optionally using another Vector3f field of the same voxels (the source) as operand.
+ * \details With AVX2, voxels are processed in rows of eight: a row of voxels that are P floats each spans exactly P
+ * 8-lane registers, so one fixed set of P lane masks picks out the target field in every row, and the source field is
+ * read through the same masks at a constant offset. The remainder, or everything when built without AVX2, is processed
+ * with plain per-voxel loops.
+ * \tparam TVoxel voxel type made up of floats only
+ */
+template<typename TVoxel>
+class Vector3fFieldKernel {
+	static_assert(sizeof(TVoxel) % sizeof(float) == 0, "Vector3fFieldKernel requires voxel types consisting of floats only.");
+public: // static constants
+	static constexpr int floats_per_voxel = static_cast<int>(sizeof(TVoxel) / sizeof(float));
+	static constexpr int row_voxel_count = 8;
+
+public: // instance functions
+	Vector3fFieldKernel(Vector3f TVoxel::* target_field, Vector3f TVoxel::* source_field) :
+			target_offset(static_cast<int>(Vector3fFieldOffset(target_field) / sizeof(float))),
+			source_offset(static_cast<int>(Vector3fFieldOffset(source_field) / sizeof(float))) {
+#ifdef WITH_AVX2
+		for (int i_register = 0; i_register < floats_per_voxel; i_register++) {
+			for (int i_lane = 0; i_lane < row_voxel_count; i_lane++) {
+				const int float_index_in_row = i_register * row_voxel_count + i_lane;
+				const int float_index_in_voxel = float_index_in_row % floats_per_voxel;
+				target_lane_masks[i_register][i_lane] =
+						float_index_in_voxel >= target_offset && float_index_in_voxel < target_offset + 3 ? -1 : 0;
+				lane_voxel_indices[i_register][i_lane] = float_index_in_row / floats_per_voxel;
+			}
+		}
+#endif
+	}
+
+	explicit Vector3fFieldKernel(Vector3f TVoxel::* target_field) : Vector3fFieldKernel(target_field, target_field) {}
+
+	/** \brief target = 0 */
+	void Clear(TVoxel* voxels, const int voxel_count) const {
+		Apply<internal::ClearVector3fFieldOperation>(voxels, voxel_count, 0.0f, nullptr);
+	}
+
+	/** \brief target += source */
+	void Add(TVoxel* voxels, const int voxel_count) const {
+		Apply<internal::AddVector3fFieldOperation>(voxels, voxel_count, 0.0f, nullptr);
+	}
+
+	/** \brief target -= factor * source, for voxels whose entry in voxel_mask is true (all voxels if voxel_mask is null) */
+	void SubtractScaled(TVoxel* voxels, const int voxel_count, const float factor, const bool* voxel_mask = nullptr) const {
+		Apply<internal::SubtractScaledVector3fFieldOperation>(voxels, voxel_count, factor, voxel_mask);
+	}
+
+private: // instance functions
+	template<typename TOperation>
+	void Apply(TVoxel* voxels, const int voxel_count, const float factor, const bool* voxel_mask) const {
+		float* values = reinterpret_cast<float*>(voxels);
+		int i_voxel = 0;
+#ifdef WITH_AVX2
+		const __m256 factor_vector = _mm256_set1_ps(factor);
+		const int source_shift = source_offset - target_offset;
+		const int row_aligned_voxel_count = voxel_count - voxel_count % row_voxel_count;
+		for (; i_voxel < row_aligned_voxel_count; i_voxel += row_voxel_count) {
+			float* row = values + i_voxel * floats_per_voxel;
+			__m256i row_voxel_mask = _mm256_set1_epi32(-1);
+			if (voxel_mask != nullptr) {
+				const __m128i row_voxel_mask_bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(voxel_mask + i_voxel));
+				row_voxel_mask = _mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(row_voxel_mask_bytes), _mm256_setzero_si256());
+			}
+			for (int i_register = 0; i_register < floats_per_voxel; i_register++) {
+				const __m256i lane_voxel_mask = _mm256_permutevar8x32_epi32(
+						row_voxel_mask, _mm256_load_si256(reinterpret_cast<const __m256i*>(lane_voxel_indices[i_register])));
+				const __m256i lane_mask = _mm256_and_si256(
+						_mm256_load_si256(reinterpret_cast<const __m256i*>(target_lane_masks[i_register])), lane_voxel_mask);
+				if (_mm256_testz_si256(lane_mask, lane_mask)) continue;
+				float* target = row + i_register * row_voxel_count;
+				// masked-out lanes are neither read nor written, so the shifted source lanes never stray outside the row
+				const __m256 target_values = _mm256_maskload_ps(target, lane_mask);
+				const __m256 source_values = _mm256_maskload_ps(target + source_shift, lane_mask);
+				_mm256_maskstore_ps(target, lane_mask, TOperation::Apply(target_values, source_values, factor_vector));
+			}
+		}
+#endif
+		for (; i_voxel < voxel_count; i_voxel++) {
+			if (voxel_mask != nullptr && !voxel_mask[i_voxel]) continue;
+			float* target = values + i_voxel * floats_per_voxel + target_offset;
+			const float* source = values + i_voxel * floats_per_voxel + source_offset;
+			for (int i_component = 0; i_component < 3; i_component++) {
+				target[i_component] = TOperation::Apply(target[i_component], source[i_component], factor);
+			}
+		}
+	}
+
+private: // instance variables
+	const int target_offset;
+	const int source_offset;
+#ifdef WITH_AVX2
+	alignas(32) int32_t target_lane_masks[floats_per_voxel][row_voxel_count];
+	alignas(32) int32_t lane_voxel_indices[floats_per_voxel][row_voxel_count];
+#endif
+};
+
+// endregion
+} // namespace ITMLib
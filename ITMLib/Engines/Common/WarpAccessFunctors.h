@@ -15,6 +15,10 @@
 //  ================================================================
 #pragma once
 
+//stdlib
+#include <type_traits>
+
+//local
 #include "../../../ORUtils/PlatformIndependence.h"
 #include "../../Utils/Math.h"
 #include "../../Utils/Enums/WarpType.h"
@@ -194,6 +198,28 @@ struct WarpAccessStaticFunctor<TWarpVoxel, WarpType::WARP_UPDATE>{
 };
 
 
+/**
+ * \brief Pointer to the Vector3f member holding warps of the given type, for voxel types that have such warps
+ * (lets CPU block kernels address the warp field of whole runs of voxels at once)
+ */
+template<typename TWarpVoxel, WarpType TWarpType, typename TEnable = void>
+struct WarpField {};
+
+template<typename TWarpVoxel>
+struct WarpField<TWarpVoxel, WarpType::WARP_CUMULATIVE, typename std::enable_if<TWarpVoxel::hasCumulativeWarp>::type> {
+	static inline Vector3f TWarpVoxel::* Get() { return &TWarpVoxel::cumulative_warp; }
+};
+
+template<typename TWarpVoxel>
+struct WarpField<TWarpVoxel, WarpType::WARP_FRAMEWISE, typename std::enable_if<TWarpVoxel::hasFramewiseWarp>::type> {
+	static inline Vector3f TWarpVoxel::* Get() { return &TWarpVoxel::framewise_warp; }
+};
+
+template<typename TWarpVoxel>
+struct WarpField<TWarpVoxel, WarpType::WARP_UPDATE, typename std::enable_if<TWarpVoxel::hasWarpUpdate>::type> {
+	static inline Vector3f TWarpVoxel::* Get() { return &TWarpVoxel::warp_update; }
+};
+
 }//namespace ITMLib
 // endregion ===========================================================================================================
 
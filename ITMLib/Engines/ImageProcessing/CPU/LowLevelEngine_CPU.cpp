@@ -41,8 +41,17 @@ void LowLevelEngine_CPU::ConvertColourToIntensity(FloatImage& image_out, const U
 	float *dest = image_out.GetData(MEMORYDEVICE_CPU);
 	const Vector4u *src = image_in.GetData(MEMORYDEVICE_CPU);
 
-	for (int y = 0; y < dims.y; y++) for (int x = 0; x < dims.x; x++)
-		convertColourToIntensity(dest, x, y, dims, src);
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
+	for (int y = 0; y < dims.y; y++)
+	{
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+		for (int x = 0; x < dims.x; x++)
+			convertColourToIntensity(dest, x, y, dims, src);
+	}
 }
 
 void LowLevelEngine_CPU::FilterIntensity(FloatImage& image_out, const FloatImage& image_in) const
@@ -55,8 +64,17 @@ void LowLevelEngine_CPU::FilterIntensity(FloatImage& image_out, const FloatImage
 	const float *imageData_in = image_in.GetData(MEMORYDEVICE_CPU);
 	float *imageData_out = image_out.GetData(MEMORYDEVICE_CPU);
 
-	for (int y = 2; y < dims.y - 2; y++) for (int x = 2; x < dims.x - 2; x++)
-		boxFilter2x2(imageData_out, x, y, dims, imageData_in, x, y, dims);
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
+	for (int y = 2; y < dims.y - 2; y++)
+	{
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+		for (int x = 2; x < dims.x - 2; x++)
+			boxFilter2x2(imageData_out, x, y, dims, imageData_in, x, y, dims);
+	}
 }
 
 void LowLevelEngine_CPU::FilterSubsample(UChar4Image& image_out, const UChar4Image& image_in) const
@@ -69,6 +87,9 @@ void LowLevelEngine_CPU::FilterSubsample(UChar4Image& image_out, const UChar4Ima
 	const Vector4u *imageData_in = image_in.GetData(MEMORYDEVICE_CPU);
 	Vector4u *imageData_out = image_out.GetData(MEMORYDEVICE_CPU);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 0; y < newDims.y; y++) for (int x = 0; x < newDims.x; x++)
 		filterSubsample(imageData_out, x, y, newDims, imageData_in, oldDims);
 }
@@ -84,8 +105,17 @@ void LowLevelEngine_CPU::FilterSubsample(FloatImage& image_out, const FloatImage
 	const float *imageData_in = image_in.GetData(MEMORYDEVICE_CPU);
 	float *imageData_out = image_out.GetData(MEMORYDEVICE_CPU);
 
-	for (int y = 1; y < newDims.y - 1; y++) for (int x = 1; x < newDims.x - 1; x++)
-		boxFilter2x2(imageData_out, x, y, newDims, imageData_in, x * 2, y * 2, oldDims);
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
+	for (int y = 1; y < newDims.y - 1; y++)
+	{
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+		for (int x = 1; x < newDims.x - 1; x++)
+			boxFilter2x2(imageData_out, x, y, newDims, imageData_in, x * 2, y * 2, oldDims);
+	}
 }
 
 void LowLevelEngine_CPU::FilterSubsampleWithHoles(FloatImage& image_out, const FloatImage& image_in) const
@@ -98,6 +128,9 @@ void LowLevelEngine_CPU::FilterSubsampleWithHoles(FloatImage& image_out, const F
 	const float *imageData_in = image_in.GetData(MEMORYDEVICE_CPU);
 	float *imageData_out = image_out.GetData(MEMORYDEVICE_CPU);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 0; y < newDims.y; y++) for (int x = 0; x < newDims.x; x++)
 		filterSubsampleWithHoles(imageData_out, x, y, newDims, imageData_in, oldDims);
 }
@@ -112,6 +145,9 @@ void LowLevelEngine_CPU::FilterSubsampleWithHoles(Float4Image& image_out, const
 	const Vector4f *imageData_in = image_in.GetData(MEMORYDEVICE_CPU);
 	Vector4f *imageData_out = image_out.GetData(MEMORYDEVICE_CPU);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 0; y < newDims.y; y++) for (int x = 0; x < newDims.x; x++)
 		filterSubsampleWithHoles(imageData_out, x, y, newDims, imageData_in, oldDims);
 }
@@ -126,6 +162,9 @@ void LowLevelEngine_CPU::GradientX(Short4Image& grad_out, const UChar4Image& ima
 
 	memset(grad, 0, imgSize.x * imgSize.y * sizeof(Vector4s));
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 1; y < imgSize.y - 1; y++) for (int x = 1; x < imgSize.x - 1; x++)
 		gradientX(grad, x, y, image, imgSize);
 }
@@ -140,6 +179,9 @@ void LowLevelEngine_CPU::GradientY(Short4Image& grad_out, const UChar4Image& ima
 
 	memset(grad, 0, imgSize.x * imgSize.y * sizeof(Vector4s));
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 1; y < imgSize.y - 1; y++) for (int x = 1; x < imgSize.x - 1; x++)
 		gradientY(grad, x, y, image, imgSize);
 }
@@ -153,8 +195,17 @@ void LowLevelEngine_CPU::GradientXY(Float2Image& grad_out, const FloatImage& ima
 	Vector2f *grad = grad_out.GetData(MEMORYDEVICE_CPU);
 	const float *image = image_in.GetData(MEMORYDEVICE_CPU);
 
-	for (int y = 1; y < imgSize.y - 1; y++) for (int x = 1; x < imgSize.x - 1; x++)
-		gradientXY(grad, x, y, image, imgSize);
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
+	for (int y = 1; y < imgSize.y - 1; y++)
+	{
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+		for (int x = 1; x < imgSize.x - 1; x++)
+			gradientXY(grad, x, y, image, imgSize);
+	}
 }
 
 int LowLevelEngine_CPU::CountValidDepths(const FloatImage& image_in) const
@@ -162,7 +213,11 @@ int LowLevelEngine_CPU::CountValidDepths(const FloatImage& image_in) const
 	int noValidPoints = 0;
 	const float *imageData_in = image_in.GetData(MEMORYDEVICE_CPU);
 
-	for (int i = 0; i < image_in.dimensions.x * image_in.dimensions.y; ++i) if (imageData_in[i] > 0.0) noValidPoints++;
+	const int pixelCount = image_in.dimensions.x * image_in.dimensions.y;
+#ifdef WITH_OPENMP
+#pragma omp parallel for reduction(+:noValidPoints)
+#endif
+	for (int i = 0; i < pixelCount; ++i) if (imageData_in[i] > 0.0) noValidPoints++;
 
 	return noValidPoints;
 }
@@ -101,6 +101,23 @@ public:
 	                                  const View* view,
 	                                  const CameraTrackingState* tracking_state) = 0;
 
+	/**
+	 * \brief Incremental counterpart of AllocateNearAndBetweenTwoSurfaces, meant for volumes that are reused from frame
+	 * to frame instead of being reset: blocks still spanned by the two surfaces are kept, blocks no longer spanned are
+	 * deallocated, and only the newly-spanned blocks are allocated.
+	 * \details Assumes the utilized block list of the volume lists all of its allocated blocks upon entry. Upon exit,
+	 * the utilized block list is the same (as a set) as it would be after a Reset followed by AllocateNearAndBetweenTwoSurfaces.
+	 * Voxels in the retained blocks are left as they were. Does nothing for a plain-voxel-array volume.
+	 * \param volume [in,out] the volume whose allocation to update
+	 * \param view [in] a view with a new depth image
+	 * \param tracking_state [in] tracking state that corresponds to the given view (and contains the point cloud of
+	 * the other surface)
+	 */
+	virtual void
+	UpdateAllocationNearAndBetweenTwoSurfaces(VoxelVolume<TVoxel, TIndex>* volume,
+	                                          const View* view,
+	                                          const CameraTrackingState* tracking_state) = 0;
+
 
 	/**
 	 * \brief Allocates (at least) enough space to fit the given
@@ -135,6 +152,32 @@ template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVo
 void AllocateUsingOtherVolume(VoxelVolume<TVoxelTarget, VoxelBlockHash>* target_volume,
                               VoxelVolume<TVoxelSource, VoxelBlockHash>* source_volume);
 
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
+void DeallocateUsingOtherVolume(VoxelVolume<TVoxelTarget, PlainVoxelArray>* target_volume,
+                                VoxelVolume<TVoxelSource, PlainVoxelArray>* source_volume);
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
+void DeallocateUsingOtherVolume(VoxelVolume<TVoxelTarget, VoxelBlockHash>* target_volume,
+                                VoxelVolume<TVoxelSource, VoxelBlockHash>* source_volume);
+
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
+void MirrorIndexOfOtherVolume(VoxelVolume<TVoxelTarget, PlainVoxelArray>* target_volume,
+                              VoxelVolume<TVoxelSource, PlainVoxelArray>* source_volume);
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
+void MirrorIndexOfOtherVolume(VoxelVolume<TVoxelTarget, VoxelBlockHash>* target_volume,
+                              VoxelVolume<TVoxelSource, VoxelBlockHash>* source_volume);
+
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxel>
+void ResetUtilizedVoxels(VoxelVolume<TVoxel, PlainVoxelArray>* volume);
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxel>
+void ResetUtilizedVoxels(VoxelVolume<TVoxel, VoxelBlockHash>* volume);
+
+template<MemoryDeviceType TMemoryDeviceType>
+inline void BuildBlockNeighborTable(PlainVoxelArray& target_index, const PlainVoxelArray& reference_index) {
+	// plain voxel arrays resolve neighbors by direct array indexing, nothing to build
+}
+template<MemoryDeviceType TMemoryDeviceType>
+void BuildBlockNeighborTable(VoxelBlockHash& target_index, const VoxelBlockHash& reference_index);
+
 template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
 void AllocateUsingOtherVolume_Bounded(VoxelVolume<TVoxelTarget, VoxelBlockHash>* target_volume,
                                       VoxelVolume<TVoxelSource, VoxelBlockHash>* source_volume,
@@ -208,5 +251,113 @@ void AllocateUsingOtherVolume_OffsetAndBounded(VoxelVolume<TVoxelTarget, TIndex>
 	}
 }
 
+/**
+ * \brief Deallocate all blocks in the target volume that are not allocated in the source volume (the counterpart
+ * of AllocateUsingOtherVolume). Does nothing for a plain-voxel-array volume.
+ * \details Relies on the utilized block list of the target volume, which is rebuilt if any blocks are deallocated.
+ */
+template<typename TVoxelTarget, typename TVoxelSource, typename TIndex>
+void DeallocateUsingOtherVolume(VoxelVolume<TVoxelTarget, TIndex>* target_volume,
+                                VoxelVolume<TVoxelSource, TIndex>* source_volume,
+                                MemoryDeviceType memory_device_type) {
+	switch (memory_device_type) {
+		case MEMORYDEVICE_CPU:
+			internal::DeallocateUsingOtherVolume<MEMORYDEVICE_CPU>(target_volume, source_volume);
+			break;
+		case MEMORYDEVICE_CUDA:
+#ifndef COMPILE_WITHOUT_CUDA
+			internal::DeallocateUsingOtherVolume<MEMORYDEVICE_CUDA>(target_volume, source_volume);
+#else
+			DIEWITHEXCEPTION_REPORTLOCATION("Tried to invoke the CUDA version of 'DeallocateUsingOtherVolume' while code built "
+			                                "without CUDA support (WITH_CUDA=OFF CMake option).");
+#endif
+			break;
+		default:
+			DIEWITHEXCEPTION_REPORTLOCATION("Unsupported device type.");
+	}
+}
+
+/**
+ * \brief Make the index of the target volume an exact copy of the index of the source volume, so that both volumes
+ * hold the same blocks at the same hash codes and voxel storage offsets. A cheaper alternative to the
+ * DeallocateUsingOtherVolume / AllocateUsingOtherVolume pair, which also lets multi-volume traversals over both
+ * volumes skip matching up blocks (see VoxelBlockHash::SharesBlockLayoutWith). Does nothing for a plain-voxel-array volume.
+ * \details Target voxels are kept only for blocks the target index already held at the same hash code and offset, i.e.
+ * when the target has been mirrored from the same source before, voxels of blocks that remain allocated are preserved.
+ * Voxels of all other blocks are reset to default values. Both volumes need to have the same voxel block count.
+ */
+template<typename TVoxelTarget, typename TVoxelSource, typename TIndex>
+void MirrorIndexOfOtherVolume(VoxelVolume<TVoxelTarget, TIndex>* target_volume,
+                              VoxelVolume<TVoxelSource, TIndex>* source_volume,
+                              MemoryDeviceType memory_device_type) {
+	switch (memory_device_type) {
+		case MEMORYDEVICE_CPU:
+			internal::MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU>(target_volume, source_volume);
+			break;
+		case MEMORYDEVICE_CUDA:
+#ifndef COMPILE_WITHOUT_CUDA
+			internal::MirrorIndexOfOtherVolume<MEMORYDEVICE_CUDA>(target_volume, source_volume);
+#else
+			DIEWITHEXCEPTION_REPORTLOCATION("Tried to invoke the CUDA version of 'MirrorIndexOfOtherVolume' while code built "
+			                                "without CUDA support (WITH_CUDA=OFF CMake option).");
+#endif
+			break;
+		default:
+			DIEWITHEXCEPTION_REPORTLOCATION("Unsupported device type.");
+	}
+}
+
+/**
+ * \brief Reset voxels within all utilized blocks of the volume to their default values without touching the index,
+ * i.e. a cheaper alternative to VoxelVolume::Reset for volumes whose allocation is to be reused.
+ * \details For a plain-voxel-array volume, resets all voxels.
+ */
+template<typename TVoxel, typename TIndex>
+void ResetUtilizedVoxels(VoxelVolume<TVoxel, TIndex>* volume, MemoryDeviceType memory_device_type) {
+	switch (memory_device_type) {
+		case MEMORYDEVICE_CPU:
+			internal::ResetUtilizedVoxels<MEMORYDEVICE_CPU>(volume);
+			break;
+		case MEMORYDEVICE_CUDA:
+#ifndef COMPILE_WITHOUT_CUDA
+			internal::ResetUtilizedVoxels<MEMORYDEVICE_CUDA>(volume);
+#else
+			DIEWITHEXCEPTION_REPORTLOCATION("Tried to invoke the CUDA version of 'ResetUtilizedVoxels' while code built "
+			                                "without CUDA support (WITH_CUDA=OFF CMake option).");
+#endif
+			break;
+		default:
+			DIEWITHEXCEPTION_REPORTLOCATION("Unsupported device type.");
+	}
+}
+
+/**
+ * \brief (Re)build the block neighbor table of the target volume, which holds voxel offsets to the target blocks
+ * in the 3x3x3 block neighborhood of every block utilized in the reference volume, in the order of the reference
+ * volume's utilized block list. Does nothing for a plain-voxel-array volume.
+ * \details The table stays valid until the utilized block list of the target volume changes. Building tables of several
+ * volumes with the same reference volume enables their concurrent neighbor-aware traversal (see ThreeVolumeTraversalEngine).
+ */
+template<typename TVoxelTarget, typename TVoxelSource, typename TIndex>
+void BuildBlockNeighborTable(VoxelVolume<TVoxelTarget, TIndex>* target_volume,
+                             VoxelVolume<TVoxelSource, TIndex>* reference_volume,
+                             MemoryDeviceType memory_device_type) {
+	switch (memory_device_type) {
+		case MEMORYDEVICE_CPU:
+			internal::BuildBlockNeighborTable<MEMORYDEVICE_CPU>(target_volume->index, reference_volume->index);
+			break;
+		case MEMORYDEVICE_CUDA:
+#ifndef COMPILE_WITHOUT_CUDA
+			internal::BuildBlockNeighborTable<MEMORYDEVICE_CUDA>(target_volume->index, reference_volume->index);
+#else
+			DIEWITHEXCEPTION_REPORTLOCATION("Tried to invoke the CUDA version of 'BuildBlockNeighborTable' while code built "
+			                                "without CUDA support (WITH_CUDA=OFF CMake option).");
+#endif
+			break;
+		default:
+			DIEWITHEXCEPTION_REPORTLOCATION("Unsupported device type.");
+	}
+}
+
 }//namespace ITMLib
 
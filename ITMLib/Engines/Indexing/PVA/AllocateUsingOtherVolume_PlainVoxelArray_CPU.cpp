@@ -63,4 +63,34 @@ template void AllocateUsingOtherVolume_OffsetAndBounded<MEMORYDEVICE_CPU, WarpVo
 		ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* target_volume,
 		ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* source_volume,
 		const Extent3Di& source_bounds, const Vector3i& target_offset);
+
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CPU, WarpVoxel, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, PlainVoxelArray>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CPU, TSDFVoxel_f_flags, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, PlainVoxelArray>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, PlainVoxelArray>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CPU, TSDFVoxel_f_rgb, TSDFVoxel_f_rgb>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, PlainVoxelArray>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, PlainVoxelArray>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CPU, WarpVoxel, WarpVoxel>(
+		ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* target_volume,
+		ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* source_volume);
+
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU, WarpVoxel, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, PlainVoxelArray>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU, TSDFVoxel_f_flags, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, PlainVoxelArray>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, PlainVoxelArray>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU, TSDFVoxel_f_rgb, TSDFVoxel_f_rgb>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, PlainVoxelArray>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, PlainVoxelArray>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU, WarpVoxel, WarpVoxel>(
+		ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* target_volume,
+		ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* source_volume);
+
+template void ResetUtilizedVoxels<MEMORYDEVICE_CPU, TSDFVoxel_f_flags>(ITMLib::VoxelVolume<TSDFVoxel_f_flags, PlainVoxelArray>* volume);
+template void ResetUtilizedVoxels<MEMORYDEVICE_CPU, TSDFVoxel_f_rgb>(ITMLib::VoxelVolume<TSDFVoxel_f_rgb, PlainVoxelArray>* volume);
+template void ResetUtilizedVoxels<MEMORYDEVICE_CPU, WarpVoxel>(ITMLib::VoxelVolume<WarpVoxel, PlainVoxelArray>* volume);
 } //namespace ITMLib
\ No newline at end of file
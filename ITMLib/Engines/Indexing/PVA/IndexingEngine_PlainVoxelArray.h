@@ -41,6 +41,9 @@ public: // instance functions
 	void AllocateNearAndBetweenTwoSurfaces(VoxelVolume<TVoxel, PlainVoxelArray>* targetVolume,
 	                                       const View* view,
 	                                       const CameraTrackingState* tracking_state) override;
+	void UpdateAllocationNearAndBetweenTwoSurfaces(VoxelVolume<TVoxel, PlainVoxelArray>* volume,
+	                                               const View* view,
+	                                               const CameraTrackingState* tracking_state) override;
 	void AllocateGridAlignedBox(VoxelVolume<TVoxel, PlainVoxelArray>* volume, const Extent3Di& box) override;
 
 };
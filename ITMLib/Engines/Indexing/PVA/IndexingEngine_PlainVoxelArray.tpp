@@ -40,6 +40,10 @@ template<typename TVoxel, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExe
 void IndexingEngine<TVoxel, PlainVoxelArray, TMemoryDeviceType, TExecutionMode>::AllocateNearAndBetweenTwoSurfaces(
 		VoxelVolume<TVoxel, PlainVoxelArray>* targetVolume, const View* view, const CameraTrackingState* tracking_state) {}
 
+template<typename TVoxel, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
+void IndexingEngine<TVoxel, PlainVoxelArray, TMemoryDeviceType, TExecutionMode>::UpdateAllocationNearAndBetweenTwoSurfaces(
+		VoxelVolume<TVoxel, PlainVoxelArray>* volume, const View* view, const CameraTrackingState* tracking_state) {}
+
 template<typename TVoxel, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
 void IndexingEngine<TVoxel, PlainVoxelArray, TMemoryDeviceType, TExecutionMode>::ResetUtilizedBlockList(VoxelVolume<TVoxel, PlainVoxelArray>* volume) {}
 template<typename TVoxel, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
@@ -64,6 +68,19 @@ template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVo
 void AllocateUsingOtherVolume_OffsetAndBounded(VoxelVolume<TVoxelTarget, PlainVoxelArray>* target_volume,
                                                VoxelVolume<TVoxelSource, PlainVoxelArray>* source_volume,
                                                const Extent3Di& source_bounds, const Vector3i& target_offset){}
+
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
+void DeallocateUsingOtherVolume(VoxelVolume<TVoxelTarget, PlainVoxelArray>* target_volume,
+                                VoxelVolume<TVoxelSource, PlainVoxelArray>* source_volume){}
+
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
+void MirrorIndexOfOtherVolume(VoxelVolume<TVoxelTarget, PlainVoxelArray>* target_volume,
+                              VoxelVolume<TVoxelSource, PlainVoxelArray>* source_volume){}
+
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxel>
+void ResetUtilizedVoxels(VoxelVolume<TVoxel, PlainVoxelArray>* volume){
+	volume->Reset();
+}
 } // namespace internal
 } // namespace ITMLib
 
@@ -47,6 +47,22 @@ public: // instance functions
 	}
 };
 
+/**
+ * \brief Retrieve a block of VOXEL_BLOCK_SIZE3 default-constructed voxels, residing on the specified device
+ * (handy for clearing out voxel blocks via a single memcpy)
+ */
+template<typename TVoxel, MemoryDeviceType TMemoryDeviceType>
+const TVoxel* GetEmptyVoxelBlock() {
+	static ORUtils::MemoryBlock<TVoxel> empty_voxel_block = []() {
+		ORUtils::MemoryBlock<TVoxel> empty_voxel_block(VOXEL_BLOCK_SIZE3, true, true);
+		TVoxel* empty_voxel_block_CPU = empty_voxel_block.GetData(MEMORYDEVICE_CPU);
+		for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) empty_voxel_block_CPU[i_voxel] = TVoxel();
+		empty_voxel_block.UpdateDeviceFromHost();
+		return empty_voxel_block;
+	}();
+	return empty_voxel_block.GetData(TMemoryDeviceType);
+}
+
 template<typename TVoxel, MemoryDeviceType TMemoryDeviceType>
 struct BlockListDeallocationFunctor {
 public:
@@ -77,14 +93,7 @@ public: // instance functions
 		INITIALIZE_ATOMIC(int, last_free_voxel_block_id, volume->index.GetLastFreeBlockListId());
 		INITIALIZE_ATOMIC(int, last_free_excess_list_id, volume->index.GetLastFreeExcessListId());
 
-		static ORUtils::MemoryBlock<TVoxel> empty_voxel_block = []() {
-			ORUtils::MemoryBlock<TVoxel> empty_voxel_block(VOXEL_BLOCK_SIZE3, true, true);
-			TVoxel* empty_voxel_block_CPU = empty_voxel_block.GetData(MEMORYDEVICE_CPU);
-			for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) empty_voxel_block_CPU[i_voxel] = TVoxel();
-			empty_voxel_block.UpdateDeviceFromHost();
-			return empty_voxel_block;
-		}();
-		empty_voxel_block_device = empty_voxel_block.GetData(TMemoryDeviceType);
+		empty_voxel_block_device = GetEmptyVoxelBlock<TVoxel, TMemoryDeviceType>();
 	}
 
 	~BlockListDeallocationFunctor() {
@@ -304,9 +313,8 @@ public: // instance functions
 	_DEVICE_WHEN_AVAILABLE_
 	void operator()(const float& depth_measure, int x, int y) {
 
-		if (depth_measure <= 0 || (depth_measure - surface_distance_cutoff) < 0 ||
-		    (depth_measure - surface_distance_cutoff) < near_clipping_distance ||
-		    (depth_measure + surface_distance_cutoff) > far_clipping_distance)
+		if (!DepthBandIsWithinClippingRange(depth_measure, surface_distance_cutoff, near_clipping_distance,
+		                                    far_clipping_distance))
 			return;
 
 
@@ -392,40 +400,12 @@ protected: // instance functions
 	                    const float& live_frame_depth_meters,
 	                    Vector4f canonical_surface_point_in_world_space,
 	                    const int x, const int y) {
-		has_live_surface = has_canonical_surface = false;
-		if (!(live_frame_depth_meters <= 0 || (live_frame_depth_meters - this->surface_distance_cutoff) < 0 ||
-		      (live_frame_depth_meters - this->surface_distance_cutoff) < this->near_clipping_distance ||
-		      (live_frame_depth_meters + this->surface_distance_cutoff) > this->far_clipping_distance))
-			has_live_surface = true;
-
-		if (canonical_surface_point_in_world_space.w > 0.0f) {
-			has_canonical_surface = true;
-			canonical_surface_point_in_world_space[3] = 1.0;
-			canonical_surface_point_in_camera_space = WorldSpacePointToCameraSpace(canonical_surface_point_in_world_space, this->depth_camera_pose);
-		}
-
-		if (has_live_surface && has_canonical_surface) {
-			live_surface_point_in_camera_space = ImageSpacePointToCameraSpace(live_frame_depth_meters, x, y,
-			                                                                  this->inverted_projection_parameters);
-			march_segment = FindHashBlockSegmentAlongCameraRayWithinRangeFromAndBetweenTwoPoints(
-					this->surface_distance_cutoff, live_surface_point_in_camera_space, canonical_surface_point_in_camera_space,
-					this->inverted_camera_pose,
-					this->hash_block_size_reciprocal);
-		} else {
-			if (has_live_surface) {
-				march_segment = FindHashBlockSegmentAlongCameraRayWithinRangeFromDepth(
-						live_surface_point_in_camera_space, this->surface_distance_cutoff, live_frame_depth_meters, x, y,
-						this->inverted_camera_pose, this->inverted_projection_parameters,
-						this->hash_block_size_reciprocal);
-			} else if (has_canonical_surface) {
-				march_segment = FindHashBlockSegmentAlongCameraRayWithinRangeFromPoint(
-						this->surface_distance_cutoff, canonical_surface_point_in_camera_space, this->inverted_camera_pose,
-						this->hash_block_size_reciprocal);
-			} else {
-				return false; // neither surface is defined at this point, nothing to do.
-			}
-		}
-		return true;
+		return FindHashBlockSegmentAlongCameraRayNearAndBetweenTwoSurfaces(
+				march_segment, live_surface_point_in_camera_space, canonical_surface_point_in_camera_space,
+				has_live_surface, has_canonical_surface, live_frame_depth_meters, canonical_surface_point_in_world_space,
+				x, y, this->surface_distance_cutoff, this->near_clipping_distance, this->far_clipping_distance,
+				this->depth_camera_pose, this->inverted_camera_pose, this->inverted_projection_parameters,
+				this->hash_block_size_reciprocal);
 	}
 
 	_DEVICE_WHEN_AVAILABLE_
@@ -551,6 +531,199 @@ public: // instance functions
 	using DepthBasedAllocationStateMarkerFunctor<TMemoryDeviceType, DIAGNOSTIC>::colliding_block_positions;
 };
 
+/**
+ * \brief Same as the optimized TwoSurfaceBasedAllocationStateMarkerFunctor, but additionally flags (by hash code) all
+ * previously-allocated blocks that are spanned by the march segments, so that the blocks that are no longer spanned
+ * can be identified and deallocated afterward.
+ */
+template<MemoryDeviceType TMemoryDeviceType>
+struct TwoSurfaceBasedIncrementalAllocationStateMarkerFunctor
+		: public TwoSurfaceBasedAllocationStateMarkerFunctor_Base<TMemoryDeviceType, OPTIMIZED> {
+private: // instance variables
+	bool* spanned_block_flags;
+public: // instance functions
+	TwoSurfaceBasedIncrementalAllocationStateMarkerFunctor(VoxelBlockHash& index,
+	                                                       const VoxelVolumeParameters& volume_parameters,
+	                                                       const ITMLib::View* view,
+	                                                       const CameraTrackingState* tracking_state,
+	                                                       float surface_distance_cutoff,
+	                                                       bool* spanned_block_flags)
+			:
+			TwoSurfaceBasedAllocationStateMarkerFunctor_Base<TMemoryDeviceType, OPTIMIZED>(index, volume_parameters, view,
+			                                                                               tracking_state,
+			                                                                               surface_distance_cutoff),
+			spanned_block_flags(spanned_block_flags) {}
+
+	_DEVICE_WHEN_AVAILABLE_
+	void operator()(const float& surface1_depth, const Vector4f& surface2_point_world_space, const int x, const int y) {
+
+		ITMLib::Segment march_segment;
+		if (!this->ComputeMarchSegment(march_segment, surface1_depth, surface2_point_world_space, x, y)) {
+			return;
+		}
+
+		MarkVoxelHashBlocksAlongSegment(this->hash_entry_allocation_states, this->hash_block_coordinates,
+		                                *this->unresolvable_collision_encountered_device, this->hash_table,
+		                                march_segment,
+		                                this->colliding_block_positions_device, this->colliding_block_count,
+		                                spanned_block_flags);
+	}
+
+	using DepthBasedAllocationStateMarkerFunctor<TMemoryDeviceType, OPTIMIZED>::colliding_block_positions;
+};
+
+/**
+ * \brief Collects positions of the blocks (traversed by hash code) that haven't been flagged as spanned.
+ */
+template<MemoryDeviceType TMemoryDeviceType>
+struct UnspannedBlockCollectionFunctor {
+public: // instance variables
+	ORUtils::MemoryBlock<Vector3s> unspanned_block_positions;
+private: // instance variables
+	const HashEntry* hash_table;
+	const bool* spanned_block_flags;
+	Vector3s* unspanned_block_positions_device;
+	DECLARE_ATOMIC(int, unspanned_block_count);
+public: // instance functions
+	UnspannedBlockCollectionFunctor(const VoxelBlockHash& index, const bool* spanned_block_flags, int max_block_count)
+			: unspanned_block_positions(max_block_count, TMemoryDeviceType),
+			  hash_table(index.GetEntries()),
+			  spanned_block_flags(spanned_block_flags),
+			  unspanned_block_positions_device(unspanned_block_positions.GetData(TMemoryDeviceType)) {
+		INITIALIZE_ATOMIC(int, unspanned_block_count, 0);
+	}
+
+	~UnspannedBlockCollectionFunctor() {
+		CLEAN_UP_ATOMIC(unspanned_block_count);
+	}
+
+	int GetUnspannedBlockCount() const {
+		return GET_ATOMIC_VALUE_CPU(unspanned_block_count);
+	}
+
+	_DEVICE_WHEN_AVAILABLE_
+	void operator()(const int& hash_code) {
+		if (!spanned_block_flags[hash_code]) {
+			int i_unspanned_block = ATOMIC_ADD(unspanned_block_count, 1);
+			unspanned_block_positions_device[i_unspanned_block] = hash_table[hash_code].pos;
+		}
+	}
+};
+
+/**
+ * \brief Collects positions of the (traversed) target-volume blocks that are not allocated in the source volume.
+ */
+template<MemoryDeviceType TMemoryDeviceType>
+struct BlocksMissingFromOtherVolumeCollectionFunctor {
+public: // instance variables
+	ORUtils::MemoryBlock<Vector3s> missing_block_positions;
+private: // instance variables
+	const HashEntry* source_hash_table;
+	Vector3s* missing_block_positions_device;
+	DECLARE_ATOMIC(int, missing_block_count);
+public: // instance functions
+	BlocksMissingFromOtherVolumeCollectionFunctor(const VoxelBlockHash& target_index, const VoxelBlockHash& source_index)
+			: missing_block_positions(target_index.GetUtilizedBlockCount(), TMemoryDeviceType),
+			  source_hash_table(source_index.GetEntries()),
+			  missing_block_positions_device(missing_block_positions.GetData(TMemoryDeviceType)) {
+		INITIALIZE_ATOMIC(int, missing_block_count, 0);
+	}
+
+	~BlocksMissingFromOtherVolumeCollectionFunctor() {
+		CLEAN_UP_ATOMIC(missing_block_count);
+	}
+
+	int GetMissingBlockCount() const {
+		return GET_ATOMIC_VALUE_CPU(missing_block_count);
+	}
+
+	_DEVICE_WHEN_AVAILABLE_
+	void operator()(const HashEntry& target_hash_entry, const int& target_hash_code) {
+		if (FindHashCodeAt(source_hash_table, target_hash_entry.pos) == -1) {
+			int i_missing_block = ATOMIC_ADD(missing_block_count, 1);
+			missing_block_positions_device[i_missing_block] = target_hash_entry.pos;
+		}
+	}
+};
+
+/**
+ * \brief Resets all voxels of each (traversed) block to default values, leaving the block itself allocated.
+ */
+template<typename TVoxel, MemoryDeviceType TMemoryDeviceType>
+struct BlockVoxelResetFunctor {
+private: // instance variables
+	TVoxel* voxels;
+	const TVoxel* empty_voxel_block_device;
+public: // instance functions
+	explicit BlockVoxelResetFunctor(VoxelVolume<TVoxel, VoxelBlockHash>* volume)
+			: voxels(volume->GetVoxels()),
+			  empty_voxel_block_device(GetEmptyVoxelBlock<TVoxel, TMemoryDeviceType>()) {}
+
+	_DEVICE_WHEN_AVAILABLE_
+	void operator()(const HashEntry& hash_entry, const int& hash_code) {
+		memcpy(voxels + hash_entry.ptr * VOXEL_BLOCK_SIZE3, empty_voxel_block_device, sizeof(TVoxel) * VOXEL_BLOCK_SIZE3);
+	}
+};
+
+/**
+ * \brief For each (traversed) source-volume block, resets voxels of the target volume at the source block's voxel
+ * storage offset to default values, unless the target hash table already holds the same block at the same hash code
+ * and offset (in which case the target voxels there already belong to that block).
+ */
+template<typename TVoxel, MemoryDeviceType TMemoryDeviceType>
+struct RelocatedBlockVoxelResetFunctor {
+private: // instance variables
+	TVoxel* target_voxels;
+	const HashEntry* target_hash_table;
+	const TVoxel* empty_voxel_block_device;
+public: // instance functions
+	explicit RelocatedBlockVoxelResetFunctor(VoxelVolume<TVoxel, VoxelBlockHash>* target_volume)
+			: target_voxels(target_volume->GetVoxels()),
+			  target_hash_table(target_volume->index.GetEntries()),
+			  empty_voxel_block_device(GetEmptyVoxelBlock<TVoxel, TMemoryDeviceType>()) {}
+
+	_DEVICE_WHEN_AVAILABLE_
+	void operator()(const HashEntry& source_hash_entry, const int& hash_code) {
+		const HashEntry& target_hash_entry = target_hash_table[hash_code];
+		if (target_hash_entry.ptr == source_hash_entry.ptr && target_hash_entry.pos == source_hash_entry.pos) return;
+		memcpy(target_voxels + source_hash_entry.ptr * VOXEL_BLOCK_SIZE3, empty_voxel_block_device,
+		       sizeof(TVoxel) * VOXEL_BLOCK_SIZE3);
+	}
+};
+
+/**
+ * \brief For each (traversed) utilized hash code of the reference index, fills in the corresponding row of the block neighbor
+ * table of the target index with voxel offsets to the target blocks in the 3x3x3 block neighborhood (-1 where unallocated).
+ */
+template<MemoryDeviceType TMemoryDeviceType>
+struct BlockNeighborTableFunctor {
+private: // instance variables
+	const HashEntry* target_hash_table;
+	const HashEntry* reference_hash_table;
+	int* block_neighbor_table;
+public: // instance functions
+	BlockNeighborTableFunctor(VoxelBlockHash& target_index, const VoxelBlockHash& reference_index)
+			: target_hash_table(target_index.GetEntries()),
+			  reference_hash_table(reference_index.GetEntries()),
+			  block_neighbor_table(target_index.GetBlockNeighborTable()) {}
+
+	_DEVICE_WHEN_AVAILABLE_
+	void operator()(const int& reference_hash_code, const int& i_utilized_block) {
+		const Vector3s block_position = reference_hash_table[reference_hash_code].pos;
+		int* neighbor_block_offsets = block_neighbor_table + i_utilized_block * VOXEL_BLOCK_NEIGHBORHOOD_SIZE;
+		int i_neighbor = 0;
+		for (short z = -1; z < 2; z++) {
+			for (short y = -1; y < 2; y++) {
+				for (short x = -1; x < 2; x++, i_neighbor++) {
+					int neighbor_hash_code = FindHashCodeAt(target_hash_table, block_position + Vector3s(x, y, z));
+					neighbor_block_offsets[i_neighbor] =
+							neighbor_hash_code == -1 ? -1 : target_hash_table[neighbor_hash_code].ptr * VOXEL_BLOCK_SIZE3;
+				}
+			}
+		}
+	}
+};
+
 template<typename TVoxel, MemoryDeviceType TMemoryDeviceType>
 struct ReallocateDeletedHashBlocksFunctor {
 	ReallocateDeletedHashBlocksFunctor(VoxelVolume<TVoxel, VoxelBlockHash>* volume) :
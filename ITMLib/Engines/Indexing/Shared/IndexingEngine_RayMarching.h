@@ -41,7 +41,8 @@ TryToMarkBlockForAllocation(const Vector3s& block_position,
                             bool& unresolvable_collision_encountered,
                             const CONSTPTR(HashEntry)* hash_table,
                             THREADPTR(Vector3s)* colliding_block_positions,
-                            ATOMIC_ARGUMENT(int) colliding_block_count) {
+                            ATOMIC_ARGUMENT(int) colliding_block_count,
+                            THREADPTR(bool)* spanned_block_flags = nullptr) {
 	ThreadAllocationStatus resulting_status = MarkAsNeedingAllocationIfNotFound<true>(
 			hash_entry_allocation_states,
 			hash_block_coordinates, block_position,
@@ -49,18 +50,26 @@ TryToMarkBlockForAllocation(const Vector3s& block_position,
 
 	if (resulting_status == BEING_MODIFIED_BY_ANOTHER_THREAD) {
 		unresolvable_collision_encountered = true;
+	} else if (spanned_block_flags != nullptr &&
+	           (resulting_status == ALREADY_IN_ORDERED_LIST || resulting_status == ALREADY_IN_EXCESS_LIST)) {
+		// block is already allocated -- record that it is still in use, if the caller asked for it
+		int hash_code = FindHashCodeAt(hash_table, block_position);
+		if (hash_code != -1) {
+			spanned_block_flags[hash_code] = true;
+		}
 	}
 }
 
 
+/**
+ * \brief Invokes the given function for every hash block that the given segment passes through, including blocks
+ * that the segment only clips diagonally between two sampled steps.
+ * \param segment_in_hash_blocks segment, in hash block coordinates
+ * \param visit_block function to call with the position of each block (the same block may be visited repeatedly)
+ */
+template<typename TVisitBlockFunction>
 _DEVICE_WHEN_AVAILABLE_ inline void
-MarkVoxelHashBlocksAlongSegment(ITMLib::HashEntryAllocationState* hash_entry_allocation_states,
-                                Vector3s* hash_block_coordinates,
-                                bool& unresolvable_collision_encountered,
-                                const CONSTPTR(HashEntry)* hash_table,
-                                const ITMLib::Segment& segment_in_hash_blocks,
-                                THREADPTR(Vector3s)* colliding_block_positions,
-                                ATOMIC_ARGUMENT(int) colliding_block_count) {
+ForEachHashBlockAlongSegment(const ITMLib::Segment& segment_in_hash_blocks, TVisitBlockFunction&& visit_block) {
 
 // number of steps to take along the truncated SDF band
 	int step_count = (int) std::ceil(2.0f * segment_in_hash_blocks.length());
@@ -86,15 +95,7 @@ MarkVoxelHashBlocksAlongSegment(ITMLib::HashEntryAllocationState* hash_entry_all
 						if (SegmentIntersectsGridAlignedCube3D(segment_in_hash_blocks,
 						                                       TO_FLOAT3(potentially_missed_block_position),
 						                                       1.0f)) {
-							TryToMarkBlockForAllocation(
-									potentially_missed_block_position,
-									hash_entry_allocation_states,
-									hash_block_coordinates,
-									unresolvable_collision_encountered,
-									hash_table,
-									colliding_block_positions,
-									colliding_block_count
-							);
+							visit_block(potentially_missed_block_position);
 						}
 					}
 				}
@@ -106,48 +107,40 @@ MarkVoxelHashBlocksAlongSegment(ITMLib::HashEntryAllocationState* hash_entry_all
 					if (SegmentIntersectsGridAlignedCube3D(segment_in_hash_blocks,
 					                                       TO_FLOAT3(potentially_missed_block_position),
 					                                       1.0f)) {
-						TryToMarkBlockForAllocation(
-								potentially_missed_block_position,
-								hash_entry_allocation_states,
-								hash_block_coordinates,
-								unresolvable_collision_encountered,
-								hash_table,
-								colliding_block_positions,
-								colliding_block_count
-						);
+						visit_block(potentially_missed_block_position);
 					}
 					potentially_missed_block_position = current_block_position;
 					potentially_missed_block_position.values[iDirection] = previous_block_position.values[iDirection];
 					if (SegmentIntersectsGridAlignedCube3D(segment_in_hash_blocks,
 					                                       TO_FLOAT3(potentially_missed_block_position),
 					                                       1.0f)) {
-						TryToMarkBlockForAllocation(
-								potentially_missed_block_position,
-								hash_entry_allocation_states,
-								hash_block_coordinates,
-								unresolvable_collision_encountered,
-								hash_table,
-								colliding_block_positions,
-								colliding_block_count
-						);
+						visit_block(potentially_missed_block_position);
 					}
 				}
 			}
 		}
-		TryToMarkBlockForAllocation(
-				current_block_position,
-				hash_entry_allocation_states,
-				hash_block_coordinates,
-				unresolvable_collision_encountered,
-				hash_table,
-				colliding_block_positions,
-				colliding_block_count
-		);
+		visit_block(current_block_position);
 		check_position += strideVector;
 		previous_block_position = current_block_position;
 	}
 }
 
+_DEVICE_WHEN_AVAILABLE_ inline void
+MarkVoxelHashBlocksAlongSegment(ITMLib::HashEntryAllocationState* hash_entry_allocation_states,
+                                Vector3s* hash_block_coordinates,
+                                bool& unresolvable_collision_encountered,
+                                const CONSTPTR(HashEntry)* hash_table,
+                                const ITMLib::Segment& segment_in_hash_blocks,
+                                THREADPTR(Vector3s)* colliding_block_positions,
+                                ATOMIC_ARGUMENT(int) colliding_block_count,
+                                THREADPTR(bool)* spanned_block_flags = nullptr) {
+	ForEachHashBlockAlongSegment(segment_in_hash_blocks, [&](const Vector3s& block_position) {
+		TryToMarkBlockForAllocation(block_position, hash_entry_allocation_states, hash_block_coordinates,
+		                            unresolvable_collision_encountered, hash_table, colliding_block_positions,
+		                            colliding_block_count, spanned_block_flags);
+	});
+}
+
 _CPU_AND_GPU_CODE_
 inline Vector4f ImageSpacePointToCameraSpace(const float depth, const float x, const float y,
                                              const Vector4f& inverted_camera_projection_parameters) {
@@ -322,6 +315,70 @@ FindHashBlockSegmentAlongCameraRayWithinRangeFromDepth(const float distance_from
 }
 
 
+/**
+ * \brief Determine whether the depth measurement is valid and the truncated SDF band around it lies within the clipping range
+ */
+_CPU_AND_GPU_CODE_
+inline bool DepthBandIsWithinClippingRange(const float depth_measure, const float surface_distance_cutoff,
+                                           const float near_clipping_distance, const float far_clipping_distance) {
+	return !(depth_measure <= 0 || (depth_measure - surface_distance_cutoff) < 0 ||
+	         (depth_measure - surface_distance_cutoff) < near_clipping_distance ||
+	         (depth_measure + surface_distance_cutoff) > far_clipping_distance);
+}
+
+/**
+ * \brief Compute the segment (in hash block coordinates) to march along for a single pixel so as to cover the truncated
+ * SDF bands around both surfaces, and the space between them, when both surfaces are present at the pixel, or just the
+ * band around one of them, when only that one is present.
+ * \param[out] march_segment resulting segment
+ * \param[out] surface1_point_in_camera_space point on the first surface (only set when both surfaces are present, or only the first is)
+ * \param[out] surface2_point_in_camera_space point on the second surface (only set when the second surface is present)
+ * \param[out] has_surface1 whether the depth of the first surface at the pixel is usable
+ * \param[out] has_surface2 whether the second surface is present at the pixel
+ * \param surface1_depth depth of the first surface at the pixel
+ * \param surface2_point_in_world_space point on the second surface (w-component > 0 if present)
+ * \return false if neither surface is present, true otherwise
+ */
+_CPU_AND_GPU_CODE_
+inline bool FindHashBlockSegmentAlongCameraRayNearAndBetweenTwoSurfaces(
+		ITMLib::Segment& march_segment,
+		Vector4f& surface1_point_in_camera_space, Vector4f& surface2_point_in_camera_space,
+		bool& has_surface1, bool& has_surface2,
+		const float surface1_depth, Vector4f surface2_point_in_world_space, const int x, const int y,
+		const float surface_distance_cutoff, const float near_clipping_distance, const float far_clipping_distance,
+		const Matrix4f& depth_camera_pose, const Matrix4f& inverted_camera_pose,
+		const Vector4f& inverted_projection_parameters, const float hash_block_size_reciprocal) {
+	has_surface1 = DepthBandIsWithinClippingRange(surface1_depth, surface_distance_cutoff,
+	                                              near_clipping_distance, far_clipping_distance);
+	has_surface2 = false;
+
+	if (surface2_point_in_world_space.w > 0.0f) {
+		has_surface2 = true;
+		surface2_point_in_world_space[3] = 1.0;
+		surface2_point_in_camera_space = WorldSpacePointToCameraSpace(surface2_point_in_world_space, depth_camera_pose);
+	}
+
+	if (has_surface1 && has_surface2) {
+		surface1_point_in_camera_space = ImageSpacePointToCameraSpace(surface1_depth, x, y, inverted_projection_parameters);
+		march_segment = FindHashBlockSegmentAlongCameraRayWithinRangeFromAndBetweenTwoPoints(
+				surface_distance_cutoff, surface1_point_in_camera_space, surface2_point_in_camera_space,
+				inverted_camera_pose, hash_block_size_reciprocal);
+	} else {
+		if (has_surface1) {
+			march_segment = FindHashBlockSegmentAlongCameraRayWithinRangeFromDepth(
+					surface1_point_in_camera_space, surface_distance_cutoff, surface1_depth, x, y,
+					inverted_camera_pose, inverted_projection_parameters, hash_block_size_reciprocal);
+		} else if (has_surface2) {
+			march_segment = FindHashBlockSegmentAlongCameraRayWithinRangeFromPoint(
+					surface_distance_cutoff, surface2_point_in_camera_space, inverted_camera_pose,
+					hash_block_size_reciprocal);
+		} else {
+			return false; // neither surface is defined at this point, nothing to do.
+		}
+	}
+	return true;
+}
+
 _DEVICE_WHEN_AVAILABLE_ inline void
 FindVoxelBlocksForRayNearSurface(ITMLib::HashEntryAllocationState* hash_entry_allocation_states,
                                  Vector3s* hash_block_coordinates,
@@ -337,9 +394,8 @@ FindVoxelBlocksForRayNearSurface(ITMLib::HashEntryAllocationState* hash_entry_al
                                  ATOMIC_ARGUMENT(int) colliding_block_count) {
 
 	float depth_measure = depth[x + y * depth_image_size.x];
-	if (depth_measure <= 0 || (depth_measure - surface_distance_cutoff) < 0 ||
-	    (depth_measure - surface_distance_cutoff) < near_clipping_distance ||
-	    (depth_measure + surface_distance_cutoff) > far_clipping_distance)
+	if (!DepthBandIsWithinClippingRange(depth_measure, surface_distance_cutoff, near_clipping_distance,
+	                                    far_clipping_distance))
 		return;
 
 // segment from start of the (truncated SDF) band, through the observed point, and to the opposite (occluded)
@@ -93,4 +93,36 @@ template void AllocateUsingOtherVolume_OffsetAndBounded<MEMORYDEVICE_CPU, WarpVo
 		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
 		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* source_volume,
 		const Extent3Di& source_bounds, const Vector3i& target_offset);
+
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CPU, WarpVoxel, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CPU, TSDFVoxel_f_flags, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CPU, TSDFVoxel_f_rgb, TSDFVoxel_f_rgb>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CPU, WarpVoxel, WarpVoxel>(
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* source_volume);
+
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU, WarpVoxel, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU, TSDFVoxel_f_flags, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU, TSDFVoxel_f_rgb, TSDFVoxel_f_rgb>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CPU, WarpVoxel, WarpVoxel>(
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* source_volume);
+
+template void ResetUtilizedVoxels<MEMORYDEVICE_CPU, TSDFVoxel_f_flags>(ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* volume);
+template void ResetUtilizedVoxels<MEMORYDEVICE_CPU, TSDFVoxel_f_rgb>(ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* volume);
+template void ResetUtilizedVoxels<MEMORYDEVICE_CPU, WarpVoxel>(ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* volume);
+
+template void BuildBlockNeighborTable<MEMORYDEVICE_CPU>(VoxelBlockHash& target_index, const VoxelBlockHash& reference_index);
 }//namespace ITMLib
\ No newline at end of file
@@ -78,4 +78,36 @@ template void AllocateUsingOtherVolume_OffsetAndBounded<MEMORYDEVICE_CUDA, WarpV
 		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
 		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* source_volume,
 		const Extent3Di& source_bounds, const Vector3i& target_offset);
+
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CUDA, WarpVoxel, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CUDA, TSDFVoxel_f_flags, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CUDA, TSDFVoxel_f_rgb, TSDFVoxel_f_rgb>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* source_volume);
+template void DeallocateUsingOtherVolume<MEMORYDEVICE_CUDA, WarpVoxel, WarpVoxel>(
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* source_volume);
+
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CUDA, WarpVoxel, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CUDA, TSDFVoxel_f_flags, TSDFVoxel_f_flags>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CUDA, TSDFVoxel_f_rgb, TSDFVoxel_f_rgb>(
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* source_volume);
+template void MirrorIndexOfOtherVolume<MEMORYDEVICE_CUDA, WarpVoxel, WarpVoxel>(
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* target_volume,
+		ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* source_volume);
+
+template void ResetUtilizedVoxels<MEMORYDEVICE_CUDA, TSDFVoxel_f_flags>(ITMLib::VoxelVolume<TSDFVoxel_f_flags, VoxelBlockHash>* volume);
+template void ResetUtilizedVoxels<MEMORYDEVICE_CUDA, TSDFVoxel_f_rgb>(ITMLib::VoxelVolume<TSDFVoxel_f_rgb, VoxelBlockHash>* volume);
+template void ResetUtilizedVoxels<MEMORYDEVICE_CUDA, WarpVoxel>(ITMLib::VoxelVolume<WarpVoxel, VoxelBlockHash>* volume);
+
+template void BuildBlockNeighborTable<MEMORYDEVICE_CUDA>(VoxelBlockHash& target_index, const VoxelBlockHash& reference_index);
 }//namespace ITMLib
\ No newline at end of file
@@ -0,0 +1,270 @@
+#pragma once
+
+//stdlib
+#include <atomic>
+#include <limits>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//local
+#include "../../Shared/IndexingEngine_RayMarching.h"
+#include "../../../../Objects/Volume/VoxelBlockHash.h"
+#include "../../../../Objects/Views/View.h"
+#include "../../../../Objects/Tracking/CameraTrackingState.h"
+#include "../../../../Utils/VoxelVolumeParameters.h"
+
+namespace ITMLib {
+namespace internal {
+
+// region ================================ ATOMIC ACCESS TO HASH ENTRY FIELDS =========================================
+
+inline int AtomicLoadAcquire_CPU(const int* value) {
+#ifdef _MSC_VER
+	const int loaded_value = *reinterpret_cast<const volatile int*>(value);
+	_ReadWriteBarrier();
+	return loaded_value;
+#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+inline void AtomicStoreRelease_CPU(int* value, int new_value) {
+#ifdef _MSC_VER
+	_ReadWriteBarrier();
+	*reinterpret_cast<volatile int*>(value) = new_value;
+#else
+	__atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+inline bool AtomicCompareExchange_CPU(int* value, int expected, int desired) {
+#ifdef _MSC_VER
+	return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(value), desired, expected) == expected;
+#else
+	return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// endregion ===========================================================================================================
+
+/**
+ * \brief Inserts blocks into a voxel block hash table from any number of CPU threads at once, in a single pass, i.e.
+ * without marking hash entry allocation states first.
+ * \details A free ordered-list entry is claimed by swapping its ptr for ENTRY_BEING_ALLOCATED, and the tail of a
+ * collision chain is claimed by swapping its offset for CHAIN_BEING_EXTENDED. The claiming thread pops (in the latter
+ * case) an excess list entry and then a voxel block off the free stacks, fills in the new entry, and then releases
+ * the claim, which publishes the entry. The free stack counters are only decremented by compare-and-swap from
+ * non-negative values, so that no two threads pop the same id and the counters never drop below -1. Threads that run
+ * into a claimed entry wait for it to be published, since it might hold the very block they are looking for. The
+ * free stack and utilized list counters are written back to the index only by UpdateIndexCounters.
+ */
+struct ConcurrentHashBlockInserter_CPU {
+private: // static constants
+	static constexpr int ENTRY_BEING_ALLOCATED = std::numeric_limits<int>::min();
+	static constexpr int CHAIN_BEING_EXTENDED = -1;
+private: // instance variables
+	HashEntry* hash_table;
+	const int* block_allocation_list;
+	const int* excess_entry_list;
+	int* utilized_block_hash_codes;
+
+	std::atomic<int> last_free_voxel_block_id;
+	std::atomic<int> last_free_excess_list_id;
+	std::atomic<int> utilized_block_count;
+	std::atomic<bool> out_of_space;
+public: // instance functions
+	explicit ConcurrentHashBlockInserter_CPU(VoxelBlockHash& index)
+			: hash_table(index.GetEntries()),
+			  block_allocation_list(index.GetBlockAllocationList()),
+			  excess_entry_list(index.GetExcessEntryList()),
+			  utilized_block_hash_codes(index.GetUtilizedBlockHashCodes()),
+			  last_free_voxel_block_id(index.GetLastFreeBlockListId()),
+			  last_free_excess_list_id(index.GetLastFreeExcessListId()),
+			  utilized_block_count(index.GetUtilizedBlockCount()),
+			  out_of_space(false) {}
+
+	void UpdateIndexCounters(VoxelBlockHash& index) const {
+		index.SetLastFreeBlockListId(last_free_voxel_block_id.load());
+		index.SetLastFreeExcessListId(last_free_excess_list_id.load());
+		index.SetUtilizedBlockCount(utilized_block_count.load());
+	}
+
+	/** \brief Whether any block could not be allocated because the voxel blocks or the excess list ran out */
+	bool RanOutOfSpace() const {
+		return out_of_space.load();
+	}
+
+	/**
+	 * \brief Find the block at the given position in the hash table, allocating it first if it isn't there yet.
+	 * \return hash code of the block, or -1 if the block needed allocation but there was no room for it
+	 */
+	int FindOrAllocate(const Vector3s& block_position) {
+		int hash_code = HashCodeFromBlockPosition(block_position);
+		HashEntry* entry = hash_table + hash_code;
+
+		int ptr;
+		while ((ptr = AtomicLoadAcquire_CPU(&entry->ptr)) < -1) {
+			if (ptr == ENTRY_BEING_ALLOCATED) {
+				std::this_thread::yield();
+			} else if (AtomicCompareExchange_CPU(&entry->ptr, ptr, ENTRY_BEING_ALLOCATED)) {
+				const int voxel_block_index = PopFreeListId(last_free_voxel_block_id);
+				if (voxel_block_index < 0) {
+					AtomicStoreRelease_CPU(&entry->ptr, ptr);
+					out_of_space.store(true);
+					return -1;
+				}
+				entry->pos = block_position;
+				entry->offset = 0;
+				AtomicStoreRelease_CPU(&entry->ptr, block_allocation_list[voxel_block_index]);
+				AppendToUtilizedBlockList(hash_code);
+				return hash_code;
+			}
+		}
+
+		// the ordered entry is taken, search the chain of entries in the excess list behind it
+		while (true) {
+			if (IS_EQUAL3(entry->pos, block_position)) {
+				return hash_code;
+			}
+			const int offset = AtomicLoadAcquire_CPU(&entry->offset);
+			if (offset >= 1) {
+				hash_code = ORDERED_LIST_SIZE + offset - 1;
+				entry = hash_table + hash_code;
+			} else if (offset == CHAIN_BEING_EXTENDED) {
+				std::this_thread::yield();
+			} else if (AtomicCompareExchange_CPU(&entry->offset, 0, CHAIN_BEING_EXTENDED)) {
+				const int excess_list_index = PopFreeListId(last_free_excess_list_id);
+				const int voxel_block_index = excess_list_index < 0 ? -1 : PopFreeListId(last_free_voxel_block_id);
+				if (voxel_block_index < 0) {
+					if (excess_list_index >= 0) {
+						PushBackFreeListId(last_free_excess_list_id, excess_list_index);
+					}
+					AtomicStoreRelease_CPU(&entry->offset, 0);
+					out_of_space.store(true);
+					return -1;
+				}
+				const int excess_list_offset = excess_entry_list[excess_list_index];
+				const int new_hash_code = ORDERED_LIST_SIZE + excess_list_offset;
+				HashEntry& new_entry = hash_table[new_hash_code];
+				new_entry.pos = block_position;
+				new_entry.ptr = block_allocation_list[voxel_block_index];
+				new_entry.offset = 0;
+				AtomicStoreRelease_CPU(&entry->offset, excess_list_offset + 1);
+				AppendToUtilizedBlockList(new_hash_code);
+				return new_hash_code;
+			}
+		}
+	}
+
+private: // static functions
+	/**
+	 * \brief Pop the top id off a free stack, never driving its counter below -1.
+	 * \return the popped id, or -1 if the stack is empty
+	 */
+	static int PopFreeListId(std::atomic<int>& last_free_id) {
+		int id = last_free_id.load();
+		while (id >= 0 && !last_free_id.compare_exchange_weak(id, id - 1)) {}
+		return id < 0 ? -1 : id;
+	}
+
+	/**
+	 * \brief Return an id popped by PopFreeListId, which succeeds only if no other thread popped anything since.
+	 * \details Otherwise, the id below the given one belongs to another thread now, and the given one stays claimed
+	 * until the next reset of the index. This only ever happens once the voxel blocks have run out, i.e. when
+	 * RanOutOfSpace() will report the allocation as incomplete anyway.
+	 */
+	static void PushBackFreeListId(std::atomic<int>& last_free_id, int id) {
+		int expected_id = id - 1;
+		last_free_id.compare_exchange_strong(expected_id, id);
+	}
+
+private: // instance functions
+	void AppendToUtilizedBlockList(int hash_code) {
+		utilized_block_hash_codes[utilized_block_count.fetch_add(1)] = hash_code;
+	}
+};
+
+/**
+ * \brief Allocates the blocks within the truncated SDF band around each depth measurement directly, via a
+ * ConcurrentHashBlockInserter_CPU (see DepthBasedAllocationStateMarkerFunctor for the multi-pass counterpart)
+ */
+struct DepthBasedConcurrentAllocationFunctor_CPU {
+protected: // instance variables
+	ConcurrentHashBlockInserter_CPU& inserter;
+
+	const float near_clipping_distance;
+	const float far_clipping_distance;
+	const Matrix4f inverted_camera_pose;
+	const Vector4f inverted_projection_parameters;
+
+	const float surface_distance_cutoff;
+	const float hash_block_size_reciprocal;
+public: // instance functions
+	DepthBasedConcurrentAllocationFunctor_CPU(ConcurrentHashBlockInserter_CPU& inserter,
+	                                          const VoxelVolumeParameters& volume_parameters, const ITMLib::View* view,
+	                                          const Matrix4f& inverted_depth_camera_pose, float surface_distance_cutoff)
+			: inserter(inserter),
+			  near_clipping_distance(volume_parameters.near_clipping_distance),
+			  far_clipping_distance(volume_parameters.far_clipping_distance),
+			  inverted_camera_pose(inverted_depth_camera_pose),
+			  inverted_projection_parameters([&view]() {
+				  Vector4f params = view->calibration_information.intrinsics_d.projectionParamsSimple.all;
+				  params.fx = 1.0f / params.fx;
+				  params.fy = 1.0f / params.fy;
+				  return params;
+			  }()),
+			  surface_distance_cutoff(surface_distance_cutoff),
+			  hash_block_size_reciprocal(1.0f / (volume_parameters.voxel_size * VOXEL_BLOCK_SIZE)) {}
+
+	void operator()(const float& depth_measure, int x, int y) {
+		if (!DepthBandIsWithinClippingRange(depth_measure, surface_distance_cutoff, near_clipping_distance,
+		                                    far_clipping_distance))
+			return;
+		ITMLib::Segment march_segment = FindHashBlockSegmentAlongCameraRayWithinRangeFromDepth(
+				surface_distance_cutoff, depth_measure, x, y, inverted_camera_pose, inverted_projection_parameters,
+				hash_block_size_reciprocal);
+		ForEachHashBlockAlongSegment(march_segment, [this](const Vector3s& block_position) {
+			inserter.FindOrAllocate(block_position);
+		});
+	}
+};
+
+/**
+ * \brief Allocates the blocks near and between two surfaces directly, via a ConcurrentHashBlockInserter_CPU
+ * (see TwoSurfaceBasedAllocationStateMarkerFunctor for the multi-pass counterpart)
+ */
+struct TwoSurfaceBasedConcurrentAllocationFunctor_CPU : public DepthBasedConcurrentAllocationFunctor_CPU {
+protected: // instance variables
+	const Matrix4f depth_camera_pose;
+public: // instance functions
+	TwoSurfaceBasedConcurrentAllocationFunctor_CPU(ConcurrentHashBlockInserter_CPU& inserter,
+	                                               const VoxelVolumeParameters& volume_parameters,
+	                                               const ITMLib::View* view,
+	                                               const CameraTrackingState* tracking_state,
+	                                               float surface_distance_cutoff)
+			: DepthBasedConcurrentAllocationFunctor_CPU(inserter, volume_parameters, view,
+			                                            tracking_state->pose_d->GetInvM(), surface_distance_cutoff),
+			  depth_camera_pose(tracking_state->pose_d->GetM()) {}
+
+	void operator()(const float& surface1_depth, const Vector4f& surface2_point_world_space, const int x, const int y) {
+		ITMLib::Segment march_segment;
+		Vector4f surface1_point_camera_space, surface2_point_camera_space;
+		bool has_surface1, has_surface2;
+		if (!FindHashBlockSegmentAlongCameraRayNearAndBetweenTwoSurfaces(
+				march_segment, surface1_point_camera_space, surface2_point_camera_space, has_surface1, has_surface2,
+				surface1_depth, surface2_point_world_space, x, y, surface_distance_cutoff, near_clipping_distance,
+				far_clipping_distance, depth_camera_pose, inverted_camera_pose, inverted_projection_parameters,
+				hash_block_size_reciprocal)) {
+			return;
+		}
+		ForEachHashBlockAlongSegment(march_segment, [this](const Vector3s& block_position) {
+			inserter.FindOrAllocate(block_position);
+		});
+	}
+};
+
+} // namespace internal
+} // namespace ITMLib
@@ -30,6 +30,18 @@ struct IndexingEngine_VoxelBlockHash_MemoryDeviceTypeSpecialized<MEMORYDEVICE_CP
 	static void RebuildVisibleBlockList(VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view, const Matrix4f& depth_camera_matrix);
 };
 
+template<typename TVoxel>
+struct IndexingEngine_VoxelBlockHash_SinglePassAllocation<MEMORYDEVICE_CPU, OPTIMIZED, TVoxel> {
+	static constexpr bool available = true;
+	/** \return false if some of the blocks could not be allocated because the voxel blocks or the excess list ran out */
+	static bool AllocateNearSurface(VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view,
+	                                const Matrix4f& inverse_depth_camera_matrix, float surface_distance_cutoff);
+	/** \return false if some of the blocks could not be allocated because the voxel blocks or the excess list ran out */
+	static bool AllocateNearAndBetweenTwoSurfaces(VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view,
+	                                              const CameraTrackingState* tracking_state,
+	                                              float surface_distance_cutoff);
+};
+
 template<typename TVoxelTarget, typename TVoxelSource>
 struct AllocateUsingOtherVolume_OffsetAndBounded_Executor<MEMORYDEVICE_CPU, TVoxelTarget, TVoxelSource> {
 	static inline
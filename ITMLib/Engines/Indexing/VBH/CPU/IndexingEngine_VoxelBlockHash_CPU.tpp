@@ -20,6 +20,7 @@
 
 // local
 #include "IndexingEngine_VoxelBlockHash_CPU.h"
+#include "IndexingEngine_ConcurrentHashInsertion_CPU.h"
 #include "../../../../Objects/Volume/RepresentationAccess.h"
 #include "../../../EditAndCopy/Shared/EditAndCopyEngine_Shared.h"
 #include "../../../Traversal/Interface/HashTableTraversal.h"
@@ -72,6 +73,31 @@ bool IndexingEngine_VoxelBlockHash_MemoryDeviceTypeSpecialized<MEMORYDEVICE_CPU,
 	return true;
 }
 
+template<typename TVoxel>
+bool IndexingEngine_VoxelBlockHash_SinglePassAllocation<MEMORYDEVICE_CPU, OPTIMIZED, TVoxel>::AllocateNearSurface(
+		VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view, const Matrix4f& inverse_depth_camera_matrix,
+		float surface_distance_cutoff) {
+	ConcurrentHashBlockInserter_CPU inserter(volume->index);
+	DepthBasedConcurrentAllocationFunctor_CPU allocation_functor(inserter, volume->GetParameters(), view,
+	                                                             inverse_depth_camera_matrix, surface_distance_cutoff);
+	ImageTraversalEngine<MEMORYDEVICE_CPU>::TraverseWithPosition(&view->depth, allocation_functor);
+	inserter.UpdateIndexCounters(volume->index);
+	return !inserter.RanOutOfSpace();
+}
+
+template<typename TVoxel>
+bool IndexingEngine_VoxelBlockHash_SinglePassAllocation<MEMORYDEVICE_CPU, OPTIMIZED, TVoxel>::AllocateNearAndBetweenTwoSurfaces(
+		VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view, const CameraTrackingState* tracking_state,
+		float surface_distance_cutoff) {
+	ConcurrentHashBlockInserter_CPU inserter(volume->index);
+	TwoSurfaceBasedConcurrentAllocationFunctor_CPU allocation_functor(inserter, volume->GetParameters(), view,
+	                                                                  tracking_state, surface_distance_cutoff);
+	TwoImageTraversalEngine<float, Vector4f, MEMORYDEVICE_CPU>::TraverseWithPosition(
+			view->depth, *(tracking_state->point_cloud->locations), allocation_functor);
+	inserter.UpdateIndexCounters(volume->index);
+	return !inserter.RanOutOfSpace();
+}
+
 template<typename TVoxel>
 void IndexingEngine_VoxelBlockHash_MemoryDeviceTypeSpecialized<MEMORYDEVICE_CPU, TVoxel>::RebuildVisibleBlockList(
 		VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view, const Matrix4f& depth_camera_matrix) {
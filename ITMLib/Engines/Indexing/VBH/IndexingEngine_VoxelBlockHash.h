@@ -27,6 +27,8 @@ class IndexingEngine<TVoxel, VoxelBlockHash, TMemoryDeviceType, TExecutionMode>
 		public IndexingEngineInterface<TVoxel, VoxelBlockHash>{
 private: // instance variables
 	internal::IndexingEngine_VoxelBlockHash_ExecutionModeSpecialized<TMemoryDeviceType, TExecutionMode> execution_mode_specialized_engine;
+	// per-hash-entry flags used by UpdateAllocationNearAndBetweenTwoSurfaces, kept between calls and only ever grown
+	ORUtils::MemoryBlock<bool> spanned_block_flags;
 
 protected: // instance variables
 	using IndexingEngineInterface<TVoxel,VoxelBlockHash>::parameters;
@@ -60,6 +62,9 @@ public: // instance functions
 	void AllocateNearAndBetweenTwoSurfaces(VoxelVolume<TVoxel, VoxelBlockHash>* volume,
 	                                       const View* view,
 	                                       const CameraTrackingState* tracking_state) override;
+	void UpdateAllocationNearAndBetweenTwoSurfaces(VoxelVolume<TVoxel, VoxelBlockHash>* volume,
+	                                               const View* view,
+	                                               const CameraTrackingState* tracking_state) override;
 	void AllocateHashEntriesUsingAllocationStateList(VoxelVolume<TVoxel, VoxelBlockHash>* volume);
 	void AllocateHashEntriesUsingAllocationStateList_SetVisibility(VoxelVolume<TVoxel, VoxelBlockHash>* volume);
 	void AllocateGridAlignedBox(VoxelVolume<TVoxel, VoxelBlockHash>* volume, const Extent3Di& box) override;
@@ -82,6 +87,21 @@ void AllocateUsingOtherVolume_Generic(VoxelVolume<TVoxelTarget, VoxelBlockHash>*
 template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
 struct AllocateUsingOtherVolume_OffsetAndBounded_Executor;
 
+/**
+ * \brief Allocation that inserts blocks into the hash table directly, in a single concurrent pass. Specialized only for
+ * the device & execution mode combinations that support it, elsewhere allocation proceeds by marking hash entry
+ * allocation states and then allocating the marked entries, in as many passes as it takes to resolve all collisions.
+ */
+template<MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode, typename TVoxel>
+struct IndexingEngine_VoxelBlockHash_SinglePassAllocation {
+	static constexpr bool available = false;
+	static bool AllocateNearSurface(VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view,
+	                                const Matrix4f& inverse_depth_camera_matrix, float surface_distance_cutoff) { return false; }
+	static bool AllocateNearAndBetweenTwoSurfaces(VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view,
+	                                              const CameraTrackingState* tracking_state,
+	                                              float surface_distance_cutoff) { return false; }
+};
+
 } // namespace internal
 
 
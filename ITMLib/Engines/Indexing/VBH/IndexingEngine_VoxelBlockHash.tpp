@@ -25,10 +25,16 @@
 #include "../../Traversal/Interface/VolumeTraversal.h"
 #include "../Shared/IndexingEngine_Functors.h"
 #include "../../../Utils/Configuration/Configuration.h"
+#include "../../../Utils/Logging/Logging.h"
 
 
 using namespace ITMLib;
 
+static inline void ReportOutOfSpace(const char* function_name) {
+	LOG4CPLUS_WARN(logging::GetLogger(), function_name << " ran out of voxel blocks or excess list entries, "
+	                                                      "some of the hash blocks were not allocated.");
+}
+
 template<typename TVoxel, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
 template<typename TAllocationFunctor>
 void IndexingEngine<TVoxel, VoxelBlockHash, TMemoryDeviceType, TExecutionMode>::
@@ -90,6 +96,14 @@ void IndexingEngine<TVoxel, VoxelBlockHash, TMemoryDeviceType, TExecutionMode>::
 	Matrix4f inverse_depth_camera_matrix;
 	depth_camera_matrix.inv(inverse_depth_camera_matrix);
 
+	typedef internal::IndexingEngine_VoxelBlockHash_SinglePassAllocation<TMemoryDeviceType, TExecutionMode, TVoxel> SinglePassAllocation;
+	if (SinglePassAllocation::available) {
+		if (!SinglePassAllocation::AllocateNearSurface(volume, view, inverse_depth_camera_matrix, surface_distance_cutoff)) {
+			ReportOutOfSpace("AllocateNearSurface");
+		}
+		return;
+	}
+
 	DepthBasedAllocationStateMarkerFunctor<TMemoryDeviceType, TExecutionMode> depth_based_allocator(
 			volume->index, volume->GetParameters(), view, inverse_depth_camera_matrix, surface_distance_cutoff);
 	if(TExecutionMode == DIAGNOSTIC){
@@ -125,6 +139,14 @@ void IndexingEngine<TVoxel, VoxelBlockHash, TMemoryDeviceType, TExecutionMode>::
 	float band_factor = configuration::Get().general_voxel_volume_parameters.block_allocation_band_factor;
 	float surface_distance_cutoff = band_factor * volume->GetParameters().truncation_distance;
 
+	typedef internal::IndexingEngine_VoxelBlockHash_SinglePassAllocation<TMemoryDeviceType, TExecutionMode, TVoxel> SinglePassAllocation;
+	if (SinglePassAllocation::available) {
+		if (!SinglePassAllocation::AllocateNearAndBetweenTwoSurfaces(volume, view, tracking_state, surface_distance_cutoff)) {
+			ReportOutOfSpace("AllocateNearAndBetweenTwoSurfaces");
+		}
+		return;
+	}
+
 	TwoSurfaceBasedAllocationStateMarkerFunctor<TMemoryDeviceType, TExecutionMode> depth_based_allocator(
 			volume->index, volume->GetParameters(), view, tracking_state, surface_distance_cutoff, execution_mode_specialized_engine);
 	if(TExecutionMode == DIAGNOSTIC){
@@ -147,6 +169,47 @@ void IndexingEngine<TVoxel, VoxelBlockHash, TMemoryDeviceType, TExecutionMode>::
 	depth_based_allocator.SaveDataToDisk();
 }
 
+template<typename TVoxel, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
+void IndexingEngine<TVoxel, VoxelBlockHash, TMemoryDeviceType, TExecutionMode>::UpdateAllocationNearAndBetweenTwoSurfaces(
+		VoxelVolume<TVoxel, VoxelBlockHash>* volume, const View* view, const CameraTrackingState* tracking_state) {
+	// newly-allocated blocks get appended to the utilized block list, so the first previous_block_count entries
+	// in it will still refer to the blocks allocated beforehand
+	const int previous_block_count = volume->index.GetUtilizedBlockCount();
+
+	float band_factor = configuration::Get().general_voxel_volume_parameters.block_allocation_band_factor;
+	float surface_distance_cutoff = band_factor * volume->GetParameters().truncation_distance;
+
+	if (static_cast<int>(spanned_block_flags.size()) < volume->index.hash_entry_count) {
+		spanned_block_flags = ORUtils::MemoryBlock<bool>(volume->index.hash_entry_count, TMemoryDeviceType);
+	}
+	spanned_block_flags.Clear();
+
+	TwoSurfaceBasedIncrementalAllocationStateMarkerFunctor<TMemoryDeviceType> depth_based_allocator(
+			volume->index, volume->GetParameters(), view, tracking_state, surface_distance_cutoff,
+			spanned_block_flags.GetData(TMemoryDeviceType));
+	//TODO: remove push/pop when Clang D FP bug is fixed
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "LoopDoesntUseConditionVariableInspection"
+	do {
+		volume->index.ClearHashEntryAllocationStates();
+		depth_based_allocator.ResetFlagsAndCounters();
+		TwoImageTraversalEngine<float, Vector4f, TMemoryDeviceType>::TraverseWithPosition(
+				view->depth, *(tracking_state->point_cloud->locations), depth_based_allocator);
+		this->AllocateHashEntriesUsingAllocationStateList(volume);
+		this->AllocateBlockList(volume, depth_based_allocator.colliding_block_positions,
+		                        depth_based_allocator.GetCollidingBlockCount());
+	} while (depth_based_allocator.EncounteredUnresolvableCollision());
+#pragma clang diagnostic pop
+
+	if (previous_block_count == 0) return;
+	UnspannedBlockCollectionFunctor<TMemoryDeviceType> unspanned_block_collector(
+			volume->index, spanned_block_flags.GetData(TMemoryDeviceType), previous_block_count);
+	RawArrayTraversalEngine<TMemoryDeviceType>::Traverse(volume->index.GetUtilizedBlockHashCodes(),
+	                                                     unspanned_block_collector, previous_block_count);
+	this->DeallocateBlockList(volume, unspanned_block_collector.unspanned_block_positions,
+	                          unspanned_block_collector.GetUnspannedBlockCount());
+}
+
 
 template<typename TVoxel, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
 void IndexingEngine<TVoxel, VoxelBlockHash, TMemoryDeviceType, TExecutionMode>::ReallocateDeletedHashBlocks(
@@ -362,6 +425,49 @@ void AllocateUsingOtherVolume(
 	                                                              volume_based_allocation_state_marker);
 }
 
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
+void DeallocateUsingOtherVolume(
+		VoxelVolume<TVoxelTarget, VoxelBlockHash>* target_volume,
+		VoxelVolume<TVoxelSource, VoxelBlockHash>* source_volume) {
+	if (target_volume->index.GetUtilizedBlockCount() == 0) return;
+	BlocksMissingFromOtherVolumeCollectionFunctor<TMemoryDeviceType> missing_block_collector(target_volume->index,
+	                                                                                        source_volume->index);
+	HashTableTraversalEngine<TMemoryDeviceType>::TraverseUtilizedWithIndex(target_volume->index, missing_block_collector);
+	IndexingEngine<TVoxelTarget, VoxelBlockHash, TMemoryDeviceType>::Instance().DeallocateBlockList(
+			target_volume, missing_block_collector.missing_block_positions, missing_block_collector.GetMissingBlockCount());
+}
+
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
+void MirrorIndexOfOtherVolume(
+		VoxelVolume<TVoxelTarget, VoxelBlockHash>* target_volume,
+		VoxelVolume<TVoxelSource, VoxelBlockHash>* source_volume) {
+	if (target_volume->index.SharesBlockLayoutWith(source_volume->index)) return;
+	if (target_volume->index.voxel_block_count != source_volume->index.voxel_block_count ||
+	    target_volume->index.hash_entry_count != source_volume->index.hash_entry_count) {
+		DIEWITHEXCEPTION_REPORTLOCATION("Can only mirror the index of a volume with the same voxel block count and hash table size.");
+	}
+	// has to run while the target hash table still holds the old layout
+	RelocatedBlockVoxelResetFunctor<TVoxelTarget, TMemoryDeviceType> reset_functor(target_volume);
+	HashTableTraversalEngine<TMemoryDeviceType>::TraverseUtilizedWithIndex(source_volume->index, reset_functor);
+	target_volume->index.SetFrom(source_volume->index);
+}
+
+template<MemoryDeviceType TMemoryDeviceType, typename TVoxel>
+void ResetUtilizedVoxels(VoxelVolume<TVoxel, VoxelBlockHash>* volume) {
+	BlockVoxelResetFunctor<TVoxel, TMemoryDeviceType> reset_functor(volume);
+	HashTableTraversalEngine<TMemoryDeviceType>::TraverseUtilizedWithIndex(volume->index, reset_functor);
+}
+
+template<MemoryDeviceType TMemoryDeviceType>
+void BuildBlockNeighborTable(VoxelBlockHash& target_index, const VoxelBlockHash& reference_index) {
+	const int row_count = reference_index.GetUtilizedBlockCount();
+	target_index.ReserveBlockNeighborTable(row_count);
+	BlockNeighborTableFunctor<TMemoryDeviceType> neighbor_table_functor(target_index, reference_index);
+	RawArrayTraversalEngine<TMemoryDeviceType>::TraverseWithIndex(reference_index.GetUtilizedBlockHashCodes(),
+	                                                              neighbor_table_functor, row_count);
+	target_index.SetBlockNeighborTableBuiltFrom(reference_index);
+}
+
 template<MemoryDeviceType TMemoryDeviceType, typename TVoxelTarget, typename TVoxelSource>
 void AllocateUsingOtherVolume_Bounded(
 		VoxelVolume<TVoxelTarget, VoxelBlockHash>* target_volume,
@@ -67,6 +67,40 @@ public:
 
 	_DEVICE_WHEN_AVAILABLE_
 	void operator()(TWarp& warp_voxel, TVoxel& canonical_voxel, TVoxel& live_voxel, const Vector3i& voxel_position) {
+		ComputeEnergyGradient(warp_voxel, canonical_voxel, live_voxel, voxel_position,
+		                      warp_index_data, canonical_index_data, live_index_data);
+	}
+
+	/**
+	 * \brief Neighbor-aware version, for use with ThreeVolumeTraversalEngine::TraverseUtilizedWithNeighborhood.
+	 * Neighbor voxels are looked up through the provided neighborhood views instead of the volume indices.
+	 */
+	template<typename TNeighborhood>
+	_DEVICE_WHEN_AVAILABLE_
+	void operator()(TWarp& warp_voxel, TVoxel& canonical_voxel, TVoxel& live_voxel, const Vector3i& voxel_position,
+	                const TNeighborhood& warp_neighborhood, const TNeighborhood& canonical_neighborhood,
+	                const TNeighborhood& live_neighborhood) {
+		ComputeEnergyGradient(warp_voxel, canonical_voxel, live_voxel, voxel_position,
+		                      &warp_neighborhood, &canonical_neighborhood, &live_neighborhood);
+	}
+
+
+	void PrintStatistics() {
+
+	}
+
+	void SaveStatistics() {
+
+	}
+
+
+private:
+
+	template<typename TIndexData>
+	_DEVICE_WHEN_AVAILABLE_
+	void ComputeEnergyGradient(TWarp& warp_voxel, TVoxel& canonical_voxel, TVoxel& live_voxel, const Vector3i& voxel_position,
+	                           const TIndexData* warp_index_data, const TIndexData* canonical_index_data,
+	                           const TIndexData* live_index_data) {
 
 		if (!VoxelIsConsideredForAlignment(canonical_voxel, live_voxel)) return;
 
@@ -134,18 +168,6 @@ public:
 		warp_voxel.gradient0 = local_energy_gradient;
 	}
 
-
-	void PrintStatistics() {
-
-	}
-
-	void SaveStatistics() {
-
-	}
-
-
-private:
-
 	const float sdf_unity;
 	const int iteration_index;
 
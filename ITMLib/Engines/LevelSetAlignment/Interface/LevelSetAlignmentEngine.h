@@ -15,6 +15,9 @@
 //  ================================================================
 #pragma once
 
+//stdlib
+#include <vector>
+
 //temporary
 #include "LevelSetAlignmentParameters.h"
 #include "LevelSetAlignmentEngineInterface.h"
@@ -26,6 +29,8 @@
 
 namespace ITMLib {
 
+struct TiledGradientSmoothingWorkspace;
+
 
 template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
 class LevelSetAlignmentEngine : public LevelSetAlignmentEngineInterface<TVoxel, TWarp, TIndex> {
@@ -41,12 +46,15 @@ private: // instance variables
 	// needs to be declared after "parameters", derives value from it during initialization
 	const float vector_update_threshold_in_voxels;
 	const bool log_settings = false;
+	// per-thread tile buffers of the fused optimization step, see SmoothGradientAndUpdateWarpsInTiles
+	std::vector<TiledGradientSmoothingWorkspace> tile_workspaces;
 
 public: // instance functions
 
 	LevelSetAlignmentEngine();
 	LevelSetAlignmentEngine(const LevelSetAlignmentSwitches& switches);
 	LevelSetAlignmentEngine(const LevelSetAlignmentSwitches& switches, const LevelSetAlignmentTerminationConditions& termination_conditions);
+	explicit LevelSetAlignmentEngine(const LevelSetAlignmentParameters& parameters);
 	virtual ~LevelSetAlignmentEngine();
 
 
@@ -63,6 +71,10 @@ public: // instance functions
 
 	void ClearOutWarpUpdates(VoxelVolume<TWarp, TIndex>* warp_field) const;
 
+	void WarpVolume_WarpUpdates(VoxelVolume<TWarp, TIndex>* warp_field,
+	                            VoxelVolume<TVoxel, TIndex>* source_volume,
+	                            VoxelVolume<TVoxel, TIndex>* target_volume) override;
+
 protected: // instance functions
 	void ClearOutFramewiseWarps(VoxelVolume<TWarp, TIndex>* warp_field) const;
 	void ClearOutCumulativeWarps(VoxelVolume<TWarp, TIndex>* warp_field) const;
@@ -105,6 +117,29 @@ private: // instance functions
 	                                             VoxelVolume<TWarp, TIndex>* warp_field,
 	                                             float& gradient_length_statistic_in_voxels);
 
+	/**
+	 * \brief Optimization step with the gradient smoothing, the gradient length statistic and the warp update folded into a
+	 * single tiled sweep that follows the energy gradient sweep.
+	 * \details Warping the live volume with the updated warps remains a separate (third) traversal. Produces the same warp
+	 * updates and warped live volume as the unfused step, but leaves the raw, unsmoothed energy gradient in .gradient0 of
+	 * the warp voxels, where the unfused smoothing passes leave the intermediate (X- and Y-smoothed) result.
+	 */
+	void PerformSingleOptimizationStep_Fused(VoxelVolume<TVoxel, TIndex>* canonical_volume,
+	                                         VoxelVolume<TVoxel, TIndex>* source_live_volume,
+	                                         VoxelVolume<TVoxel, TIndex>* target_live_volume,
+	                                         VoxelVolume<TWarp, TIndex>* warp_field,
+	                                         float& gradient_length_statistic_in_voxels);
+
+	template<bool TSmoothGradient>
+	void SmoothGradientAndUpdateWarpsInTiles(VoxelVolume<TVoxel, TIndex>* canonical_volume,
+	                                         VoxelVolume<TVoxel, TIndex>* live_volume,
+	                                         VoxelVolume<TWarp, TIndex>* warp_field,
+	                                         float& gradient_length_statistic_in_voxels);
+
+	void BuildBlockNeighborTables(VoxelVolume<TWarp, TIndex>* warp_field,
+	                              VoxelVolume<TVoxel, TIndex>** live_volume_pair,
+	                              VoxelVolume<TVoxel, TIndex>* canonical_volume);
+
 	template<WarpType TWarpType>
 	void ClearOutWarps(VoxelVolume<TWarp, TIndex>* warp_field) const;
 	void LogSettings();
@@ -35,6 +35,59 @@ using namespace ITMLib;
 
 namespace bench = ITMLib::benchmarking;
 
+namespace ITMLib {
+namespace internal {
+// diagnostic gradient & smoothing passes stick to the volume indices for neighbor look-ups, optimized ones use
+// neighborhood views
+template<ExecutionMode TExecutionMode>
+struct EnergyGradientTraversal;
+
+template<>
+struct EnergyGradientTraversal<DIAGNOSTIC> {
+	template<typename TWarp, typename TVoxel, typename TIndex, MemoryDeviceType TMemoryDeviceType, typename TFunctor>
+	static void Traverse(VoxelVolume<TWarp, TIndex>* warp_field, VoxelVolume<TVoxel, TIndex>* canonical_volume,
+	                     VoxelVolume<TVoxel, TIndex>* live_volume, TFunctor& functor) {
+		ThreeVolumeTraversalEngine<TWarp, TVoxel, TVoxel, TIndex, TMemoryDeviceType>::
+		TraverseUtilizedWithPosition(warp_field, canonical_volume, live_volume, functor);
+	}
+};
+
+template<>
+struct EnergyGradientTraversal<OPTIMIZED> {
+	template<typename TWarp, typename TVoxel, typename TIndex, MemoryDeviceType TMemoryDeviceType, typename TFunctor>
+	static void Traverse(VoxelVolume<TWarp, TIndex>* warp_field, VoxelVolume<TVoxel, TIndex>* canonical_volume,
+	                     VoxelVolume<TVoxel, TIndex>* live_volume, TFunctor& functor) {
+		ThreeVolumeTraversalEngine<TWarp, TVoxel, TVoxel, TIndex, TMemoryDeviceType>::
+		TraverseUtilizedWithNeighborhood(warp_field, canonical_volume, live_volume, functor);
+	}
+};
+
+// tile-wise (block-wise) traversal is only implemented on the CPU, where the fused optimization step relies on caches
+template<MemoryDeviceType TMemoryDeviceType>
+struct TiledTraversal {
+	static constexpr bool available = false;
+
+	template<typename TWarp, typename TVoxel, typename TIndex, typename TFunctor>
+	static void Traverse(VoxelVolume<TWarp, TIndex>* warp_field, VoxelVolume<TVoxel, TIndex>* canonical_volume,
+	                     VoxelVolume<TVoxel, TIndex>* live_volume, TFunctor& functor) {
+		DIEWITHEXCEPTION_REPORTLOCATION("Tile-wise traversal not supported for this device type.");
+	}
+};
+
+template<>
+struct TiledTraversal<MEMORYDEVICE_CPU> {
+	static constexpr bool available = true;
+
+	template<typename TWarp, typename TVoxel, typename TIndex, typename TFunctor>
+	static void Traverse(VoxelVolume<TWarp, TIndex>* warp_field, VoxelVolume<TVoxel, TIndex>* canonical_volume,
+	                     VoxelVolume<TVoxel, TIndex>* live_volume, TFunctor& functor) {
+		ThreeVolumeTraversalEngine<TWarp, TVoxel, TVoxel, TIndex, MEMORYDEVICE_CPU>::
+		TraverseUtilizedBlocksWithNeighborhood(warp_field, canonical_volume, live_volume, functor);
+	}
+};
+} // namespace internal
+} // namespace ITMLib
+
 
 // region ===================================== CONSTRUCTORS / DESTRUCTORS =============================================
 
@@ -52,7 +105,8 @@ LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode
 template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
 LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::LevelSetAlignmentEngine(const LevelSetAlignmentSwitches& switches):
 		LevelSetAlignmentEngineInterface<TVoxel, TWarp, TIndex>(
-				LevelSetAlignmentParameters(LevelSetAlignmentParameters().execution_mode, LevelSetAlignmentWeights(), switches,
+				LevelSetAlignmentParameters(LevelSetAlignmentParameters().execution_mode,
+				                            LevelSetAlignmentParameters().fuse_optimization_step, LevelSetAlignmentWeights(), switches,
 				                            LevelSetAlignmentTerminationConditions(), "")
 		),
 		weights(this->parameters.weights),
@@ -68,7 +122,8 @@ template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMem
 LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::LevelSetAlignmentEngine(
 		const LevelSetAlignmentSwitches& switches, const LevelSetAlignmentTerminationConditions& termination_conditions) :
 		LevelSetAlignmentEngineInterface<TVoxel, TWarp, TIndex>(
-				LevelSetAlignmentParameters(LevelSetAlignmentParameters().execution_mode, LevelSetAlignmentWeights(), switches,
+				LevelSetAlignmentParameters(LevelSetAlignmentParameters().execution_mode,
+				                            LevelSetAlignmentParameters().fuse_optimization_step, LevelSetAlignmentWeights(), switches,
 				                            termination_conditions, "")
 		),
 		weights(this->parameters.weights),
@@ -79,6 +134,18 @@ LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode
 		                                  configuration::Get().general_voxel_volume_parameters.voxel_size),
 		iteration(0) {}
 
+template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
+LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::LevelSetAlignmentEngine(
+		const LevelSetAlignmentParameters& parameters) :
+		LevelSetAlignmentEngineInterface<TVoxel, TWarp, TIndex>(parameters),
+		weights(this->parameters.weights),
+		switches(this->parameters.switches),
+		termination(this->parameters.termination),
+		warping_engine(WarpingEngineFactory::Build<TVoxel, TWarp, TIndex>(TMemoryDeviceType)),
+		vector_update_threshold_in_voxels(termination.update_length_threshold /
+		                                  configuration::Get().general_voxel_volume_parameters.voxel_size),
+		iteration(0) {}
+
 template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
 LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::~LevelSetAlignmentEngine() {
 	delete warping_engine;
@@ -125,6 +192,13 @@ void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutio
 	ClearOutWarps<WARP_UPDATE>(warp_field);
 }
 
+template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
+void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::WarpVolume_WarpUpdates(
+		VoxelVolume<TWarp, TIndex>* warp_field, VoxelVolume<TVoxel, TIndex>* source_volume,
+		VoxelVolume<TVoxel, TIndex>* target_volume) {
+	warping_engine->WarpVolume_WarpUpdates(warp_field, source_volume, target_volume);
+}
+
 // endregion ====================================== LOGGING ============================================================
 
 // region ==================================== MOTION TRACKING LOOP ====================================================
@@ -150,6 +224,12 @@ LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode
 
 	float gradient_length_statistic_in_voxels = std::numeric_limits<float>::infinity();
 
+	// the index stays unchanged throughout the optimization, so block neighbors only need to be resolved once per frame
+	// (diagnostic mode sticks to hash lookups and doesn't need them)
+	if (TExecutionMode == OPTIMIZED) {
+		BuildBlockNeighborTables(warp_field, live_volume_pair, canonical_volume);
+	}
+
 	int source_live_volume_index = 0;
 	int target_live_volume_index = 1;
 	for (iteration = 0;
@@ -180,6 +260,22 @@ LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode
 }
 
 
+template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
+void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::BuildBlockNeighborTables(
+		VoxelVolume<TWarp, TIndex>* warp_field,
+		VoxelVolume<TVoxel, TIndex>** live_volume_pair,
+		VoxelVolume<TVoxel, TIndex>* canonical_volume) {
+	// all tables follow the utilized block list of the warp field, which is the first volume in all traversals
+	BuildBlockNeighborTable(warp_field, warp_field, TMemoryDeviceType);
+	BuildBlockNeighborTable(canonical_volume, warp_field, TMemoryDeviceType);
+	for (int i_live_volume = 0; i_live_volume < 2; i_live_volume++) {
+		// target live volume may be omitted for testing purposes
+		if (live_volume_pair[i_live_volume] != nullptr) {
+			BuildBlockNeighborTable(live_volume_pair[i_live_volume], warp_field, TMemoryDeviceType);
+		}
+	}
+}
+
 template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
 void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::PerformSingleOptimizationStep(
 		VoxelVolume<TVoxel, TIndex>* canonical_volume,
@@ -219,8 +315,8 @@ LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode
 			                           canonical_volume->GetParameters().voxel_size,
 			                           canonical_volume->GetParameters().truncation_distance, this->iteration);
 
-	ThreeVolumeTraversalEngine<TWarp, TVoxel, TVoxel, TIndex, TMemoryDeviceType>::
-	TraverseUtilizedWithPosition(warp_field, canonical_volume, live_volume, calculate_gradient_functor);
+	internal::EnergyGradientTraversal<TExecutionMode>::template Traverse<TWarp, TVoxel, TIndex, TMemoryDeviceType>(
+			warp_field, canonical_volume, live_volume, calculate_gradient_functor);
 
 
 	calculate_gradient_functor.PrintStatistics();
@@ -242,12 +338,12 @@ void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutio
 		GradientSmoothingPassFunctor<TVoxel, TWarp, TIndex, Y> smoothing_pass_functor_Y(warp_field);
 		GradientSmoothingPassFunctor<TVoxel, TWarp, TIndex, Z> smoothing_pass_functor_Z(warp_field);
 
-		ITMLib::ThreeVolumeTraversalEngine<TWarp, TVoxel, TVoxel, TIndex, TMemoryDeviceType>::
-		template TraverseUtilizedWithPosition(warp_field, canonical_volume, live_volume, smoothing_pass_functor_X);
-		ITMLib::ThreeVolumeTraversalEngine<TWarp, TVoxel, TVoxel, TIndex, TMemoryDeviceType>::
-		template TraverseUtilizedWithPosition(warp_field, canonical_volume, live_volume, smoothing_pass_functor_Y);
-		ITMLib::ThreeVolumeTraversalEngine<TWarp, TVoxel, TVoxel, TIndex, TMemoryDeviceType>::
-		template TraverseUtilizedWithPosition(warp_field, canonical_volume, live_volume, smoothing_pass_functor_Z);
+		internal::EnergyGradientTraversal<TExecutionMode>::template Traverse<TWarp, TVoxel, TIndex, TMemoryDeviceType>(
+				warp_field, canonical_volume, live_volume, smoothing_pass_functor_X);
+		internal::EnergyGradientTraversal<TExecutionMode>::template Traverse<TWarp, TVoxel, TIndex, TMemoryDeviceType>(
+				warp_field, canonical_volume, live_volume, smoothing_pass_functor_Y);
+		internal::EnergyGradientTraversal<TExecutionMode>::template Traverse<TWarp, TVoxel, TIndex, TMemoryDeviceType>(
+				warp_field, canonical_volume, live_volume, smoothing_pass_functor_Z);
 	}
 }
 
@@ -362,6 +458,11 @@ void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutio
 		VoxelVolume<TWarp, TIndex>* warp_field,
 		float& gradient_length_statistic_in_voxels) {
 
+	if (this->parameters.fuse_optimization_step && internal::TiledTraversal<TMemoryDeviceType>::available) {
+		PerformSingleOptimizationStep_Fused(canonical_volume, source_live_volume, target_live_volume, warp_field,
+		                                    gradient_length_statistic_in_voxels);
+		return;
+	}
 	CalculateEnergyGradient(warp_field, canonical_volume, source_live_volume);
 	SmoothEnergyGradient(warp_field, canonical_volume, source_live_volume);
 	UpdateGradientLengthStatistic(gradient_length_statistic_in_voxels, warp_field);
@@ -369,6 +470,64 @@ void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutio
 	warping_engine->WarpVolume_WarpUpdates(warp_field, source_live_volume, target_live_volume);
 }
 
+template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
+void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::PerformSingleOptimizationStep_Fused(
+		VoxelVolume<TVoxel, TIndex>* canonical_volume,
+		VoxelVolume<TVoxel, TIndex>* source_live_volume,
+		VoxelVolume<TVoxel, TIndex>* target_live_volume,
+		VoxelVolume<TWarp, TIndex>* warp_field,
+		float& gradient_length_statistic_in_voxels) {
+	// sweep 1: energy gradient, with clearing out of the previous iteration's gradients folded in
+	typedef WarpGradientFunctor<TVoxel, TWarp, TIndex, TMemoryDeviceType, OPTIMIZED> GradientFunctorType;
+	GradientFunctorType calculate_gradient_functor(this->weights, this->switches, warp_field, canonical_volume, source_live_volume,
+	                                               canonical_volume->GetParameters().voxel_size,
+	                                               canonical_volume->GetParameters().truncation_distance, this->iteration);
+	GradientClearingFunctor<TVoxel, TWarp, GradientFunctorType> clear_and_calculate_gradient_functor(calculate_gradient_functor);
+	ThreeVolumeTraversalEngine<TWarp, TVoxel, TVoxel, TIndex, TMemoryDeviceType>::
+	TraverseUtilizedWithNeighborhood(warp_field, canonical_volume, source_live_volume, clear_and_calculate_gradient_functor);
+
+	// sweep 2: gradient smoothing, gradient length statistic, and warp update, in cache-sized tiles
+	if (this->switches.enable_Sobolev_gradient_smoothing) {
+		SmoothGradientAndUpdateWarpsInTiles<true>(canonical_volume, source_live_volume, warp_field,
+		                                          gradient_length_statistic_in_voxels);
+	} else {
+		SmoothGradientAndUpdateWarpsInTiles<false>(canonical_volume, source_live_volume, warp_field,
+		                                           gradient_length_statistic_in_voxels);
+	}
+
+	warping_engine->WarpVolume_WarpUpdates(warp_field, source_live_volume, target_live_volume);
+}
+
+template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
+template<bool TSmoothGradient>
+void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::SmoothGradientAndUpdateWarpsInTiles(
+		VoxelVolume<TVoxel, TIndex>* canonical_volume,
+		VoxelVolume<TVoxel, TIndex>* live_volume,
+		VoxelVolume<TWarp, TIndex>* warp_field,
+		float& gradient_length_statistic_in_voxels) {
+#if defined(WITH_OPENMP) && !defined(__CUDACC__)
+	const int thread_count = omp_get_max_threads();
+#else
+	const int thread_count = 1;
+#endif
+	if (static_cast<int>(tile_workspaces.size()) < thread_count) {
+		tile_workspaces.resize(thread_count);
+	}
+	TiledGradientSmoothingAndWarpUpdateFunctor<TVoxel, TWarp, TIndex, TMemoryDeviceType, TSmoothGradient>
+			tile_functor(warp_field, canonical_volume, live_volume, this->weights.learning_rate, tile_workspaces);
+	internal::TiledTraversal<TMemoryDeviceType>::Traverse(warp_field, canonical_volume, live_volume, tile_functor);
+	switch (this->termination.warp_length_termination_threshold_type) {
+		case AVERAGE:
+			gradient_length_statistic_in_voxels = tile_functor.GetAverageGradientLength();
+			break;
+		case MAXIMUM:
+			gradient_length_statistic_in_voxels = tile_functor.GetMaximumGradientLength();
+			break;
+		default:
+			DIEWITHEXCEPTION_REPORTLOCATION("Unsupported warp termination threshold type, aborting.");
+	}
+}
+
 template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, ExecutionMode TExecutionMode>
 void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutionMode>::UpdateGradientLengthStatistic(
 		float& gradient_length_statistic_in_voxels, VoxelVolume<TWarp, TIndex>* warp_field) {
@@ -423,7 +582,7 @@ void LevelSetAlignmentEngine<TVoxel, TWarp, TIndex, TMemoryDeviceType, TExecutio
 		final_sum_and_count = VolumeReductionEngine<TWarp, TIndex, TMemoryDeviceType>::
 		template ReduceUtilized<ReduceFunctorType, RetrieveFunctorType>(position, warp_field, ignored_value);
 	}
-	average_warp_length = final_sum_and_count.sum / final_sum_and_count.count;
+	average_warp_length = final_sum_and_count.count == 0u ? 0.0f : final_sum_and_count.sum / final_sum_and_count.count;
 }
 
 
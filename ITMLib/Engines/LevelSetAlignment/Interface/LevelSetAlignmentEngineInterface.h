@@ -74,6 +74,15 @@ public:
 	 */
 	virtual void ClearOutWarpUpdates(VoxelVolume<TWarp, TIndex>* warp_field) const = 0;
 
+	/**
+	 * \brief Warp the source volume into the target volume using the warp updates currently stored in warp_field,
+	 * with the same warping engine the alignment itself uses.
+	 * \details Used to apply warps carried over from the previous frame before a warm-started Align.
+	 */
+	virtual void WarpVolume_WarpUpdates(VoxelVolume<TWarp, TIndex>* warp_field,
+	                                    VoxelVolume<TVoxel, TIndex>* source_volume,
+	                                    VoxelVolume<TVoxel, TIndex>* target_volume) = 0;
+
 };
 
 
@@ -74,6 +74,10 @@ DECLARE_SERIALIZABLE_STRUCT(TERMINATION_CONDITIONS_STRUCT_DESCRIPTION);
 
 #define LEVEL_SET_EVOLUTION_PARAMETERS_STRUCT_DESCRIPTION LevelSetAlignmentParameters, "level_set_evolution", \
     (ExecutionMode, execution_mode, ExecutionMode::OPTIMIZED, ENUM, "Whether to use optimized or diagnostic mode."), \
+    (bool, fuse_optimization_step, false, PRIMITIVE, "(Optimized mode, CPU only) Fuse each optimization step into two sweeps over " \
+            "the volumes: one for the energy gradient, and one that does gradient smoothing, warp update and the gradient " \
+            "length statistic in cache-sized tiles of voxels. Warping the live volume remains a separate pass, and the warp " \
+            "voxels keep the raw (unsmoothed) energy gradient in .gradient0."), \
     (LevelSetAlignmentWeights, weights, LevelSetAlignmentWeights(), STRUCT, "Level set evolution weights / rates / factors"), \
     (LevelSetAlignmentSwitches, switches, LevelSetAlignmentSwitches(), STRUCT, "Level set evolution switches for turning different terms on and off."), \
     (LevelSetAlignmentTerminationConditions, termination, LevelSetAlignmentTerminationConditions(), STRUCT, "Level set evolution termination parameters.") \
@@ -15,6 +15,10 @@
 //  ================================================================
 #pragma once
 
+//stdlib
+#include <vector>
+
+//local
 #include "../../../Utils/Math.h"
 #include "../../../Objects/Volume/VoxelVolume.h"
 #include "../../../Utils/Configuration/Configuration.h"
@@ -27,6 +31,11 @@
 
 #ifdef __CUDACC__
 #include "../../../Utils/CUDA/CUDAUtils.h"
+#else
+#include "../../Common/VoxelBlockKernels_CPU.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 #endif
 
 
@@ -36,6 +45,14 @@ struct ClearOutWarpStaticFunctor {
 	static inline void run(TWarpVoxel& voxel) {
 		WarpAccessStaticFunctor<TWarpVoxel, TWarpType>::SetWarp(voxel, Vector3f(0.0f));
 	}
+#ifndef __CUDACC__
+	// block kernel for the CPU traversal engines, only available for voxel types that have the warp field
+	template<typename TVoxel = TWarpVoxel>
+	static inline auto ProcessBlock(TWarpVoxel* voxels, const int voxel_count) -> decltype(WarpField<TVoxel, TWarpType>::Get(), void()) {
+		static const Vector3fFieldKernel<TWarpVoxel> warp_field_kernel(WarpField<TVoxel, TWarpType>::Get());
+		warp_field_kernel.Clear(voxels, voxel_count);
+	}
+#endif
 };
 
 template<typename TWarpVoxel>
@@ -64,6 +81,19 @@ struct WarpUpdateFunctor {
 		}
 	}
 
+#ifndef __CUDACC__
+	// block kernel for the CPU traversal engines
+	void ProcessBlock(TWarp* warp_voxels, const TVoxel* canonical_voxels, const TVoxel* live_voxels, const int voxel_count) {
+		static const Vector3fFieldKernel<TWarp> warp_update_kernel(&TWarp::warp_update,
+		                                                           TUseGradient1 ? &TWarp::gradient1 : &TWarp::gradient0);
+		bool considered[VOXEL_BLOCK_SIZE3];
+		for (int i_voxel = 0; i_voxel < voxel_count; i_voxel++) {
+			considered[i_voxel] = VoxelIsConsideredForAlignment(canonical_voxels[i_voxel], live_voxels[i_voxel]);
+		}
+		warp_update_kernel.SubtractScaled(warp_voxels, voxel_count, learning_rate, considered);
+	}
+#endif
+
 
 private:
 	const float learning_rate;
@@ -74,6 +104,20 @@ enum TraversalDirection : int {
 	X = 0, Y = 1, Z = 2
 };
 
+// 1D kernel of the separable Sobolev gradient smoothing filter
+struct SobolevFilter1D {
+	static constexpr int size = 7;
+	float coefficients[size] = {
+			2.995861099047703036e-04f,
+			4.410932423926419363e-03f,
+			6.571314272194948847e-02f,
+			9.956527876693953560e-01f,
+			6.571314272194946071e-02f,
+			4.410932423926422832e-03f,
+			2.995861099045313996e-04f
+	};
+};
+
 template<typename TVoxel, typename TWarp, typename TIndex, TraversalDirection TDirection>
 struct GradientSmoothingPassFunctor {
 	GradientSmoothingPassFunctor(ITMLib::VoxelVolume<TWarp, TIndex>* warp_field) :
@@ -85,16 +129,29 @@ struct GradientSmoothingPassFunctor {
 	_CPU_AND_GPU_CODE_
 	void
 	operator()(TWarp& warp_voxel, TVoxel& canonical_voxel, TVoxel& live_voxel, Vector3i voxel_position) {
-		const int sobolev_filter_size = 7;
-		const float sobolev_filter1D[sobolev_filter_size] = {
-				2.995861099047703036e-04f,
-				4.410932423926419363e-03f,
-				6.571314272194948847e-02f,
-				9.956527876693953560e-01f,
-				6.571314272194946071e-02f,
-				4.410932423926422832e-03f,
-				2.995861099045313996e-04f
-		};
+		SmoothGradient(warp_voxel, canonical_voxel, live_voxel, voxel_position, warp_index_data);
+	}
+
+	/**
+	 * \brief Neighbor-aware version, for use with ThreeVolumeTraversalEngine::TraverseUtilizedWithNeighborhood.
+	 * The filter taps are looked up through the warp neighborhood view instead of the warp volume index.
+	 */
+	template<typename TNeighborhood>
+	_CPU_AND_GPU_CODE_
+	void
+	operator()(TWarp& warp_voxel, TVoxel& canonical_voxel, TVoxel& live_voxel, const Vector3i& voxel_position,
+	           const TNeighborhood& warp_neighborhood, const TNeighborhood& canonical_neighborhood,
+	           const TNeighborhood& live_neighborhood) {
+		SmoothGradient(warp_voxel, canonical_voxel, live_voxel, voxel_position, &warp_neighborhood);
+	}
+
+private:
+	template<typename TIndexData>
+	_CPU_AND_GPU_CODE_
+	void SmoothGradient(TWarp& warp_voxel, TVoxel& canonical_voxel, TVoxel& live_voxel, const Vector3i& voxel_position,
+	                    const TIndexData* warp_index_data) {
+		const SobolevFilter1D sobolev_filter{};
+		const int sobolev_filter_size = SobolevFilter1D::size;
 
 		int vmIndex = 0;
 		if (!VoxelIsConsideredForAlignment(canonical_voxel, live_voxel)) return;
@@ -111,12 +168,11 @@ struct GradientSmoothingPassFunctor {
 #else
 			const TWarp& destination_voxel = readVoxel(warp_voxels, warp_index_data, receptive_voxel_position, vmIndex);
 #endif
-			smoothed_gradient += sobolev_filter1D[iVoxel] * GetGradient(destination_voxel);
+			smoothed_gradient += sobolev_filter.coefficients[iVoxel] * GetGradient(destination_voxel);
 		}
 		SetGradient(warp_voxel, smoothed_gradient);
 	}
 
-private:
 	_CPU_AND_GPU_CODE_
 	static inline Vector3f GetGradient(const TWarp& warp_voxel) {
 		switch (TDirection) {
@@ -153,6 +209,245 @@ private:
 
 };
 
+/**
+ * \brief Wraps a neighbor-aware energy gradient functor, clearing out both gradient fields of each warp voxel right before
+ * the gradient computation, so that no separate clearing traversal is necessary.
+ */
+template<typename TVoxel, typename TWarp, typename TGradientFunctor>
+struct GradientClearingFunctor {
+	explicit GradientClearingFunctor(TGradientFunctor& gradient_functor) : gradient_functor(gradient_functor) {}
+
+	template<typename TNeighborhood>
+	_DEVICE_WHEN_AVAILABLE_
+	void operator()(TWarp& warp_voxel, TVoxel& canonical_voxel, TVoxel& live_voxel, const Vector3i& voxel_position,
+	                const TNeighborhood& warp_neighborhood, const TNeighborhood& canonical_neighborhood,
+	                const TNeighborhood& live_neighborhood) {
+		warp_voxel.gradient0 = Vector3f(0.0f);
+		warp_voxel.gradient1 = Vector3f(0.0f);
+		gradient_functor(warp_voxel, canonical_voxel, live_voxel, voxel_position,
+		                 warp_neighborhood, canonical_neighborhood, live_neighborhood);
+	}
+
+private:
+	TGradientFunctor& gradient_functor;
+};
+
+namespace ITMLib {
+
+/**
+ * \brief Scratch space and partial statistics of a single thread running TiledGradientSmoothingAndWarpUpdateFunctor.
+ * \details Too large for worker thread stacks, so the engine keeps one per thread and reuses them across iterations.
+ * Arrays are sized for the largest tile (with halo), smaller tiles only use the leading part of each dimension.
+ */
+struct TiledGradientSmoothingWorkspace {
+	static constexpr int max_tile_size = VOXEL_BLOCK_SIZE + 2 * (SobolevFilter1D::size / 2);
+
+	Vector3f raw_gradients[max_tile_size][max_tile_size][max_tile_size];
+	bool considered[max_tile_size][max_tile_size][max_tile_size];
+	Vector3f x_smoothed_gradients[max_tile_size][max_tile_size][VOXEL_BLOCK_SIZE];
+	Vector3f xy_smoothed_gradients[max_tile_size][VOXEL_BLOCK_SIZE][VOXEL_BLOCK_SIZE];
+	Vector3f gradients[VOXEL_BLOCK_SIZE][VOXEL_BLOCK_SIZE][VOXEL_BLOCK_SIZE];
+
+	float maximum_gradient_length;
+	float gradient_length_sum;
+	unsigned int non_zero_gradient_count;
+};
+
+} // namespace ITMLib
+
+/**
+ * \brief Performs everything in an optimization step that follows the energy gradient computation, i.e. the Sobolev
+ * gradient smoothing (optional), the warp update, and the gradient length statistics, on one tile of
+ * VOXEL_BLOCK_SIZE^3 voxels at a time. For use with ThreeVolumeTraversalEngine::TraverseUtilizedBlocksWithNeighborhood.
+ * \details Raw gradients (.gradient0) of the tile and of a halo of half the filter size around it are read from the
+ * warp field only once; the three separable smoothing passes are then run on per-thread buffers, which stay in cache.
+ * The resulting gradients and warp updates match those of three GradientSmoothingPassFunctor traversals followed by a
+ * WarpUpdateFunctor traversal, with one exception: since neighboring tiles may be reading the raw gradients
+ * concurrently, .gradient0 is left as is, whereas the separate passes would leave the intermediate result there.
+ * Requires .gradient1 to be cleared out beforehand, e.g. by GradientClearingFunctor.
+ */
+template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType, bool TSmoothGradient>
+struct TiledGradientSmoothingAndWarpUpdateFunctor {
+private: // static constants
+	static constexpr int halo_width = TSmoothGradient ? SobolevFilter1D::size / 2 : 0;
+	static constexpr int tile_size = VOXEL_BLOCK_SIZE + 2 * halo_width;
+	static constexpr int max_tile_size = ITMLib::TiledGradientSmoothingWorkspace::max_tile_size;
+public: // instance functions
+	/**
+	 * \param workspaces one workspace per thread that may run the functor. Statistics are gathered per thread and merged in
+	 * thread order, which keeps them reproducible as long as tiles are assigned to threads deterministically (i.e. with a
+	 * static schedule).
+	 */
+	TiledGradientSmoothingAndWarpUpdateFunctor(ITMLib::VoxelVolume<TWarp, TIndex>* warp_field,
+	                                           ITMLib::VoxelVolume<TVoxel, TIndex>* canonical_volume,
+	                                           ITMLib::VoxelVolume<TVoxel, TIndex>* live_volume,
+	                                           float learning_rate,
+	                                           std::vector<ITMLib::TiledGradientSmoothingWorkspace>& workspaces) :
+			warp_voxels(warp_field->GetVoxels()),
+			canonical_voxels(canonical_volume->GetVoxels()),
+			live_voxels(live_volume->GetVoxels()),
+			learning_rate(learning_rate),
+			workspaces(workspaces) {
+		for (ITMLib::TiledGradientSmoothingWorkspace& workspace : workspaces) {
+			workspace.maximum_gradient_length = 0.0f;
+			workspace.gradient_length_sum = 0.0f;
+			workspace.non_zero_gradient_count = 0u;
+		}
+	}
+
+	template<typename TNeighborhood>
+	void operator()(const Vector3i& tile_origin, const TNeighborhood& warp_neighborhood,
+	                const TNeighborhood& canonical_neighborhood, const TNeighborhood& live_neighborhood) {
+#if defined(WITH_OPENMP) && !defined(__CUDACC__)
+		ITMLib::TiledGradientSmoothingWorkspace& workspace = workspaces[omp_get_thread_num()];
+#else
+		ITMLib::TiledGradientSmoothingWorkspace& workspace = workspaces[0];
+#endif
+		// ==== gather raw gradients & alignment eligibility of all voxels in the tile, including its halo
+		Vector3f (& raw_gradients)[max_tile_size][max_tile_size][max_tile_size] = workspace.raw_gradients;
+		bool (& considered)[max_tile_size][max_tile_size][max_tile_size] = workspace.considered;
+		int vm_index = 0;
+		for (int z = 0; z < tile_size; z++) {
+			for (int y = 0; y < tile_size; y++) {
+				for (int x = 0; x < tile_size; x++) {
+					const Vector3i position = tile_origin + Vector3i(x - halo_width, y - halo_width, z - halo_width);
+					const TVoxel canonical_voxel = readVoxel(canonical_voxels, &canonical_neighborhood, position, vm_index);
+					const TVoxel live_voxel = readVoxel(live_voxels, &live_neighborhood, position, vm_index);
+					considered[z][y][x] = VoxelIsConsideredForAlignment(canonical_voxel, live_voxel);
+					raw_gradients[z][y][x] = considered[z][y][x] ?
+					                         readVoxel(warp_voxels, &warp_neighborhood, position, vm_index).gradient0 :
+					                         Vector3f(0.0f);
+				}
+			}
+		}
+
+		// ==== smooth (or not), update warps & collect statistics for the voxels of the tile proper
+		Vector3f (& gradients)[VOXEL_BLOCK_SIZE][VOXEL_BLOCK_SIZE][VOXEL_BLOCK_SIZE] = workspace.gradients;
+		ComputeFinalGradients(workspace);
+
+		float tile_maximum_gradient_length = 0.0f;
+		float tile_gradient_length_sum = 0.0f;
+		unsigned int tile_non_zero_gradient_count = 0u;
+		for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
+			for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+				for (int x = 0; x < VOXEL_BLOCK_SIZE; x++) {
+					if (!considered[z + halo_width][y + halo_width][x + halo_width]) continue;
+					const int warp_voxel_index = findVoxel(&warp_neighborhood, tile_origin + Vector3i(x, y, z), vm_index);
+					if (!vm_index) continue;
+					TWarp& warp_voxel = warp_voxels[warp_voxel_index];
+					const Vector3f& gradient = gradients[z][y][x];
+					if (TSmoothGradient) {
+						warp_voxel.gradient1 = gradient;
+					}
+					warp_voxel.warp_update = warp_voxel.warp_update - learning_rate * gradient;
+
+					const float gradient_length = ORUtils::length(gradient);
+					if (gradient_length > tile_maximum_gradient_length) {
+						tile_maximum_gradient_length = gradient_length;
+					}
+					if (gradient_length != 0.0f) {
+						tile_gradient_length_sum += gradient_length;
+						tile_non_zero_gradient_count++;
+					}
+				}
+			}
+		}
+		if (tile_maximum_gradient_length > workspace.maximum_gradient_length) {
+			workspace.maximum_gradient_length = tile_maximum_gradient_length;
+		}
+		workspace.gradient_length_sum += tile_gradient_length_sum;
+		workspace.non_zero_gradient_count += tile_non_zero_gradient_count;
+	}
+
+	float GetMaximumGradientLength() const {
+		float maximum_gradient_length = 0.0f;
+		for (const ITMLib::TiledGradientSmoothingWorkspace& workspace : workspaces) {
+			if (workspace.maximum_gradient_length > maximum_gradient_length) {
+				maximum_gradient_length = workspace.maximum_gradient_length;
+			}
+		}
+		return maximum_gradient_length;
+	}
+
+	float GetAverageGradientLength() const {
+		float gradient_length_sum = 0.0f;
+		unsigned int non_zero_gradient_count = 0u;
+		for (const ITMLib::TiledGradientSmoothingWorkspace& workspace : workspaces) {
+			gradient_length_sum += workspace.gradient_length_sum;
+			non_zero_gradient_count += workspace.non_zero_gradient_count;
+		}
+		return non_zero_gradient_count == 0u ? 0.0f : gradient_length_sum / non_zero_gradient_count;
+	}
+
+private: // instance functions
+	void ComputeFinalGradients(ITMLib::TiledGradientSmoothingWorkspace& workspace) {
+		Vector3f (& gradients)[VOXEL_BLOCK_SIZE][VOXEL_BLOCK_SIZE][VOXEL_BLOCK_SIZE] = workspace.gradients;
+		const Vector3f (& raw_gradients)[max_tile_size][max_tile_size][max_tile_size] = workspace.raw_gradients;
+		const bool (& considered)[max_tile_size][max_tile_size][max_tile_size] = workspace.considered;
+		if (!TSmoothGradient) {
+			for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
+				for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+					for (int x = 0; x < VOXEL_BLOCK_SIZE; x++) {
+						gradients[z][y][x] = raw_gradients[z][y][x];
+					}
+				}
+			}
+			return;
+		}
+		// Each pass only covers the region needed by the next one. Results for voxels not considered for alignment are zero,
+		// same as with the separate passes, where the voxels retain their (cleared-out) gradients.
+		const SobolevFilter1D sobolev_filter{};
+		Vector3f (& x_smoothed_gradients)[max_tile_size][max_tile_size][VOXEL_BLOCK_SIZE] = workspace.x_smoothed_gradients;
+		for (int z = 0; z < tile_size; z++) {
+			for (int y = 0; y < tile_size; y++) {
+				for (int x = 0; x < VOXEL_BLOCK_SIZE; x++) {
+					Vector3f smoothed_gradient(0.0f);
+					if (considered[z][y][x + halo_width]) {
+						for (int i_tap = 0; i_tap < SobolevFilter1D::size; i_tap++) {
+							smoothed_gradient += sobolev_filter.coefficients[i_tap] * raw_gradients[z][y][x + i_tap];
+						}
+					}
+					x_smoothed_gradients[z][y][x] = smoothed_gradient;
+				}
+			}
+		}
+		Vector3f (& xy_smoothed_gradients)[max_tile_size][VOXEL_BLOCK_SIZE][VOXEL_BLOCK_SIZE] = workspace.xy_smoothed_gradients;
+		for (int z = 0; z < tile_size; z++) {
+			for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+				for (int x = 0; x < VOXEL_BLOCK_SIZE; x++) {
+					Vector3f smoothed_gradient(0.0f);
+					if (considered[z][y + halo_width][x + halo_width]) {
+						for (int i_tap = 0; i_tap < SobolevFilter1D::size; i_tap++) {
+							smoothed_gradient += sobolev_filter.coefficients[i_tap] * x_smoothed_gradients[z][y + i_tap][x];
+						}
+					}
+					xy_smoothed_gradients[z][y][x] = smoothed_gradient;
+				}
+			}
+		}
+		for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
+			for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+				for (int x = 0; x < VOXEL_BLOCK_SIZE; x++) {
+					Vector3f smoothed_gradient(0.0f);
+					if (considered[z + halo_width][y + halo_width][x + halo_width]) {
+						for (int i_tap = 0; i_tap < SobolevFilter1D::size; i_tap++) {
+							smoothed_gradient += sobolev_filter.coefficients[i_tap] * xy_smoothed_gradients[z + i_tap][y][x];
+						}
+					}
+					gradients[z][y][x] = smoothed_gradient;
+				}
+			}
+		}
+	}
+
+private: // instance variables
+	TWarp* warp_voxels;
+	const TVoxel* canonical_voxels;
+	const TVoxel* live_voxels;
+	const float learning_rate;
+	std::vector<ITMLib::TiledGradientSmoothingWorkspace>& workspaces;
+};
+
 template<typename TWarp, bool hasCumulativeWarp>
 struct AddFramewiseWarpToWarpWithClearStaticFunctor;
 
@@ -163,6 +458,14 @@ struct AddFramewiseWarpToWarpWithClearStaticFunctor<TWarp, true> {
 		warp.warp += warp.framewise_warp;
 		warp.framewise_warp = Vector3f(0.0f);
 	}
+#ifndef __CUDACC__
+	static inline void ProcessBlock(TWarp* voxels, const int voxel_count) {
+		static const Vector3fFieldKernel<TWarp> warp_kernel(&TWarp::warp, &TWarp::framewise_warp);
+		static const Vector3fFieldKernel<TWarp> framewise_warp_kernel(&TWarp::framewise_warp);
+		warp_kernel.Add(voxels, voxel_count);
+		framewise_warp_kernel.Clear(voxels, voxel_count);
+	}
+#endif
 };
 
 template<typename TWarp>
@@ -170,6 +473,9 @@ struct AddFramewiseWarpToWarpWithClearStaticFunctor<TWarp, false> {
 	_CPU_AND_GPU_CODE_
 	static inline void run(TWarp& warp) {
 	}
+#ifndef __CUDACC__
+	static inline void ProcessBlock(TWarp* voxels, const int voxel_count) {}
+#endif
 };
 template<typename TWarpVoxel, bool THasCumulativeWarp>
 struct AddFramewiseWarpToWarpStaticFunctor;
@@ -180,6 +486,12 @@ struct AddFramewiseWarpToWarpStaticFunctor<TWarp, true> {
 	static inline void run(TWarp& warp) {
 		warp.warp += warp.framewise_warp;
 	}
+#ifndef __CUDACC__
+	static inline void ProcessBlock(TWarp* voxels, const int voxel_count) {
+		static const Vector3fFieldKernel<TWarp> warp_kernel(&TWarp::warp, &TWarp::framewise_warp);
+		warp_kernel.Add(voxels, voxel_count);
+	}
+#endif
 };
 
 template<typename TWarp>
@@ -187,4 +499,7 @@ struct AddFramewiseWarpToWarpStaticFunctor<TWarp, false> {
 	_CPU_AND_GPU_CODE_
 	static inline void run(TWarp& voxel) {
 	}
+#ifndef __CUDACC__
+	static inline void ProcessBlock(TWarp* voxels, const int voxel_count) {}
+#endif
 };
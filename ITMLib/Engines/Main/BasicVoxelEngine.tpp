@@ -97,7 +97,7 @@ template <typename TVoxel, typename TIndex>
 void BasicVoxelEngine<TVoxel,TIndex>::SaveVolumeToMesh(const std::string& path)
 {
 	if (meshing_engine == nullptr) return;
-	Mesh mesh = meshing_engine->MeshVolume(volume);
+	Mesh mesh = meshing_engine->MeshVolumeIndexed(volume);
 	mesh.WritePLY(path);
 }
 
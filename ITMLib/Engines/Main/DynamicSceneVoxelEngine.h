@@ -21,6 +21,7 @@
 //local
 #include "FusionAlgorithm.h"
 #include "CameraTrackingController.h"
+#include "PreparedViewBuffer.h"
 #include "../ImageProcessing/Interface/ImageProcessingEngineInterface.h"
 #include "../Meshing/Interface/MeshingEngine.h"
 #include "../ViewBuilder/Interface/ViewBuilder.h"
@@ -81,6 +82,8 @@ private: // instance variables
 
 	/// The current input frame data
 	View* view;
+	/// Input frame data preprocessed ahead of time (for pipelined processing)
+	PreparedViewBuffer prepared_views;
 
 	/// Current camera pose and additional tracking information
 	CameraTrackingState* tracking_state;
@@ -98,6 +101,9 @@ public: // instance functions
 
 	CameraTrackingState::TrackingResult ProcessFrame(UChar4Image* rgb_image, ShortImage* depth_image,
 	                                                 IMUMeasurement* imu_measurement = nullptr) override;
+	bool CanPrepareFrames() const override { return true; }
+	void PrepareFrame(UChar4Image* rgb_image, ShortImage* depth_image, IMUMeasurement* imu_measurement = nullptr) override;
+	CameraTrackingState::TrackingResult ProcessPreparedFrame() override;
 
 	/// Extracts a mesh from the current volume and saves it to the disk at the specified path
 	void SaveVolumeToMesh(const std::string& path) override;
@@ -128,9 +134,32 @@ public: // instance functions
 
 	virtual bool GetMainProcessingOn() const override;
 
+private: // member types
+	/// How a volume that follows the allocation of live_volumes[0] (i.e. live_volumes[1] or the warp field) is updated
+	enum FollowerVolumeAllocation {
+		/// discard all blocks, then allocate the blocks of the live volume
+		FOLLOWER_RESET_AND_ALLOCATE,
+		/// discard all blocks, then copy the index of the live volume
+		FOLLOWER_RESET_AND_MIRROR,
+		/// free blocks the live volume no longer has, allocate blocks it gained, then clear all voxels
+		FOLLOWER_REALLOCATE_AND_CLEAR,
+		/// copy the index of the live volume, then clear all voxels
+		FOLLOWER_MIRROR_AND_CLEAR,
+		/// free blocks the live volume no longer has, allocate blocks it gained, keep voxels in the remaining blocks
+		FOLLOWER_REALLOCATE_KEEPING_VOXELS
+	};
+
 private: // instance functions
 	void Reset();
+	/// Allocate live_volumes[0] for the current view, then all volumes that follow its allocation
+	void AllocateLiveVolumes();
+	FollowerVolumeAllocation ChooseFollowerVolumeAllocation(bool keep_voxels) const;
+	template<typename TFollowerVoxel>
+	void AllocateFollowerVolume(VoxelVolume<TFollowerVoxel, TIndex>* follower_volume, FollowerVolumeAllocation allocation);
 	void InitializeScenes();
+	void BuildView(View** view_to_build, UChar4Image* rgb_image, ShortImage* depth_image, IMUMeasurement* imu_measurement);
+	/// Run alignment & fusion (and everything in between) on the current view
+	CameraTrackingState::TrackingResult ProcessCurrentView();
 	//TODO: move to SwappingEngine itself.
 	void ProcessSwapping(RenderState* render_state);
 	void HandlePotentialCameraTrackingFailure();
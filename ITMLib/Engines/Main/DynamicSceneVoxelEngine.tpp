@@ -192,11 +192,11 @@ template<typename TVoxel, typename TWarp, typename TIndex>
 void DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::SaveVolumeToMesh(const std::string& path) {
 	if (meshing_engine == nullptr) return;
 	{
-		Mesh mesh = meshing_engine->MeshVolume(canonical_volume);
+		Mesh mesh = meshing_engine->MeshVolumeIndexed(canonical_volume);
 		mesh.WritePLY(path);
 	}
 	if (target_warped_live_volume != nullptr) {
-		Mesh mesh = meshing_engine->MeshVolume(target_warped_live_volume);
+		Mesh mesh = meshing_engine->MeshVolumeIndexed(target_warped_live_volume);
 		fs::path p(path);
 		mesh.WritePLY((p.parent_path() / "live_mesh.ply").string());
 	}
@@ -286,15 +286,93 @@ CameraTrackingState::TrackingResult
 DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::ProcessFrame(UChar4Image* rgb_image,
                                                              ShortImage* depth_image,
                                                              IMUMeasurement* imu_measurement) {
+	BuildView(&view, rgb_image, depth_image, imu_measurement);
+	return ProcessCurrentView();
+}
+
+template<typename TVoxel, typename TWarp, typename TIndex>
+void DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::PrepareFrame(UChar4Image* rgb_image, ShortImage* depth_image,
+                                                                  IMUMeasurement* imu_measurement) {
+	BuildView(prepared_views.NextViewToPrepare(), rgb_image, depth_image, imu_measurement);
+}
+
+template<typename TVoxel, typename TWarp, typename TIndex>
+CameraTrackingState::TrackingResult DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::ProcessPreparedFrame() {
+	prepared_views.SwapInPreparedView(view, config.device_type);
+	return ProcessCurrentView();
+}
+
+template<typename TVoxel, typename TWarp, typename TIndex>
+void DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::BuildView(View** view_to_build, UChar4Image* rgb_image,
+                                                               ShortImage* depth_image, IMUMeasurement* imu_measurement) {
 	// prepare images & IMU measurements and turn them into a "view"
 	if (imu_measurement == nullptr) {
-		view_builder->UpdateView(&view, rgb_image, depth_image, config.use_threshold_filter,
+		view_builder->UpdateView(view_to_build, rgb_image, depth_image, config.use_threshold_filter,
 		                         config.use_bilateral_filter, false, true);
 	} else {
-		view_builder->UpdateView(&view, rgb_image, depth_image, config.use_threshold_filter,
+		view_builder->UpdateView(view_to_build, rgb_image, depth_image, config.use_threshold_filter,
 		                         config.use_bilateral_filter, imu_measurement, false, true);
 	}
+}
 
+template<typename TVoxel, typename TWarp, typename TIndex>
+void DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::AllocateLiveVolumes() {
+	if (this->parameters.incremental_live_volume_allocation) {
+		// keep blocks that are still needed, only allocate / deallocate the difference from the previous frame
+		indexing_engine->UpdateAllocationNearAndBetweenTwoSurfaces(live_volumes[0], view, tracking_state);
+		ResetUtilizedVoxels(live_volumes[0], this->config.device_type);
+	} else {
+		live_volumes[0]->Reset();
+		indexing_engine->AllocateNearAndBetweenTwoSurfaces(live_volumes[0], view, tracking_state);
+	}
+	AllocateFollowerVolume(live_volumes[1], ChooseFollowerVolumeAllocation(false));
+	AllocateFollowerVolume(warp_field, ChooseFollowerVolumeAllocation(this->parameters.warm_start_non_rigid_alignment));
+}
+
+template<typename TVoxel, typename TWarp, typename TIndex>
+typename DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::FollowerVolumeAllocation
+DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::ChooseFollowerVolumeAllocation(bool keep_voxels) const {
+	// mirroring clears the voxels of blocks that move to a different storage offset, so a volume whose voxels are
+	// carried over to the next frame (i.e. the warp field when warm-starting) keeps its own block storage
+	if (keep_voxels) return FOLLOWER_REALLOCATE_KEEPING_VOXELS;
+	if (this->parameters.incremental_live_volume_allocation) {
+		return this->parameters.mirror_live_volume_index ? FOLLOWER_MIRROR_AND_CLEAR : FOLLOWER_REALLOCATE_AND_CLEAR;
+	}
+	return this->parameters.mirror_live_volume_index ? FOLLOWER_RESET_AND_MIRROR : FOLLOWER_RESET_AND_ALLOCATE;
+}
+
+template<typename TVoxel, typename TWarp, typename TIndex>
+template<typename TFollowerVoxel>
+void DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::AllocateFollowerVolume(
+		VoxelVolume<TFollowerVoxel, TIndex>* follower_volume, FollowerVolumeAllocation allocation) {
+	const MemoryDeviceType device_type = this->config.device_type;
+	switch (allocation) {
+		case FOLLOWER_RESET_AND_ALLOCATE:
+			follower_volume->Reset();
+			AllocateUsingOtherVolume(follower_volume, live_volumes[0], device_type);
+			break;
+		case FOLLOWER_RESET_AND_MIRROR:
+			follower_volume->Reset();
+			MirrorIndexOfOtherVolume(follower_volume, live_volumes[0], device_type);
+			break;
+		case FOLLOWER_REALLOCATE_AND_CLEAR:
+			DeallocateUsingOtherVolume(follower_volume, live_volumes[0], device_type);
+			AllocateUsingOtherVolume(follower_volume, live_volumes[0], device_type);
+			ResetUtilizedVoxels(follower_volume, device_type);
+			break;
+		case FOLLOWER_MIRROR_AND_CLEAR:
+			MirrorIndexOfOtherVolume(follower_volume, live_volumes[0], device_type);
+			ResetUtilizedVoxels(follower_volume, device_type);
+			break;
+		case FOLLOWER_REALLOCATE_KEEPING_VOXELS:
+			DeallocateUsingOtherVolume(follower_volume, live_volumes[0], device_type);
+			AllocateUsingOtherVolume(follower_volume, live_volumes[0], device_type);
+			break;
+	}
+}
+
+template<typename TVoxel, typename TWarp, typename TIndex>
+CameraTrackingState::TrackingResult DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::ProcessCurrentView() {
 	if (!main_processing_active) {
 		return CameraTrackingState::TRACKING_FAILED;
 	}
@@ -312,14 +390,8 @@ DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::ProcessFrame(UChar4Image* rgb_im
 		camera_tracking_controller->Prepare(tracking_state, canonical_volume, view, rendering_engine, canonical_render_state);
 		LOG4CPLUS_PER_FRAME(logging::GetLogger(), bright_cyan << "*** Generating raw live TSDF from view... ***" << reset);
 		benchmarking::start_timer("GenerateRawLiveVolume");
-		live_volumes[0]->Reset();
-		live_volumes[1]->Reset();
-		warp_field->Reset();
-
-		indexing_engine->AllocateNearAndBetweenTwoSurfaces(live_volumes[0], view, tracking_state);
-		AllocateUsingOtherVolume(live_volumes[1], live_volumes[0], this->config.device_type);
+		AllocateLiveVolumes();
 		AllocateUsingOtherVolume(canonical_volume, live_volumes[0], this->config.device_type);
-		AllocateUsingOtherVolume(warp_field, live_volumes[0], this->config.device_type);
 		depth_fusion_engine->IntegrateDepthImageIntoTsdfVolume(live_volumes[0], view, tracking_state);
 		benchmarking::stop_timer("GenerateRawLiveVolume");
 
@@ -330,7 +402,15 @@ DynamicSceneVoxelEngine<TVoxel, TWarp, TIndex>::ProcessFrame(UChar4Image* rgb_im
 		benchmarking::start_timer("TrackMotion");
 		LOG4CPLUS_PER_FRAME(logging::GetLogger(), bright_cyan << "*** Optimizing warp based on difference between canonical and live SDF. ***" << reset);
 		bool optimizationConverged;
-		target_warped_live_volume = surface_tracker->Align(warp_field, live_volumes, canonical_volume, optimizationConverged);
+		if (this->parameters.warm_start_non_rigid_alignment) {
+			// the alignment computes its first gradient on the source live volume, so that volume has to be warped
+			// by the warps carried over from the previous frame first; the alignment then starts from live_volumes[1]
+			surface_tracker->WarpVolume_WarpUpdates(warp_field, live_volumes[0], live_volumes[1]);
+			VoxelVolume<TVoxel, TIndex>* warm_started_live_volume_pair[2] = {live_volumes[1], live_volumes[0]};
+			target_warped_live_volume = surface_tracker->Align(warp_field, warm_started_live_volume_pair, canonical_volume, optimizationConverged);
+		} else {
+			target_warped_live_volume = surface_tracker->Align(warp_field, live_volumes, canonical_volume, optimizationConverged);
+		}
 		if(this->parameters.halt_on_non_rigid_alignment_convergence_failure && !optimizationConverged){
 			main_processing_active = false;
 			LOG4CPLUS_TOP_LEVEL(logging::GetLogger(), bright_cyan << "Non-rigid TSDF alignment optimization did not converge. Switching off main processing." << reset);
@@ -6,6 +6,7 @@
 #include "../../Utils/Configuration/Configuration.h"
 #include "../Common/Configurable.h"
 #include "MainEngineSettings.h"
+#include "../../../ORUtils/PlatformIndependence.h"
 
 //FIXME main documentation page
 /** \mainpage
@@ -69,6 +70,24 @@ public:
 	virtual CameraTrackingState::TrackingResult
 	ProcessFrame(UChar4Image* rgbImage, ShortImage* rawDepthImage, IMUMeasurement* imuMeasurement = nullptr) = 0;
 
+	/// Whether the engine supports splitting ProcessFrame into PrepareFrame and ProcessPreparedFrame
+	virtual bool CanPrepareFrames() const { return false; }
+
+	/**
+	 * \brief Preprocess the images of an upcoming frame (i.e. build its view) ahead of processing it.
+	 * \details PrepareFrame for frame N+1 may run on another thread concurrently with ProcessPreparedFrame for frame
+	 * N, but must not start before ProcessPreparedFrame for frame N-1 has returned.
+	 */
+	virtual void PrepareFrame(UChar4Image* rgb_image, ShortImage* raw_depth_image, IMUMeasurement* imu_measurement = nullptr) {
+		DIEWITHEXCEPTION_REPORTLOCATION("Frame preparation is not supported by this engine.");
+	}
+
+	/// Process the oldest frame handed to PrepareFrame, same as ProcessFrame would
+	virtual CameraTrackingState::TrackingResult ProcessPreparedFrame() {
+		DIEWITHEXCEPTION_REPORTLOCATION("Frame preparation is not supported by this engine.");
+		return CameraTrackingState::TRACKING_FAILED;
+	}
+
 	/// Get a result image as output
 	virtual Vector2i GetImageSize() const = 0;
 
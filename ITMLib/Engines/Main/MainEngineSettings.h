@@ -35,7 +35,10 @@ DECLARE_SERIALIZABLE_ENUM(LIBMODE_ENUM_DESCRIPTION);
     (LibMode, library_mode, LIBMODE_DYNAMIC, ENUM, "Switch between various library modes - basic, with loop closure, etc."), \
     (IndexingMethod, indexing_method, INDEX_HASH, ENUM, "Indexing method to use in the 3D volumes, i.e. array or hash."),    \
     (bool, halt_on_non_rigid_alignment_convergence_failure, false, PRIMITIVE, "Whether to halt on non-rigid alignment optimization convergence failure"), \
-    (bool, enable_rigid_alignment, true, PRIMITIVE, "Enables or disables rigid (camera) tracking/alignment.")
+    (bool, enable_rigid_alignment, true, PRIMITIVE, "Enables or disables rigid (camera) tracking/alignment."), \
+    (bool, incremental_live_volume_allocation, false, PRIMITIVE, "(Dynamic mode, hash indexing) Keep live volume & warp field blocks allocated between frames and only allocate/deallocate the difference, instead of resetting these volumes at every frame."), \
+    (bool, warm_start_non_rigid_alignment, false, PRIMITIVE, "(Dynamic mode) Start non-rigid alignment of each frame from the previous frame's warp field, carried over in the blocks allocated in both frames, instead of from a zero warp."), \
+    (bool, mirror_live_volume_index, false, PRIMITIVE, "(Dynamic mode, hash indexing) Give the second live volume and the warp field exact copies of the index of the newly-allocated live volume instead of allocating their blocks separately, so that traversals over these volumes can walk their blocks in lockstep. With warm_start_non_rigid_alignment, the warp field still allocates its blocks separately, so that it keeps the previous frame's warps.")
 
 
 DECLARE_DEFERRABLE_SERIALIZABLE_STRUCT(MAIN_ENGINE_SETTINGS_STRUCT_DESCRIPTION);
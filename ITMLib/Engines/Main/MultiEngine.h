@@ -17,8 +17,38 @@
 
 #include <vector>
 
+namespace threadpool11 { class pool; }
+/// grants Tests/Test_MultiEngine.cpp access to the concurrent local map processing
+struct MultiEngineTestAccess;
+
 namespace ITMLib
 {
+	/** \brief What to do with one active local map while processing a frame
+	*/
+	struct TodoListEntry {
+		TodoListEntry(int _activeDataID, bool _track, bool _fusion, bool _prepare)
+			: dataId(_activeDataID), track(_track), fusion(_fusion), prepare(_prepare), preprepare(false) {}
+		TodoListEntry() {}
+		int dataId;
+		bool track;
+		bool fusion;
+		bool prepare;
+		bool preprepare;
+	};
+
+	/** \brief Engines used to prepare, track and fuse into a single local map at a time.
+		MultiEngine tracks several local maps concurrently, so each concurrent task needs its own set.
+	*/
+	template <typename TVoxel, typename TIndex>
+	struct LocalMapTrackingContext
+	{
+		ImageProcessingEngineInterface *lowLevelEngine;
+		CameraTracker *tracker;
+		CameraTrackingController *trackingController;
+		RenderingEngineBase<TVoxel, TIndex> *visualizationEngine;
+		DenseMapper<TVoxel, TIndex> *denseMapper;
+	};
+
 	/** \brief
 	*/
 	template <typename TVoxel, typename TIndex>
@@ -52,6 +82,27 @@ namespace ITMLib
 
 		/// Pointer for storing the current input frame
 		View *view;
+
+		/// image sizes, for building the engines of additional tracking contexts
+		Vector2i imgSize_rgb, imgSize_d;
+		/// contexts for concurrent tracking tasks beyond the first, which uses the engine's own members; built on demand
+		std::vector<LocalMapTrackingContext<TVoxel, TIndex>> concurrentTrackingContexts;
+		/// pool that runs concurrent tracking tasks beyond the first, created on demand
+		threadpool11::pool *trackingPool;
+		/// maximum number of local maps tracked at the same time (relocalisation / loop closure candidates)
+		int maxConcurrentLocalMapTracking;
+
+		LocalMapTrackingContext<TVoxel, TIndex> GetMainTrackingContext();
+		LocalMapTrackingContext<TVoxel, TIndex>& GetConcurrentTrackingContext(int contextIdx);
+		/// process todo list entries [begin, end) for non-primary local maps, concurrently for different local maps
+		void ProcessSecondaryTodoListEntries(std::vector<TodoListEntry> &todoList, size_t begin, size_t end,
+		                                     std::vector<CameraTrackingState::TrackingResult> &trackingResults);
+		/** \brief Starts localMapCount new local maps and fuses the current view into all of them (and prepares them for
+			tracking) as one concurrent batch, the way ProcessFrame handles relocalisation and loop closure candidates.
+		*/
+		std::vector<LocalMap<TVoxel, TIndex>*> FuseIntoNewLocalMaps(int localMapCount);
+
+		friend struct ::MultiEngineTestAccess;
 	public:
 		View* GetView() { return view; }
 
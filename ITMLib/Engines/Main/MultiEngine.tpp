@@ -2,6 +2,16 @@
 
 #include "MultiEngine.h"
 
+#include <algorithm>
+#include <exception>
+#include <future>
+
+#include <threadpool11/threadpool11.hpp>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 #include "../ImageProcessing/ImageProcessingEngineFactory.h"
 #include "../ViewBuilder/ViewBuilderFactory.h"
 #include "../Rendering/RenderingEngineFactory.h"
@@ -30,8 +40,12 @@ static const bool separateThreadGlobalAdjustment = true;
 template <typename TVoxel, typename TIndex>
 MultiEngine<TVoxel, TIndex>::MultiEngine(const RGBD_CalibrationInformation& calib, Vector2i imgSize_rgb, Vector2i imgSize_d){
 	if ((imgSize_d.x == -1) || (imgSize_d.y == -1)) imgSize_d = imgSize_rgb;
+	this->imgSize_rgb = imgSize_rgb;
+	this->imgSize_d = imgSize_d;
+	trackingPool = nullptr;
 
 	auto& settings = configuration::Get();
+	maxConcurrentLocalMapTracking = std::max(1, settings.multi_map_concurrent_tracking_limit);
 
 	const MemoryDeviceType deviceType = settings.device_type;
 	lowLevelEngine = ImageProcessingEngineFactory::Build(deviceType);
@@ -62,7 +76,7 @@ MultiEngine<TVoxel, TIndex>::MultiEngine(const RGBD_CalibrationInformation& cali
 
 	relocaliser = new FernRelocLib::Relocaliser<float>(imgSize_d, Vector2f(settings.general_voxel_volume_parameters.near_clipping_distance, settings.general_voxel_volume_parameters.far_clipping_distance), 0.1f, 1000, 4);
 
-	mGlobalAdjustmentEngine = new GlobalAdjustmentEngine();
+	mGlobalAdjustmentEngine = new GlobalAdjustmentEngine(settings.multi_map_incremental_global_adjustment);
 	mScheduleGlobalAdjustment = false;
 	if (separateThreadGlobalAdjustment) mGlobalAdjustmentEngine->startSeparateThread();
 
@@ -76,6 +90,17 @@ MultiEngine<TVoxel, TIndex>::~MultiEngine()
 	if (renderState_multiscene != nullptr) delete renderState_multiscene;
 
 	delete mGlobalAdjustmentEngine;
+
+	delete trackingPool;
+	for (LocalMapTrackingContext<TVoxel, TIndex>& context : concurrentTrackingContexts)
+	{
+		delete context.denseMapper;
+		delete context.visualizationEngine;
+		delete context.trackingController;
+		delete context.tracker;
+		delete context.lowLevelEngine;
+	}
+
 	delete mActiveDataManager;
 	delete mapManager;
 
@@ -121,6 +146,30 @@ CameraTrackingState* MultiEngine<TVoxel, TIndex>::GetTrackingState()
 	return mapManager->getLocalMap(idx)->trackingState;
 }
 
+template <typename TVoxel, typename TIndex>
+LocalMapTrackingContext<TVoxel, TIndex> MultiEngine<TVoxel, TIndex>::GetMainTrackingContext()
+{
+	return { lowLevelEngine, tracker, trackingController, visualization_engine, denseMapper };
+}
+
+template <typename TVoxel, typename TIndex>
+LocalMapTrackingContext<TVoxel, TIndex>& MultiEngine<TVoxel, TIndex>::GetConcurrentTrackingContext(int contextIdx)
+{
+	auto& settings = configuration::Get();
+	while ((int)concurrentTrackingContexts.size() <= contextIdx)
+	{
+		LocalMapTrackingContext<TVoxel, TIndex> context;
+		context.lowLevelEngine = ImageProcessingEngineFactory::Build(settings.device_type);
+		context.tracker = CameraTrackerFactory::Instance().Make(imgSize_rgb, imgSize_d, context.lowLevelEngine, imuCalibrator,
+		                                                        settings.general_voxel_volume_parameters);
+		context.trackingController = new CameraTrackingController(context.tracker);
+		context.visualizationEngine = RenderingEngineFactory::Build<TVoxel, TIndex>(settings.device_type);
+		context.denseMapper = new DenseMapper<TVoxel, TIndex>();
+		concurrentTrackingContexts.push_back(context);
+	}
+	return concurrentTrackingContexts[contextIdx];
+}
+
 // -whenever a new local scene is added, add to list of "to be established 3D relations"
 // - whenever a relocalisation is detected, add to the same list, preserving any existing information on that 3D relation
 //
@@ -132,16 +181,132 @@ CameraTrackingState* MultiEngine<TVoxel, TIndex>::GetTrackingState()
 // 	- try to compute_allocated 3D relation, weighting old information accordingly
 //	- if outlier ratio below p_relation_outliers and at least n_overlap inliers, success
 
-struct TodoListEntry {
-	TodoListEntry(int _activeDataID, bool _track, bool _fusion, bool _prepare)
-		: dataId(_activeDataID), track(_track), fusion(_fusion), prepare(_prepare), preprepare(false) {}
-	TodoListEntry() {}
-	int dataId;
-	bool track;
-	bool fusion;
-	bool prepare;
-	bool preprepare;
-};
+// prepare (if requested), track, fuse and raycast a single local map with the given context
+template <typename TVoxel, typename TIndex>
+static CameraTrackingState::TrackingResult ProcessTodoListEntry(TodoListEntry &entry, LocalMap<TVoxel, TIndex> *currentLocalMap, bool isPrimary,
+                                                                const View *view, const LocalMapTrackingContext<TVoxel, TIndex> &context)
+{
+	CameraTrackingState::TrackingResult trackingResult = CameraTrackingState::TRACKING_FAILED;
+
+	// if a new relocalization/loop closure is started, this will do the initial raycasting before tracking can start
+	if (entry.preprepare)
+	{
+		context.denseMapper->UpdateVisibleList(view, currentLocalMap->trackingState, currentLocalMap->volume, currentLocalMap->renderState);
+		context.trackingController->Prepare(currentLocalMap->trackingState, currentLocalMap->volume, view, context.visualizationEngine, currentLocalMap->renderState);
+	}
+
+	if (entry.track)
+	{
+		// actual tracking
+		ORUtils::SE3Pose oldPose(*(currentLocalMap->trackingState->pose_d));
+		context.trackingController->Track(currentLocalMap->trackingState, view);
+
+		// tracking is allowed to be poor only in the primary scenes.
+		trackingResult = currentLocalMap->trackingState->trackerResult;
+		if (!isPrimary && trackingResult == CameraTrackingState::TRACKING_POOR) trackingResult = CameraTrackingState::TRACKING_FAILED;
+
+		// actions on tracking result for all scenes TODO: incorporate behaviour on tracking failure from settings
+		if (trackingResult != CameraTrackingState::TRACKING_GOOD) entry.fusion = false;
+
+		if (trackingResult == CameraTrackingState::TRACKING_FAILED)
+		{
+			entry.prepare = false;
+			*(currentLocalMap->trackingState->pose_d) = oldPose;
+		}
+	}
+
+	// fusion in any subscene as long as tracking is good for the respective subscene
+	if (entry.fusion) context.denseMapper->ProcessFrame(view, currentLocalMap->trackingState, currentLocalMap->volume, currentLocalMap->renderState);
+	else if (entry.prepare) context.denseMapper->UpdateVisibleList(view, currentLocalMap->trackingState, currentLocalMap->volume, currentLocalMap->renderState);
+
+	// raycast to renderState_canonical for tracking and free Rendering
+	if (entry.prepare) context.trackingController->Prepare(currentLocalMap->trackingState, currentLocalMap->volume, view, context.visualizationEngine, currentLocalMap->renderState);
+
+	return trackingResult;
+}
+
+template <typename TVoxel, typename TIndex>
+void MultiEngine<TVoxel, TIndex>::ProcessSecondaryTodoListEntries(std::vector<TodoListEntry> &todoList, size_t begin, size_t end,
+                                                                  std::vector<CameraTrackingState::TrackingResult> &trackingResults)
+{
+	// entries for the same local map share its tracking and render state, so they stay together, in order, within one task
+	std::vector<int> groupLocalMapIndices;
+	std::vector<std::vector<size_t>> groups;
+	for (size_t i = begin; i < end; ++i)
+	{
+		int localMapIdx = mActiveDataManager->getLocalMapIndex(todoList[i].dataId);
+		size_t groupIdx = std::find(groupLocalMapIndices.begin(), groupLocalMapIndices.end(), localMapIdx) - groupLocalMapIndices.begin();
+		if (groupIdx == groups.size())
+		{
+			groupLocalMapIndices.push_back(localMapIdx);
+			groups.emplace_back();
+		}
+		groups[groupIdx].push_back(i);
+	}
+
+	const int taskCount = std::min((int)groups.size(), maxConcurrentLocalMapTracking);
+#ifdef WITH_OPENMP
+	// the tasks run side by side, so the parallel regions within each of them get a share of the threads rather than all
+	const int callerThreadCount = omp_get_max_threads();
+	const int taskThreadCount = std::max(1, callerThreadCount / std::max(1, taskCount));
+#endif
+	auto runTask = [&](int taskIdx, const LocalMapTrackingContext<TVoxel, TIndex> &context)
+	{
+#ifdef WITH_OPENMP
+		omp_set_num_threads(taskThreadCount);
+#endif
+		for (size_t groupIdx = taskIdx; groupIdx < groups.size(); groupIdx += taskCount)
+		{
+			LocalMap<TVoxel, TIndex> *currentLocalMap = mapManager->getLocalMap(groupLocalMapIndices[groupIdx]);
+			for (size_t entryIdx : groups[groupIdx])
+			{
+#ifdef DEBUG_MULTISCENE
+				fprintf(stderr, " %i", groupLocalMapIndices[groupIdx]);
+#endif
+				trackingResults[entryIdx - begin] = ProcessTodoListEntry(todoList[entryIdx], currentLocalMap, false, view, context);
+			}
+		}
+	};
+
+	// the first task runs on the calling thread with the engine's own trackers and the rest on the pool, each with its own context
+	std::vector<std::future<void>> taskFutures;
+	if (taskCount > 1 && trackingPool == nullptr) trackingPool = new threadpool11::pool(maxConcurrentLocalMapTracking - 1);
+	for (int taskIdx = 1; taskIdx < taskCount; ++taskIdx)
+	{
+		// copied, since building further contexts may reallocate their storage while this task already runs
+		LocalMapTrackingContext<TVoxel, TIndex> context = GetConcurrentTrackingContext(taskIdx - 1);
+		taskFutures.push_back(trackingPool->post_work<void>([&runTask, context, taskIdx]() { runTask(taskIdx, context); }));
+	}
+
+	std::exception_ptr firstTaskException;
+	try
+	{
+		if (taskCount > 0) runTask(0, GetMainTrackingContext());
+	}
+	catch (...)
+	{
+		firstTaskException = std::current_exception();
+	}
+#ifdef WITH_OPENMP
+	omp_set_num_threads(callerThreadCount);
+#endif
+	for (std::future<void> &taskFuture : taskFutures) taskFuture.wait();
+	if (firstTaskException) std::rethrow_exception(firstTaskException);
+	for (std::future<void> &taskFuture : taskFutures) taskFuture.get();
+}
+
+template <typename TVoxel, typename TIndex>
+std::vector<LocalMap<TVoxel, TIndex>*> MultiEngine<TVoxel, TIndex>::FuseIntoNewLocalMaps(int localMapCount)
+{
+	std::vector<TodoListEntry> todoList;
+	for (int i = 0; i < localMapCount; ++i) todoList.emplace_back(mActiveDataManager->initiateNewLocalMap(), false, true, true);
+	std::vector<CameraTrackingState::TrackingResult> trackingResults(todoList.size(), CameraTrackingState::TRACKING_FAILED);
+	ProcessSecondaryTodoListEntries(todoList, 0, todoList.size(), trackingResults);
+
+	std::vector<LocalMap<TVoxel, TIndex>*> localMaps;
+	for (const TodoListEntry &entry : todoList) localMaps.push_back(mapManager->getLocalMap(mActiveDataManager->getLocalMapIndex(entry.dataId)));
+	return localMaps;
+}
 
 template <typename TVoxel, typename TIndex>
 CameraTrackingState::TrackingResult MultiEngine<TVoxel, TIndex>::ProcessFrame(UChar4Image *rgbImage, ShortImage *rawDepthImage, IMUMeasurement *imuMeasurement)
@@ -181,7 +346,8 @@ CameraTrackingState::TrackingResult MultiEngine<TVoxel, TIndex>::ProcessFrame(UC
 	todoList.push_back(TodoListEntry(-1, false, false, false));
 
 	bool primaryTrackingSuccess = false;
-	for (size_t i = 0; i < todoList.size(); ++i)
+	size_t i = 0;
+	while (i < todoList.size())
 	{
 		// - first pass of the todo list is for primary local map and ongoing relocalization and loop closure attempts
 		// - an element with id -1 marks the end of the first pass, a request to call the loop closure detection engine, and
@@ -221,50 +387,21 @@ CameraTrackingState::TrackingResult MultiEngine<TVoxel, TIndex>::ProcessFrame(UC
 				}
 			}
 
+			++i;
 			continue;
 		}
 
-		LocalMap<TVoxel, TIndex> *currentLocalMap = nullptr;
-		int currentLocalMapIdx = mActiveDataManager->getLocalMapIndex(todoList[i].dataId);
-		currentLocalMap = mapManager->getLocalMap(currentLocalMapIdx);
-
-		// if a new relocalization/loop closure is started, this will do the initial raycasting before tracking can start
-		if (todoList[i].preprepare)
-		{
-			denseMapper->UpdateVisibleList(view, currentLocalMap->trackingState, currentLocalMap->volume, currentLocalMap->renderState);
-			trackingController->Prepare(currentLocalMap->trackingState, currentLocalMap->volume, view, visualization_engine, currentLocalMap->renderState);
-		}
-
-		if (todoList[i].track)
+		// the primary local map goes alone: the results recorded for the other local maps depend on its tracking result
+		if (mActiveDataManager->getLocalMapType(todoList[i].dataId) == ActiveMapManager::PRIMARY_LOCAL_MAP)
 		{
 			int dataId = todoList[i].dataId;
+			LocalMap<TVoxel, TIndex> *currentLocalMap = mapManager->getLocalMap(mActiveDataManager->getLocalMapIndex(dataId));
+			CameraTrackingState::TrackingResult trackingResult =
+					ProcessTodoListEntry(todoList[i], currentLocalMap, true, view, GetMainTrackingContext());
 
-#ifdef DEBUG_MULTISCENE
-			int blocksInUse = currentLocalMap->volume->index.Getsource_volume() - currentLocalMap->volume->index.GetLastFreeBlockListId() - 1;
-			fprintf(stderr, " %i%s (%i)", currentLocalMapIdx, (todoList[i].dataId == primaryDataIdx) ? "*" : "", blocksInUse);
-#endif
-
-			// actual tracking
-			ORUtils::SE3Pose oldPose(*(currentLocalMap->trackingState->pose_d));
-			trackingController->Track(currentLocalMap->trackingState, view);
-
-			// tracking is allowed to be poor only in the primary scenes.
-			CameraTrackingState::TrackingResult trackingResult = currentLocalMap->trackingState->trackerResult;
-			if (mActiveDataManager->getLocalMapType(dataId) != ActiveMapManager::PRIMARY_LOCAL_MAP)
-				if (trackingResult == CameraTrackingState::TRACKING_POOR) trackingResult = CameraTrackingState::TRACKING_FAILED;
-
-			// actions on tracking result for all scenes TODO: incorporate behaviour on tracking failure from settings
-			if (trackingResult != CameraTrackingState::TRACKING_GOOD) todoList[i].fusion = false;
-
-			if (trackingResult == CameraTrackingState::TRACKING_FAILED)
-			{
-				todoList[i].prepare = false;
-				*(currentLocalMap->trackingState->pose_d) = oldPose;
-			}
-
-			// actions on tracking result for primary local map
-			if (mActiveDataManager->getLocalMapType(dataId) == ActiveMapManager::PRIMARY_LOCAL_MAP)
+			if (todoList[i].track)
 			{
+				// actions on tracking result for primary local map
 				primaryLocalMapTrackingResult = trackingResult;
 
 				if (trackingResult == CameraTrackingState::TRACKING_GOOD) primaryTrackingSuccess = true;
@@ -276,17 +413,29 @@ CameraTrackingState::TrackingResult MultiEngine<TVoxel, TIndex>::ProcessFrame(UC
 					todoList.resize(i + 1);
 					todoList.push_back(TodoListEntry(-1, false, false, false));
 				}
+
+				mActiveDataManager->recordTrackingResult(dataId, trackingResult, primaryTrackingSuccess);
 			}
 
-			mActiveDataManager->recordTrackingResult(dataId, trackingResult, primaryTrackingSuccess);
+			++i;
+			continue;
 		}
 
-		// fusion in any subscene as long as tracking is good for the respective subscene
-		if (todoList[i].fusion) denseMapper->ProcessFrame(view, currentLocalMap->trackingState, currentLocalMap->volume, currentLocalMap->renderState);
-		else if (todoList[i].prepare) denseMapper->UpdateVisibleList(view, currentLocalMap->trackingState, currentLocalMap->volume, currentLocalMap->renderState);
+		// the other local maps up to the end of the current pass are independent of each other, track them concurrently
+		size_t batchEnd = i;
+		while (batchEnd < todoList.size() && todoList[batchEnd].dataId != -1 &&
+		       mActiveDataManager->getLocalMapType(todoList[batchEnd].dataId) != ActiveMapManager::PRIMARY_LOCAL_MAP) ++batchEnd;
+
+		std::vector<CameraTrackingState::TrackingResult> trackingResults(batchEnd - i, CameraTrackingState::TRACKING_FAILED);
+		ProcessSecondaryTodoListEntries(todoList, i, batchEnd, trackingResults);
+
+		// join: record the results in todo list order, as if the entries had been processed one after another
+		for (size_t j = i; j < batchEnd; ++j)
+		{
+			if (todoList[j].track) mActiveDataManager->recordTrackingResult(todoList[j].dataId, trackingResults[j - i], primaryTrackingSuccess);
+		}
 
-		// raycast to renderState_canonical for tracking and free Rendering
-		if (todoList[i].prepare) trackingController->Prepare(currentLocalMap->trackingState, currentLocalMap->volume, view, visualization_engine, currentLocalMap->renderState);
+		i = batchEnd;
 	}
 
 	mScheduleGlobalAdjustment |= mActiveDataManager->maintainActiveData();
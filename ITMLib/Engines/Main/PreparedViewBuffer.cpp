@@ -0,0 +1,40 @@
+//stdlib
+#include <utility>
+
+//local
+#include "PreparedViewBuffer.h"
+#include "../../../ORUtils/PlatformIndependence.h"
+
+using namespace ITMLib;
+
+PreparedViewBuffer::PreparedViewBuffer() : views{nullptr, nullptr}, prepared_view_count(0), swapped_in_view_count(0) {}
+
+PreparedViewBuffer::~PreparedViewBuffer() {
+	delete views[0];
+	delete views[1];
+}
+
+View** PreparedViewBuffer::NextViewToPrepare() {
+	if (prepared_view_count - swapped_in_view_count >= 2) {
+		DIEWITHEXCEPTION_REPORTLOCATION("Can only prepare one view ahead of the view being processed.");
+	}
+	return &views[prepared_view_count++ % 2];
+}
+
+bool PreparedViewBuffer::HasPreparedView() const {
+	return swapped_in_view_count < prepared_view_count;
+}
+
+void PreparedViewBuffer::SwapInPreparedView(View*& current_view, MemoryDeviceType memory_device_type) {
+	if (!HasPreparedView()) {
+		DIEWITHEXCEPTION_REPORTLOCATION("No view has been prepared.");
+	}
+	View*& prepared_view = views[swapped_in_view_count % 2];
+	std::swap(current_view, prepared_view);
+	swapped_in_view_count++;
+	// prepared_view now holds the view that was current until now, i.e. that of the previous frame
+	if (current_view->rgb_prev != nullptr && prepared_view != nullptr) {
+		current_view->rgb_prev->SetFrom(prepared_view->rgb, memory_device_type == MEMORYDEVICE_CUDA ?
+		                                                    MemoryCopyDirection::CUDA_TO_CUDA : MemoryCopyDirection::CPU_TO_CPU);
+	}
+}
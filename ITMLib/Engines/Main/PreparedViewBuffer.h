@@ -0,0 +1,46 @@
+#pragma once
+
+//stdlib
+#include <atomic>
+
+//local
+#include "../../Objects/Views/View.h"
+#include "../../../ORUtils/MemoryDeviceType.h"
+
+namespace ITMLib {
+
+/**
+ * \brief Views that main engines build ahead of time from upcoming frames, so that preprocessing of frame N+1 can
+ * run on one thread while frame N is processed from the engine's current view on another.
+ * \details Views alternate between two slots. The slot that was just swapped in for processing holds the previous
+ * current view afterwards, and gets reused for the frame after the next one.
+ */
+class PreparedViewBuffer {
+public: // instance functions
+	PreparedViewBuffer();
+	~PreparedViewBuffer();
+
+	PreparedViewBuffer(const PreparedViewBuffer&) = delete;
+	PreparedViewBuffer& operator=(const PreparedViewBuffer&) = delete;
+
+	/**
+	 * \brief Slot to build the next view into, to be passed on to ViewBuilder::UpdateView.
+	 * \details The view builder's "previous RGB image" of a view prepared this way is stale; it is set properly when the
+	 * view is swapped in.
+	 */
+	View** NextViewToPrepare();
+	bool HasPreparedView() const;
+	/**
+	 * \brief Make the oldest prepared view the current one.
+	 * \param current_view the engine's current view, which the prepared view gets swapped with
+	 * \param memory_device_type device that the views' images are kept on
+	 */
+	void SwapInPreparedView(View*& current_view, MemoryDeviceType memory_device_type);
+
+private: // instance variables
+	View* views[2];
+	std::atomic<int> prepared_view_count;
+	std::atomic<int> swapped_in_view_count;
+};
+
+} // namespace ITMLib
@@ -0,0 +1,67 @@
+#pragma once
+
+//stdlib
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//local
+#include "../../../Objects/Meshing/Mesh.h"
+#include "../../../Objects/Volume/VoxelVolume.h"
+#include "../../../Objects/Volume/VoxelBlockHash.h"
+
+namespace ITMLib {
+
+/**
+ * \brief Keeps a triangle mesh of a voxel-block-hash volume cached per hash block, and on every update reruns
+ * MarchingCubes only for blocks whose SDF changed since the previous update (or that were allocated / deallocated
+ * since), plus the neighboring blocks whose cubes reach into them.
+ * \details Blocks are recognized as changed by comparing a signature of their SDF values to the one recorded at the
+ * previous update, so changes are picked up regardless of which engine made them.
+ * \tparam TVoxel voxel type
+ */
+template<typename TVoxel>
+class IncrementalMeshingEngine_CPU {
+public: // inner classes
+	/** \brief Triangles generated from the cubes whose minimum corners lie in one hash block */
+	struct MeshChunk {
+		Vector3s block_position;
+		std::vector<Mesh::Triangle> triangles;
+	};
+
+public: // instance functions
+	IncrementalMeshingEngine_CPU() = default;
+
+	/**
+	 * \brief Remesh whatever changed in the volume since the last update (everything on the first update).
+	 * \param volume volume to mesh, the same one (at various states) for every update
+	 * \return number of chunks that were remeshed or removed
+	 */
+	int UpdateMesh(const VoxelVolume<TVoxel, VoxelBlockHash>* volume);
+
+	/** \brief Positions of blocks whose chunks were remeshed or removed during the last update */
+	const std::vector<Vector3s>& GetChangedBlockPositions() const;
+	/** \brief Chunks remeshed during the last update, including ones that turned out empty; removed chunks are left out */
+	std::vector<MeshChunk> GetChangedChunks() const;
+	/** \brief The full mesh as of the last update, unindexed */
+	Mesh GetMesh() const;
+	unsigned int GetTriangleCount() const;
+
+	/** \brief Forget all cached chunks, so that the next update remeshes the entire volume. */
+	void Reset();
+
+private: // inner classes
+	struct CachedBlock {
+		uint64_t sdf_signature;
+		std::vector<Mesh::Triangle> triangles;
+	};
+
+private: // instance functions
+	void UpdateMesh_Generic(const VoxelVolume<TVoxel, VoxelBlockHash>& volume);
+
+private: // instance variables
+	std::unordered_map<Vector3s, CachedBlock> cached_blocks;
+	std::vector<Vector3s> changed_block_positions;
+};
+
+} // namespace ITMLib
@@ -0,0 +1,184 @@
+//stdlib
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+//local
+#include "IncrementalMeshingEngine_CPU.h"
+#include "../Shared/MeshingEngine_Shared.h"
+
+using namespace ITMLib;
+
+namespace {
+
+/**
+ * \brief FNV-1a hash of the SDF values of a voxel block, i.e. of everything in the block that MarchingCubes depends on
+ */
+template<typename TVoxel>
+inline uint64_t ComputeBlockSdfSignature(const TVoxel* voxel_block) {
+	uint64_t signature = 14695981039346656037ull;
+	for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) {
+		unsigned char sdf_bytes[sizeof(voxel_block[i_voxel].sdf)];
+		std::memcpy(sdf_bytes, &voxel_block[i_voxel].sdf, sizeof(sdf_bytes));
+		for (unsigned char byte : sdf_bytes) {
+			signature = (signature ^ byte) * 1099511628211ull;
+		}
+	}
+	return signature;
+}
+
+inline bool BlockPositionPrecedes(const Vector3s& a, const Vector3s& b) {
+	if (a.z != b.z) return a.z < b.z;
+	if (a.y != b.y) return a.y < b.y;
+	return a.x < b.x;
+}
+
+} // anonymous namespace
+
+template<typename TVoxel>
+int IncrementalMeshingEngine_CPU<TVoxel>::UpdateMesh(const VoxelVolume<TVoxel, VoxelBlockHash>* volume) {
+	if (volume->GetMemoryType() == MEMORYDEVICE_CUDA) {
+		VoxelVolume<TVoxel, VoxelBlockHash> cpu_volume(*volume, MEMORYDEVICE_CPU);
+		UpdateMesh_Generic(cpu_volume);
+	} else {
+		UpdateMesh_Generic(*volume);
+	}
+	return static_cast<int>(changed_block_positions.size());
+}
+
+template<typename TVoxel>
+void IncrementalMeshingEngine_CPU<TVoxel>::UpdateMesh_Generic(const VoxelVolume<TVoxel, VoxelBlockHash>& volume) {
+	const int utilized_block_count = volume.index.GetUtilizedBlockCount();
+	const int* utilized_block_hash_codes = volume.index.GetUtilizedBlockHashCodes();
+	const HashEntry* hash_table = volume.index.GetEntries();
+	const TVoxel* voxels = volume.GetVoxels();
+	const float voxel_size = volume.GetParameters().voxel_size;
+
+	std::vector<uint64_t> sdf_signatures(utilized_block_count);
+	uint64_t* sdf_signature_data = sdf_signatures.data();
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(sdf_signature_data, hash_table, utilized_block_hash_codes, voxels) \
+firstprivate(utilized_block_count)
+#endif
+	for (int i_block = 0; i_block < utilized_block_count; i_block++) {
+		const HashEntry& hash_entry = hash_table[utilized_block_hash_codes[i_block]];
+		sdf_signature_data[i_block] = ComputeBlockSdfSignature(voxels + hash_entry.ptr * VOXEL_BLOCK_SIZE3);
+	}
+
+	// blocks whose own voxels changed, appeared, or disappeared
+	std::vector<Vector3s> modified_block_positions;
+	std::unordered_map<Vector3s, uint64_t> current_signatures;
+	current_signatures.reserve(utilized_block_count);
+	for (int i_block = 0; i_block < utilized_block_count; i_block++) {
+		const Vector3s& block_position = hash_table[utilized_block_hash_codes[i_block]].pos;
+		current_signatures[block_position] = sdf_signatures[i_block];
+		auto cached_block = cached_blocks.find(block_position);
+		if (cached_block == cached_blocks.end() || cached_block->second.sdf_signature != sdf_signatures[i_block]) {
+			modified_block_positions.push_back(block_position);
+		}
+	}
+	changed_block_positions.clear();
+	for (auto cached_block = cached_blocks.begin(); cached_block != cached_blocks.end();) {
+		if (current_signatures.find(cached_block->first) == current_signatures.end()) {
+			modified_block_positions.push_back(cached_block->first);
+			changed_block_positions.push_back(cached_block->first);
+			cached_block = cached_blocks.erase(cached_block);
+		} else {
+			++cached_block;
+		}
+	}
+
+	// cubes of a block reach into its neighbors at +x, +y, +z and the diagonals between those, so a modified block
+	// affects the triangles of every block at an offset of 0 or -1 along each axis, i.e. of the full 2x2x2 set of
+	// blocks that has it in its +x, +y, +z corner
+	std::unordered_set<Vector3s> blocks_to_remesh;
+	for (const Vector3s& block_position : modified_block_positions) {
+		for (short dz = 0; dz < 2; dz++) {
+			for (short dy = 0; dy < 2; dy++) {
+				for (short dx = 0; dx < 2; dx++) {
+					const Vector3s neighbor_position = block_position - Vector3s(dx, dy, dz);
+					if (current_signatures.find(neighbor_position) != current_signatures.end()) {
+						blocks_to_remesh.insert(neighbor_position);
+					}
+				}
+			}
+		}
+	}
+
+	std::vector<Vector3s> remeshed_block_positions(blocks_to_remesh.begin(), blocks_to_remesh.end());
+	const int remeshed_block_count = static_cast<int>(remeshed_block_positions.size());
+	std::vector<std::vector<Mesh::Triangle>> remeshed_triangles(remeshed_block_count);
+	const Vector3s* remeshed_block_position_data = remeshed_block_positions.data();
+	std::vector<Mesh::Triangle>* remeshed_triangle_data = remeshed_triangles.data();
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(remeshed_block_position_data, remeshed_triangle_data, voxels, hash_table) \
+firstprivate(remeshed_block_count, voxel_size) schedule(dynamic)
+#endif
+	for (int i_block = 0; i_block < remeshed_block_count; i_block++) {
+		std::vector<Mesh::Triangle>& triangles = remeshed_triangle_data[i_block];
+		meshBlock(remeshed_block_position_data[i_block].toInt() * VOXEL_BLOCK_SIZE, voxel_size, voxels, hash_table,
+		          [&triangles](const Vector3f& p0, const Vector3f& p1, const Vector3f& p2) {
+			          triangles.push_back({p0, p1, p2});
+		          });
+	}
+
+	for (int i_block = 0; i_block < remeshed_block_count; i_block++) {
+		const Vector3s& block_position = remeshed_block_positions[i_block];
+		CachedBlock& cached_block = cached_blocks[block_position];
+		cached_block.sdf_signature = current_signatures[block_position];
+		cached_block.triangles = std::move(remeshed_triangles[i_block]);
+		changed_block_positions.push_back(block_position);
+	}
+}
+
+template<typename TVoxel>
+const std::vector<Vector3s>& IncrementalMeshingEngine_CPU<TVoxel>::GetChangedBlockPositions() const {
+	return changed_block_positions;
+}
+
+template<typename TVoxel>
+std::vector<typename IncrementalMeshingEngine_CPU<TVoxel>::MeshChunk>
+IncrementalMeshingEngine_CPU<TVoxel>::GetChangedChunks() const {
+	std::vector<MeshChunk> chunks;
+	for (const Vector3s& block_position : changed_block_positions) {
+		auto cached_block = cached_blocks.find(block_position);
+		if (cached_block != cached_blocks.end()) {
+			chunks.push_back({block_position, cached_block->second.triangles});
+		}
+	}
+	return chunks;
+}
+
+template<typename TVoxel>
+unsigned int IncrementalMeshingEngine_CPU<TVoxel>::GetTriangleCount() const {
+	std::size_t triangle_count = 0;
+	for (const auto& cached_block : cached_blocks) {
+		triangle_count += cached_block.second.triangles.size();
+	}
+	return static_cast<unsigned int>(triangle_count);
+}
+
+template<typename TVoxel>
+Mesh IncrementalMeshingEngine_CPU<TVoxel>::GetMesh() const {
+	const unsigned int triangle_count = GetTriangleCount();
+	ORUtils::MemoryBlock<Mesh::Triangle> triangles(triangle_count, MEMORYDEVICE_CPU);
+	Mesh::Triangle* triangle_data = triangles.GetData(MEMORYDEVICE_CPU);
+	// walk the blocks in z-y-x order, so that the triangle order does not depend on the hash map's bucket layout
+	std::vector<Vector3s> block_positions;
+	block_positions.reserve(cached_blocks.size());
+	for (const auto& cached_block : cached_blocks) {
+		block_positions.push_back(cached_block.first);
+	}
+	std::sort(block_positions.begin(), block_positions.end(), BlockPositionPrecedes);
+	for (const Vector3s& block_position : block_positions) {
+		const std::vector<Mesh::Triangle>& block_triangles = cached_blocks.at(block_position).triangles;
+		triangle_data = std::copy(block_triangles.begin(), block_triangles.end(), triangle_data);
+	}
+	return Mesh(std::move(triangles), triangle_count);
+}
+
+template<typename TVoxel>
+void IncrementalMeshingEngine_CPU<TVoxel>::Reset() {
+	cached_blocks.clear();
+	changed_block_positions.clear();
+}
@@ -0,0 +1,9 @@
+//local
+#include "../../../../Objects/Volume/VoxelTypes.h"
+#include "../../../../Objects/Volume/VoxelBlockHash.h"
+#include "../IncrementalMeshingEngine_CPU.tpp"
+
+namespace ITMLib {
+template
+class IncrementalMeshingEngine_CPU<TSDFVoxel_f_rgb>;
+} // namespace ITMLib
\ No newline at end of file
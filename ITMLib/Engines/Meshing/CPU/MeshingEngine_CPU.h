@@ -24,8 +24,11 @@ namespace ITMLib
 	{
 	public:
 		Mesh MeshVolume(const VoxelVolume<TVoxel, VoxelBlockHash> *volume);
+		Mesh MeshVolumeIndexed(const VoxelVolume<TVoxel, VoxelBlockHash> *volume) override;
 
 		explicit MeshingEngine_CPU() = default;
 		~MeshingEngine_CPU() = default;
+	private:
+		Mesh MeshVolume_Generic(const VoxelVolume<TVoxel, VoxelBlockHash> *volume, bool indexed);
 	};
 }
@@ -13,82 +13,254 @@
 //  See the License for the specific language governing permissions and
 //  limitations under the License.
 //  ================================================================
+//stdlib
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+//local
 #include "MeshingEngine_CPU.h"
 #include "../Shared/MeshingEngine_Shared.h"
-#include "../../../../ORUtils/PlatformIndependentAtomics.h"
 
 using namespace ITMLib;
 
-template<class TVoxel>
-Mesh MeshingEngine_CPU<TVoxel, VoxelBlockHash>::MeshVolume(const VoxelVolume<TVoxel, VoxelBlockHash>* volume) {
-	bool temporary_volume_used = false;
+namespace {
 
-	const VoxelVolume<TVoxel, VoxelBlockHash>* meshing_target_volume;
-	VoxelVolume<TVoxel, VoxelBlockHash>* temporary_volume;
+inline int GetMeshingThreadCount() {
+#ifdef WITH_OPENMP
+	return omp_get_max_threads();
+#else
+	return 1;
+#endif
+}
 
-	if (volume->GetMemoryType() == MEMORYDEVICE_CUDA) {
-		temporary_volume_used = true;
-		temporary_volume = new VoxelVolume<TVoxel, VoxelBlockHash>(*volume, MEMORYDEVICE_CPU);
-		meshing_target_volume = temporary_volume;
-	} else {
-		meshing_target_volume = volume;
+inline int GetMeshingThreadIndex() {
+#ifdef WITH_OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * \brief Run process_block on every utilized block, handing each thread its own output buffer.
+ * \details Each thread processes one contiguous range of the utilized blocks, so concatenating the thread buffers in
+ * thread order yields the same output order as a sequential run.
+ */
+template<typename TThreadBuffer, typename TProcessBlockFunction>
+void TraverseUtilizedBlocksWithThreadBuffers(const int utilized_block_count, const int* utilized_block_hash_codes,
+                                             const HashEntry* hash_table, std::vector<TThreadBuffer>& thread_buffers,
+                                             TProcessBlockFunction& process_block) {
+#ifdef WITH_OPENMP
+#pragma omp parallel default(none) shared(thread_buffers, process_block, hash_table, utilized_block_hash_codes) \
+firstprivate(utilized_block_count)
+#endif
+	{
+		TThreadBuffer& thread_buffer = thread_buffers[GetMeshingThreadIndex()];
+#ifdef WITH_OPENMP
+#pragma omp for schedule(static)
+#endif
+		for (int utilized_entry_index = 0; utilized_entry_index < utilized_block_count; utilized_entry_index++) {
+			const HashEntry& hash_entry = hash_table[utilized_block_hash_codes[utilized_entry_index]];
+			//position of the voxel at the current hash block corner with minimum coordinates
+			process_block(thread_buffer, hash_entry.pos.toInt() * VOXEL_BLOCK_SIZE);
+		}
 	}
+}
 
-	const int utilized_block_count = meshing_target_volume->index.GetUtilizedBlockCount();
-	const int max_triangle_count = utilized_block_count * VOXEL_BLOCK_SIZE3;
-	const float voxel_size = meshing_target_volume->GetParameters().voxel_size;
+template<typename TVoxel>
+Mesh GenerateTriangleSoup(const VoxelVolume<TVoxel, VoxelBlockHash>& volume) {
+	const float voxel_size = volume.GetParameters().voxel_size;
+	const TVoxel* voxels = volume.GetVoxels();
+	const HashEntry* hash_table = volume.index.GetEntries();
 
-	ORUtils::MemoryBlock<Mesh::Triangle> triangles(max_triangle_count, MEMORYDEVICE_CPU);
-	Mesh::Triangle* triangles_device = triangles.GetData(MEMORYDEVICE_CPU);
-	const TVoxel* voxels = meshing_target_volume->GetVoxels();
-	const HashEntry* hash_table = meshing_target_volume->index.GetEntries();
+	auto process_block = [&voxels, &hash_table, &voxel_size](std::vector<Mesh::Triangle>& triangles,
+	                                                         const Vector3i& block_corner_position) {
+		meshBlock(block_corner_position, voxel_size, voxels, hash_table,
+		          [&triangles](const Vector3f& p0, const Vector3f& p1, const Vector3f& p2) {
+			          triangles.push_back({p0, p1, p2});
+		          });
+	};
 
-	const int* utilized_block_indices = meshing_target_volume->index.GetUtilizedBlockHashCodes();
+	std::vector<std::vector<Mesh::Triangle>> thread_triangles(GetMeshingThreadCount());
+	TraverseUtilizedBlocksWithThreadBuffers(volume.index.GetUtilizedBlockCount(), volume.index.GetUtilizedBlockHashCodes(),
+	                                        hash_table, thread_triangles, process_block);
 
-	std::atomic<unsigned int> triangle_count(0);
+	std::size_t triangle_count = 0;
+	for (const std::vector<Mesh::Triangle>& triangles : thread_triangles) {
+		triangle_count += triangles.size();
+	}
+	ORUtils::MemoryBlock<Mesh::Triangle> triangles(triangle_count, MEMORYDEVICE_CPU);
+	Mesh::Triangle* triangle_data = triangles.GetData(MEMORYDEVICE_CPU);
+	for (const std::vector<Mesh::Triangle>& thread_triangle_vector : thread_triangles) {
+		triangle_data = std::copy(thread_triangle_vector.begin(), thread_triangle_vector.end(), triangle_data);
+	}
+	return Mesh(std::move(triangles), static_cast<unsigned int>(triangle_count));
+}
 
+/**
+ * \brief Identifies the vertex on the edge going from the voxel at lower_voxel_position to its neighbor along the
+ * given axis (x = 0, y = 1, z = 2).
+ */
+inline uint64_t EdgeVertexKey(const Vector3i& lower_voxel_position, const int axis) {
+	// 20 bits per coordinate, offset to be non-negative
+	constexpr int coordinate_offset = 1 << 19;
+	return (static_cast<uint64_t>(lower_voxel_position.z + coordinate_offset) << 42u) |
+	       (static_cast<uint64_t>(lower_voxel_position.y + coordinate_offset) << 22u) |
+	       (static_cast<uint64_t>(lower_voxel_position.x + coordinate_offset) << 2u) |
+	       static_cast<uint64_t>(axis);
+}
 
-#ifdef WITH_OPENMP
-#pragma omp parallel for default(none) shared(hash_table, voxels, utilized_block_indices, triangle_count, triangle_table, triangles_device) \
-firstprivate(utilized_block_count, voxel_size)
-#endif
-	for (int utilized_entry_index = 0; utilized_entry_index < utilized_block_count; utilized_entry_index++) {
-		const HashEntry& hash_entry = hash_table[utilized_block_indices[utilized_entry_index]];
+struct EdgeVertex {
+	uint64_t key;
+	Vector3f position;
+};
 
-		//position of the voxel at the current hash block corner with minimum coordinates
-		Vector3i block_corner_position = hash_entry.pos.toInt() * VOXEL_BLOCK_SIZE;
+struct IndexedMeshThreadBuffer {
+	// vertices are deduplicated within each block here, edges shared between blocks may still repeat
+	std::vector<EdgeVertex> vertices;
+	// three vertex keys per triangle
+	std::vector<uint64_t> triangle_vertex_keys;
+};
 
+template<typename TVoxel>
+Mesh GenerateIndexedMesh(const VoxelVolume<TVoxel, VoxelBlockHash>& volume) {
+	const float voxel_size = volume.GetParameters().voxel_size;
+	const TVoxel* voxels = volume.GetVoxels();
+	const HashEntry* hash_table = volume.index.GetEntries();
+
+	auto process_block = [&voxels, &hash_table, &voxel_size](IndexedMeshThreadBuffer& buffer,
+	                                                         const Vector3i& block_corner_position) {
+		// cubes at the far faces of the block reach one voxel into the neighboring blocks
+		constexpr int edge_span = VOXEL_BLOCK_SIZE + 1;
+		bool vertex_added[edge_span * edge_span * edge_span * 3] = {};
 		for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
 			for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
 				for (int x = 0; x < VOXEL_BLOCK_SIZE; x++) {
-					Vector3f vertex_list[12];
-					// build vertices by interpolating edges of cubes that intersect with the isosurface
-					// based on positive/negative SDF values
-					int cube_index = buildVertexList(vertex_list, block_corner_position, Vector3i(x, y, z), voxels,
-					                                 hash_table);
-
+					// cube corner positions & sdf values at them
+					Vector3f points[8];
+					float sdf_values[8];
+					const int cube_index = findCubeIndex(points, sdf_values, block_corner_position + Vector3i(x, y, z),
+					                                     voxels, hash_table);
 					// cube does not intersect with the isosurface
 					if (cube_index < 0) continue;
 
-					for (int i_vertex = 0; triangle_table[cube_index][i_vertex] != -1; i_vertex += 3) {
-						unsigned int current_triangle_count = atomicAdd_CPU(triangle_count, 1u);
-						// cube index also tells us how the vertices are grouped into triangles,
-						// use it to look up the vertex indices composing each triangle from the vertex list
-						triangles_device[current_triangle_count].p0 =
-								vertex_list[triangle_table[cube_index][i_vertex]] * voxel_size;
-						triangles_device[current_triangle_count].p1 =
-								vertex_list[triangle_table[cube_index][i_vertex + 1]] * voxel_size;
-						triangles_device[current_triangle_count].p2 =
-								vertex_list[triangle_table[cube_index][i_vertex + 2]] * voxel_size;
+					for (int i_vertex = 0; triangle_table[cube_index][i_vertex] != -1; i_vertex++) {
+						const int* edge = edge_corners_and_axes[triangle_table[cube_index][i_vertex]];
+						const int* lower_corner_offset = cube_corner_offsets[edge[0]];
+						const Vector3i lower_position_in_block(x + lower_corner_offset[0], y + lower_corner_offset[1],
+						                                       z + lower_corner_offset[2]);
+						const uint64_t key = EdgeVertexKey(block_corner_position + lower_position_in_block, edge[2]);
+						bool& added = vertex_added[((lower_position_in_block.z * edge_span + lower_position_in_block.y) *
+						                            edge_span + lower_position_in_block.x) * 3 + edge[2]];
+						if (!added) {
+							added = true;
+							// always interpolate from the lower end of the edge, so that cubes in different blocks
+							// produce identical vertices for the same edge
+							buffer.vertices.push_back(
+									{key, interpolateSdf(points[edge[0]], points[edge[1]],
+									                     sdf_values[edge[0]], sdf_values[edge[1]]) * voxel_size});
+						}
+						buffer.triangle_vertex_keys.push_back(key);
 					}
 				}
 			}
 		}
+	};
+
+	std::vector<IndexedMeshThreadBuffer> thread_buffers(GetMeshingThreadCount());
+	TraverseUtilizedBlocksWithThreadBuffers(volume.index.GetUtilizedBlockCount(), volume.index.GetUtilizedBlockHashCodes(),
+	                                        hash_table, thread_buffers, process_block);
+
+	// merge the vertices of all threads, dropping the ones repeated across blocks
+	std::size_t vertex_candidate_count = 0;
+	std::size_t triangle_vertex_key_count = 0;
+	for (const IndexedMeshThreadBuffer& buffer : thread_buffers) {
+		vertex_candidate_count += buffer.vertices.size();
+		triangle_vertex_key_count += buffer.triangle_vertex_keys.size();
+	}
+	std::vector<EdgeVertex> unique_vertices;
+	unique_vertices.reserve(vertex_candidate_count);
+	for (IndexedMeshThreadBuffer& buffer : thread_buffers) {
+		unique_vertices.insert(unique_vertices.end(), buffer.vertices.begin(), buffer.vertices.end());
+		std::vector<EdgeVertex>().swap(buffer.vertices);
+	}
+	std::sort(unique_vertices.begin(), unique_vertices.end(),
+	          [](const EdgeVertex& a, const EdgeVertex& b) { return a.key < b.key; });
+	unique_vertices.erase(std::unique(unique_vertices.begin(), unique_vertices.end(),
+	                                  [](const EdgeVertex& a, const EdgeVertex& b) { return a.key == b.key; }),
+	                      unique_vertices.end());
+
+	const int vertex_count = static_cast<int>(unique_vertices.size());
+	ORUtils::MemoryBlock<Vector3f> vertices(vertex_count, MEMORYDEVICE_CPU);
+	Vector3f* vertex_data = vertices.GetData(MEMORYDEVICE_CPU);
+	std::vector<uint64_t> vertex_keys(vertex_count);
+	uint64_t* vertex_key_data = vertex_keys.data();
+	const EdgeVertex* unique_vertex_data = unique_vertices.data();
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(vertex_data, vertex_key_data, unique_vertex_data) firstprivate(vertex_count)
+#endif
+	for (int i_vertex = 0; i_vertex < vertex_count; i_vertex++) {
+		vertex_data[i_vertex] = unique_vertex_data[i_vertex].position;
+		vertex_key_data[i_vertex] = unique_vertex_data[i_vertex].key;
+	}
+
+	// replace vertex keys in triangles by vertex indices
+	ORUtils::MemoryBlock<unsigned int> triangle_vertex_indices(triangle_vertex_key_count, MEMORYDEVICE_CPU);
+	unsigned int* index_data = triangle_vertex_indices.GetData(MEMORYDEVICE_CPU);
+	for (const IndexedMeshThreadBuffer& buffer : thread_buffers) {
+		const uint64_t* key_data = buffer.triangle_vertex_keys.data();
+		const int key_count = static_cast<int>(buffer.triangle_vertex_keys.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(index_data, key_data, vertex_key_data) firstprivate(key_count, vertex_count)
+#endif
+		for (int i_key = 0; i_key < key_count; i_key++) {
+			index_data[i_key] = static_cast<unsigned int>(
+					std::lower_bound(vertex_key_data, vertex_key_data + vertex_count, key_data[i_key]) - vertex_key_data);
+		}
+		index_data += key_count;
+	}
+
+	return Mesh(std::move(vertices), static_cast<unsigned int>(vertex_count), std::move(triangle_vertex_indices),
+	            static_cast<unsigned int>(triangle_vertex_key_count / 3));
+}
+
+} // anonymous namespace
+
+template<class TVoxel>
+Mesh MeshingEngine_CPU<TVoxel, VoxelBlockHash>::MeshVolume(const VoxelVolume<TVoxel, VoxelBlockHash>* volume) {
+	return MeshVolume_Generic(volume, false);
+}
+
+template<class TVoxel>
+Mesh MeshingEngine_CPU<TVoxel, VoxelBlockHash>::MeshVolumeIndexed(const VoxelVolume<TVoxel, VoxelBlockHash>* volume) {
+	return MeshVolume_Generic(volume, true);
+}
+
+template<class TVoxel>
+Mesh MeshingEngine_CPU<TVoxel, VoxelBlockHash>::MeshVolume_Generic(const VoxelVolume<TVoxel, VoxelBlockHash>* volume,
+                                                                   bool indexed) {
+	bool temporary_volume_used = false;
+
+	const VoxelVolume<TVoxel, VoxelBlockHash>* meshing_target_volume;
+	VoxelVolume<TVoxel, VoxelBlockHash>* temporary_volume;
+
+	if (volume->GetMemoryType() == MEMORYDEVICE_CUDA) {
+		temporary_volume_used = true;
+		temporary_volume = new VoxelVolume<TVoxel, VoxelBlockHash>(*volume, MEMORYDEVICE_CPU);
+		meshing_target_volume = temporary_volume;
+	} else {
+		meshing_target_volume = volume;
 	}
 
+	Mesh mesh = indexed ? GenerateIndexedMesh(*meshing_target_volume) : GenerateTriangleSoup(*meshing_target_volume);
+
 	if (temporary_volume_used) {
 		delete temporary_volume;
 	}
-	return Mesh(triangles, triangle_count.load());
-}
\ No newline at end of file
+	return mesh;
+}
@@ -26,6 +26,16 @@ namespace ITMLib
 		 */
 		virtual Mesh MeshVolume(const VoxelVolume<TVoxel,TIndex>* volume) = 0;
 
+		/**
+		 * \brief Runs MarchingCubes on the voxel grid to generate an indexed triangle mesh, where all triangles
+		 * that use the same isosurface crossing of a voxel edge share the one vertex generated for it
+		 * \details Engines that don't support indexed meshing produce the same unindexed mesh as MeshVolume.
+		 * \param volume[in] voxel grid with SDF values
+		 */
+		virtual Mesh MeshVolumeIndexed(const VoxelVolume<TVoxel,TIndex>* volume) {
+			return MeshVolume(volume);
+		}
+
 		virtual ~MeshingEngine() = default;
 	};
 }
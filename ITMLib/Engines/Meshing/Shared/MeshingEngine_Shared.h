@@ -150,6 +150,14 @@ static const _CPU_AND_GPU_CONSTANT_ int triangle_table[256][16] = { { -1, -1, -1
 { 0, 9, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 }, { 0, 3, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
 { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 } };
 
+// offsets of the cube corners, in the order used by findPointNeighbors
+static const _CPU_AND_GPU_CONSTANT_ int cube_corner_offsets[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+	{ 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+
+// for each of the 12 cube edges: the corner at its lower end, the corner at its upper end, and the axis it runs along
+static const _CPU_AND_GPU_CONSTANT_ int edge_corners_and_axes[12][3] = { { 0, 1, 0 }, { 1, 2, 1 }, { 3, 2, 0 }, { 0, 3, 1 },
+	{ 4, 5, 0 }, { 5, 6, 1 }, { 7, 6, 0 }, { 4, 7, 1 }, { 0, 4, 2 }, { 1, 5, 2 }, { 2, 6, 2 }, { 3, 7, 2 } };
+
 //@formatter:on
 template<class TVoxel>
 _CPU_AND_GPU_CODE_ inline bool findPointNeighbors(THREADPTR(Vector3f)* p, THREADPTR(float)* sdf, Vector3i blockLocation,
@@ -214,16 +222,10 @@ interpolateSdf(const THREADPTR(Vector3f)& point1, const THREADPTR(Vector3f)& poi
 
 template<class TVoxel>
 _CPU_AND_GPU_CODE_ inline int
-buildVertexList(THREADPTR(Vector3f)* vertexList, Vector3i hashBlockCornerVoxelPosition, Vector3i voxelPositionWithinBlock,
-                const CONSTPTR(TVoxel)* localVBA, const CONSTPTR(ITMLib::HashEntry)* hashTable) {
-	// cube corner positions
-	Vector3f points[8];
-	// sdf values at corner positions
-	float sdfValues[8];
-
+findCubeIndex(THREADPTR(Vector3f)* points, THREADPTR(float)* sdfValues, Vector3i cubeCornerVoxelPosition,
+              const CONSTPTR(TVoxel)* localVBA, const CONSTPTR(ITMLib::HashEntry)* hashTable) {
 	// effectively, finds values at block's corners (8 voxels)
-	if (!findPointNeighbors(points, sdfValues, hashBlockCornerVoxelPosition + voxelPositionWithinBlock, localVBA,
-	                        hashTable))
+	if (!findPointNeighbors(points, sdfValues, cubeCornerVoxelPosition, localVBA, hashTable))
 		return -1;
 
 	int cubeIndex = 0;
@@ -240,6 +242,22 @@ buildVertexList(THREADPTR(Vector3f)* vertexList, Vector3i hashBlockCornerVoxelPo
 
 	if (edgeTable[cubeIndex] == 0) return -1;
 
+	return cubeIndex;
+}
+
+template<class TVoxel>
+_CPU_AND_GPU_CODE_ inline int
+buildVertexList(THREADPTR(Vector3f)* vertexList, Vector3i hashBlockCornerVoxelPosition, Vector3i voxelPositionWithinBlock,
+                const CONSTPTR(TVoxel)* localVBA, const CONSTPTR(ITMLib::HashEntry)* hashTable) {
+	// cube corner positions
+	Vector3f points[8];
+	// sdf values at corner positions
+	float sdfValues[8];
+
+	int cubeIndex = findCubeIndex(points, sdfValues, hashBlockCornerVoxelPosition + voxelPositionWithinBlock, localVBA,
+	                              hashTable);
+	if (cubeIndex < 0) return -1;
+
 	// generate vertices by traversing the 12 edges of the cube and interpolating them based on the SDF values
 	if (edgeTable[cubeIndex] & 1) vertexList[0] = interpolateSdf(points[0], points[1], sdfValues[0], sdfValues[1]);
 	if (edgeTable[cubeIndex] & 2) vertexList[1] = interpolateSdf(points[1], points[2], sdfValues[1], sdfValues[2]);
@@ -255,4 +273,35 @@ buildVertexList(THREADPTR(Vector3f)* vertexList, Vector3i hashBlockCornerVoxelPo
 	if (edgeTable[cubeIndex] & 2048) vertexList[11] = interpolateSdf(points[3], points[7], sdfValues[3], sdfValues[7]);
 
 	return cubeIndex;
-}
\ No newline at end of file
+}
+
+/**
+ * \brief Runs MarchingCubes on the cubes whose minimum corners lie in the given voxel hash block (host code only)
+ * \param addTriangle function called with the three vertices of each generated triangle, in world units
+ */
+template<class TVoxel, typename TAddTriangleFunction>
+inline void meshBlock(Vector3i hashBlockCornerVoxelPosition, float voxelSize, const TVoxel* localVBA,
+                      const ITMLib::HashEntry* hashTable, TAddTriangleFunction&& addTriangle) {
+	for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
+		for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+			for (int x = 0; x < VOXEL_BLOCK_SIZE; x++) {
+				Vector3f vertexList[12];
+				// build vertices by interpolating edges of cubes that intersect with the isosurface
+				// based on positive/negative SDF values
+				int cubeIndex = buildVertexList(vertexList, hashBlockCornerVoxelPosition, Vector3i(x, y, z), localVBA,
+				                                hashTable);
+
+				// cube does not intersect with the isosurface
+				if (cubeIndex < 0) continue;
+
+				// cube index also tells us how the vertices are grouped into triangles,
+				// use it to look up the vertex indices composing each triangle from the vertex list
+				for (int iVertex = 0; triangle_table[cubeIndex][iVertex] != -1; iVertex += 3) {
+					addTriangle(vertexList[triangle_table[cubeIndex][iVertex]] * voxelSize,
+					            vertexList[triangle_table[cubeIndex][iVertex + 1]] * voxelSize,
+					            vertexList[triangle_table[cubeIndex][iVertex + 2]] * voxelSize);
+				}
+			}
+		}
+	}
+}
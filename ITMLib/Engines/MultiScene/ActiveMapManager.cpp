@@ -2,6 +2,8 @@
 
 #include "ActiveMapManager.h"
 
+#include <cassert>
+
 using namespace ITMLib;
 
 // try loop closures for this number of frames
@@ -465,7 +467,9 @@ bool ActiveMapManager::maintainActiveData()
 			// NOTE: there will only be at most one new local map at
 			// any given time and it's guaranteed to be the last
 			// in the list. Removing this new local map will therefore
-			// not require rearranging indices!
+			// not require rearranging indices (which the incremental
+			// global adjustment relies on)!
+			assert(link.localMapIndex == (int)localMapManager->numLocalMaps() - 1);
 			localMapManager->removeLocalMap(link.localMapIndex);
 			link.type = LOST;
 		}
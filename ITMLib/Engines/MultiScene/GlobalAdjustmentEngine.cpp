@@ -7,6 +7,9 @@
 #include "../../../MiniSlamGraphLib/SlamGraphErrorFunction.h"
 #include "../../../MiniSlamGraphLib/LevenbergMarquardtMethod.h"
 
+#include <algorithm>
+#include <cassert>
+
 #ifndef NO_CPP11
 #include <mutex>
 #include <thread>
@@ -30,11 +33,14 @@ struct GlobalAdjustmentEngine::PrivateData
 #endif
 };
 
-GlobalAdjustmentEngine::GlobalAdjustmentEngine()
+GlobalAdjustmentEngine::GlobalAdjustmentEngine(bool incremental)
 {
 	privateData = new PrivateData();
 	workingData = nullptr;
 	processedData = nullptr;
+	this->incremental = incremental;
+	workingDataChanged = false;
+	hessianSparsityPattern = nullptr;
 }
 
 GlobalAdjustmentEngine::~GlobalAdjustmentEngine()
@@ -42,6 +48,7 @@ GlobalAdjustmentEngine::~GlobalAdjustmentEngine()
 	stopSeparateThread();
 	if (workingData != nullptr) delete workingData;
 	if (processedData != nullptr) delete processedData;
+	InvalidateHessianSparsityPattern();
 	delete privateData;
 }
 
@@ -84,7 +91,8 @@ bool GlobalAdjustmentEngine::updateMeasurements(const MapGraphManager & src)
 	if (!privateData->workingData_mutex.try_lock()) return false;
 
 	if (workingData == nullptr) workingData = new MiniSlamGraph::PoseGraph;
-	MultiSceneToPoseGraph(src, *workingData);
+	if (incremental) workingDataChanged |= MultiSceneToPoseGraphIncremental(src);
+	else MultiSceneToPoseGraph(src, *workingData);
 	privateData->workingData_mutex.unlock();
 #endif
 	return true;
@@ -99,18 +107,41 @@ bool GlobalAdjustmentEngine::runGlobalAdjustment(bool blockingWait)
 	if (blockingWait) privateData->workingData_mutex.lock();
 	else if (!privateData->workingData_mutex.try_lock()) return false;
 
+	// in incremental mode, the graph persists and might already be optimal
+	if (incremental && !workingDataChanged)
+	{
+		privateData->workingData_mutex.unlock();
+		return false;
+	}
+
 	// now Run the actual global adjustment
 	workingData->prepareEvaluations();
 	MiniSlamGraph::SlamGraphErrorFunction errf(*workingData);
+	if (incremental) errf.getHessianSparsityPattern() = hessianSparsityPattern;
 	MiniSlamGraph::SlamGraphErrorFunction::Parameters para(*workingData);
 	MiniSlamGraph::LevenbergMarquardtMethod::minimize(errf, para);
 	workingData->setNodeIndex(para.getNodes());
+	if (incremental)
+	{
+		// keep the symbolic factorisation for the next run instead of letting errf free it
+		hessianSparsityPattern = errf.getHessianSparsityPattern();
+		errf.getHessianSparsityPattern() = nullptr;
+	}
 
 	// copy data to output buffer
 	privateData->processedData_mutex.lock();
 	if (processedData != nullptr) delete processedData;
-	processedData = workingData;
-	workingData = nullptr;
+	if (incremental)
+	{
+		processedData = new MiniSlamGraph::PoseGraph;
+		processedData->setNodeIndex(workingData->getNodeIndex());
+		workingDataChanged = false;
+	}
+	else
+	{
+		processedData = workingData;
+		workingData = nullptr;
+	}
 	privateData->processedData_mutex.unlock();
 
 	privateData->workingData_mutex.unlock();
@@ -192,6 +223,107 @@ void GlobalAdjustmentEngine::MultiSceneToPoseGraph(const MapGraphManager & src,
 	}
 }
 
+bool GlobalAdjustmentEngine::MultiSceneToPoseGraphIncremental(const MapGraphManager & src)
+{
+	bool changed = false;
+	bool structureChanged = false;
+	const int numLocalMaps = (int)src.numLocalMaps();
+
+	// node ids are local map indices, and as local maps are only ever removed from the end (asserted in
+	// ActiveMapManager::maintainActiveData), the nodes of the remaining ones keep their ids and any nodes past the end are gone
+	const MiniSlamGraph::SlamGraph::NodeIndex & nodeIndex = workingData->getNodeIndex();
+	assert(nodeIndex.empty() || (nodeIndex.begin()->first == 0 && nodeIndex.rbegin()->first == (int)nodeIndex.size() - 1));
+	std::vector<int> removedNodeIds;
+	for (MiniSlamGraph::SlamGraph::NodeIndex::const_iterator it = workingData->getNodeIndex().begin(); it != workingData->getNodeIndex().end(); ++it)
+		if (it->first >= numLocalMaps) removedNodeIds.push_back(it->first);
+	for (size_t i = 0; i < removedNodeIds.size(); ++i) workingData->removeNode(removedNodeIds[i]);
+	if (!removedNodeIds.empty()) changed = structureChanged = true;
+
+	// the initial guess for every node is the current estimate of the map graph, i.e. the last result for existing nodes
+	for (int localMapId = 0; localMapId < numLocalMaps; ++localMapId)
+	{
+		const ORUtils::SE3Pose & estimatedPose = src.getEstimatedGlobalPose(localMapId);
+		MiniSlamGraph::SlamGraph::NodeIndex::const_iterator it = workingData->getNodeIndex().find(localMapId);
+		if (it == workingData->getNodeIndex().end())
+		{
+			MiniSlamGraph::GraphNodeSE3 *pose = new MiniSlamGraph::GraphNodeSE3();
+
+			pose->setId(localMapId);
+			pose->setPose(estimatedPose);
+			if (localMapId == 0) pose->setFixed(true);
+
+			workingData->addNode(pose);
+			changed = structureChanged = true;
+			continue;
+		}
+
+		MiniSlamGraph::GraphNodeSE3 *pose = (MiniSlamGraph::GraphNodeSE3*)it->second;
+		if (pose->getPose().GetM() != estimatedPose.GetM())
+		{
+			pose->setPose(estimatedPose);
+			changed = true;
+		}
+	}
+
+	// drop the edges of constraints that no longer exist...
+	for (std::map<std::pair<int, int>, MiniSlamGraph::GraphEdgeSE3*>::iterator it = workingEdges.begin(); it != workingEdges.end(); )
+	{
+		const int fromId = it->first.first, toId = it->first.second;
+		if (fromId < numLocalMaps && toId < numLocalMaps && src.getConstraints(fromId).count(toId) > 0)
+		{
+			++it;
+			continue;
+		}
+		workingData->removeEdge(it->second);
+		it = workingEdges.erase(it);
+		changed = structureChanged = true;
+	}
+
+	// ...then add the new ones and refresh the measurements of the rest
+	for (int localMapId = 0; localMapId < numLocalMaps; ++localMapId)
+	{
+		const ConstraintList & constraints = src.getConstraints(localMapId);
+		for (ConstraintList::const_iterator it = constraints.begin(); it != constraints.end(); ++it)
+		{
+			MiniSlamGraph::GraphEdgeSE3 measurement;
+			measurement.setMeasurementSE3(it->second.GetAccumulatedObservations());
+			double newValues[6];
+			measurement.getMeasurement(newValues);
+
+			MiniSlamGraph::GraphEdgeSE3 *&odometry = workingEdges[std::make_pair(localMapId, it->first)];
+			if (odometry == nullptr)
+			{
+				odometry = new MiniSlamGraph::GraphEdgeSE3();
+				odometry->setFromNodeId(localMapId);
+				odometry->setToNodeId(it->first);
+				odometry->setMeasurement(newValues);
+
+				//TODO odometry->setInformation
+				workingData->addEdge(odometry);
+				changed = structureChanged = true;
+				continue;
+			}
+
+			double oldValues[6];
+			odometry->getMeasurement(oldValues);
+			if (!std::equal(oldValues, oldValues + 6, newValues))
+			{
+				odometry->setMeasurement(newValues);
+				changed = true;
+			}
+		}
+	}
+
+	if (structureChanged) InvalidateHessianSparsityPattern();
+	return changed;
+}
+
+void GlobalAdjustmentEngine::InvalidateHessianSparsityPattern()
+{
+	MiniSlamGraph::SlamGraphErrorFunction::freeHessianSparsityPattern(hessianSparsityPattern);
+	hessianSparsityPattern = nullptr;
+}
+
 void GlobalAdjustmentEngine::PoseGraphToMultiScene(const MiniSlamGraph::PoseGraph & src, MapGraphManager & dest)
 {
 	for (int localMapId = 0; localMapId < (int)dest.numLocalMaps(); ++localMapId) 
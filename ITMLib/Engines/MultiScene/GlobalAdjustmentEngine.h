@@ -2,9 +2,14 @@
 
 #pragma once
 
+#include <map>
+#include <utility>
+
 #include "../../../MiniSlamGraphLib/PoseGraph.h"
 #include "VoxelMapGraphManager.h"
 
+namespace MiniSlamGraph { class GraphEdgeSE3; }
+
 namespace ITMLib {
 
 	/** This engine computes global pose adjustments using pose graph optimisation.
@@ -23,13 +28,22 @@ namespace ITMLib {
 		measurements are being passed, a call to wakeupSeparateThread() is also
 		recommended. The thread will reject new data while a pose graph optimisation
 		is currently in progress, and it may go to sleep otherwise.
+
+		In incremental mode, the pose graph is kept alive between optimisations.
+		updateMeasurements() then only adds or removes the nodes and edges of
+		local maps and constraints that appeared or disappeared and refreshes
+		the initial poses and measurements of the rest, the symbolic
+		factorisation of the Hessian is reused for as long as the structure of
+		the graph stays the same, and
+		runGlobalAdjustment() returns false without solving if nothing changed
+		since the last optimisation.
 	*/
 	class GlobalAdjustmentEngine {
 	private:
 		struct PrivateData;
 
 	public:
-		GlobalAdjustmentEngine();
+		explicit GlobalAdjustmentEngine(bool incremental = false);
 		~GlobalAdjustmentEngine();
 
 		bool hasNewEstimates() const;
@@ -44,6 +58,10 @@ namespace ITMLib {
 		// create a copy of all new measurements and make it busy
 		bool updateMeasurements(const MapGraphManager & src);
 
+		// Run the pose graph optimisation on the current measurements. Returns
+		// false without optimising if there are no measurements or if another
+		// optimisation is in progress (and blockingWait is off), and in
+		// incremental mode also if nothing changed since the last optimisation
 		bool runGlobalAdjustment(bool blockingWait = false);
 
 		bool startSeparateThread();
@@ -55,10 +73,21 @@ namespace ITMLib {
 
 		static void MultiSceneToPoseGraph(const MapGraphManager & src, MiniSlamGraph::PoseGraph & dest);
 		static void PoseGraphToMultiScene(const MiniSlamGraph::PoseGraph & src, MapGraphManager & dest);
+		// brings the persistent pose graph of the incremental mode up to date, returns whether anything changed
+		bool MultiSceneToPoseGraphIncremental(const MapGraphManager & src);
+		void InvalidateHessianSparsityPattern();
 
 		MiniSlamGraph::PoseGraph *workingData;
 		MiniSlamGraph::PoseGraph *processedData;
 
+		bool incremental;
+		// incremental mode only: whether workingData changed since the last optimisation
+		bool workingDataChanged;
+		// incremental mode only: edges of workingData by (from, to) local map id
+		std::map<std::pair<int, int>, MiniSlamGraph::GraphEdgeSE3*> workingEdges;
+		// incremental mode only: symbolic factorisation reused while the structure of workingData is unchanged
+		void *hessianSparsityPattern;
+
 		PrivateData *privateData;
 	};
 }
@@ -22,4 +22,8 @@ template
 class SurfelSceneReconstructionEngine_CPU<Surfel_rgb>;
 template
 class SurfelSceneReconstructionEngine_CPU<Surfel_grey>;
+template
+void RemoveMarkedSurfels_CPU<Surfel_rgb>(SurfelScene<Surfel_rgb>* scene, unsigned int* surfelRemovalMask);
+template
+void RemoveMarkedSurfels_CPU<Surfel_grey>(SurfelScene<Surfel_grey>* scene, unsigned int* surfelRemovalMask);
 } // namespace ITMLib
\ No newline at end of file
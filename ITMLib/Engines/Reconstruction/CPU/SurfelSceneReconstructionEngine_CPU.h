@@ -45,4 +45,16 @@ namespace ITMLib
     /** Override */
     virtual void RemoveMarkedSurfels(SurfelScene<TSurfel> *scene) const;
   };
+
+  //#################### NON-MEMBER FUNCTIONS ####################
+
+  /**
+   * \brief Removes the marked surfels from a scene, keeping the surviving surfels in their original order.
+   *
+   * \param scene              The scene.
+   * \param surfelRemovalMask  One entry per surfel in the scene, 1 for the surfels to remove and 0 otherwise
+   *                           (replaced with its inclusive prefix sum).
+   */
+  template <typename TSurfel>
+  void RemoveMarkedSurfels_CPU(SurfelScene<TSurfel> *scene, unsigned int *surfelRemovalMask);
 }
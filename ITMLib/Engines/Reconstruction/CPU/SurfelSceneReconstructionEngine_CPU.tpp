@@ -1,5 +1,8 @@
 // InfiniTAM: Surffuse. Copyright (c) Torr Vision Group and the authors of InfiniTAM, 2016.
 
+#include <algorithm>
+#include <vector>
+
 #include "SurfelSceneReconstructionEngine_CPU.h"
 
 #include "../Shared/SurfelSceneReconstructionEngine_Shared.h"
@@ -249,9 +252,86 @@ void SurfelSceneReconstructionEngine_CPU<TSurfel>::PreprocessDepthMap(const View
 template <typename TSurfel>
 void SurfelSceneReconstructionEngine_CPU<TSurfel>::RemoveMarkedSurfels(SurfelScene<TSurfel> *scene) const
 {
-  // Remove marked surfels from the scene.
-  // TODO: This is is currently unimplemented on CPU. It's not worth implementing it at the moment,
-  // because we're going to need to change the scene representation to something better anyway.
+  RemoveMarkedSurfels_CPU(scene, this->m_surfelRemovalMaskMB->GetData(MEMORYDEVICE_CPU));
+}
+
+//#################### NON-MEMBER FUNCTIONS ####################
+
+template <typename TSurfel>
+void RemoveMarkedSurfels_CPU(SurfelScene<TSurfel> *scene, unsigned int *surfelRemovalMask)
+{
+  const int surfelCount = static_cast<int>(scene->GetSurfelCount());
+
+  // If the scene is empty, early out.
+  if(surfelCount == 0) return;
+
+  TSurfel *surfels = scene->GetSurfels()->GetData(MEMORYDEVICE_CPU);
+
+  // Replace the removal mask with its inclusive prefix sum. The mask is split into fixed-size chunks
+  // that are scanned in parallel, after which the running totals of the preceding chunks are added on.
+  const int chunkSize = 1 << 16;
+  const int chunkCount = (surfelCount + chunkSize - 1) / chunkSize;
+  std::vector<unsigned int> chunkOffsets(chunkCount + 1, 0);
+
+#ifdef WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for(int chunkId = 0; chunkId < chunkCount; ++chunkId)
+  {
+    const int chunkEnd = std::min(surfelCount, (chunkId + 1) * chunkSize);
+    unsigned int sum = 0;
+    for(int surfelId = chunkId * chunkSize; surfelId < chunkEnd; ++surfelId)
+    {
+      sum += surfelRemovalMask[surfelId];
+      surfelRemovalMask[surfelId] = sum;
+    }
+    chunkOffsets[chunkId + 1] = sum;
+  }
+
+  for(int chunkId = 1; chunkId <= chunkCount; ++chunkId)
+  {
+    chunkOffsets[chunkId] += chunkOffsets[chunkId - 1];
+  }
+
+#ifdef WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for(int chunkId = 1; chunkId < chunkCount; ++chunkId)
+  {
+    const int chunkEnd = std::min(surfelCount, (chunkId + 1) * chunkSize);
+    for(int surfelId = chunkId * chunkSize; surfelId < chunkEnd; ++surfelId)
+    {
+      surfelRemovalMask[surfelId] += chunkOffsets[chunkId];
+    }
+  }
+
+  const unsigned int *removedPrefixSum = surfelRemovalMask;
+  const int removedSurfelCount = static_cast<int>(chunkOffsets[chunkCount]);
+  if(removedSurfelCount == 0) return;
+
+  // Each surviving surfel moves down by the number of removed surfels before it, so the surviving surfels keep their
+  // relative order. Only the surfels from the first removed one onwards move: they are gathered into a scratch buffer
+  // in parallel and then copied back in place.
+  const int keptSurfelCount = surfelCount - removedSurfelCount;
+  const int firstRemovedId =
+    static_cast<int>(std::lower_bound(removedPrefixSum, removedPrefixSum + surfelCount, 1u) - removedPrefixSum);
+  std::vector<TSurfel> keptTail(keptSurfelCount - firstRemovedId);
+
+#ifdef WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for(int surfelId = firstRemovedId + 1; surfelId < surfelCount; ++surfelId)
+  {
+    const unsigned int removedBefore = removedPrefixSum[surfelId - 1];
+    if(removedPrefixSum[surfelId] == removedBefore)
+    {
+      keptTail[surfelId - static_cast<int>(removedBefore) - firstRemovedId] = surfels[surfelId];
+    }
+  }
+
+  std::copy(keptTail.begin(), keptTail.end(), surfels + firstRemovedId);
+
+  scene->DeallocateRemovedSurfels(removedSurfelCount);
 }
 
 }
@@ -15,6 +15,13 @@
 //  ================================================================
 #pragma once
 
+//stdlib
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 //local
 #include "../Interface/VolumeReduction.h"
 #include "../../../Objects/Volume/PlainVoxelArray.h"
@@ -54,6 +61,53 @@ public:
 		return final_result.value;
 	}
 
+	template<typename TStatisticPack>
+	static void ReduceUtilizedStatistics_Generic(const VoxelVolume<TVoxel, PlainVoxelArray>* volume, TStatisticPack& statistics) {
+		const TVoxel* voxels = volume->GetVoxels();
+		const Vector3i volume_size = volume->index.GetVolumeSize();
+		const Vector3i volume_offset = volume->index.GetVolumeOffset();
+		const int row_count = volume_size.y * volume_size.z;
+
+#ifdef WITH_OPENMP
+		const int thread_count = omp_get_max_threads();
+#else
+		const int thread_count = 1;
+#endif
+		TStatisticPack empty_statistics = statistics;
+		empty_statistics.Clear();
+		// one partial per thread, filled in with a static schedule and merged in thread order for reproducible results
+		// (slots of threads the runtime didn't spawn stay empty and merge as no-ops)
+		std::vector<TStatisticPack> thread_partials(thread_count, empty_statistics);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel default(none) firstprivate(row_count, volume_size, volume_offset, empty_statistics) shared(voxels, thread_partials)
+#endif
+		{
+			TStatisticPack partial = empty_statistics;
+#ifdef WITH_OPENMP
+#pragma omp for schedule(static)
+#endif
+			for (int i_row = 0; i_row < row_count; i_row++) {
+				const int y = i_row % volume_size.y;
+				const int z = i_row / volume_size.y;
+				const TVoxel* row_voxels = voxels + i_row * volume_size.x;
+				for (int x = 0; x < volume_size.x; x++) {
+					partial.Accumulate(row_voxels[x], volume_offset + Vector3i(x, y, z));
+				}
+			}
+#ifdef WITH_OPENMP
+			thread_partials[omp_get_thread_num()] = partial;
+#else
+			thread_partials[0] = partial;
+#endif
+		}
+
+		// the caller's initial state is folded in once, as the first operand
+		for (int i_thread = 0; i_thread < thread_count; i_thread++) {
+			statistics.Merge(thread_partials[i_thread]);
+		}
+	}
+
 private:
 	template<typename TReduceBlockLevelStaticFunctor, typename TReduceResultLevelStaticFunctor, typename TOutput, typename TRetrieveFunction>
 	static ReductionResult<TOutput, PlainVoxelArray>
@@ -18,6 +18,11 @@
 #pragma once
 
 #include <thread>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 //threadpool
 #include <threadpool11/threadpool11.hpp>
@@ -28,6 +33,7 @@
 #include "../../../Objects/Volume/VoxelVolume.h"
 #include "../Shared/ReductionResult.h"
 #include "../../../GlobalTemplateDefines.h"
+#include "../../../Utils/Geometry/SpatialIndexConversions.h"
 
 namespace ITMLib {
 
@@ -141,6 +147,59 @@ public:
 		return final_result.value;
 	}
 
+	template<typename TStatisticPack>
+	static void ReduceUtilizedStatistics_Generic(const VoxelVolume<TVoxel, VoxelBlockHash>* volume, TStatisticPack& statistics) {
+		const int utilized_entry_count = volume->index.GetUtilizedBlockCount();
+		const int* utilized_hash_codes = volume->index.GetUtilizedBlockHashCodes();
+		const HashEntry* hash_entries = volume->index.GetEntries();
+		const TVoxel* voxels = volume->GetVoxels();
+
+#ifdef WITH_OPENMP
+		const int thread_count = omp_get_max_threads();
+#else
+		const int thread_count = 1;
+#endif
+		TStatisticPack empty_statistics = statistics;
+		empty_statistics.Clear();
+		// one partial per thread, filled in with a static schedule and merged in thread order for reproducible results
+		// (slots of threads the runtime didn't spawn stay empty and merge as no-ops)
+		std::vector<TStatisticPack> thread_partials(thread_count, empty_statistics);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel default(none) firstprivate(utilized_entry_count, empty_statistics) shared(utilized_hash_codes, hash_entries, voxels, thread_partials)
+#endif
+		{
+			TStatisticPack partial = empty_statistics;
+#ifdef WITH_OPENMP
+#pragma omp for schedule(static)
+#endif
+			for (int i_utilized_block = 0; i_utilized_block < utilized_entry_count; i_utilized_block++) {
+				const HashEntry& entry = hash_entries[utilized_hash_codes[i_utilized_block]];
+				const TVoxel* block_voxels = voxels + (entry.ptr * VOXEL_BLOCK_SIZE3);
+				const Vector3i block_position_voxels = entry.pos.toInt() * VOXEL_BLOCK_SIZE;
+				int i_voxel_in_block = 0;
+				for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
+					for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+						for (int x = 0; x < VOXEL_BLOCK_SIZE; x++, i_voxel_in_block++) {
+							partial.Accumulate(block_voxels[i_voxel_in_block], block_position_voxels + Vector3i(x, y, z));
+						}
+					}
+				}
+				partial.FinishBlock();
+			}
+#ifdef WITH_OPENMP
+			thread_partials[omp_get_thread_num()] = partial;
+#else
+			thread_partials[0] = partial;
+#endif
+		}
+
+		// the caller's initial state is folded in once, as the first operand
+		for (int i_thread = 0; i_thread < thread_count; i_thread++) {
+			statistics.Merge(thread_partials[i_thread]);
+		}
+	}
+
 };
 } // namespace internal
 } // namespace ITMLib
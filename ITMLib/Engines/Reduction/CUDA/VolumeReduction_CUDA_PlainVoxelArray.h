@@ -133,5 +133,31 @@ public:
 		position = ComputePositionVectorFromLinearIndex_PlainVoxelArray(&array_bounds, static_cast<int> (final_result.index_within_array));
 		return final_result.value;
 	}
+
+	template<typename TStatisticPack>
+	static void ReduceUtilizedStatistics_Generic(const VoxelVolume<TVoxel, PlainVoxelArray>* volume, TStatisticPack& statistics) {
+		const TVoxel* voxels = volume->GetVoxels();
+		const Vector3i volume_size = volume->index.GetVolumeSize();
+		const Vector3i volume_offset = volume->index.GetVolumeOffset();
+		const int row_count = volume_size.y * volume_size.z;
+		if (row_count == 0) return;
+
+		TStatisticPack empty_statistics = statistics;
+		empty_statistics.Clear();
+		// one partial per row of voxels along x, merged on the host in row order for reproducible results
+		ORUtils::MemoryBlock<TStatisticPack> row_statistics(row_count, true, true);
+		dim3 cuda_block_size(256);
+		dim3 cuda_grid_size(ceil_of_integer_quotient(row_count, cuda_block_size.x));
+		accumulatePlainVoxelArrayStatistics_RowLevel<<<cuda_grid_size, cuda_block_size>>>
+				(row_statistics.GetData(MEMORYDEVICE_CUDA), empty_statistics, voxels, volume_size, volume_offset);
+		ORcudaKernelCheck;
+		row_statistics.UpdateHostFromDevice();
+
+		const TStatisticPack* row_statistics_CPU = row_statistics.GetData(MEMORYDEVICE_CPU);
+		// the caller's initial state is folded in once, as the first operand
+		for (int i_row = 0; i_row < row_count; i_row++) {
+			statistics.Merge(row_statistics_CPU[i_row]);
+		}
+	}
 };
 } // namespace ITMLib
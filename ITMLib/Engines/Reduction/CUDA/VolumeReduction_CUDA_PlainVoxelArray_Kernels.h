@@ -88,4 +88,22 @@ void computeVoxelHashReduction_ResultLevel(ReductionResult<TOutput, PlainVoxelAr
 	if (thread_id == 0) output[block_id] = shared_data[0];
 }
 
+template<typename TVoxel, typename TStatisticPack>
+__global__
+void accumulatePlainVoxelArrayStatistics_RowLevel(TStatisticPack* row_statistics, const TStatisticPack empty_statistics,
+                                                  const TVoxel* voxels, const Vector3i volume_size, const Vector3i volume_offset) {
+	int i_row = threadIdx.x + blockIdx.x * blockDim.x;
+	if (i_row >= volume_size.y * volume_size.z) return;
+
+	const int y = i_row % volume_size.y;
+	const int z = i_row / volume_size.y;
+	const TVoxel* row_voxels = voxels + i_row * volume_size.x;
+
+	TStatisticPack statistics = empty_statistics;
+	for (int x = 0; x < volume_size.x; x++) {
+		statistics.Accumulate(row_voxels[x], volume_offset + Vector3i(x, y, z));
+	}
+	row_statistics[i_row] = statistics;
+}
+
 } // end anonymous namespace (CUDA kernels)
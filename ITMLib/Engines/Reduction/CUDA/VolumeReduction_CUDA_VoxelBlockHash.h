@@ -118,6 +118,32 @@ public:
 		}
 		return final_result.value;
 	}
+
+	template<typename TStatisticPack>
+	static void ReduceUtilizedStatistics_Generic(const VoxelVolume<TVoxel, VoxelBlockHash>* volume, TStatisticPack& statistics) {
+		const int utilized_entry_count = volume->index.GetUtilizedBlockCount();
+		if (utilized_entry_count == 0) return;
+		const int* utilized_hash_codes = volume->index.GetUtilizedBlockHashCodes();
+		const HashEntry* hash_entries = volume->index.GetEntries();
+		const TVoxel* voxels = volume->GetVoxels();
+
+		TStatisticPack empty_statistics = statistics;
+		empty_statistics.Clear();
+		// one partial per utilized block, merged on the host in block order for reproducible results
+		ORUtils::MemoryBlock<TStatisticPack> block_statistics(utilized_entry_count, true, true);
+		dim3 cuda_block_size(256);
+		dim3 cuda_grid_size(ceil_of_integer_quotient(utilized_entry_count, cuda_block_size.x));
+		accumulateVoxelHashStatistics_BlockLevel<<<cuda_grid_size, cuda_block_size>>>
+				(block_statistics.GetData(MEMORYDEVICE_CUDA), empty_statistics, voxels, hash_entries, utilized_hash_codes, utilized_entry_count);
+		ORcudaKernelCheck;
+		block_statistics.UpdateHostFromDevice();
+
+		const TStatisticPack* block_statistics_CPU = block_statistics.GetData(MEMORYDEVICE_CPU);
+		// the caller's initial state is folded in once, as the first operand
+		for (int i_utilized_block = 0; i_utilized_block < utilized_entry_count; i_utilized_block++) {
+			statistics.Merge(block_statistics_CPU[i_utilized_block]);
+		}
+	}
 };
 } // namespace internal
 } // namespace ITMLib
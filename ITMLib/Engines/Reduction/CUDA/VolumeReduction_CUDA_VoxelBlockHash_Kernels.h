@@ -93,4 +93,29 @@ void computeVoxelHashReduction_ResultLevel(ReductionResult<TOutput, VoxelBlockHa
 	if (thread_id == 0) output[block_id] = shared_data[0];
 }
 
+template<typename TVoxel, typename TStatisticPack>
+__global__
+void accumulateVoxelHashStatistics_BlockLevel(TStatisticPack* block_statistics, const TStatisticPack empty_statistics,
+                                              const TVoxel* voxels, const HashEntry* hash_entries,
+                                              const int* utilized_hash_codes, const int utilized_entry_count) {
+	int i_utilized_hash_block = threadIdx.x + blockIdx.x * blockDim.x;
+	if (i_utilized_hash_block >= utilized_entry_count) return;
+
+	const HashEntry& entry = hash_entries[utilized_hash_codes[i_utilized_hash_block]];
+	const TVoxel* block_voxels = voxels + (entry.ptr * VOXEL_BLOCK_SIZE3);
+	const Vector3i block_position_voxels = entry.pos.toInt() * VOXEL_BLOCK_SIZE;
+
+	TStatisticPack statistics = empty_statistics;
+	int i_voxel_in_block = 0;
+	for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
+		for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+			for (int x = 0; x < VOXEL_BLOCK_SIZE; x++, i_voxel_in_block++) {
+				statistics.Accumulate(block_voxels[i_voxel_in_block], block_position_voxels + Vector3i(x, y, z));
+			}
+		}
+	}
+	statistics.FinishBlock();
+	block_statistics[i_utilized_hash_block] = statistics;
+}
+
 } // end anonymous namespace (CUDA global kernels)
\ No newline at end of file
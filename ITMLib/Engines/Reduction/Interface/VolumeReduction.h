@@ -17,6 +17,7 @@
 
 #include "../../../../ORUtils/MemoryDeviceType.h"
 #include "../Shared/ReductionResult.h"
+#include "../Shared/VolumeStatistics.h"
 #include "../../../Objects/Volume/VoxelVolume.h"
 #include "../../../../ORUtils/CrossPlatformMacros.h"
 #include "../../../Utils/CUDA/CudaCallWrappers.cuh"
@@ -113,6 +114,26 @@ public:
 		return result;
 	}
 
+	/**
+	 * \brief Computes several statistics over all utilized voxels of the volume in a single pass, e.g. counts, sums,
+	 * extrema with their positions and histograms (see Shared/VolumeStatistics.h for the available statistic types).
+	 *
+	 * \details Each statistic comes out holding its state on entry (normally empty) merged with the result. Partial statistics
+	 * are accumulated per thread on the CPU and per voxel block on CUDA devices, and then merged in a fixed order, so the
+	 * result does not depend on thread scheduling.
+	 *
+	 * \tparam TStatistics types of the statistics to compute
+	 * \param volume the volume to compute the statistics over
+	 * \param statistics the statistics to compute
+	 */
+	template<typename... TStatistics>
+	static void ReduceUtilizedStatistics(const VoxelVolume<TVoxel, TIndex>* volume, TStatistics& ... statistics) {
+		StatisticPack<TStatistics...> statistic_pack(statistics...);
+		internal::VolumeReductionEngine_IndexSpecialized<TVoxel, TIndex, TMemoryDeviceType>::
+		ReduceUtilizedStatistics_Generic(volume, statistic_pack);
+		statistic_pack.CopyTo(statistics...);
+	}
+
 };
 
 } // namespace ITMLib
@@ -0,0 +1,317 @@
+#pragma once
+
+//local
+#include "../../../../ORUtils/PlatformIndependence.h"
+#include "../../../Utils/Math.h"
+
+/*
+ * Statistics that can be combined and computed in a single pass over the utilized voxels of a volume via
+ * VolumeReductionEngine::ReduceUtilizedStatistics.
+ *
+ * Every statistic is a small copyable accumulator exposing:
+ *   template<typename TVoxel> void Accumulate(const TVoxel& voxel, const Vector3i& position) -- fold in one voxel
+ *   void FinishBlock() -- called after all voxels of a voxel hash block were accumulated (never for plain voxel arrays)
+ *   void Merge(const Statistic& other) -- fold in a partial result computed over a disjoint set of voxels
+ *   void Clear() -- drop everything accumulated so far, keeping the retrieval functor and any other parameters
+ * Partials start out as cleared copies of the statistic, and the state the statistic has on entry is merged with
+ * them exactly once, so e.g. a count that goes in non-zero is added to, not multiplied by the thread count.
+ * Values are obtained from voxels via a retrieval functor instance with a public "retrieve(const TVoxel&)" function,
+ * same as for VolumeReductionEngine::ReduceUtilized.
+ */
+
+namespace ITMLib {
+namespace internal {
+// strict order on positions (z-major), used to break ties between equal extrema deterministically
+_CPU_AND_GPU_CODE_
+inline bool PositionPrecedes(const Vector3i& position1, const Vector3i& position2) {
+	if (position1.z != position2.z) return position1.z < position2.z;
+	if (position1.y != position2.y) return position1.y < position2.y;
+	return position1.x < position2.x;
+}
+} // namespace internal
+
+/** \brief Sum of the retrieved values, e.g. a count when the retrieval functor returns 0 or 1. */
+template<typename TRetrieveFunctor, typename TValue>
+struct SumStatistic {
+	SumStatistic() = default;
+	explicit SumStatistic(const TRetrieveFunctor& retrieve_functor) : retrieve_functor(retrieve_functor) {}
+
+	TRetrieveFunctor retrieve_functor;
+	TValue sum = TValue(0);
+
+	template<typename TVoxel>
+	_CPU_AND_GPU_CODE_
+	inline void Accumulate(const TVoxel& voxel, const Vector3i& position) {
+		sum += static_cast<TValue>(retrieve_functor.retrieve(voxel));
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void FinishBlock() {}
+
+	_CPU_AND_GPU_CODE_
+	inline void Merge(const SumStatistic& other) {
+		sum += other.sum;
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Clear() {
+		sum = TValue(0);
+	}
+};
+
+/** \brief Minimum of the retrieved values along with the position of the (first, in z-major order) voxel holding it. */
+template<typename TRetrieveFunctor, typename TValue>
+struct MinimumStatistic {
+	MinimumStatistic() = default;
+	explicit MinimumStatistic(const TRetrieveFunctor& retrieve_functor) : retrieve_functor(retrieve_functor) {}
+
+	TRetrieveFunctor retrieve_functor;
+	TValue value = TValue(0);
+	Vector3i position = Vector3i(0);
+	// false until at least one voxel was accumulated
+	bool found = false;
+
+	template<typename TVoxel>
+	_CPU_AND_GPU_CODE_
+	inline void Accumulate(const TVoxel& voxel, const Vector3i& voxel_position) {
+		Update(static_cast<TValue>(retrieve_functor.retrieve(voxel)), voxel_position);
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void FinishBlock() {}
+
+	_CPU_AND_GPU_CODE_
+	inline void Merge(const MinimumStatistic& other) {
+		if (other.found) Update(other.value, other.position);
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Clear() {
+		value = TValue(0);
+		position = Vector3i(0);
+		found = false;
+	}
+
+private:
+	_CPU_AND_GPU_CODE_
+	inline void Update(TValue candidate_value, const Vector3i& candidate_position) {
+		if (!found || candidate_value < value ||
+		    (candidate_value == value && internal::PositionPrecedes(candidate_position, position))) {
+			value = candidate_value;
+			position = candidate_position;
+			found = true;
+		}
+	}
+};
+
+/** \brief Maximum of the retrieved values along with the position of the (first, in z-major order) voxel holding it. */
+template<typename TRetrieveFunctor, typename TValue>
+struct MaximumStatistic {
+	MaximumStatistic() = default;
+	explicit MaximumStatistic(const TRetrieveFunctor& retrieve_functor) : retrieve_functor(retrieve_functor) {}
+
+	TRetrieveFunctor retrieve_functor;
+	TValue value = TValue(0);
+	Vector3i position = Vector3i(0);
+	// false until at least one voxel was accumulated
+	bool found = false;
+
+	template<typename TVoxel>
+	_CPU_AND_GPU_CODE_
+	inline void Accumulate(const TVoxel& voxel, const Vector3i& voxel_position) {
+		Update(static_cast<TValue>(retrieve_functor.retrieve(voxel)), voxel_position);
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void FinishBlock() {}
+
+	_CPU_AND_GPU_CODE_
+	inline void Merge(const MaximumStatistic& other) {
+		if (other.found) Update(other.value, other.position);
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Clear() {
+		value = TValue(0);
+		position = Vector3i(0);
+		found = false;
+	}
+
+private:
+	_CPU_AND_GPU_CODE_
+	inline void Update(TValue candidate_value, const Vector3i& candidate_position) {
+		if (!found || candidate_value > value ||
+		    (candidate_value == value && internal::PositionPrecedes(candidate_position, position))) {
+			value = candidate_value;
+			position = candidate_position;
+			found = true;
+		}
+	}
+};
+
+/**
+ * \brief Histogram of the retrieved values over TBinCount uniform bins spanning [minimum, maximum].
+ * \details Values equal to maximum go to the last bin, values outside of the range are only counted in out_of_range_count.
+ */
+template<typename TRetrieveFunctor, int TBinCount>
+struct HistogramStatistic {
+	HistogramStatistic() = default;
+	HistogramStatistic(const TRetrieveFunctor& retrieve_functor, float minimum, float maximum)
+			: retrieve_functor(retrieve_functor), minimum(minimum), maximum(maximum) {}
+
+	TRetrieveFunctor retrieve_functor;
+	float minimum = 0.0f;
+	float maximum = 1.0f;
+	unsigned int bin_counts[TBinCount] = {};
+	unsigned int out_of_range_count = 0u;
+
+	template<typename TVoxel>
+	_CPU_AND_GPU_CODE_
+	inline void Accumulate(const TVoxel& voxel, const Vector3i& position) {
+		const float value = static_cast<float>(retrieve_functor.retrieve(voxel));
+		if (value < minimum || value > maximum || maximum <= minimum) {
+			out_of_range_count++;
+			return;
+		}
+		const int bin_index = ORUTILS_MIN(TBinCount - 1, static_cast<int>((value - minimum) * TBinCount / (maximum - minimum)));
+		bin_counts[bin_index]++;
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void FinishBlock() {}
+
+	_CPU_AND_GPU_CODE_
+	inline void Merge(const HistogramStatistic& other) {
+		for (int i_bin = 0; i_bin < TBinCount; i_bin++) {
+			bin_counts[i_bin] += other.bin_counts[i_bin];
+		}
+		out_of_range_count += other.out_of_range_count;
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Clear() {
+		for (int i_bin = 0; i_bin < TBinCount; i_bin++) {
+			bin_counts[i_bin] = 0u;
+		}
+		out_of_range_count = 0u;
+	}
+};
+
+/**
+ * \brief Count of voxel hash blocks for which the retrieval functor returns a non-zero value at every voxel.
+ * \details Only meaningful for volumes indexed by a voxel block hash, remains zero for plain voxel arrays.
+ */
+template<typename TRetrieveFunctor>
+struct BlockCountStatistic {
+	BlockCountStatistic() = default;
+	explicit BlockCountStatistic(const TRetrieveFunctor& retrieve_functor) : retrieve_functor(retrieve_functor) {}
+
+	TRetrieveFunctor retrieve_functor;
+	unsigned int count = 0u;
+	// whether the predicate held for every voxel of the current block accumulated so far
+	bool current_block_matches = true;
+
+	template<typename TVoxel>
+	_CPU_AND_GPU_CODE_
+	inline void Accumulate(const TVoxel& voxel, const Vector3i& position) {
+		current_block_matches = current_block_matches && static_cast<bool>(retrieve_functor.retrieve(voxel));
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void FinishBlock() {
+		if (current_block_matches) count++;
+		current_block_matches = true;
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Merge(const BlockCountStatistic& other) {
+		count += other.count;
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Clear() {
+		count = 0u;
+		current_block_matches = true;
+	}
+};
+
+/**
+ * \brief Compile-time tuple of statistics that are all accumulated together, voxel by voxel.
+ * \details Plain recursive aggregate rather than std::tuple, so that it can be used and copied in device code.
+ */
+template<typename... TStatistics>
+struct StatisticPack;
+
+template<typename TStatistic>
+struct StatisticPack<TStatistic> {
+	StatisticPack() = default;
+	explicit StatisticPack(const TStatistic& head) : head(head) {}
+
+	TStatistic head;
+
+	template<typename TVoxel>
+	_CPU_AND_GPU_CODE_
+	inline void Accumulate(const TVoxel& voxel, const Vector3i& position) {
+		head.Accumulate(voxel, position);
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void FinishBlock() {
+		head.FinishBlock();
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Merge(const StatisticPack& other) {
+		head.Merge(other.head);
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Clear() {
+		head.Clear();
+	}
+
+	void CopyTo(TStatistic& head_out) const {
+		head_out = head;
+	}
+};
+
+template<typename THeadStatistic, typename... TTailStatistics>
+struct StatisticPack<THeadStatistic, TTailStatistics...> {
+	StatisticPack() = default;
+	explicit StatisticPack(const THeadStatistic& head, const TTailStatistics& ... tail) : head(head), tail(tail...) {}
+
+	THeadStatistic head;
+	StatisticPack<TTailStatistics...> tail;
+
+	template<typename TVoxel>
+	_CPU_AND_GPU_CODE_
+	inline void Accumulate(const TVoxel& voxel, const Vector3i& position) {
+		head.Accumulate(voxel, position);
+		tail.Accumulate(voxel, position);
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void FinishBlock() {
+		head.FinishBlock();
+		tail.FinishBlock();
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Merge(const StatisticPack& other) {
+		head.Merge(other.head);
+		tail.Merge(other.tail);
+	}
+
+	_CPU_AND_GPU_CODE_
+	inline void Clear() {
+		head.Clear();
+		tail.Clear();
+	}
+
+	void CopyTo(THeadStatistic& head_out, TTailStatistics& ... tail_out) const {
+		head_out = head;
+		tail.CopyTo(tail_out...);
+	}
+};
+
+} // namespace ITMLib
@@ -173,6 +173,7 @@ void RenderingEngine<TVoxel, TIndex, TMemoryDeviceType>::ForwardRender(
 	ImageTraversalEngine<TMemoryDeviceType>::template TraversePositionOnly(render_state->raycastResult, find_missing_points_functor);
 	render_state->noFwdProjMissingPoints = find_missing_points_functor.GetMissingPointCount();
 
+	specialized_engine.PrepareForRaycasting(volume);
 	RaycastMissingPointsFunctor<TVoxel, TIndex, TMemoryDeviceType> raycast_missing_points_functor(
 			*volume, view->calibration_information.intrinsics_d.projectionParamsSimple.all, camera_tracking_state->pose_d->GetInvM(),
 			*render_state->renderingRangeImage);
@@ -198,6 +199,7 @@ void RenderingEngine<TVoxel, TIndex, TMemoryDeviceType>::GenericRaycast(
 		const Vector4f& camera_projection_parameters, const RenderState* render_state, bool update_visible_list) const {
 
 	bool update_visibility_information = update_visible_list && RaycastingTraits<TIndex>::has_visibility_information;
+	specialized_engine.PrepareForRaycasting(volume);
 
 	if (update_visibility_information) {
 		RaycastFunctor<TVoxel, TIndex, TMemoryDeviceType, true> functor(
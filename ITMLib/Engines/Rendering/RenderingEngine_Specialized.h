@@ -32,6 +32,8 @@ struct RenderingEngine_Specialized<TVoxel, PlainVoxelArray, TMemoryDeviceType> {
 
 	inline void CreateExpectedDepths(const VoxelVolume <TVoxel, PlainVoxelArray>* volume, const ORUtils::SE3Pose* pose, const Intrinsics* intrinsics,
 	                                 RenderState* render_state) const;
+
+	inline void PrepareForRaycasting(const VoxelVolume <TVoxel, PlainVoxelArray>* volume) const {}
 };
 
 template<class TVoxel, MemoryDeviceType TMemoryDeviceType>
@@ -43,6 +45,15 @@ struct RenderingEngine_Specialized<TVoxel, VoxelBlockHash, TMemoryDeviceType> {
 
 	inline void CreateExpectedDepths(const VoxelVolume <TVoxel, VoxelBlockHash>* volume, const ORUtils::SE3Pose* pose, const Intrinsics* intrinsics,
 	                                 RenderState* render_state) const;
+
+	/** \brief Bring the block occupancy bits of the index up to date, so that rays can skip empty space */
+	inline void PrepareForRaycasting(const VoxelVolume <TVoxel, VoxelBlockHash>* volume) const;
+private:
+	/**
+	 * \brief Rebuild the coarse block grid (CPU only, see VoxelBlockHash::CoarseBlockGrid) and the block occupancy
+	 * bits of the index, if they are out of date with the utilized blocks
+	 */
+	inline void UpdateUtilizedBlockCaches(const VoxelBlockHash& index) const;
 };
 
 } // namespace internal
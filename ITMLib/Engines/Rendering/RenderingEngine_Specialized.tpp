@@ -15,7 +15,12 @@
 //  ================================================================
 #pragma once
 
+//stdlib
+#include <algorithm>
+
+//local
 #include "../Traversal/Interface/Regular2DSubGridArrayTraversal.h"
+#include "../Traversal/Interface/RawArrayTraversal.h"
 #include "../../../ORUtils/CrossPlatformMacros.h"
 #include "RenderingEngine_Specialized.h"
 #include "Shared/RenderingEngine_Shared.h"
@@ -60,6 +65,38 @@ int RenderingEngine_Specialized<TVoxel, VoxelBlockHash, TMemoryDeviceType>::Coun
 	return functor.GetCurrentVisibleBlockInIDRangeCount();
 }
 
+template<class TVoxel, MemoryDeviceType TMemoryDeviceType>
+void RenderingEngine_Specialized<TVoxel, VoxelBlockHash, TMemoryDeviceType>::UpdateUtilizedBlockCaches(
+		const VoxelBlockHash& index) const {
+	VoxelBlockHash::CoarseBlockGrid& coarse_block_grid = index.GetCoarseBlockGrid();
+	const bool rebuild_coarse_block_grid = TMemoryDeviceType == MEMORYDEVICE_CPU && !coarse_block_grid.up_to_date;
+	const bool rebuild_block_occupancy_bits = index.GetBlockOccupancyBits() == nullptr;
+	if (!rebuild_coarse_block_grid && !rebuild_block_occupancy_bits) return;
+
+	const int utilized_block_count = index.GetUtilizedBlockCount();
+	ORUtils::MemoryBlock<Vector3s> block_positions(utilized_block_count, true, TMemoryDeviceType == MEMORYDEVICE_CUDA);
+	ORUtils::MemoryBlock<int> block_hash_codes(utilized_block_count, true, TMemoryDeviceType == MEMORYDEVICE_CUDA);
+	if (utilized_block_count > 0) {
+		GatherBlockPositionsFunctor<TMemoryDeviceType> gather_functor(index, block_positions, block_hash_codes);
+		RawArrayTraversalEngine<TMemoryDeviceType>::TraverseWithIndex(index.GetUtilizedBlockHashCodes(), gather_functor, utilized_block_count);
+		if (TMemoryDeviceType == MEMORYDEVICE_CUDA) {
+			block_positions.UpdateHostFromDevice();
+		}
+	}
+	if (rebuild_coarse_block_grid) {
+		coarse_block_grid.Rebuild(block_positions.GetData(MEMORYDEVICE_CPU), block_hash_codes.GetData(MEMORYDEVICE_CPU), utilized_block_count);
+	}
+	if (rebuild_block_occupancy_bits) {
+		index.RebuildBlockOccupancyBits(block_positions.GetData(MEMORYDEVICE_CPU), utilized_block_count);
+	}
+}
+
+template<class TVoxel, MemoryDeviceType TMemoryDeviceType>
+void RenderingEngine_Specialized<TVoxel, VoxelBlockHash, TMemoryDeviceType>::PrepareForRaycasting(
+		const VoxelVolume<TVoxel, VoxelBlockHash>* volume) const {
+	UpdateUtilizedBlockCaches(volume->index);
+}
+
 template<class TVoxel, MemoryDeviceType TMemoryDeviceType>
 void RenderingEngine_Specialized<TVoxel, VoxelBlockHash, TMemoryDeviceType>::CreateExpectedDepths(
 		const VoxelVolume<TVoxel, VoxelBlockHash>* volume, const ORUtils::SE3Pose* pose, const Intrinsics* intrinsics,
@@ -71,17 +108,42 @@ void RenderingEngine_Specialized<TVoxel, VoxelBlockHash, TMemoryDeviceType>::Cre
 
 	auto depth_image_size = render_state->renderingRangeImage->dimensions;
 	float voxel_size = volume->GetParameters().voxel_size;
-	//TODO: optimize by making rendering_blocks a member variable to avoid repeated allocations & deallocations (requires converting it to raw pointer or removing const-ness from the function)
-	ORUtils::MemoryBlock<RenderingBlock> rendering_blocks(ITMLib::MAX_RENDERING_BLOCKS, TMemoryDeviceType);
-	ProjectAndSplitBlocksFunctor<TMemoryDeviceType> project_and_split_blocks_functor(
-			rendering_blocks, pose->GetM(), intrinsics->projectionParamsSimple.all, depth_image_size, voxel_size);
+	const Matrix4f camera_pose = pose->GetM();
+	const Vector4f projection_parameters = intrinsics->projectionParamsSimple.all;
 
-	//TODO: (potential optimization) figure out whether using the "Visible" list instead of the "Utilized" list makes more sense here (and how to account for visible
-	// list staying up-to-date in canonical.
-	// the visible list is only reliable if it's up-to-date. If you can ensure that it is, and keeping it up-to-date takes less resources than using the
-	// bigger "utilized" list, change this back to "Visible" list like it was in the original InfiniTAM repo.
-
-	HashTableTraversalEngine<TMemoryDeviceType>::template TraverseUtilized_Padded(volume->index, project_and_split_blocks_functor);
+	// the rendering block buffer persists in the render state, so it's only allocated on first use
+	ORUtils::MemoryBlock<RenderingBlock>& rendering_blocks = *render_state->renderingBlocks;
+	if (rendering_blocks.size() < ITMLib::MAX_RENDERING_BLOCKS) rendering_blocks.Resize(ITMLib::MAX_RENDERING_BLOCKS, false);
+	ProjectAndSplitBlocksFunctor<TMemoryDeviceType> project_and_split_blocks_functor(
+			rendering_blocks, camera_pose, projection_parameters, depth_image_size, voxel_size);
+
+	if (TMemoryDeviceType == MEMORYDEVICE_CPU) {
+		// only project the blocks in the cells of the coarse block grid that intersect the view frustum
+		UpdateUtilizedBlockCaches(volume->index);
+		const VoxelBlockHash::CoarseBlockGrid& coarse_block_grid = volume->index.GetCoarseBlockGrid();
+		ORUtils::MemoryBlock<int>& candidate_block_hash_codes = *render_state->candidateBlockHashCodes;
+		candidate_block_hash_codes.Resize(coarse_block_grid.block_hash_codes.size(), false);
+		int* candidate_block_hash_codes_host = candidate_block_hash_codes.GetData(MEMORYDEVICE_CPU);
+		int candidate_block_count = 0;
+		for (int i_cell = 0; i_cell < static_cast<int>(coarse_block_grid.cell_positions.size()); i_cell++) {
+			if (!BlockBoxMayProject(coarse_block_grid.cell_positions[i_cell] * COARSE_BLOCK_GRID_CELL_SIZE, COARSE_BLOCK_GRID_CELL_SIZE,
+			                        camera_pose, projection_parameters, depth_image_size, voxel_size)) {
+				continue;
+			}
+			const int cell_block_start = coarse_block_grid.cell_block_starts[i_cell];
+			const int cell_block_end = coarse_block_grid.cell_block_starts[i_cell + 1];
+			std::copy(coarse_block_grid.block_hash_codes.begin() + cell_block_start,
+			          coarse_block_grid.block_hash_codes.begin() + cell_block_end,
+			          candidate_block_hash_codes_host + candidate_block_count);
+			candidate_block_count += cell_block_end - cell_block_start;
+		}
+		if (candidate_block_count == 0) return;
+		HashTableTraversalEngine<TMemoryDeviceType>::template TraverseSample_Padded(
+				volume->index, candidate_block_hash_codes_host, candidate_block_count, project_and_split_blocks_functor);
+	} else {
+		// the coarse block grid is only kept for CPU volumes (see VoxelBlockHash::CoarseBlockGrid)
+		HashTableTraversalEngine<TMemoryDeviceType>::template TraverseUtilized_Padded(volume->index, project_and_split_blocks_functor);
+	}
 	unsigned int final_rendering_block_count = project_and_split_blocks_functor.GetRenderingBlockCount();
 	// this bounding is necessary due to prefix sums potentially used when parallelization is on (see comment in functor)
 	if(final_rendering_block_count >= MAX_RENDERING_BLOCKS) final_rendering_block_count = MAX_RENDERING_BLOCKS;
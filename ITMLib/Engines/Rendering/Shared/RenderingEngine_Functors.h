@@ -120,6 +120,26 @@ public: // instance functions
 	}
 };
 
+template<MemoryDeviceType TMemoryDeviceType>
+struct GatherBlockPositionsFunctor {
+private: // instance variables
+	const HashEntry* hash_entries;
+	Vector3s* block_positions;
+	int* block_hash_codes;
+public: // instance functions
+	GatherBlockPositionsFunctor(const VoxelBlockHash& index, ORUtils::MemoryBlock<Vector3s>& block_positions,
+	                            ORUtils::MemoryBlock<int>& block_hash_codes)
+			: hash_entries(index.GetEntries()),
+			  block_positions(block_positions.GetData(TMemoryDeviceType)),
+			  block_hash_codes(block_hash_codes.GetData(TMemoryDeviceType)) {}
+
+	_DEVICE_WHEN_AVAILABLE_
+	inline void operator()(const int& hash_code, const int i_block) {
+		block_positions[i_block] = hash_entries[hash_code].pos;
+		block_hash_codes[i_block] = hash_code;
+	}
+};
+
 template<MemoryDeviceType TMemoryDeviceType>
 struct ProjectAndSplitBlocksFunctor {
 private: // instance variables
@@ -221,6 +241,19 @@ template<>
 inline HashBlockVisibility* GetBlockVisibilityTypesIfAvailable<PlainVoxelArray>(PlainVoxelArray& index) {
 	return nullptr;
 }
+
+template<typename TIndex>
+static inline const unsigned int* GetBlockOccupancyBitsIfAvailable(const TIndex& index);
+
+template<>
+inline const unsigned int* GetBlockOccupancyBitsIfAvailable<VoxelBlockHash>(const VoxelBlockHash& index) {
+	return index.GetBlockOccupancyBits();
+}
+
+template<>
+inline const unsigned int* GetBlockOccupancyBitsIfAvailable<PlainVoxelArray>(const PlainVoxelArray& index) {
+	return nullptr;
+}
 } // namespace internal
 
 //#if !defined(WITH_OPENMP) && !defined(__CUDACC__)
@@ -241,12 +274,14 @@ struct RaycastFunctor {
 //#endif
 	const Vector2f* ray_depth_range_image;
 	const int ray_depth_image_width;
+	const unsigned int* block_occupancy_bits;
 
 
 public: // instance functions
 	RaycastFunctor(VoxelVolume<TVoxel, TIndex>& volume, const ORUtils::Image<Vector2f>& ray_depth_range_image,
 	               const Vector4f& inverted_camera_projection_parameters, const Matrix4f inverted_camera_pose)
-			: inverted_camera_projection_parameters(inverted_camera_projection_parameters),
+			: block_visibility_types(internal::GetBlockVisibilityTypesIfAvailable(volume.index)),
+			  inverted_camera_projection_parameters(inverted_camera_projection_parameters),
 			  inverted_camera_pose(inverted_camera_pose),
 			  truncation_distance(volume.GetParameters().truncation_distance),
 			  voxel_size_reciprocal(1.0f / volume.GetParameters().voxel_size),
@@ -254,7 +289,7 @@ public: // instance functions
 			  index_data(volume.index.GetIndexData()),
 			  ray_depth_range_image(ray_depth_range_image.GetData(TMemoryDeviceType)),
 			  ray_depth_image_width(ray_depth_range_image.dimensions.width),
-			  block_visibility_types(internal::GetBlockVisibilityTypesIfAvailable(volume.index)) {}
+			  block_occupancy_bits(internal::GetBlockOccupancyBitsIfAvailable(volume.index)) {}
 
 	_DEVICE_WHEN_AVAILABLE_
 	inline void operator()(Vector4f& point, const int x, const int y) {
@@ -263,7 +298,7 @@ public: // instance functions
 		                                                        (y / ray_depth_image_subsampling_factor) * ray_depth_image_width];
 		CastRay<TVoxel, TIndex, TModifyVisibilityInformation>(
 				point, block_visibility_types, x, y, voxels, index_data, inverted_camera_pose, inverted_camera_projection_parameters,
-				voxel_size_reciprocal, truncation_distance, ray_depth_range
+				voxel_size_reciprocal, truncation_distance, ray_depth_range, block_occupancy_bits
 //#ifdef SINGLE_THREADED
 //				, cache
 //#endif
@@ -493,6 +528,7 @@ private: // instance variables
 	const typename TIndex::IndexData* index_data;
 	const Vector2f* pixel_ray_depth_range_data;
 	const int ray_depth_range_image_width;
+	const unsigned int* block_occupancy_bits;
 
 public: // instance functions
 	RaycastMissingPointsFunctor(const VoxelVolume<TVoxel, TIndex>& volume,
@@ -505,7 +541,8 @@ public: // instance functions
 			  voxels(volume.GetVoxels()),
 			  index_data(volume.index.GetIndexData()),
 			  pixel_ray_depth_range_data(pixel_ray_depth_range_image.GetData(TMemoryDeviceType)),
-			  ray_depth_range_image_width(pixel_ray_depth_range_image.dimensions.x) {}
+			  ray_depth_range_image_width(pixel_ray_depth_range_image.dimensions.x),
+			  block_occupancy_bits(internal::GetBlockOccupancyBitsIfAvailable(volume.index)) {}
 
 	_DEVICE_WHEN_AVAILABLE_
 	inline void operator()(Vector4f& point, const int x, const int y) {
@@ -515,7 +552,7 @@ public: // instance functions
 		CastRay<TVoxel, TIndex, false>(point, nullptr, x, y, voxels,
 		                               index_data, inverted_camera_pose, inverted_camera_projection_parameters,
 		                               voxel_size_reciprocal, truncation_distance,
-		                               pixel_ray_depth_range_data[ray_ranges_pixel_index]);
+		                               pixel_ray_depth_range_data[ray_ranges_pixel_index], block_occupancy_bits);
 	}
 };
 
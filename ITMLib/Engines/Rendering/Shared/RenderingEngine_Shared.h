@@ -69,6 +69,42 @@ ProjectSingleBlock(const THREADPTR(Vector3s)& blockPos, const THREADPTR(Matrix4f
 	return true;
 }
 
+/**
+ * \brief Conservative check of whether any block inside an axis-aligned box of blocks could affect the part of the ray
+ * depth range image that ray casting reads, i.e. its upper-left imgSize / ray_depth_image_subsampling_factor pixels.
+ * \details The box is rejected only if all of its corners lie on the far side of one of the planes bounding the view
+ * frustum of that part of the image, in which case the whole box does. Note that ProjectSingleBlock accepts any block
+ * with a corner in front of the camera, even one closer than VERY_CLOSE, so the frustum is cut just in front of the camera.
+ * \param min_block_position position of the block at the minimal corner of the box, in blocks
+ * \param box_block_size edge length of the box, in blocks
+ */
+inline bool BlockBoxMayProject(const Vector3s& min_block_position, int box_block_size, const Matrix4f& pose,
+                               const Vector4f& intrinsics, const Vector2i& imgSize, float voxelSize) {
+	const float subsampling_factor = static_cast<float>(ray_depth_image_subsampling_factor);
+	const Vector2f read_image_size((float) ((imgSize.x - 1) / ray_depth_image_subsampling_factor + 1),
+	                               (float) ((imgSize.y - 1) / ray_depth_image_subsampling_factor + 1));
+	// count of corners behind the camera and beyond the left, right, top, and bottom image bounds, respectively
+	int beyond_plane_counts[5] = {0, 0, 0, 0, 0};
+	for (int corner = 0; corner < 8; ++corner) {
+		Vector3f corner_block_position = TO_FLOAT3(min_block_position);
+		corner_block_position.x += (corner & 1) ? box_block_size : 0;
+		corner_block_position.y += (corner & 2) ? box_block_size : 0;
+		corner_block_position.z += (corner & 4) ? box_block_size : 0;
+		Vector4f pt3d(corner_block_position * (float) VOXEL_BLOCK_SIZE * voxelSize, 1.0f);
+		pt3d = pose * pt3d;
+		if (pt3d.z < 1e-6) beyond_plane_counts[0]++;
+		// image bounds, with the projection multiplied out by the depth so that the planes extend behind the camera
+		if (intrinsics.x * pt3d.x + (intrinsics.z + subsampling_factor) * pt3d.z < 0.0f) beyond_plane_counts[1]++;
+		if (intrinsics.x * pt3d.x + (intrinsics.z - subsampling_factor * read_image_size.x) * pt3d.z > 0.0f) beyond_plane_counts[2]++;
+		if (intrinsics.y * pt3d.y + (intrinsics.w + subsampling_factor) * pt3d.z < 0.0f) beyond_plane_counts[3]++;
+		if (intrinsics.y * pt3d.y + (intrinsics.w - subsampling_factor * read_image_size.y) * pt3d.z > 0.0f) beyond_plane_counts[4]++;
+	}
+	for (int beyond_plane_count : beyond_plane_counts) {
+		if (beyond_plane_count == 8) return false;
+	}
+	return true;
+}
+
 _CPU_AND_GPU_CODE_ inline void CreateRenderingBlocks(DEVICEPTR(RenderingBlock)* rendering_block_list, int offset,
                                                      const THREADPTR(Vector2i)& upper_left, const THREADPTR(Vector2i)& lower_right,
                                                      const THREADPTR(Vector2f)& z_range) {
@@ -144,12 +180,35 @@ struct ReadWithConfidenceFromSdfFloatInterpolated<false, true, TVoxel, TIndex, T
 //#define SINGLE_THREADED
 //#endif
 
+/**
+ * \brief Distance along a ray, starting inside an axis-aligned box, to the point where the ray leaves the box.
+ * \param box_min minimum corner of the box
+ * \param box_size edge length of the (cube-shaped) box
+ */
+_CPU_AND_GPU_CODE_ inline float DistanceToBoxExit(const THREADPTR(Vector3f)& origin, const THREADPTR(Vector3f)& direction,
+                                                  const THREADPTR(Vector3f)& box_min, float box_size) {
+	float distance = 1e30f;
+	if (direction.x != 0.0f) distance = ORUTILS_MIN(distance, ((direction.x > 0.0f ? box_min.x + box_size : box_min.x) - origin.x) / direction.x);
+	if (direction.y != 0.0f) distance = ORUTILS_MIN(distance, ((direction.y > 0.0f ? box_min.y + box_size : box_min.y) - origin.y) / direction.y);
+	if (direction.z != 0.0f) distance = ORUTILS_MIN(distance, ((direction.z > 0.0f ? box_min.z + box_size : box_min.z) - origin.z) / direction.z);
+	return distance;
+}
+
+/**
+ * \brief March along the ray through pixel (x, y) until it crosses the surface (zero level set) or leaves the depth range.
+ * \param occupancy_bits optional block occupancy bits (see VoxelBlockHash::GetBlockOccupancyBits). When provided, a sample
+ * that falls in a block known to be unallocated is followed by a single leap past that block, or past its whole coarse
+ * block grid cell if the cell is known to be empty. The leap lands on the first of the VOXEL_BLOCK_SIZE-spaced samples
+ * that the march would have taken without the occupancy bits beyond the empty region, so the samples taken outside
+ * empty regions are the same either way (up to floating-point rounding).
+ */
 template<typename TVoxel, typename TIndex,
 		bool TModifyVisibilityInformation>
 _CPU_AND_GPU_CODE_ inline bool CastRay(DEVICEPTR(Vector4f)& point, DEVICEPTR(ITMLib::HashBlockVisibility)* block_visibility_types,
                                        int x, int y, const CONSTPTR(TVoxel)* voxels, const CONSTPTR(typename TIndex::IndexData)* index_data,
                                        Matrix4f inverted_camera_matrix, Vector4f inverted_camera_projection_parameters,
-                                       float voxel_size_reciprocal, float truncation_distance, const CONSTPTR(Vector2f)& ray_depth_range) {
+                                       float voxel_size_reciprocal, float truncation_distance, const CONSTPTR(Vector2f)& ray_depth_range,
+                                       const CONSTPTR(unsigned int)* occupancy_bits = nullptr) {
 	const Vector4f& inverted_projection = inverted_camera_projection_parameters;
 
 	Vector4f point_in_camera_space;
@@ -185,6 +244,30 @@ _CPU_AND_GPU_CODE_ inline bool CastRay(DEVICEPTR(Vector4f)& point, DEVICEPTR(ITM
 	typename TIndex::IndexCache cache;
 //#endif
 	while (distance_along_ray_voxels < distance_to_ray_end_length_voxels) {
+		if (occupancy_bits != nullptr) {
+			Vector3i block_position;
+			pointToVoxelBlockPos(Vector3i((int) ROUND(march_point_world_space_voxels.x), (int) ROUND(march_point_world_space_voxels.y),
+			                              (int) ROUND(march_point_world_space_voxels.z)), block_position);
+			if (!BlockMayBeOccupied(occupancy_bits, block_position)) {
+				// same as reading a default-constructed voxel from an unallocated block, see below
+				sdf_value = 1.0f;
+				const Vector3i cell_position = BlockPositionToCoarseCellPosition(block_position);
+				const bool cell_is_empty = !CellMayBeOccupied(occupancy_bits, cell_position);
+				const int empty_region_size_voxels = cell_is_empty ? COARSE_BLOCK_GRID_CELL_SIZE * VOXEL_BLOCK_SIZE : VOXEL_BLOCK_SIZE;
+				// samples are rounded to the nearest voxel, so voxel v covers about [v - 0.5, v + 0.5) along each axis
+				const Vector3f empty_region_min = (cell_is_empty ? cell_position * empty_region_size_voxels
+				                                                 : block_position * VOXEL_BLOCK_SIZE).toFloat() - Vector3f(0.5f);
+				// the margin keeps rounding errors from leaping over the first sample past the region, landing short is
+				// harmless, since the sample is then just checked and leapt over again
+				const float distance_to_region_exit =
+						DistanceToBoxExit(march_point_world_space_voxels, march_vector, empty_region_min,
+						                  (float) empty_region_size_voxels) - 0.01f;
+				const int step_count = ORUTILS_MAX((int) ceil(distance_to_region_exit / (float) VOXEL_BLOCK_SIZE), 1);
+				march_point_world_space_voxels += (float) (step_count * VOXEL_BLOCK_SIZE) * march_vector;
+				distance_along_ray_voxels += (float) (step_count * VOXEL_BLOCK_SIZE);
+				continue;
+			}
+		}
 		sdf_value = readFromSDF_float_uninterpolated(voxels, index_data, march_point_world_space_voxels, index_identifier, cache);
 
 		if (TModifyVisibilityInformation) {
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "../Interface/SwappingEngine.h"
 
 namespace ITMLib
@@ -20,17 +22,26 @@ namespace ITMLib
 	class SwappingEngine_CPU<TVoxel, VoxelBlockHash> : public SwappingEngine < TVoxel, VoxelBlockHash >
 	{
 	private:
-		int LoadFromGlobalMemory(VoxelVolume<TVoxel, VoxelBlockHash> *volume);
+		// maximum number of blocks swapped in, swapped out or cleaned up per call, 0 or less for no limit
+		const int block_budget_per_frame;
+		// hash codes of the blocks picked for the current swap operation
+		std::vector<int> swap_hash_codes;
+
+		int LoadFromGlobalMemory(VoxelVolume<TVoxel, VoxelBlockHash> *volume, const int* hash_codes, int block_count);
+		int ReleaseInvisibleBlocks(VoxelVolume<TVoxel, VoxelBlockHash> *volume, bool save_to_global_memory);
 
 	public:
 		// This class is currently just for debugging purposes -- swaps CPU memory to CPU memory.
 		// Potentially this could stream into the host memory from somewhere else (disk, database, etc.).
+		// Swap candidates are taken from the visible block list (swapping in) and from the utilized block list
+		// (swapping out & cleanup), both maintained by the indexing engine, rather than from a scan of the hash table.
 
 		void IntegrateGlobalIntoLocal(VoxelVolume<TVoxel, VoxelBlockHash> *volume, RenderState *render_state);
 		void SaveToGlobalMemory(VoxelVolume<TVoxel, VoxelBlockHash> *volume, RenderState *render_state);
 		void CleanLocalMemory(VoxelVolume<TVoxel, VoxelBlockHash> *volume, RenderState *renderState);
 
-		explicit SwappingEngine_CPU(typename VoxelBlockHash::InitializationParameters index){};
+		explicit SwappingEngine_CPU(typename VoxelBlockHash::InitializationParameters index);
+		SwappingEngine_CPU(typename VoxelBlockHash::InitializationParameters index, int block_budget_per_frame);
 		~SwappingEngine_CPU() = default;
 	};
 }
@@ -1,58 +1,91 @@
 // Copyright 2014-2017 Oxford University Innovation Limited and the authors of InfiniTAM
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
 #include "SwappingEngine_CPU.h"
 
 #include "../Shared/SwappingEngine_Shared.h"
+#include "../../../Utils/Configuration/Configuration.h"
 using namespace ITMLib;
 
+namespace {
 
-template<class TVoxel>
-int SwappingEngine_CPU<TVoxel, VoxelBlockHash>::LoadFromGlobalMemory(VoxelVolume<TVoxel, VoxelBlockHash>* volume)
-{
-	GlobalCache<TVoxel, VoxelBlockHash>& global_cache = volume->global_cache;
+/**
+ * \return how many of candidate_count blocks may be processed within block_budget (0 or less means no limit)
+ */
+inline int ApplyBlockBudget(const int block_budget, const int candidate_count) {
+	return block_budget > 0 ? std::min(block_budget, candidate_count) : candidate_count;
+}
 
-	HashSwapState* swap_states = global_cache.GetSwapStates(false);
+/**
+ * \brief Gather (in parallel) the hash codes from candidate_hash_codes[0, candidate_count) that satisfy the predicate
+ * and keep the lowest max_collected_count of them, in ascending order.
+ * \details Parallel gathering yields the hash codes in no particular order, so they are sorted before the budget is
+ * applied to make the choice of blocks (and the order they are processed in) independent of thread scheduling.
+ * \return number of hash codes kept at the front of collected_hash_codes
+ */
+template<typename TPredicate>
+int CollectSwapCandidates(std::vector<int>& collected_hash_codes, const int* candidate_hash_codes, const int candidate_count,
+                          const int max_collected_count, TPredicate& predicate) {
+	collected_hash_codes.resize(candidate_count);
+	int* collected_hash_codes_data = collected_hash_codes.data();
+	std::atomic<int> collected_count(0);
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(collected_hash_codes_data, candidate_hash_codes, collected_count, predicate) \
+firstprivate(candidate_count)
+#endif
+	for (int i_candidate = 0; i_candidate < candidate_count; i_candidate++) {
+		const int hash_code = candidate_hash_codes[i_candidate];
+		if (predicate(hash_code)) {
+			collected_hash_codes_data[collected_count.fetch_add(1)] = hash_code;
+		}
+	}
+	const int kept_count = std::min(collected_count.load(), max_collected_count);
+	std::partial_sort(collected_hash_codes.begin(), collected_hash_codes.begin() + kept_count,
+	                  collected_hash_codes.begin() + collected_count.load());
+	return kept_count;
+}
 
-	int* neededEntryIDs_local = global_cache.GetNeededEntryIDs(false);
+} // anonymous namespace
 
-	TVoxel *syncedVoxelBlocks_global = global_cache.GetSyncedVoxelBlocks(false);
-	bool *hasSyncedData_global = global_cache.GetHasSyncedData(false);
-	int *neededEntryIDs_global = global_cache.GetNeededEntryIDs(false);
+template<class TVoxel>
+SwappingEngine_CPU<TVoxel, VoxelBlockHash>::SwappingEngine_CPU(typename VoxelBlockHash::InitializationParameters index)
+		: SwappingEngine_CPU(index, configuration::Get().swapping_block_budget_per_frame) {}
 
-	int hashEntryCount = global_cache.GetHashEntryCount();
+template<class TVoxel>
+SwappingEngine_CPU<TVoxel, VoxelBlockHash>::SwappingEngine_CPU(typename VoxelBlockHash::InitializationParameters index,
+                                                               int block_budget_per_frame)
+		: block_budget_per_frame(block_budget_per_frame) {}
 
-	int neededHashEntryCount = 0;
-	for (int entryId = 0; entryId < hashEntryCount; entryId++)
-	{
-		if (neededHashEntryCount >= SWAP_OPERATION_BLOCK_COUNT) break;
-		if (swap_states[entryId].state == 1)
-		{
-			neededEntryIDs_local[neededHashEntryCount] = entryId;
-			neededHashEntryCount++;
-		}
-	}
+template<class TVoxel>
+int SwappingEngine_CPU<TVoxel, VoxelBlockHash>::LoadFromGlobalMemory(VoxelVolume<TVoxel, VoxelBlockHash>* volume,
+                                                                     const int* hash_codes, int block_count)
+{
+	GlobalCache<TVoxel, VoxelBlockHash>& global_cache = volume->global_cache;
 
-	// would copy neededEntryIDs_local into neededEntryIDs_global here
+	int *neededEntryIDs_global = global_cache.GetNeededEntryIDs(false);
+	TVoxel *syncedVoxelBlocks_global = global_cache.GetSyncedVoxelBlocks(false);
+	bool *hasSyncedData_global = global_cache.GetHasSyncedData(false);
 
-	if (neededHashEntryCount > 0)
+	// blocks may have to be paged in from disk by the global cache, which is not thread-safe
+	for (int i = 0; i < block_count; i++)
 	{
-		memset(syncedVoxelBlocks_global, 0, neededHashEntryCount * VOXEL_BLOCK_SIZE3 * sizeof(TVoxel));
-		memset(hasSyncedData_global, 0, neededHashEntryCount * sizeof(bool));
-		for (int i = 0; i < neededHashEntryCount; i++)
+		int entryId = hash_codes[i];
+		neededEntryIDs_global[i] = entryId;
+		const TVoxel* stored_block = global_cache.HasStoredData(entryId) ? global_cache.GetStoredVoxelBlock(entryId) : nullptr;
+		hasSyncedData_global[i] = stored_block != nullptr;
+		if (stored_block != nullptr)
 		{
-			int entryId = neededEntryIDs_global[i];
-
-			if (global_cache.HasStoredData(entryId))
-			{
-				hasSyncedData_global[i] = true;
-				memcpy(syncedVoxelBlocks_global + i * VOXEL_BLOCK_SIZE3, global_cache.GetStoredVoxelBlock(entryId), VOXEL_BLOCK_SIZE3 * sizeof(TVoxel));
-			}
+			memcpy(syncedVoxelBlocks_global + i * VOXEL_BLOCK_SIZE3, stored_block, VOXEL_BLOCK_SIZE3 * sizeof(TVoxel));
 		}
 	}
 
 	// would copy syncedVoxelBlocks_global and hasSyncedData_global and syncedVoxelBlocks_local and hasSyncedData_local here
 
-	return neededHashEntryCount;
+	return block_count;
 }
 
 template<class TVoxel>
@@ -70,138 +103,159 @@ void SwappingEngine_CPU<TVoxel, VoxelBlockHash>::IntegrateGlobalIntoLocal(VoxelV
 
 	TVoxel *localVBA = volume->GetVoxels();
 
-	const int needed_entry_count = this->LoadFromGlobalMemory(volume);
-
 	const int max_integration_weight = volume->GetParameters().max_integration_weight;
 
-	for (int i = 0; i < needed_entry_count; i++)
-	{
-		int destination_hash_code = neededEntryIDs_local[i];
+	// blocks to swap in are marked during the visibility pass, so they can only be among the visible ones
+	auto needs_swapping_in = [&swap_states, &hash_table](int hash_code) {
+		return swap_states[hash_code].state == 1 && hash_table[hash_code].ptr >= 0;
+	};
+	const int max_needed_entry_count = ApplyBlockBudget(block_budget_per_frame, volume->index.GetVisibleBlockCount());
+	const int needed_entry_count = CollectSwapCandidates(swap_hash_codes, volume->index.GetVisibleBlockHashCodes(),
+	                                                     volume->index.GetVisibleBlockCount(), max_needed_entry_count,
+	                                                     needs_swapping_in);
 
-		if (hasSyncedData_local[i])
+	for (int batch_start = 0; batch_start < needed_entry_count; batch_start += SWAP_OPERATION_BLOCK_COUNT)
+	{
+		const int batch_entry_count = this->LoadFromGlobalMemory(
+				volume, swap_hash_codes.data() + batch_start,
+				std::min(SWAP_OPERATION_BLOCK_COUNT, needed_entry_count - batch_start));
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(hash_table, swap_states, syncedVoxelBlocks_local, hasSyncedData_local, \
+                                              neededEntryIDs_local, localVBA) \
+firstprivate(batch_entry_count, max_integration_weight)
+#endif
+		for (int i = 0; i < batch_entry_count; i++)
 		{
-			TVoxel *srcVB = syncedVoxelBlocks_local + i * VOXEL_BLOCK_SIZE3;
-			TVoxel *dstVB = localVBA + hash_table[destination_hash_code].ptr * VOXEL_BLOCK_SIZE3;
+			int destination_hash_code = neededEntryIDs_local[i];
 
-			for (int vIdx = 0; vIdx < VOXEL_BLOCK_SIZE3; vIdx++)
+			if (hasSyncedData_local[i])
 			{
-				CombineVoxelInformation<TVoxel::hasColorInformation, TVoxel>::compute(srcVB[vIdx], dstVB[vIdx], max_integration_weight);
+				TVoxel *srcVB = syncedVoxelBlocks_local + i * VOXEL_BLOCK_SIZE3;
+				TVoxel *dstVB = localVBA + hash_table[destination_hash_code].ptr * VOXEL_BLOCK_SIZE3;
+
+				for (int vIdx = 0; vIdx < VOXEL_BLOCK_SIZE3; vIdx++)
+				{
+					CombineVoxelInformation<TVoxel::hasColorInformation, TVoxel>::compute(srcVB[vIdx], dstVB[vIdx], max_integration_weight);
+				}
 			}
-		}
 
-		swap_states[destination_hash_code].state = 2;
+			swap_states[destination_hash_code].state = 2;
+		}
 	}
 }
 
+/**
+ * \brief Free up to block_budget_per_frame (if positive) in-memory blocks that are not visible (and, when saving,
+ * whose most recent data is in active memory), optionally saving them to the global cache first.
+ * \details Freed blocks are returned to the block allocation list & removed from the utilized block list.
+ * \return number of blocks released
+ */
 template<class TVoxel>
-void SwappingEngine_CPU<TVoxel, VoxelBlockHash>::SaveToGlobalMemory(VoxelVolume<TVoxel, VoxelBlockHash>* volume, RenderState* render_state)
+int SwappingEngine_CPU<TVoxel, VoxelBlockHash>::ReleaseInvisibleBlocks(VoxelVolume<TVoxel, VoxelBlockHash>* volume,
+                                                                      bool save_to_global_memory)
 {
 	GlobalCache<TVoxel, VoxelBlockHash>& global_cache = volume->global_cache;
 
-	HashSwapState* swap_states = global_cache.GetSwapStates(false);
+	HashSwapState* swap_states = save_to_global_memory ? global_cache.GetSwapStates(false) : nullptr;
 
 	HashEntry* hash_table = volume->index.GetEntries();
-	HashBlockVisibility* block_visibility_types = volume->index.GetBlockVisibilityTypes();
+	const HashBlockVisibility* block_visibility_types = volume->index.GetBlockVisibilityTypes();
 
 	TVoxel *syncedVoxelBlocks_local = global_cache.GetSyncedVoxelBlocks(false);
 	bool *hasSyncedData_local = global_cache.GetHasSyncedData(false);
 	int *neededEntryIDs_local = global_cache.GetNeededEntryIDs(false);
 
-	TVoxel *syncedVoxelBlocks_global = global_cache.GetSyncedVoxelBlocks(false);
-	bool *hasSyncedData_global = global_cache.GetHasSyncedData(false);
-	int *neededEntryIDs_global = global_cache.GetNeededEntryIDs(false);
-
 	TVoxel* voxels = volume->GetVoxels();
 	int* block_allocation_list = volume->index.GetBlockAllocationList();
 
-	const int hash_entry_count = global_cache.GetHashEntryCount();
-	
-	int needed_entry_count = 0; // needed for what?
-	int allocated_block_count = volume->index.GetLastFreeBlockListId();
-
-	for (int destination_hash_code = 0; destination_hash_code < hash_entry_count; destination_hash_code++)
+	// blocks in active memory are, by definition, the utilized ones
+	auto can_be_released = [&swap_states, &hash_table, &block_visibility_types](int hash_code) {
+		return hash_table[hash_code].ptr >= 0 && block_visibility_types[hash_code] == INVISIBLE &&
+		       (swap_states == nullptr || swap_states[hash_code].state == 2);
+	};
+	const int max_needed_entry_count = ApplyBlockBudget(block_budget_per_frame, volume->index.GetUtilizedBlockCount());
+	const int needed_entry_count = CollectSwapCandidates(swap_hash_codes, volume->index.GetUtilizedBlockHashCodes(),
+	                                                     volume->index.GetUtilizedBlockCount(), max_needed_entry_count,
+	                                                     can_be_released);
+
+	// blocks can only be returned while there is room for them in the allocation list
+	const int last_free_block_id = volume->index.GetLastFreeBlockListId();
+	const int freed_block_count = std::min(needed_entry_count, ORDERED_LIST_SIZE - 1 - last_free_block_id);
+
+	for (int batch_start = 0; batch_start < needed_entry_count; batch_start += SWAP_OPERATION_BLOCK_COUNT)
 	{
-		if (needed_entry_count >= SWAP_OPERATION_BLOCK_COUNT) break;
-
-		int localPtr = hash_table[destination_hash_code].ptr;
-		HashSwapState &swapState = swap_states[destination_hash_code];
-
-		if (swapState.state == 2 && localPtr >= 0 && block_visibility_types[destination_hash_code] == 0)
+		const int batch_entry_count = std::min(SWAP_OPERATION_BLOCK_COUNT, needed_entry_count - batch_start);
+		const int* batch_hash_codes = swap_hash_codes.data() + batch_start;
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(hash_table, swap_states, syncedVoxelBlocks_local, hasSyncedData_local, \
+                                              neededEntryIDs_local, voxels, block_allocation_list, batch_hash_codes) \
+firstprivate(batch_entry_count, batch_start, freed_block_count, last_free_block_id, save_to_global_memory)
+#endif
+		for (int i = 0; i < batch_entry_count; i++)
 		{
+			const int hash_code = batch_hash_codes[i];
+			const int localPtr = hash_table[hash_code].ptr;
 			TVoxel *localVBALocation = voxels + localPtr * VOXEL_BLOCK_SIZE3;
 
-			neededEntryIDs_local[needed_entry_count] = destination_hash_code;
-
-			hasSyncedData_local[needed_entry_count] = true;
-			memcpy(syncedVoxelBlocks_local + needed_entry_count * VOXEL_BLOCK_SIZE3, localVBALocation, VOXEL_BLOCK_SIZE3 * sizeof(TVoxel));
-
-			swap_states[destination_hash_code].state = 0;
+			if (save_to_global_memory)
+			{
+				neededEntryIDs_local[i] = hash_code;
+				hasSyncedData_local[i] = true;
+				memcpy(syncedVoxelBlocks_local + i * VOXEL_BLOCK_SIZE3, localVBALocation, VOXEL_BLOCK_SIZE3 * sizeof(TVoxel));
+				swap_states[hash_code].state = 0;
+			}
 
-			int vbaIdx = allocated_block_count;
-			if (vbaIdx < ORDERED_LIST_SIZE - 1)
+			const int i_freed = batch_start + i;
+			if (i_freed < freed_block_count)
 			{
-				allocated_block_count++;
-				block_allocation_list[vbaIdx + 1] = localPtr;
-				hash_table[destination_hash_code].ptr = -1;
+				block_allocation_list[last_free_block_id + 1 + i_freed] = localPtr;
+				hash_table[hash_code].ptr = -1;
 
-				for (int i = 0; i < VOXEL_BLOCK_SIZE3; i++) localVBALocation[i] = TVoxel();
+				for (int vIdx = 0; vIdx < VOXEL_BLOCK_SIZE3; vIdx++) localVBALocation[vIdx] = TVoxel();
 			}
-
-			needed_entry_count++;
 		}
-	}
 
-	volume->index.SetLastFreeBlockListId(allocated_block_count);
+		// would copy neededEntryIDs_local, hasSyncedData_local and syncedVoxelBlocks_local into *_global here
 
-	// would copy neededEntryIDs_local, hasSyncedData_local and syncedVoxelBlocks_local into *_global here
-
-	if (needed_entry_count > 0)
-	{
-		for (int entryId = 0; entryId < needed_entry_count; entryId++)
+		if (save_to_global_memory)
 		{
-			if (hasSyncedData_global[entryId])
-				global_cache.SetStoredData(neededEntryIDs_global[entryId], syncedVoxelBlocks_global + entryId * VOXEL_BLOCK_SIZE3);
+			TVoxel *syncedVoxelBlocks_global = global_cache.GetSyncedVoxelBlocks(false);
+			bool *hasSyncedData_global = global_cache.GetHasSyncedData(false);
+			int *neededEntryIDs_global = global_cache.GetNeededEntryIDs(false);
+			// the global cache may page blocks out to disk, which is not thread-safe
+			for (int entryId = 0; entryId < batch_entry_count; entryId++)
+			{
+				if (hasSyncedData_global[entryId])
+					global_cache.SetStoredData(neededEntryIDs_global[entryId], syncedVoxelBlocks_global + entryId * VOXEL_BLOCK_SIZE3);
+			}
 		}
 	}
-}
-
-template<class TVoxel>
-void SwappingEngine_CPU<TVoxel, VoxelBlockHash>::CleanLocalMemory(VoxelVolume<TVoxel, VoxelBlockHash> *volume, RenderState *renderState)
-{
-	HashEntry* hash_table = volume->index.GetEntries();
-	HashBlockVisibility* block_visibility_types = volume->index.GetBlockVisibilityTypes();
-
-	TVoxel *localVBA = volume->GetVoxels();
-	int *voxelAllocationList = volume->index.GetBlockAllocationList();
 
-	int noTotalEntries = volume->index.hash_entry_count;
+	volume->index.SetLastFreeBlockListId(last_free_block_id + freed_block_count);
 
-	int noNeededEntries = 0;
-	int noAllocatedVoxelEntries = volume->index.GetLastFreeBlockListId();
-
-	for (int entryDestId = 0; entryDestId < noTotalEntries; entryDestId++)
+	if (freed_block_count > 0)
 	{
-		if (noNeededEntries >= SWAP_OPERATION_BLOCK_COUNT) break;
-
-		int localPtr = hash_table[entryDestId].ptr;
-
-		if (localPtr >= 0 && block_visibility_types[entryDestId] == 0)
-		{
-			TVoxel *localVBALocation = localVBA + localPtr * VOXEL_BLOCK_SIZE3;
-
-			int vbaIdx = noAllocatedVoxelEntries;
-			if (vbaIdx < ORDERED_LIST_SIZE - 1)
-			{
-				noAllocatedVoxelEntries++;
-				voxelAllocationList[vbaIdx + 1] = localPtr;
-				hash_table[entryDestId].ptr = -1;
+		int* utilized_block_hash_codes = volume->index.GetUtilizedBlockHashCodes();
+		const int utilized_block_count = volume->index.GetUtilizedBlockCount();
+		int* utilized_block_hash_codes_end =
+				std::remove_if(utilized_block_hash_codes, utilized_block_hash_codes + utilized_block_count,
+				               [&hash_table](int hash_code) { return hash_table[hash_code].ptr < 0; });
+		volume->index.SetUtilizedBlockCount(static_cast<int>(utilized_block_hash_codes_end - utilized_block_hash_codes));
+	}
 
-				for (int i = 0; i < VOXEL_BLOCK_SIZE3; i++) localVBALocation[i] = TVoxel();
-			}
+	return needed_entry_count;
+}
 
-			noNeededEntries++;
-		}
-	}
+template<class TVoxel>
+void SwappingEngine_CPU<TVoxel, VoxelBlockHash>::SaveToGlobalMemory(VoxelVolume<TVoxel, VoxelBlockHash>* volume, RenderState* render_state)
+{
+	this->ReleaseInvisibleBlocks(volume, true);
+}
 
-	volume->index.SetLastFreeBlockListId(noAllocatedVoxelEntries);
-}
\ No newline at end of file
+template<class TVoxel>
+void SwappingEngine_CPU<TVoxel, VoxelBlockHash>::CleanLocalMemory(VoxelVolume<TVoxel, VoxelBlockHash> *volume, RenderState *renderState)
+{
+	this->ReleaseInvisibleBlocks(volume, false);
+}
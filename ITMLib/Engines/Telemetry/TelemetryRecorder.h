@@ -22,6 +22,10 @@
 #include "../../../ORUtils/PlatformIndependentAtomics.h"
 #include "../../Utils/Analytics/Histogram.h"
 #include "../LevelSetAlignment/Shared/WarpGradientAggregates.h"
+#include "../../Utils/FileIO/BackgroundWriter.h"
+
+//stdlib
+#include <memory>
 
 namespace ITMLib {
 
@@ -47,6 +51,8 @@ private: // instance variables
 	ORUtils::OStreamWrapper surface_tracking_energy_file;
 	ORUtils::OStreamWrapper surface_tracking_statistics_file;
 	ORUtils::OStreamWrapper warp_update_length_histogram_file;
+	// only present when meshes are to be written in the background
+	std::unique_ptr<BackgroundWriter> mesh_writer;
 protected: // instance variables
 	using TelemetryRecorderInterface<TVoxel,TWarp,TIndex>::parameters;
 public: // instance functions
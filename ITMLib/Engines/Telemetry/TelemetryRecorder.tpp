@@ -57,7 +57,8 @@ TelemetryRecorder<TVoxel, TWarp, TIndex, TMemoryDeviceType>::TelemetryRecorder()
 		 warp_update_length_histogram_file(parameters.record_warp_update_length_histograms ?
 		                                   ORUtils::OStreamWrapper((fs::path(configuration::Get().paths.output_path) /
 		                                                            fs::path("warp_update_length_histograms.dat")).string(), true)
-		                                                                                   : ORUtils::OStreamWrapper()) {}
+		                                                                                   : ORUtils::OStreamWrapper()),
+		 mesh_writer(parameters.record_frame_meshes && parameters.write_meshes_in_background ? new BackgroundWriter() : nullptr) {}
 
 template<typename TVoxel, typename TWarp, typename TIndex, MemoryDeviceType TMemoryDeviceType>
 void TelemetryRecorder<TVoxel, TWarp, TIndex, TMemoryDeviceType>::RecordVolumeMemoryUsageInfo(
@@ -89,9 +90,14 @@ void TelemetryRecorder<TVoxel, TWarp, TIndex, TMemoryDeviceType>::RecordFrameMes
 			meshing_engine = MeshingEngineFactory::Build<TVoxel, TIndex>(configuration::Get().device_type);
 		}
 
-		Mesh mesh = meshing_engine->MeshVolume(&volume);
-		mesh.WritePLY(mesh_file_path, false, false);
+		Mesh mesh = meshing_engine->MeshVolumeIndexed(&volume);
 		delete meshing_engine;
+		if (mesh_writer) {
+			auto mesh_to_write = std::make_shared<Mesh>(std::move(mesh));
+			mesh_writer->Submit([mesh_to_write, mesh_file_path]() { mesh_to_write->WritePLY(mesh_file_path, false, false); });
+		} else {
+			mesh.WritePLY(mesh_file_path, false, false);
+		}
 	}
 }
 
@@ -31,7 +31,7 @@ public:
 				recorder = new TelemetryRecorder<TVoxel, TWarp, TIndex, MEMORYDEVICE_CPU>();
 				break;
 			case MEMORYDEVICE_CUDA:
-#ifdef COMPILE_WITHOU_CUDA
+#ifdef COMPILE_WITHOUT_CUDA
 				DIEWITHEXCEPTION_REPORTLOCATION("Requested construction of CUDA-based TelemetryRecorder while code built without CUDA support.");
 				break;
 #else
@@ -60,16 +60,16 @@ public:
 			case MEMORYDEVICE_CPU:
 				return TelemetryRecorder<TVoxel, TWarp, TIndex, MEMORYDEVICE_CPU>::GetDefaultInstance();
 			case MEMORYDEVICE_CUDA:
-#ifdef COMPILE_WITHOU_CUDA
+#ifdef COMPILE_WITHOUT_CUDA
 				DIEWITHEXCEPTION_REPORTLOCATION("Requested construction of CUDA-based TelemetryRecorder while code built without CUDA support.");
-				return TelemetryRecorder<TVoxel,TIndex,MEMORYDEVICE_CPU>::GetDefaultInstance();
+				return TelemetryRecorder<TVoxel, TWarp, TIndex, MEMORYDEVICE_CPU>::GetDefaultInstance();
 #else
 				return TelemetryRecorder<TVoxel, TWarp, TIndex, MEMORYDEVICE_CUDA>::GetDefaultInstance();
 #endif
 			case MEMORYDEVICE_METAL:
 #ifdef COMPILE_WITH_METAL
 				DIEWITHEXCEPTION_REPORTLOCATION("Not implemented.");
-				return TelemetryRecorder<TVoxel,TIndex,MEMORYDEVICE_CPU>::GetDefaultInstance();
+				return TelemetryRecorder<TVoxel, TWarp, TIndex, MEMORYDEVICE_CPU>::GetDefaultInstance();
 #else
 				DIEWITHEXCEPTION_REPORTLOCATION(
 						"Requested construction of Metal-based TelemetryRecorder while code built without Metal support.");
@@ -42,7 +42,9 @@ namespace ITMLib {
     "Bin count for warp update length histogram when -telemetry_settings.record_warp_update_length_histograms "\
     "or -logging_settings.log_warp_update_length_histograms or both are used."),\
     (bool, use_CPU_for_mesh_recording, false, PRIMITIVE, "Whether to ALWAYS use CPU & regular RAM when recording mesh telemetry. For CUDA runs, this will reduce GPU memory usage."), \
-    (bool, record_camera_matrices, false, PRIMITIVE, "Whether to record estimated camera trajectory matrices in world space.")
+    (bool, record_camera_matrices, false, PRIMITIVE, "Whether to record estimated camera trajectory matrices in world space."), \
+    (bool, write_meshes_in_background, false, PRIMITIVE, "Whether to write recorded frame meshes to disk on a background thread, " \
+    "so that frame processing doesn't wait on disk I/O. Meshes are still extracted from the volumes in-line.")
 
 
 DECLARE_DEFERRABLE_SERIALIZABLE_STRUCT(TELEMETRY_SETTINGS_STRUCT_DESCRIPTION);
@@ -127,7 +127,9 @@ protected: // static functions
 		const int job_count = ceil_of_integer_quotient(sample_size, thread_count) * thread_count;
 #pragma omp parallel for default(none) shared(sample_indices, data, functor) firstprivate(job_count, sample_size)
 		for (int i_index = 0; i_index < job_count; i_index++) {
-			functor(data, sample_indices[i_index], i_index >= sample_size);
+			const bool padding_job = i_index >= sample_size;
+			// padding jobs don't correspond to any sample, avoid reading past the end of the sample index array for them
+			functor(data, padding_job ? 0 : sample_indices[i_index], padding_job);
 		}
 #else
 		for (int i_index = 0; i_index < sample_size; i_index++) {
@@ -19,6 +19,7 @@
 #include "../Interface/ThreeVolumeTraversal.h"
 #include "../../../Objects/Volume/VoxelVolume.h"
 #include "../../../Objects/Volume/PlainVoxelArray.h"
+#include "../../Common/VoxelBlockKernels_CPU.h"
 
 namespace ITMLib {
 
@@ -61,6 +62,40 @@ private:
 		}
 	}
 
+	template<typename TFunctor>
+	inline static void TraverseUtilizedWithPosition_Generic(
+			VoxelVolume<TVoxel1, PlainVoxelArray>* volume1,
+			VoxelVolume<TVoxel2, PlainVoxelArray>* volume2,
+			VoxelVolume<TVoxel3, PlainVoxelArray>* volume3,
+			TFunctor& functor, std::false_type) {
+		TraverseAllWithPosition(volume1, volume2, volume3, functor);
+	}
+
+	// functor has a block kernel (see VoxelBlockKernels_CPU.h), run it on chunks of one voxel block's worth of voxels
+	template<typename TFunctor>
+	inline static void TraverseUtilizedWithPosition_Generic(
+			VoxelVolume<TVoxel1, PlainVoxelArray>* volume1,
+			VoxelVolume<TVoxel2, PlainVoxelArray>* volume2,
+			VoxelVolume<TVoxel3, PlainVoxelArray>* volume3,
+			TFunctor& functor, std::true_type) {
+		assert(volume2->index.GetVolumeSize() == volume3->index.GetVolumeSize() &&
+		       volume2->index.GetVolumeSize() == volume1->index.GetVolumeSize());
+		TVoxel1* voxels1 = volume1->GetVoxels();
+		TVoxel2* voxels2 = volume2->GetVoxels();
+		TVoxel3* voxels3 = volume3->GetVoxels();
+		const int voxel_count = volume1->index.GetVolumeSize().x * volume1->index.GetVolumeSize().y *
+		                        volume1->index.GetVolumeSize().z;
+		const int chunk_count = (voxel_count + VOXEL_BLOCK_SIZE3 - 1) / VOXEL_BLOCK_SIZE3;
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(voxels1, voxels2, voxels3, functor) firstprivate(voxel_count, chunk_count)
+#endif
+		for (int i_chunk = 0; i_chunk < chunk_count; i_chunk++) {
+			const int chunk_start = i_chunk * VOXEL_BLOCK_SIZE3;
+			functor.ProcessBlock(voxels1 + chunk_start, voxels2 + chunk_start, voxels3 + chunk_start,
+			                     ORUTILS_MIN(VOXEL_BLOCK_SIZE3, voxel_count - chunk_start));
+		}
+	}
+
 public:
 // region ================================ STATIC TWO-SCENE TRAVERSAL WITH WARPS =======================================
 
@@ -124,7 +159,65 @@ public:
 	                        VoxelVolume<TVoxel2, PlainVoxelArray>* volume2,
 	                        VoxelVolume<TVoxel3, PlainVoxelArray>* volume3,
 	                        TFunctor& functor) {
-		TraverseAllWithPosition(volume1,volume2,volume3, functor);
+		TraverseUtilizedWithPosition_Generic(volume1, volume2, volume3, functor,
+		                                     HasBlockKernel<TFunctor, TVoxel1*, TVoxel2*, TVoxel3*>());
+	}
+
+	/**
+	 * \brief Neighbor-aware counterpart of TraverseUtilizedWithPosition. For plain voxel arrays, the neighborhood of every
+	 * voxel is fully described by the index data of each volume, which is handed to the functor as the neighborhood view.
+	 * \details Functor is called as functor(voxel1, voxel2, voxel3, voxel_position, neighborhood1, neighborhood2, neighborhood3).
+	 */
+	template<typename TFunctor>
+	inline static void
+	TraverseUtilizedWithNeighborhood(VoxelVolume<TVoxel1, PlainVoxelArray>* volume1,
+	                                 VoxelVolume<TVoxel2, PlainVoxelArray>* volume2,
+	                                 VoxelVolume<TVoxel3, PlainVoxelArray>* volume3,
+	                                 TFunctor& functor) {
+		const PlainVoxelArray::IndexData* index_data1 = volume1->index.GetIndexData();
+		const PlainVoxelArray::IndexData* index_data2 = volume2->index.GetIndexData();
+		const PlainVoxelArray::IndexData* index_data3 = volume3->index.GetIndexData();
+		TraverseAll_Generic(
+				volume1, volume2, volume3,
+				[&functor, &index_data1, &index_data2, &index_data3](
+						TVoxel1& voxel1, TVoxel2& voxel2, TVoxel3& voxel3, const int& linear_index) {
+					Vector3i voxel_position = ComputePositionVectorFromLinearIndex_PlainVoxelArray(index_data1, linear_index);
+					functor(voxel1, voxel2, voxel3, voxel_position, *index_data1, *index_data2, *index_data3);
+				}
+		);
+	}
+
+	/**
+	 * \brief Traverse the volumes in tiles of VOXEL_BLOCK_SIZE^3 voxels, the plain voxel array counterpart of
+	 * TraverseUtilizedBlocksWithNeighborhood for voxel block hash volumes.
+	 * \details Tiles on the upper boundaries of the array may extend beyond it, so the functor has to check voxel
+	 * presence (see findVoxel). Functor is called as functor(tile_origin, neighborhood1, neighborhood2, neighborhood3),
+	 * where the neighborhoods are the index data of each volume.
+	 */
+	template<typename TFunctor>
+	inline static void
+	TraverseUtilizedBlocksWithNeighborhood(VoxelVolume<TVoxel1, PlainVoxelArray>* volume1,
+	                                       VoxelVolume<TVoxel2, PlainVoxelArray>* volume2,
+	                                       VoxelVolume<TVoxel3, PlainVoxelArray>* volume3,
+	                                       TFunctor& functor) {
+		assert(volume2->index.GetVolumeSize() == volume3->index.GetVolumeSize() &&
+		       volume2->index.GetVolumeSize() == volume1->index.GetVolumeSize());
+		const PlainVoxelArray::IndexData* index_data1 = volume1->index.GetIndexData();
+		const PlainVoxelArray::IndexData* index_data2 = volume2->index.GetIndexData();
+		const PlainVoxelArray::IndexData* index_data3 = volume3->index.GetIndexData();
+
+		const Vector3i tile_counts = (index_data1->size + Vector3i(VOXEL_BLOCK_SIZE - 1)) / VOXEL_BLOCK_SIZE;
+		const int tile_count = tile_counts.x * tile_counts.y * tile_counts.z;
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(functor, index_data1, index_data2, index_data3) firstprivate(tile_counts, tile_count) schedule(static)
+#endif
+		for (int i_tile = 0; i_tile < tile_count; i_tile++) {
+			const Vector3i tile_position(i_tile % tile_counts.x, (i_tile / tile_counts.x) % tile_counts.y,
+			                             i_tile / (tile_counts.x * tile_counts.y));
+			const Vector3i tile_origin = index_data1->offset + tile_position * VOXEL_BLOCK_SIZE;
+			functor(tile_origin, *index_data1, *index_data2, *index_data3);
+		}
 	}
 
 	/** Single-threaded traversal **/
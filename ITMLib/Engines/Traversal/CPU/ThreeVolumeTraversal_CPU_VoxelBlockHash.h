@@ -19,6 +19,7 @@
 #include "../Interface/ThreeVolumeTraversal.h"
 #include "../../../Objects/Volume/VoxelVolume.h"
 #include "../../../Objects/Volume/VoxelBlockHash.h"
+#include "../../Common/VoxelBlockKernels_CPU.h"
 
 namespace ITMLib {
 
@@ -89,6 +90,24 @@ private:
 		}
 	}
 
+	template<typename TFunctor>
+	inline static void TraverseBlocksWithPositionWithFunctor(TVoxel1* voxel_block1, TVoxel2* voxel_block2, TVoxel3* voxel_block3,
+	                                                         const HashEntry& hash_entry1, TFunctor& functor, std::false_type) {
+		TraverseBlocksWithPosition(
+				voxel_block1, voxel_block2, voxel_block3, hash_entry1,
+				[&functor](TVoxel1& voxel1, TVoxel2& voxel2, TVoxel3& voxel3, const Vector3i& voxel_position) {
+					functor(voxel1, voxel2, voxel3, voxel_position);
+				}
+		);
+	}
+
+	// functor has a block kernel (see VoxelBlockKernels_CPU.h)
+	template<typename TFunctor>
+	inline static void TraverseBlocksWithPositionWithFunctor(TVoxel1* voxel_block1, TVoxel2* voxel_block2, TVoxel3* voxel_block3,
+	                                                         const HashEntry& hash_entry1, TFunctor& functor, std::true_type) {
+		functor.ProcessBlock(voxel_block1, voxel_block2, voxel_block3, VOXEL_BLOCK_SIZE3);
+	}
+
 	template<typename TBlockTraversalFunction>
 	inline static void
 	TraverseAll_Generic(
@@ -106,17 +125,25 @@ private:
 		HashEntry* hash_table3 = volume3->index.GetEntries();
 
 		const int hash_entry_count = volume1->index.hash_entry_count;
+		// blocks of volumes sharing the block layout with volume 1 sit at the same voxel offsets, no matching needed
+		const bool shared_block_layout2 = volume2->index.SharesBlockLayoutWith(volume1->index);
+		const bool shared_block_layout3 = volume3->index.SharesBlockLayoutWith(volume1->index);
 #ifdef WITH_OPENMP
 #pragma omp parallel for
 #endif
 		for (int hash_code1 = 0; hash_code1 < hash_entry_count; hash_code1++) {
 			const HashEntry& hash_entry1 = hash_table1[hash_code1];
 			if (hash_entry1.ptr < 0) continue;
-			HashEntry hash_entry2 = hash_table2[hash_code1];
-			HashEntry hash_entry3 = hash_table3[hash_code1];
-
-			CheckSlaveVolumeBlock(hash_entry2, hash_entry1, hash_table2, "volume 2");
-			CheckSlaveVolumeBlock(hash_entry3, hash_entry1, hash_table3, "volume 3");
+			HashEntry hash_entry2 = hash_entry1;
+			HashEntry hash_entry3 = hash_entry1;
+			if (!shared_block_layout2) {
+				hash_entry2 = hash_table2[hash_code1];
+				CheckSlaveVolumeBlock(hash_entry2, hash_entry1, hash_table2, "volume 2");
+			}
+			if (!shared_block_layout3) {
+				hash_entry3 = hash_table3[hash_code1];
+				CheckSlaveVolumeBlock(hash_entry3, hash_entry1, hash_table3, "volume 3");
+			}
 
 			TVoxel1* voxel_block1 = &(voxels1[hash_entry1.ptr * VOXEL_BLOCK_SIZE3]);
 			TVoxel2* voxel_block2 = &(voxels2[hash_entry2.ptr * VOXEL_BLOCK_SIZE3]);
@@ -144,19 +171,26 @@ private:
 
 		const int utilized_entry_count = volume1->index.GetUtilizedBlockCount();
 		const int* utilized_hash_codes = volume1->index.GetUtilizedBlockHashCodes();
+		const bool shared_block_layout2 = volume2->index.SharesBlockLayoutWith(volume1->index);
+		const bool shared_block_layout3 = volume3->index.SharesBlockLayoutWith(volume1->index);
 #ifdef WITH_OPENMP
 #pragma omp parallel for default(none) shared(block_traverser, utilized_hash_codes, hash_table1, hash_table2, hash_table3, voxels1, voxels2, voxels3)\
-firstprivate(utilized_entry_count)
+firstprivate(utilized_entry_count, shared_block_layout2, shared_block_layout3)
 #endif
 		for (int hash_code_index = 0; hash_code_index < utilized_entry_count; hash_code_index++) {
 			int hash_code1 = utilized_hash_codes[hash_code_index];
 			const HashEntry& hash_entry1 = hash_table1[hash_code1];
 			if (hash_entry1.ptr < 0) continue;
-			HashEntry hash_entry2 = hash_table2[hash_code1];
-			HashEntry hash_entry3 = hash_table3[hash_code1];
-
-			CheckSlaveVolumeBlock(hash_entry2, hash_entry1, hash_table2, "volume 2");
-			CheckSlaveVolumeBlock(hash_entry3, hash_entry1, hash_table3, "volume 3");
+			HashEntry hash_entry2 = hash_entry1;
+			HashEntry hash_entry3 = hash_entry1;
+			if (!shared_block_layout2) {
+				hash_entry2 = hash_table2[hash_code1];
+				CheckSlaveVolumeBlock(hash_entry2, hash_entry1, hash_table2, "volume 2");
+			}
+			if (!shared_block_layout3) {
+				hash_entry3 = hash_table3[hash_code1];
+				CheckSlaveVolumeBlock(hash_entry3, hash_entry1, hash_table3, "volume 3");
+			}
 
 			TVoxel1* voxel_block1 = &(voxels1[hash_entry1.ptr * VOXEL_BLOCK_SIZE3]);
 			TVoxel2* voxel_block2 = &(voxels2[hash_entry2.ptr * VOXEL_BLOCK_SIZE3]);
@@ -166,6 +200,68 @@ firstprivate(utilized_entry_count)
 		}
 	}
 
+	template<typename TVoxel>
+	inline static HashBlockNeighborhood
+	GetNeighborhood(VoxelVolume<TVoxel, VoxelBlockHash>* volume, const int i_utilized_block, const Vector3i& block_origin) {
+		return {volume->index.GetBlockNeighborTable() + i_utilized_block * VOXEL_BLOCK_NEIGHBORHOOD_SIZE,
+		        volume->index.GetEntries(), block_origin};
+	}
+
+	inline static void CheckBlockNeighborTable(const VoxelBlockHash& index, const VoxelBlockHash& reference_index,
+	                                           const char* volume_name) {
+		if (!index.BlockNeighborTableMatches(reference_index)) {
+			std::stringstream stream;
+			stream << "Block neighbor table of " << volume_name << " is out of date with the utilized blocks of volume 1, "
+			       << "it needs to be rebuilt using volume 1 as reference. " << __FILE__ << ": " << __LINE__;
+			DIEWITHEXCEPTION(stream.str());
+		}
+	}
+
+	template<typename TBlockTraversalFunction>
+	inline static void
+	TraverseUtilizedWithNeighborhood_Generic(
+			VoxelVolume<TVoxel1, VoxelBlockHash>* volume1,
+			VoxelVolume<TVoxel2, VoxelBlockHash>* volume2,
+			VoxelVolume<TVoxel3, VoxelBlockHash>* volume3,
+			TBlockTraversalFunction&& block_traverser) {
+
+		const int utilized_entry_count = volume1->index.GetUtilizedBlockCount();
+		CheckBlockNeighborTable(volume1->index, volume1->index, "volume 1");
+		CheckBlockNeighborTable(volume2->index, volume1->index, "volume 2");
+		CheckBlockNeighborTable(volume3->index, volume1->index, "volume 3");
+
+// *** traversal vars
+		TVoxel1* voxels1 = volume1->GetVoxels();
+		TVoxel2* voxels2 = volume2->GetVoxels();
+		TVoxel3* voxels3 = volume3->GetVoxels();
+		const HashEntry* hash_table1 = volume1->index.GetEntries();
+		const int* utilized_hash_codes = volume1->index.GetUtilizedBlockHashCodes();
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(block_traverser, utilized_hash_codes, hash_table1, volume1, volume2, volume3, \
+voxels1, voxels2, voxels3) firstprivate(utilized_entry_count) schedule(static)
+#endif
+		for (int hash_code_index = 0; hash_code_index < utilized_entry_count; hash_code_index++) {
+			const Vector3i block_origin = hash_table1[utilized_hash_codes[hash_code_index]].pos.toInt() * VOXEL_BLOCK_SIZE;
+			const HashBlockNeighborhood neighborhood1 = GetNeighborhood(volume1, hash_code_index, block_origin);
+			const HashBlockNeighborhood neighborhood2 = GetNeighborhood(volume2, hash_code_index, block_origin);
+			const HashBlockNeighborhood neighborhood3 = GetNeighborhood(volume3, hash_code_index, block_origin);
+
+			// central block of the neighborhood is the block itself
+			const int central_neighbor_index = VOXEL_BLOCK_NEIGHBORHOOD_SIZE / 2;
+			if (neighborhood2.neighbor_block_offsets[central_neighbor_index] < 0 ||
+			    neighborhood3.neighbor_block_offsets[central_neighbor_index] < 0) {
+				DIEWITHEXCEPTION_REPORTLOCATION("Could not find corresponding volume 2 or volume 3 block.");
+			}
+
+			std::forward<TBlockTraversalFunction>(block_traverser)(
+					voxels1 + neighborhood1.neighbor_block_offsets[central_neighbor_index],
+					voxels2 + neighborhood2.neighbor_block_offsets[central_neighbor_index],
+					voxels3 + neighborhood3.neighbor_block_offsets[central_neighbor_index],
+					neighborhood1, neighborhood2, neighborhood3);
+		}
+	}
+
 // endregion ===========================================================================================================
 public:
 // region ================================ STATIC THREE-SCENE TRAVERSAL ================================================
@@ -280,12 +376,67 @@ public:
 		TraverseUtilized_Generic(
 				volume1, volume2, volume3,
 				[&functor](TVoxel1* voxel_block1, TVoxel2* voxel_block2, TVoxel3* voxel_block3, const HashEntry& hash_entry1){
-					TraverseBlocksWithPosition(
-							voxel_block1, voxel_block2, voxel_block3, hash_entry1,
-							[&functor](TVoxel1& voxel1, TVoxel2& voxel2, TVoxel3& voxel3, const Vector3i& voxel_position) {
-								functor(voxel1, voxel2, voxel3, voxel_position);
+					TraverseBlocksWithPositionWithFunctor(voxel_block1, voxel_block2, voxel_block3, hash_entry1, functor,
+					                                      HasBlockKernel<TFunctor, TVoxel1*, TVoxel2*, TVoxel3*>());
+				}
+		);
+	}
+
+
+	/**
+	 * \brief Traverse utilized blocks of volume 1 along with matching blocks of volumes 2 & 3, additionally handing the
+	 * functor a neighbor-aware view of the current block in each volume
+	 * \details Neighbor reads through the views (see readVoxel) within the 3x3x3 block neighborhood need no hashing. Requires
+	 * block neighbor tables of all three volumes to be built with volume 1 as reference (see BuildBlockNeighborTable).
+	 * Functor is called as functor(voxel1, voxel2, voxel3, voxel_position, neighborhood1, neighborhood2, neighborhood3).
+	 */
+	template<typename TFunctor>
+	inline static void
+	TraverseUtilizedWithNeighborhood(
+			VoxelVolume<TVoxel1, VoxelBlockHash>* volume1,
+			VoxelVolume<TVoxel2, VoxelBlockHash>* volume2,
+			VoxelVolume<TVoxel3, VoxelBlockHash>* volume3,
+			TFunctor& functor) {
+		TraverseUtilizedWithNeighborhood_Generic(
+				volume1, volume2, volume3,
+				[&functor](TVoxel1* voxel_block1, TVoxel2* voxel_block2, TVoxel3* voxel_block3,
+				           const HashBlockNeighborhood& neighborhood1, const HashBlockNeighborhood& neighborhood2,
+				           const HashBlockNeighborhood& neighborhood3) {
+					for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
+						for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+							for (int x = 0; x < VOXEL_BLOCK_SIZE; x++) {
+								int index_within_block = x + y * VOXEL_BLOCK_SIZE + z * VOXEL_BLOCK_SIZE * VOXEL_BLOCK_SIZE;
+								Vector3i voxel_position = neighborhood1.block_origin + Vector3i(x, y, z);
+								functor(voxel_block1[index_within_block], voxel_block2[index_within_block],
+								        voxel_block3[index_within_block], voxel_position,
+								        neighborhood1, neighborhood2, neighborhood3);
 							}
-					);
+						}
+					}
+				}
+		);
+	}
+
+	/**
+	 * \brief Traverse utilized blocks of volume 1 along with matching blocks of volumes 2 & 3, calling the functor once
+	 * per block rather than once per voxel, which lets the functor work on whole blocks (and their surroundings) as tiles.
+	 * \details Has the same block neighbor table requirements as TraverseUtilizedWithNeighborhood. Functor is called as
+	 * functor(block_origin, neighborhood1, neighborhood2, neighborhood3), where block_origin is the position of the
+	 * block's first voxel. Voxels of the block can be located via findVoxel on the neighborhoods.
+	 */
+	template<typename TFunctor>
+	inline static void
+	TraverseUtilizedBlocksWithNeighborhood(
+			VoxelVolume<TVoxel1, VoxelBlockHash>* volume1,
+			VoxelVolume<TVoxel2, VoxelBlockHash>* volume2,
+			VoxelVolume<TVoxel3, VoxelBlockHash>* volume3,
+			TFunctor& functor) {
+		TraverseUtilizedWithNeighborhood_Generic(
+				volume1, volume2, volume3,
+				[&functor](TVoxel1* voxel_block1, TVoxel2* voxel_block2, TVoxel3* voxel_block3,
+				           const HashBlockNeighborhood& neighborhood1, const HashBlockNeighborhood& neighborhood2,
+				           const HashBlockNeighborhood& neighborhood3) {
+					functor(neighborhood1.block_origin, neighborhood1, neighborhood2, neighborhood3);
 				}
 		);
 	}
@@ -23,6 +23,7 @@
 #include "../../../Utils/Geometry/SpatialIndexConversions.h"
 #include "../../../Utils/Geometry/GeometryBooleanOperations.h"
 #include "../../../Utils/Enums/ExecutionMode.h"
+#include "../../Common/VoxelBlockKernels_CPU.h"
 
 namespace ITMLib {
 
@@ -36,6 +37,34 @@ class TwoVolumeTraversalEngine<TVoxel1, TVoxel2, PlainVoxelArray, PlainVoxelArra
 	 */
 private:
 
+	template<typename TFunctor>
+	inline static void TraverseUtilized_Generic(VoxelVolume<TVoxel1, PlainVoxelArray>* volume1,
+	                                            VoxelVolume<TVoxel2, PlainVoxelArray>* volume2,
+	                                            TFunctor& functor, std::false_type) {
+		TraverseAll(volume1, volume2, functor);
+	}
+
+	// functor has a block kernel (see VoxelBlockKernels_CPU.h), run it on chunks of one voxel block's worth of voxels
+	template<typename TFunctor>
+	inline static void TraverseUtilized_Generic(VoxelVolume<TVoxel1, PlainVoxelArray>* volume1,
+	                                            VoxelVolume<TVoxel2, PlainVoxelArray>* volume2,
+	                                            TFunctor& functor, std::true_type) {
+		assert(volume1->index.GetVolumeSize() == volume2->index.GetVolumeSize());
+		TVoxel1* voxels1 = volume1->GetVoxels();
+		TVoxel2* voxels2 = volume2->GetVoxels();
+		const int voxel_count = volume1->index.GetVolumeSize().x * volume1->index.GetVolumeSize().y *
+		                        volume1->index.GetVolumeSize().z;
+		const int chunk_count = (voxel_count + VOXEL_BLOCK_SIZE3 - 1) / VOXEL_BLOCK_SIZE3;
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(voxels1, voxels2, functor) firstprivate(voxel_count, chunk_count)
+#endif
+		for (int i_chunk = 0; i_chunk < chunk_count; i_chunk++) {
+			const int chunk_start = i_chunk * VOXEL_BLOCK_SIZE3;
+			functor.ProcessBlock(voxels1 + chunk_start, voxels2 + chunk_start,
+			                     ORUTILS_MIN(VOXEL_BLOCK_SIZE3, voxel_count - chunk_start));
+		}
+	}
+
 	template<typename TFunctor, typename TFunctionCall>
 	inline static bool
 	TraverseAndCompareAllocated_Generic(
@@ -208,7 +237,7 @@ public:
 	TraverseUtilized(VoxelVolume<TVoxel1, PlainVoxelArray>* volume1,
 	                 VoxelVolume<TVoxel2, PlainVoxelArray>* volume2,
 	                 TFunctor& functor) {
-		TraverseAll(volume1, volume2, functor);
+		TraverseUtilized_Generic(volume1, volume2, functor, HasBlockKernel<TFunctor, TVoxel1*, TVoxel2*>());
 	}
 
 
@@ -22,6 +22,7 @@
 #include "../Shared/VolumeTraversal_Shared.h"
 #include "../../../Utils/Analytics/IsAltered.h"
 #include "../../../Utils/Enums/ExecutionMode.h"
+#include "../../Common/VoxelBlockKernels_CPU.h"
 
 //TODO: work on reducing DRY violations
 
@@ -51,20 +52,22 @@ private:
 		HashEntry* hash_table2 = volume2->index.GetEntries();
 		int utilized_entry_count = volume1->index.GetUtilizedBlockCount();
 		const int* utilized_hash_codes = volume1->index.GetUtilizedBlockHashCodes();
+		// blocks of volumes sharing the block layout sit at the same voxel offsets, no matching needed
+		const bool shared_block_layout = volume2->index.SharesBlockLayoutWith(volume1->index);
 
 #ifdef WITH_OPENMP
-#pragma omp parallel for default(none) firstprivate(utilized_entry_count) shared(hash_table1, hash_table2, \
+#pragma omp parallel for default(none) firstprivate(utilized_entry_count, shared_block_layout) shared(hash_table1, hash_table2, \
 utilized_hash_codes, voxels1, voxels2, block_traverser)
 #endif
 		for (int hash_code_index = 0; hash_code_index < utilized_entry_count; hash_code_index++) {
 			int hash_code = utilized_hash_codes[hash_code_index];
 			const HashEntry& hash_entry1 = hash_table1[hash_code];
 			if (hash_entry1.ptr < 0) continue;
-			HashEntry hash_entry2 = hash_table2[hash_code];
+			HashEntry hash_entry2 = shared_block_layout ? hash_entry1 : hash_table2[hash_code];
 
 			// the rare case where we have different positions for primary & secondary voxel block with the same index:
 			// we have a hash bucket miss, find the secondary voxel with the matching coordinates
-			if (hash_entry2.pos != hash_entry1.pos) {
+			if (!shared_block_layout && hash_entry2.pos != hash_entry1.pos) {
 				int hash_code2;
 				if (!FindHashAtPosition(hash_code2, hash_entry1.pos, hash_table2)) {
 					std::stringstream stream;
@@ -91,19 +94,20 @@ utilized_hash_codes, voxels1, voxels2, block_traverser)
 		TVoxel2* voxels2 = volume2->GetVoxels();
 		HashEntry* hash_table2 = volume2->index.GetEntries();
 		const int hash_entry_count = volume1->index.hash_entry_count;
+		const bool shared_block_layout = volume2->index.SharesBlockLayoutWith(volume1->index);
 
 #ifdef WITH_OPENMP
-#pragma omp parallel for default(none) firstprivate(hash_entry_count) shared(hash_table1, hash_table2, \
+#pragma omp parallel for default(none) firstprivate(hash_entry_count, shared_block_layout) shared(hash_table1, hash_table2, \
 voxels1, voxels2, block_traverser)
 #endif
 		for (int hash_code = 0; hash_code < hash_entry_count; hash_code++) {
 			const HashEntry& hash_entry1 = hash_table1[hash_code];
 			if (hash_entry1.ptr < 0) continue;
-			HashEntry hash_entry2 = hash_table2[hash_code];
+			HashEntry hash_entry2 = shared_block_layout ? hash_entry1 : hash_table2[hash_code];
 
 			// the rare case where we have different positions for primary & secondary voxel block with the same index:
 			// we have a hash bucket miss, find the secondary voxel with the matching coordinates
-			if (hash_entry2.pos != hash_entry1.pos) {
+			if (!shared_block_layout && hash_entry2.pos != hash_entry1.pos) {
 				int hash_code2;
 				if (!FindHashAtPosition(hash_code2, hash_entry1.pos, hash_table2)) {
 					std::stringstream stream;
@@ -136,6 +140,24 @@ voxels1, voxels2, block_traverser)
 		}
 	}
 
+	template<typename TFunctor>
+	inline static void
+	Traverse2BlocksWithFunctor(TVoxel1* voxel_block1, TVoxel2* voxel_block2, TFunctor& functor, std::false_type) {
+		Traverse2Blocks(
+				voxel_block1, voxel_block2,
+				[&functor](TVoxel1& voxel1, TVoxel2& voxel2) {
+					functor(voxel1, voxel2);
+				}
+		);
+	}
+
+	// functor has a block kernel (see VoxelBlockKernels_CPU.h)
+	template<typename TFunctor>
+	inline static void
+	Traverse2BlocksWithFunctor(TVoxel1* voxel_block1, TVoxel2* voxel_block2, TFunctor& functor, std::true_type) {
+		functor.ProcessBlock(voxel_block1, voxel_block2, VOXEL_BLOCK_SIZE3);
+	}
+
 	template<typename T2VoxelAndPositionFunction>
 	inline static void
 	Traverse2BlocksWithPosition(TVoxel1* voxel_block1, TVoxel2* voxel_block2, const HashEntry& hash_entry1,
@@ -334,14 +356,7 @@ public:
 		TraverseUtilized_Generic(
 				volume1, volume2,
 				[&functor](TVoxel1* voxel_block1, TVoxel2* voxel_block2, const HashEntry& hash_entry1) {
-					Traverse2Blocks(
-							voxel_block1,
-							voxel_block2,
-							[&functor](TVoxel1& voxel1, TVoxel2& voxel2) {
-								functor(voxel1, voxel2);
-							}
-					);
-
+					Traverse2BlocksWithFunctor(voxel_block1, voxel_block2, functor, HasBlockKernel<TFunctor, TVoxel1*, TVoxel2*>());
 				}
 		);
 	}
@@ -28,6 +28,7 @@
 #include "../../../Objects/Volume/VoxelVolume.h"
 #include "../Shared/VolumeTraversal_Shared.h"
 #include "../../../Utils/Geometry/GeometryBooleanOperations.h"
+#include "../../Common/VoxelBlockKernels_CPU.h"
 
 namespace ITMLib {
 
@@ -224,15 +225,17 @@ public: // static functions
 	template<typename TStaticFunctor>
 	inline static void TraverseAll(VoxelVolume<TVoxel, PlainVoxelArray>* volume) {
 		TVoxel* voxels = volume->GetVoxels();
-		int voxel_count =
+		const int voxel_count =
 				volume->index.GetVolumeSize().x * volume->index.GetVolumeSize().y * volume->index.GetVolumeSize().z;
+		// chunks of one voxel block's worth of voxels, so that block kernels (if any) see the same runs as with hashing
+		const int chunk_count = (voxel_count + VOXEL_BLOCK_SIZE3 - 1) / VOXEL_BLOCK_SIZE3;
 #ifdef WITH_OPENMP
-#pragma omp parallel for default(none) shared(voxels) firstprivate(voxel_count)
+#pragma omp parallel for default(none) shared(voxels) firstprivate(voxel_count, chunk_count)
 #endif
-		for (int linear_index = 0; linear_index < voxel_count; linear_index++) {
-
-			TVoxel& voxel = voxels[linear_index];
-			TStaticFunctor::run(voxel);
+		for (int i_chunk = 0; i_chunk < chunk_count; i_chunk++) {
+			const int chunk_start = i_chunk * VOXEL_BLOCK_SIZE3;
+			RunStaticFunctorOnVoxels<TStaticFunctor>(voxels + chunk_start,
+			                                         ORUTILS_MIN(VOXEL_BLOCK_SIZE3, voxel_count - chunk_start));
 		}
 	}
 
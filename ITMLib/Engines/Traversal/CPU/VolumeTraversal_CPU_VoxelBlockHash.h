@@ -22,6 +22,7 @@
 #include "../../EditAndCopy/CPU/EditAndCopyEngine_CPU.h"
 #include "../Shared/VolumeTraversal_Shared.h"
 #include "../../../Utils/Analytics/IsAltered.h"
+#include "../../Common/VoxelBlockKernels_CPU.h"
 
 namespace ITMLib {
 
@@ -169,15 +170,14 @@ private:
 
 public:
 // region ================================ STATIC SINGLE-VOLUME TRAVERSAL ===============================================
+	// static functors with a block kernel (see VoxelBlockKernels_CPU.h) are run on whole blocks in the methods without position
 	template<typename TStaticFunctor>
 	inline static void
 	TraverseAll(VoxelVolume <TVoxel, VoxelBlockHash>* volume) {
 		TraverseAll_Generic<TVoxel>(
 				volume,
 				[](TVoxel* voxel_block, const HashEntry& hash_entry) {
-					TraverseBlock(voxel_block, [](TVoxel& voxel) {
-						TStaticFunctor::run(voxel);
-					});
+					RunStaticFunctorOnVoxels<TStaticFunctor>(voxel_block, VOXEL_BLOCK_SIZE3);
 				}
 		);
 	}
@@ -188,9 +188,7 @@ public:
 		TraverseAll_Generic<const TVoxel>(
 				volume,
 				[](const TVoxel* voxel_block, const HashEntry& hash_entry) {
-					TraverseBlock(voxel_block, [](const TVoxel& voxel) {
-						TStaticFunctor::run(voxel);
-					});
+					RunStaticFunctorOnVoxels<TStaticFunctor>(voxel_block, VOXEL_BLOCK_SIZE3);
 				}
 		);
 	}
@@ -201,9 +199,7 @@ public:
 		TraverseUtilized_Generic<TVoxel>(
 				volume,
 				[](TVoxel* voxel_block, const HashEntry& hash_entry) {
-					TraverseBlock(voxel_block, [](TVoxel& voxel) {
-						TStaticFunctor::run(voxel);
-					});
+					RunStaticFunctorOnVoxels<TStaticFunctor>(voxel_block, VOXEL_BLOCK_SIZE3);
 				}
 		);
 	}
@@ -215,9 +211,7 @@ public:
 		TraverseUtilized_Generic<const TVoxel>(
 				volume,
 				[](const TVoxel* voxel_block, const HashEntry& hash_entry) {
-					TraverseBlock(voxel_block, [](const TVoxel& voxel) {
-						TStaticFunctor::run(voxel);
-					});
+					RunStaticFunctorOnVoxels<TStaticFunctor>(voxel_block, VOXEL_BLOCK_SIZE3);
 				}
 		);
 	}
@@ -69,7 +69,9 @@ __global__ static void Traverse_device(TData* data, const unsigned int element_c
 template<typename TData, typename TFunctor>
 __global__ static void Traverse_device(TData* data, const int* sample_indices, const int sample_size, TFunctor* functor_device) {
 	int i_index = threadIdx.x + blockIdx.x * blockDim.x;
-	(*functor_device)(data, sample_indices[i_index], i_index >= sample_size);
+	const bool padding_job = i_index >= sample_size;
+	// padding jobs don't correspond to any sample, avoid reading past the end of the sample index array for them
+	(*functor_device)(data, padding_job ? 0 : sample_indices[i_index], padding_job);
 }
 
 
@@ -152,6 +152,45 @@ public:
 			TFunctor& functor){
 		TraverseAllWithPosition(volume1,volume2,volume3, functor);
 	}
+
+	/**
+	 * \brief Neighbor-aware counterpart of TraverseUtilizedWithPosition. For plain voxel arrays, the neighborhood of every
+	 * voxel is fully described by the index data of each volume, which is handed to the functor as the neighborhood view.
+	 * \details Functor is called as functor(voxel1, voxel2, voxel3, voxel_position, neighborhood1, neighborhood2, neighborhood3).
+	 */
+	template<typename TFunctor>
+	inline static void
+	TraverseUtilizedWithNeighborhood(
+			ITMLib::VoxelVolume<TVoxel1, ITMLib::PlainVoxelArray>* volume1,
+			ITMLib::VoxelVolume<TVoxel2, ITMLib::PlainVoxelArray>* volume2,
+			ITMLib::VoxelVolume<TVoxel3, ITMLib::PlainVoxelArray>* volume3,
+			TFunctor& functor) {
+
+		assert(volume2->index.GetVolumeSize() == volume3->index.GetVolumeSize() &&
+		       volume2->index.GetVolumeSize() == volume1->index.GetVolumeSize());
+
+		// transfer functor from RAM to VRAM
+		TFunctor* functor_device = nullptr;
+		ORcudaSafeCall(cudaMalloc((void**) &functor_device, sizeof(TFunctor)));
+		ORcudaSafeCall(cudaMemcpy(functor_device, &functor, sizeof(TFunctor), cudaMemcpyHostToDevice));
+
+		dim3 cuda_block_size(VOXEL_BLOCK_SIZE, VOXEL_BLOCK_SIZE, VOXEL_BLOCK_SIZE);
+		dim3 grid_size(
+				static_cast<int>(ceil(static_cast<float>(volume1->index.GetVolumeSize().x) / cuda_block_size.x)),
+				static_cast<int>(ceil(static_cast<float>(volume1->index.GetVolumeSize().y) / cuda_block_size.y)),
+				static_cast<int>(ceil(static_cast<float>(volume1->index.GetVolumeSize().z) / cuda_block_size.z))
+		);
+
+		threeVolumeTraversalWithNeighborhood_device<TFunctor, TVoxel1, TVoxel2, TVoxel3>
+		<<< grid_size, cuda_block_size >>>
+				(volume1->GetVoxels(), volume2->GetVoxels(), volume3->GetVoxels(), volume1->index.GetIndexData(),
+				 volume2->index.GetIndexData(), volume3->index.GetIndexData(), functor_device);
+		ORcudaKernelCheck;
+
+		// transfer functor from VRAM back to RAM
+		ORcudaSafeCall(cudaMemcpy(&functor, functor_device, sizeof(TFunctor), cudaMemcpyDeviceToHost));
+		ORcudaSafeCall(cudaFree(functor_device));
+	}
 // endregion ===========================================================================================================
 };
 
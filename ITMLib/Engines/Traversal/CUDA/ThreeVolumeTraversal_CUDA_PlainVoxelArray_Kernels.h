@@ -116,4 +116,25 @@ ThreeVolumeTraversalWithPosition_device(TVoxel1* voxels1, TVoxel2* voxels2, TVox
 
 }
 
+template<typename TFunctor, typename TVoxel1, typename TVoxel2, typename TVoxel3>
+__global__ void
+threeVolumeTraversalWithNeighborhood_device(TVoxel1* voxels1, TVoxel2* voxels2, TVoxel3* voxels3,
+                                            const ITMLib::GridAlignedBox* array_info1,
+                                            const ITMLib::GridAlignedBox* array_info2,
+                                            const ITMLib::GridAlignedBox* array_info3,
+                                            TFunctor* functor) {
+	int x = blockIdx.x * blockDim.x + threadIdx.x;
+	int y = blockIdx.y * blockDim.y + threadIdx.y;
+	int z = blockIdx.z * blockDim.z + threadIdx.z;
+
+	if (x >= array_info1->size.x || y >= array_info1->size.y || z >= array_info1->size.z) return;
+
+	int linear_index = x + y * array_info1->size.x + z * array_info1->size.x * array_info1->size.y;
+
+	Vector3i voxel_position(x + array_info1->offset.x, y + array_info1->offset.y, z + array_info1->offset.z);
+
+	(*functor)(voxels1[linear_index], voxels2[linear_index], voxels3[linear_index], voxel_position,
+	           *array_info1, *array_info2, *array_info3);
+}
+
 } // end anonymous namespace (CUDA kernels)
@@ -40,9 +40,12 @@ private:
 		TVoxel1* voxels1 = volume1->GetVoxels();
 		HashEntry* hash_table1 = volume1->index.GetEntries();
 		TVoxel2* voxels2 = volume2->GetVoxels();
-		HashEntry* hash_table2 = volume2->index.GetEntries();
+		// with a shared block layout, the entries of volume 1 are good for the other volume as well
+		HashEntry* hash_table2 = volume2->index.SharesBlockLayoutWith(volume1->index) ?
+		                         hash_table1 : volume2->index.GetEntries();
 		TVoxel3* voxels3 = volume3->GetVoxels();
-		HashEntry* hash_table3 = volume3->index.GetEntries();
+		HashEntry* hash_table3 = volume3->index.SharesBlockLayoutWith(volume1->index) ?
+		                         hash_table1 : volume3->index.GetEntries();
 
 		const int hash_entry_count = volume3->index.hash_entry_count;
 
@@ -75,9 +78,11 @@ private:
 		TVoxel1* voxels1 = volume1->GetVoxels();
 		HashEntry* hash_table1 = volume1->index.GetEntries();
 		TVoxel2* voxels2 = volume2->GetVoxels();
-		HashEntry* hash_table2 = volume2->index.GetEntries();
+		HashEntry* hash_table2 = volume2->index.SharesBlockLayoutWith(volume1->index) ?
+		                         hash_table1 : volume2->index.GetEntries();
 		TVoxel3* voxels3 = volume3->GetVoxels();
-		HashEntry* hash_table3 = volume3->index.GetEntries();
+		HashEntry* hash_table3 = volume3->index.SharesBlockLayoutWith(volume1->index) ?
+		                         hash_table1 : volume3->index.GetEntries();
 
 		const int utilized_entry_count = volume1->index.GetUtilizedBlockCount();
 		const int* utilized_entry_codes = volume1->index.GetUtilizedBlockHashCodes();
@@ -149,6 +154,49 @@ public:
 				functor
 		);
 	}
+
+	/**
+	 * \brief Traverse utilized blocks of volume 1 along with matching blocks of volumes 2 & 3, additionally handing the
+	 * functor a neighbor-aware view of the current block in each volume
+	 * \details Neighbor reads through the views (see readVoxel) within the 3x3x3 block neighborhood need no hashing. Requires
+	 * block neighbor tables of all three volumes to be built with volume 1 as reference (see BuildBlockNeighborTable).
+	 * Functor is called as functor(voxel1, voxel2, voxel3, voxel_position, neighborhood1, neighborhood2, neighborhood3).
+	 */
+	template<typename TFunctor>
+	inline static void
+	TraverseUtilizedWithNeighborhood(
+			VoxelVolume<TVoxel1, VoxelBlockHash>* volume1,
+			VoxelVolume<TVoxel2, VoxelBlockHash>* volume2,
+			VoxelVolume<TVoxel3, VoxelBlockHash>* volume3,
+			TFunctor& functor) {
+		if (!volume1->index.BlockNeighborTableMatches(volume1->index) ||
+		    !volume2->index.BlockNeighborTableMatches(volume1->index) ||
+		    !volume3->index.BlockNeighborTableMatches(volume1->index)) {
+			DIEWITHEXCEPTION_REPORTLOCATION("Block neighbor tables are out of date with the utilized blocks of volume 1, "
+			                                "they need to be rebuilt using volume 1 as reference.");
+		}
+		const int* block_neighbor_table1 = volume1->index.GetBlockNeighborTable();
+		const int* block_neighbor_table2 = volume2->index.GetBlockNeighborTable();
+		const int* block_neighbor_table3 = volume3->index.GetBlockNeighborTable();
+		TraverseUtilized_Generic(
+				volume1, volume2, volume3,
+				[&block_neighbor_table1, &block_neighbor_table2, &block_neighbor_table3](
+						dim3 hash_per_block_cuda_grid_size, dim3 voxel_per_thread_cuda_block_size,
+						TVoxel1* voxels1, TVoxel2* voxels2, TVoxel3* voxels3,
+						HashEntry* hash_table1, HashEntry* hash_table2, HashEntry* hash_table3,
+						const int* utilized_hash_codes, TFunctor* functor_device) {
+					traverseUtilizedWithNeighborhood_device<TFunctor, TVoxel1, TVoxel2, TVoxel3>
+							<<< hash_per_block_cuda_grid_size, voxel_per_thread_cuda_block_size >>>
+					                                            (voxels1, voxels2, voxels3,
+							                                            hash_table1, hash_table2, hash_table3,
+							                                            block_neighbor_table1, block_neighbor_table2,
+							                                            block_neighbor_table3,
+							                                            utilized_hash_codes, functor_device);
+					ORcudaKernelCheck;
+				},
+				functor
+		);
+	}
 // endregion ===========================================================================================================
 };
 
@@ -104,4 +104,40 @@ traverseUtilizedWithPosition_device(TVoxel1* voxels1, TVoxel2* voxels2, TVoxel3*
 	(*functor)(voxel1, voxel2, voxel3, voxel_position);
 }
 
+template<typename TFunctor, typename TVoxel1, typename TVoxel2, typename TVoxel3>
+__global__ void
+traverseUtilizedWithNeighborhood_device(TVoxel1* voxels1, TVoxel2* voxels2, TVoxel3* voxels3,
+                                        const ITMLib::HashEntry* hash_table1, const ITMLib::HashEntry* hash_table2,
+                                        const ITMLib::HashEntry* hash_table3, const int* block_neighbor_table1,
+                                        const int* block_neighbor_table2, const int* block_neighbor_table3,
+                                        const int* utilized_hash_codes, TFunctor* functor) {
+	const int i_utilized_block = blockIdx.x;
+	const int neighbor_table_row_start = i_utilized_block * VOXEL_BLOCK_NEIGHBORHOOD_SIZE;
+	const Vector3i block_origin = hash_table1[utilized_hash_codes[i_utilized_block]].pos.toInt() * VOXEL_BLOCK_SIZE;
+
+	const ITMLib::HashBlockNeighborhood neighborhood1{block_neighbor_table1 + neighbor_table_row_start, hash_table1, block_origin};
+	const ITMLib::HashBlockNeighborhood neighborhood2{block_neighbor_table2 + neighbor_table_row_start, hash_table2, block_origin};
+	const ITMLib::HashBlockNeighborhood neighborhood3{block_neighbor_table3 + neighbor_table_row_start, hash_table3, block_origin};
+
+	// central block of the neighborhood is the block itself
+	const int central_neighbor_index = VOXEL_BLOCK_NEIGHBORHOOD_SIZE / 2;
+	if (neighborhood2.neighbor_block_offsets[central_neighbor_index] < 0 ||
+	    neighborhood3.neighbor_block_offsets[central_neighbor_index] < 0) {
+		printf("Attempted traversal of volume 1 hash block at %d %d %d, but this block is absent from volume 2 or 3.\n",
+		       block_origin.x / VOXEL_BLOCK_SIZE, block_origin.y / VOXEL_BLOCK_SIZE, block_origin.z / VOXEL_BLOCK_SIZE);
+		DIEWITHEXCEPTION_REPORTLOCATION("No hash block with corresponding position found in other hash table.");
+	}
+
+	int x = threadIdx.x;
+	int y = threadIdx.y;
+	int z = threadIdx.z;
+	int linear_index_in_block = x + y * VOXEL_BLOCK_SIZE + z * VOXEL_BLOCK_SIZE * VOXEL_BLOCK_SIZE;
+	Vector3i voxel_position = block_origin + Vector3i(x, y, z);
+
+	TVoxel1& voxel1 = voxels1[neighborhood1.neighbor_block_offsets[central_neighbor_index] + linear_index_in_block];
+	TVoxel2& voxel2 = voxels2[neighborhood2.neighbor_block_offsets[central_neighbor_index] + linear_index_in_block];
+	TVoxel3& voxel3 = voxels3[neighborhood3.neighbor_block_offsets[central_neighbor_index] + linear_index_in_block];
+	(*functor)(voxel1, voxel2, voxel3, voxel_position, neighborhood1, neighborhood2, neighborhood3);
+}
+
 } // end anonymous namespace (CUDA kernels)
\ No newline at end of file
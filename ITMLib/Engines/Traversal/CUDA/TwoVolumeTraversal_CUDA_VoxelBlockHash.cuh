@@ -37,7 +37,9 @@ private:
 		TVoxel1* voxels1 = volume1->GetVoxels();
 		TVoxel2* voxels2 = volume2->GetVoxels();
 		const HashEntry* hash_table1 = volume1->index.GetIndexData();
-		const HashEntry* hash_table2 = volume2->index.GetIndexData();
+		// with a shared block layout, the entries of volume 1 are good for both volumes
+		const HashEntry* hash_table2 = volume2->index.SharesBlockLayoutWith(volume1->index) ?
+		                               hash_table1 : volume2->index.GetIndexData();
 		const int hash_entry_count = volume1->index.hash_entry_count;
 
 		// transfer functor from RAM to VRAM
@@ -67,7 +69,8 @@ private:
 		TVoxel1* voxels1 = volume1->GetVoxels();
 		TVoxel2* voxels2 = volume2->GetVoxels();
 		const HashEntry* hash_table1 = volume1->index.GetIndexData();
-		const HashEntry* hash_table2 = volume2->index.GetIndexData();
+		const HashEntry* hash_table2 = volume2->index.SharesBlockLayoutWith(volume1->index) ?
+		                               hash_table1 : volume2->index.GetIndexData();
 		const int utilized_entry_count = volume1->index.GetUtilizedBlockCount();
 		const int* utilized_hash_codes = volume1->index.GetUtilizedBlockHashCodes();
 
@@ -172,5 +172,16 @@ public: // static functions
 	inline static void TraverseVisible_Padded(const VoxelBlockHash& index, TFunctor& functor) {
 		TraverseVisibleWithIndex_Generic<PADDED>(index, functor);
 	}
+
+	/**
+	 * \brief Traverse the hash entries at the specified hash codes, e.g. some subset of the utilized blocks.
+	 * \param hash_codes hash codes of the entries to traverse, in the same memory as the index
+	 */
+	template<typename TFunctor>
+	inline static void TraverseSample_Padded(const VoxelBlockHash& index, const int* hash_codes, const int hash_code_count,
+	                                         TFunctor& functor) {
+		internal::RawArrayTraversalEngine_Internal<TMemoryDeviceType, PADDED, INDEX_SAMPLE>::template TraverseWithIndex_Generic
+				(hash_code_count, hash_codes, index.GetEntries(), functor);
+	}
 };
 } // namespace ITMLib
@@ -96,9 +96,16 @@ void ViewBuilder_CPU::ConvertDisparityToDepth(FloatImage& depth_out, const Short
 
 	float fx_depth = depthIntrinsics.projectionParamsSimple.fx;
 
-	for (int y = 0; y < image_dimensions.y; y++)
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
+	for (int y = 0; y < image_dimensions.y; y++) {
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
 		for (int x = 0; x < image_dimensions.x; x++)
 			convertDisparityToDepth(d_out, x, y, d_in, disparityCalibParams, fx_depth, image_dimensions);
+	}
 }
 
 void ViewBuilder_CPU::ConvertDepthAffineToFloat(FloatImage& depth_out, const ShortImage& depth_in, const Vector2f depthCalibParams) {
@@ -107,7 +114,13 @@ void ViewBuilder_CPU::ConvertDepthAffineToFloat(FloatImage& depth_out, const Sho
 	const short* d_in = depth_in.GetData(MEMORYDEVICE_CPU);
 	float* d_out = depth_out.GetData(MEMORYDEVICE_CPU);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 0; y < image_dimensions.y; y++) {
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
 		for (int x = 0; x < image_dimensions.x; x++) {
 			convertDepthAffineToFloat(d_out, x, y, d_in, image_dimensions, depthCalibParams);
 		}
@@ -122,6 +135,9 @@ void ViewBuilder_CPU::DepthFiltering(FloatImage& image_out, const FloatImage& im
 	float* imout = image_out.GetData(MEMORYDEVICE_CPU);
 	const float* imin = image_in.GetData(MEMORYDEVICE_CPU);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 2; y < imgSize.y - 2; y++)
 		for (int x = 2; x < imgSize.x - 2; x++)
 			filterDepth(imout, imin, x, y, imgSize);
@@ -136,6 +152,9 @@ void ViewBuilder_CPU::ComputeNormalAndWeights(Float4Image& normal_out, FloatImag
 	float* sigma_z_data_out = sigma_z_out.GetData(MEMORYDEVICE_CPU);
 	Vector4f* normal_data_out = normal_out.GetData(MEMORYDEVICE_CPU);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 2; y < imgDims.y - 2; y++)
 		for (int x = 2; x < imgDims.x - 2; x++)
 			computeNormalAndWeight(depth_data_in, normal_data_out, sigma_z_data_out, x, y, imgDims, camera_projection_parameters);
@@ -149,6 +168,9 @@ void ViewBuilder_CPU::ThresholdFiltering(FloatImage& image_out, const FloatImage
 	float* imout = image_out.GetData(MEMORYDEVICE_CPU);
 	const float* imin = image_in.GetData(MEMORYDEVICE_CPU);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for
+#endif
 	for (int y = 2; y < imgSize.y - 2; y++)
 		for (int x = 2; x < imgSize.x - 2; x++)
 			thresholdDepth(imout, imin, x, y, imgSize);
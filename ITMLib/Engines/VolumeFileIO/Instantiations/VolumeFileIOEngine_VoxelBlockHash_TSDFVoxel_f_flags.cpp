@@ -18,4 +18,6 @@
 namespace ITMLib {
 template
 class VolumeFileIOEngine<TSDFVoxel_f_flags, VoxelBlockHash>;
+template
+class MappedVolume<TSDFVoxel_f_flags>;
 } // namespace ITMLib
\ No newline at end of file
@@ -18,4 +18,6 @@
 namespace ITMLib {
 template
 class VolumeFileIOEngine<TSDFVoxel_f_rgb, VoxelBlockHash>;
+template
+class MappedVolume<TSDFVoxel_f_rgb>;
 } // namespace ITMLib
\ No newline at end of file
@@ -18,4 +18,6 @@
 namespace ITMLib {
 template
 class VolumeFileIOEngine<WarpVoxel, VoxelBlockHash>;
+template
+class MappedVolume<WarpVoxel>;
 } // namespace ITMLib
\ No newline at end of file
@@ -15,13 +15,46 @@
 //  ================================================================
 #pragma once
 
+//stdlib
+#include <cstdint>
+
+//local
 #include "../../Objects/Volume/VoxelBlockHash.h"
 #include "../../Objects/Volume/PlainVoxelArray.h"
 #include "../../Objects/Volume/VoxelVolume.h"
+#include "../../Utils/Configuration/Configuration.h"
 #include "../../../ORUtils/MemoryBlockPersistence.h"
+#include "../../../ORUtils/MappedFile.h"
 
 namespace ITMLib{
 
+/**
+ * \brief Header of the mapped voxel block hash volume file format, which is uncompressed and can be memory-mapped.
+ * \details The header is followed by these sections, each starting at an offset that is a multiple of
+ * MAPPED_VOLUME_SECTION_ALIGNMENT: the entire hash table, the excess entry list, the utilized block hash codes, the
+ * visible block hash codes, and, contiguously, the voxel blocks of all utilized blocks in the order of the utilized
+ * block hash codes. Block pointers of the hash entries are renumbered on saving, so that they index the voxel blocks
+ * in the last section directly.
+ */
+struct MappedVolumeFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t hash_entry_size;
+	uint32_t voxel_size;
+	int32_t excess_list_size;
+	int32_t last_free_excess_list_id;
+	int32_t utilized_block_count;
+	int32_t visible_block_count;
+	uint64_t hash_table_offset;
+	uint64_t excess_entry_list_offset;
+	uint64_t utilized_block_hash_codes_offset;
+	uint64_t visible_block_hash_codes_offset;
+	uint64_t voxel_offset;
+};
+
+constexpr uint32_t MAPPED_VOLUME_FILE_VERSION = 1;
+constexpr uint64_t MAPPED_VOLUME_SECTION_ALIGNMENT = 4096;
+
 template<typename TVoxel, typename TIndex>
 class VolumeFileIOEngine;
 
@@ -30,9 +63,45 @@ class VolumeFileIOEngine<TVoxel,VoxelBlockHash>{
 public:
 	static void SaveVolumeCompact(const VoxelVolume<TVoxel,VoxelBlockHash>& volume, const std::string& path);
 	static void LoadVolumeCompact(VoxelVolume<TVoxel,VoxelBlockHash>& volume, const std::string& path);
+	/** \brief Save the volume in the mapped format (\see MappedVolumeFileHeader). */
+	static void SaveVolumeMapped(const VoxelVolume<TVoxel,VoxelBlockHash>& volume, const std::string& path);
+	/**
+	 * \brief Load a volume saved in the mapped format by bulk-copying the file sections straight from the mapped file
+	 * into the volume's (CPU or CUDA) memory.
+	 * \details As with LoadVolumeCompact, the volume is expected to be reset beforehand. The volume needs to have the
+	 * same excess list size as the saved one and room for all of its blocks.
+	 */
+	static void LoadVolumeMapped(VoxelVolume<TVoxel,VoxelBlockHash>& volume, const std::string& path);
 	static void AppendFileWithUtilizedMemoryInformation(ORUtils::OStreamWrapper& file, const VoxelVolume<TVoxel,VoxelBlockHash>& volume);
 };
 
+/**
+ * \brief Read-only CPU volume that uses the hash table and voxel blocks of a file in the mapped format
+ * (\see MappedVolumeFileHeader) in place, without copying them.
+ * \details Pages of the file are only read in as they are accessed. The volume is full, i.e. no blocks can be allocated
+ * in it, and modifications to it (if any) are never written back to the file.
+ */
+template<typename TVoxel>
+class MappedVolume {
+public:
+	explicit MappedVolume(const std::string& path, const VoxelVolumeParameters& volume_parameters =
+			configuration::Get().general_voxel_volume_parameters);
+
+	MappedVolume(const MappedVolume&) = delete;
+	MappedVolume& operator=(const MappedVolume&) = delete;
+
+	const VoxelVolume<TVoxel, VoxelBlockHash>& Get() const { return volume; }
+	/** \brief Non-const access for functions that don't take const volumes. Nothing written ever makes it to the file. */
+	VoxelVolume<TVoxel, VoxelBlockHash>& Get() { return volume; }
+
+private:
+	static VoxelBlockHash WrapIndex(ORUtils::MappedFile& file, const std::string& path);
+	static ORUtils::MemoryBlock<TVoxel> WrapVoxels(ORUtils::MappedFile& file);
+
+	ORUtils::MappedFile file;
+	VoxelVolume<TVoxel, VoxelBlockHash> volume;
+};
+
 
 template<typename TVoxel>
 class VolumeFileIOEngine<TVoxel,PlainVoxelArray>{
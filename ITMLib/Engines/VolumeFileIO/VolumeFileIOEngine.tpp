@@ -14,6 +14,11 @@
 //  limitations under the License.
 //  ================================================================
 
+//stdlib
+#include <cstring>
+#include <fstream>
+#include <vector>
+
 //boost
 #include "../../../ORUtils/OStreamWrapper.h"
 #include "../../../ORUtils/IStreamWrapper.h"
@@ -24,6 +29,74 @@
 
 using namespace ITMLib;
 
+namespace {
+
+const char mapped_volume_file_magic[8] = {'I', 'T', 'M', 'V', 'B', 'H', 'M', 'F'};
+
+inline uint64_t AlignToMappedVolumeSection(uint64_t offset) {
+	return (offset + MAPPED_VOLUME_SECTION_ALIGNMENT - 1) / MAPPED_VOLUME_SECTION_ALIGNMENT * MAPPED_VOLUME_SECTION_ALIGNMENT;
+}
+
+/** \brief Check that the mapped file is a complete mapped volume file for the given voxel type and return its header */
+template<typename TVoxel>
+const MappedVolumeFileHeader& ReadMappedVolumeFileHeader(const ORUtils::MappedFile& file, const std::string& path) {
+	if (file.Size() < sizeof(MappedVolumeFileHeader)) {
+		DIEWITHEXCEPTION("File \"" + path + "\" is too small to be a mapped volume file.");
+	}
+	const auto& header = *reinterpret_cast<const MappedVolumeFileHeader*>(file.Data());
+	if (std::memcmp(header.magic, mapped_volume_file_magic, sizeof(mapped_volume_file_magic)) != 0) {
+		DIEWITHEXCEPTION("File \"" + path + "\" is not a mapped volume file.");
+	}
+	if (header.version != MAPPED_VOLUME_FILE_VERSION) {
+		DIEWITHEXCEPTION("Unsupported mapped volume file version in \"" + path + "\".");
+	}
+	if (header.hash_entry_size != sizeof(HashEntry) || header.voxel_size != sizeof(TVoxel)) {
+		DIEWITHEXCEPTION("Hash entry or voxel type of mapped volume file \"" + path +
+		                                 "\" does not match the volume's.");
+	}
+	const uint64_t voxel_end = header.voxel_offset + static_cast<uint64_t>(header.utilized_block_count) *
+	                                                 VOXEL_BLOCK_SIZE3 * sizeof(TVoxel);
+	if (file.Size() < voxel_end) {
+		DIEWITHEXCEPTION("Mapped volume file \"" + path + "\" is truncated.");
+	}
+	return header;
+}
+
+template<typename T>
+inline const T* GetMappedSection(const ORUtils::MappedFile& file, uint64_t offset) {
+	return reinterpret_cast<const T*>(file.Data() + offset);
+}
+
+template<typename T>
+inline T* GetMappedSection(ORUtils::MappedFile& file, uint64_t offset) {
+	return reinterpret_cast<T*>(file.Data() + offset);
+}
+
+template<typename T>
+void CopyFromHostMemory(T* destination, const T* source, std::size_t element_count, MemoryDeviceType memory_type) {
+	switch (memory_type) {
+		case MEMORYDEVICE_CPU:
+			std::memcpy(destination, source, element_count * sizeof(T));
+			break;
+#ifndef COMPILE_WITHOUT_CUDA
+		case MEMORYDEVICE_CUDA:
+			ORcudaSafeCall(cudaMemcpy(destination, source, element_count * sizeof(T), cudaMemcpyHostToDevice));
+			break;
+#endif
+		default:
+			DIEWITHEXCEPTION_REPORTLOCATION("Unsupported device type.");
+	}
+}
+
+void WriteMappedVolumeSection(std::ofstream& file, const void* data, std::size_t size, uint64_t offset) {
+	const auto padding_size = static_cast<std::size_t>(offset - static_cast<uint64_t>(file.tellp()));
+	const std::vector<char> padding(padding_size, 0);
+	file.write(padding.data(), padding_size);
+	file.write(reinterpret_cast<const char*>(data), size);
+}
+
+} // anonymous namespace
+
 
 // region ==================================== VOXEL BLOCK HASH ========================================================
 
@@ -135,6 +208,113 @@ VolumeFileIOEngine<TVoxel, VoxelBlockHash>::LoadVolumeCompact(VoxelVolume<TVoxel
 	}
 }
 
+template<typename TVoxel>
+void VolumeFileIOEngine<TVoxel, VoxelBlockHash>::SaveVolumeMapped(const VoxelVolume<TVoxel, VoxelBlockHash>& volume,
+                                                                  const std::string& path) {
+	std::unique_ptr<VoxelVolume<TVoxel, VoxelBlockHash>> volume_cpu_copy;
+	const VoxelVolume<TVoxel, VoxelBlockHash>* volume_to_save = &volume;
+	if (volume.index.memory_type == MEMORYDEVICE_CUDA) {
+		volume_cpu_copy.reset(new VoxelVolume<TVoxel, VoxelBlockHash>(volume, MEMORYDEVICE_CPU));
+		volume_to_save = volume_cpu_copy.get();
+	}
+	const VoxelBlockHash& index = volume_to_save->index;
+	const int utilized_block_count = index.GetUtilizedBlockCount();
+	const int visible_block_count = index.GetVisibleBlockCount();
+	const int* utilized_hash_codes = index.GetUtilizedBlockHashCodes();
+
+	MappedVolumeFileHeader header{};
+	std::memcpy(header.magic, mapped_volume_file_magic, sizeof(mapped_volume_file_magic));
+	header.version = MAPPED_VOLUME_FILE_VERSION;
+	header.hash_entry_size = sizeof(HashEntry);
+	header.voxel_size = sizeof(TVoxel);
+	header.excess_list_size = index.excess_list_size;
+	header.last_free_excess_list_id = index.GetLastFreeExcessListId();
+	header.utilized_block_count = utilized_block_count;
+	header.visible_block_count = visible_block_count;
+	header.hash_table_offset = AlignToMappedVolumeSection(sizeof(MappedVolumeFileHeader));
+	header.excess_entry_list_offset = AlignToMappedVolumeSection(
+			header.hash_table_offset + static_cast<uint64_t>(index.hash_entry_count) * sizeof(HashEntry));
+	header.utilized_block_hash_codes_offset = AlignToMappedVolumeSection(
+			header.excess_entry_list_offset + static_cast<uint64_t>(index.excess_list_size) * sizeof(int));
+	header.visible_block_hash_codes_offset = AlignToMappedVolumeSection(
+			header.utilized_block_hash_codes_offset + static_cast<uint64_t>(utilized_block_count) * sizeof(int));
+	header.voxel_offset = AlignToMappedVolumeSection(
+			header.visible_block_hash_codes_offset + static_cast<uint64_t>(visible_block_count) * sizeof(int));
+
+	// renumber the blocks in the order of the utilized block list, which is the order they are written in
+	std::vector<HashEntry> hash_table(index.GetEntries(), index.GetEntries() + index.hash_entry_count);
+	for (int i_utilized_block = 0; i_utilized_block < utilized_block_count; i_utilized_block++) {
+		hash_table[utilized_hash_codes[i_utilized_block]].ptr = i_utilized_block;
+	}
+
+	std::ofstream file(path, std::ios::binary | std::ios::out);
+	if (!file) {
+		DIEWITHEXCEPTION("Could not open file \"" + path + "\" for writing.");
+	}
+	file.write(reinterpret_cast<const char*>(&header), sizeof(MappedVolumeFileHeader));
+	WriteMappedVolumeSection(file, hash_table.data(), hash_table.size() * sizeof(HashEntry), header.hash_table_offset);
+	WriteMappedVolumeSection(file, index.GetExcessEntryList(), index.excess_list_size * sizeof(int),
+	                         header.excess_entry_list_offset);
+	WriteMappedVolumeSection(file, utilized_hash_codes, utilized_block_count * sizeof(int),
+	                         header.utilized_block_hash_codes_offset);
+	WriteMappedVolumeSection(file, index.GetVisibleBlockHashCodes(), visible_block_count * sizeof(int),
+	                         header.visible_block_hash_codes_offset);
+	WriteMappedVolumeSection(file, nullptr, 0, header.voxel_offset);
+	const TVoxel* voxels = volume_to_save->GetVoxels();
+	const HashEntry* original_hash_table = index.GetEntries();
+	for (int i_utilized_block = 0; i_utilized_block < utilized_block_count; i_utilized_block++) {
+		const TVoxel* voxel_block = voxels + original_hash_table[utilized_hash_codes[i_utilized_block]].ptr * VOXEL_BLOCK_SIZE3;
+		file.write(reinterpret_cast<const char*>(voxel_block), sizeof(TVoxel) * VOXEL_BLOCK_SIZE3);
+	}
+	if (!file) {
+		DIEWITHEXCEPTION("Could not write file \"" + path + "\".");
+	}
+}
+
+template<typename TVoxel>
+void VolumeFileIOEngine<TVoxel, VoxelBlockHash>::LoadVolumeMapped(VoxelVolume<TVoxel, VoxelBlockHash>& volume,
+                                                                  const std::string& path) {
+	const ORUtils::MappedFile file(path);
+	const MappedVolumeFileHeader& header = ReadMappedVolumeFileHeader<TVoxel>(file, path);
+	VoxelBlockHash& index = volume.index;
+	if (header.excess_list_size != index.excess_list_size) {
+		DIEWITHEXCEPTION_REPORTLOCATION("Excess list size of the saved volume differs from the one of the target volume.");
+	}
+	const int block_count = index.voxel_block_count;
+	const int utilized_block_count = header.utilized_block_count;
+	if (utilized_block_count > block_count) {
+		DIEWITHEXCEPTION_REPORTLOCATION("Saved volume has more blocks than the target volume can hold.");
+	}
+	const MemoryDeviceType memory_type = index.memory_type;
+
+	CopyFromHostMemory(index.GetEntries(), GetMappedSection<HashEntry>(file, header.hash_table_offset),
+	                   index.hash_entry_count, memory_type);
+	CopyFromHostMemory(index.GetExcessEntryList(), GetMappedSection<int>(file, header.excess_entry_list_offset),
+	                   index.excess_list_size, memory_type);
+	CopyFromHostMemory(index.GetUtilizedBlockHashCodes(),
+	                   GetMappedSection<int>(file, header.utilized_block_hash_codes_offset),
+	                   utilized_block_count, memory_type);
+	CopyFromHostMemory(index.GetVisibleBlockHashCodes(),
+	                   GetMappedSection<int>(file, header.visible_block_hash_codes_offset),
+	                   header.visible_block_count, memory_type);
+	CopyFromHostMemory(volume.GetVoxels(), GetMappedSection<TVoxel>(file, header.voxel_offset),
+	                   static_cast<std::size_t>(utilized_block_count) * VOXEL_BLOCK_SIZE3, memory_type);
+
+	// the saved blocks occupy the first utilized_block_count blocks of voxel memory, all the others are free
+	std::vector<int> block_allocation_list(block_count);
+	const int free_block_count = block_count - utilized_block_count;
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		block_allocation_list[i_block] = i_block < free_block_count ? utilized_block_count + i_block
+		                                                            : i_block - free_block_count;
+	}
+	CopyFromHostMemory(index.GetBlockAllocationList(), block_allocation_list.data(), block_count, memory_type);
+
+	index.SetLastFreeBlockListId(free_block_count - 1);
+	index.SetLastFreeExcessListId(header.last_free_excess_list_id);
+	index.SetUtilizedBlockCount(utilized_block_count);
+	index.SetVisibleBlockCount(header.visible_block_count);
+}
+
 template<typename TVoxel>
 void VolumeFileIOEngine<TVoxel, VoxelBlockHash>::AppendFileWithUtilizedMemoryInformation(
 		ORUtils::OStreamWrapper& file, const VoxelVolume<TVoxel, VoxelBlockHash>& volume) {
@@ -146,6 +326,37 @@ void VolumeFileIOEngine<TVoxel, VoxelBlockHash>::AppendFileWithUtilizedMemoryInf
 	}
 }
 
+// endregion ===========================================================================================================
+// region ================================= MAPPED VOLUME ==============================================================
+
+template<typename TVoxel>
+MappedVolume<TVoxel>::MappedVolume(const std::string& path, const VoxelVolumeParameters& volume_parameters)
+		: file(path),
+		  volume(volume_parameters, WrapIndex(file, path), WrapVoxels(file)) {}
+
+template<typename TVoxel>
+VoxelBlockHash MappedVolume<TVoxel>::WrapIndex(ORUtils::MappedFile& file, const std::string& path) {
+	const MappedVolumeFileHeader& header = ReadMappedVolumeFileHeader<TVoxel>(file, path);
+	VoxelBlockHash::ExternalHostData data{};
+	data.hash_entries = GetMappedSection<HashEntry>(file, header.hash_table_offset);
+	data.excess_entry_list = GetMappedSection<int>(file, header.excess_entry_list_offset);
+	data.excess_list_size = header.excess_list_size;
+	data.last_free_excess_list_id = header.last_free_excess_list_id;
+	data.utilized_block_hash_codes = GetMappedSection<int>(file, header.utilized_block_hash_codes_offset);
+	data.utilized_block_count = header.utilized_block_count;
+	data.visible_block_hash_codes = GetMappedSection<int>(file, header.visible_block_hash_codes_offset);
+	data.visible_block_count = header.visible_block_count;
+	return VoxelBlockHash(data);
+}
+
+template<typename TVoxel>
+ORUtils::MemoryBlock<TVoxel> MappedVolume<TVoxel>::WrapVoxels(ORUtils::MappedFile& file) {
+	// the header has already been checked in WrapIndex
+	const auto& header = *reinterpret_cast<const MappedVolumeFileHeader*>(file.Data());
+	return ORUtils::MemoryBlock<TVoxel>(GetMappedSection<TVoxel>(file, header.voxel_offset),
+	                                    static_cast<std::size_t>(header.utilized_block_count) * VOXEL_BLOCK_SIZE3);
+}
+
 // endregion ===========================================================================================================
 // region ================================= PLAIN VOXEL ARRAY ==========================================================
 
@@ -15,9 +15,19 @@
 //  ================================================================
 #pragma once
 
+//stdlib
+#include <cstddef>
+
+#ifndef __CUDACC__
+#ifdef WITH_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
 //local
 #include "../../../ORUtils/PlatformIndependence.h"
 #include "../../../ORUtils/MemoryDeviceType.h"
+#include "../../Objects/Volume/VoxelTypes.h"
 
 
 //#define FUSION_CONDITION_BOTH_NONTRUNCATED
@@ -30,6 +40,88 @@
 
 namespace ITMLib {
 
+#ifndef __CUDACC__
+namespace internal {
+/**
+ * \brief Vectorized part of the CPU TSDF fusion block kernel. Processes the longest prefix of voxel_count that it can
+ * handle and returns its length, leaving the rest to the per-voxel code. The generic version handles nothing.
+ */
+template<typename TVoxel, bool TUseSurfaceThicknessCutoff>
+struct TSDFFusionRowKernel {
+	static int FuseRows(const TVoxel* source_voxels, TVoxel* target_voxels, const int voxel_count, const int maximum_weight,
+	                    const float negative_surface_thickness_sdf_scale) {
+		return 0;
+	}
+};
+
+#if defined(WITH_AVX2) && defined(FUSION_CONDITION_LIVE_NONTRUNCATED) && defined(TRUNCATE_DURING_FUSION)
+/**
+ * \brief TSDFVoxel_f_flags version: every voxel is one float (sdf) followed by one 32-bit word holding w_depth, flags,
+ * and padding, so a row of eight voxels is two 8-lane registers that split into an sdf and a w_depth/flags vector.
+ */
+template<bool TUseSurfaceThicknessCutoff>
+struct TSDFFusionRowKernel<TSDFVoxel_f_flags, TUseSurfaceThicknessCutoff> {
+	static_assert(sizeof(TSDFVoxel_f_flags) == 2 * sizeof(float) && offsetof(TSDFVoxel_f_flags, sdf) == 0 &&
+	              offsetof(TSDFVoxel_f_flags, w_depth) == sizeof(float) &&
+	              offsetof(TSDFVoxel_f_flags, flags) == sizeof(float) + 1, "Unexpected TSDFVoxel_f_flags layout.");
+
+	static int FuseRows(const TSDFVoxel_f_flags* source_voxels, TSDFVoxel_f_flags* target_voxels, const int voxel_count,
+	                    const int maximum_weight, const float negative_surface_thickness_sdf_scale) {
+		const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+		const __m256i weight_and_flags_mask = _mm256_set1_epi32(0xFFFF);
+		const __m256i nontruncated = _mm256_set1_epi32(VOXEL_NONTRUNCATED);
+		const __m256i truncated = _mm256_set1_epi32(VOXEL_TRUNCATED);
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 maximum_weight_vector = _mm256_set1_ps(static_cast<float>(maximum_weight));
+		const __m256 surface_thickness_cutoff = _mm256_set1_ps(negative_surface_thickness_sdf_scale);
+		const __m256 truncation_epsilon = _mm256_set1_ps(1e-5f);
+		const __m256 absolute_value_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+		const int row_aligned_voxel_count = voxel_count - voxel_count % 8;
+		for (int i_voxel = 0; i_voxel < row_aligned_voxel_count; i_voxel += 8) {
+			const float* source = reinterpret_cast<const float*>(source_voxels + i_voxel);
+			float* target = reinterpret_cast<float*>(target_voxels + i_voxel);
+			const __m256 source_low = _mm256_loadu_ps(source);
+			const __m256 source_high = _mm256_loadu_ps(source + 8);
+			const __m256 target_low = _mm256_loadu_ps(target);
+			const __m256 target_high = _mm256_loadu_ps(target + 8);
+			// de-interleave; lanes end up in the order 0 1 4 5 2 3 6 7, which unpacklo/unpackhi below undo
+			const __m256 live_sdf = _mm256_shuffle_ps(source_low, source_high, _MM_SHUFFLE(2, 0, 2, 0));
+			const __m256i live_metadata = _mm256_castps_si256(_mm256_shuffle_ps(source_low, source_high, _MM_SHUFFLE(3, 1, 3, 1)));
+			const __m256 old_sdf = _mm256_shuffle_ps(target_low, target_high, _MM_SHUFFLE(2, 0, 2, 0));
+			const __m256i old_metadata = _mm256_castps_si256(_mm256_shuffle_ps(target_low, target_high, _MM_SHUFFLE(3, 1, 3, 1)));
+
+			__m256i fuse = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srli_epi32(live_metadata, 8), byte_mask), nontruncated);
+			if (TUseSurfaceThicknessCutoff) {
+				fuse = _mm256_and_si256(fuse, _mm256_castps_si256(_mm256_cmp_ps(live_sdf, surface_thickness_cutoff, _CMP_NLT_UQ)));
+			}
+			if (_mm256_testz_si256(fuse, fuse)) continue;
+
+			const __m256 old_depth_weight = _mm256_cvtepi32_ps(_mm256_and_si256(old_metadata, byte_mask));
+			__m256 new_depth_weight = _mm256_add_ps(old_depth_weight, one);
+			const __m256 new_sdf = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(old_depth_weight, old_sdf), live_sdf), new_depth_weight);
+			new_depth_weight = _mm256_min_ps(new_depth_weight, maximum_weight_vector);
+
+			const __m256i truncate = _mm256_castps_si256(
+					_mm256_cmp_ps(_mm256_sub_ps(one, _mm256_and_ps(new_sdf, absolute_value_mask)), truncation_epsilon, _CMP_LT_OQ));
+			const __m256i new_flags = _mm256_blendv_epi8(nontruncated, truncated, truncate);
+			const __m256i new_metadata = _mm256_or_si256(
+					_mm256_andnot_si256(weight_and_flags_mask, old_metadata),
+					_mm256_or_si256(_mm256_and_si256(_mm256_cvttps_epi32(new_depth_weight), byte_mask), _mm256_slli_epi32(new_flags, 8)));
+
+			const __m256 fused_sdf = _mm256_blendv_ps(old_sdf, new_sdf, _mm256_castsi256_ps(fuse));
+			const __m256 fused_metadata = _mm256_blendv_ps(_mm256_castsi256_ps(old_metadata), _mm256_castsi256_ps(new_metadata),
+			                                               _mm256_castsi256_ps(fuse));
+			_mm256_storeu_ps(target, _mm256_unpacklo_ps(fused_sdf, fused_metadata));
+			_mm256_storeu_ps(target + 8, _mm256_unpackhi_ps(fused_sdf, fused_metadata));
+		}
+		return row_aligned_voxel_count;
+	}
+};
+#endif
+} // namespace internal
+#endif
+
 // MemoryDeviceType template parameter needed to disambiguate linker symbols for which PlatformIndependence macros are
 // defined differently
 template<typename TVoxel, MemoryDeviceType TMemoryDeviceType, bool TUseSurfaceThicknessCutoff>
@@ -92,6 +184,17 @@ struct TSDFFusionFunctor {
 		}
 	}
 
+#ifndef __CUDACC__
+	// block kernel for the CPU traversal engines
+	void ProcessBlock(TVoxel* source_voxels, TVoxel* target_voxels, const int voxel_count) {
+		int i_voxel = internal::TSDFFusionRowKernel<TVoxel, TUseSurfaceThicknessCutoff>::FuseRows(
+				source_voxels, target_voxels, voxel_count, maximum_weight, negative_surface_thickness_sdf_scale);
+		for (; i_voxel < voxel_count; i_voxel++) {
+			(*this)(source_voxels[i_voxel], target_voxels[i_voxel]);
+		}
+	}
+#endif
+
 private:
 	const float negative_surface_thickness_sdf_scale;
 	const int maximum_weight;
@@ -31,25 +31,84 @@
 
 using namespace ITMLib;
 
-Mesh::Mesh() : triangle_count(0) {}
+Mesh::Mesh() : triangle_count(0), vertex_count(0), indexed(false) {}
 
 Mesh::Mesh(const Mesh& other, MemoryDeviceType memory_type)
-		: triangle_count(other.triangle_count),
-		  triangles(other.triangles.size(), memory_type) {
-	this->triangle_count = other.triangle_count;
-	MemoryCopyDirection memory_copy_direction = DetermineMemoryCopyDirection(memory_type,
-	                                                                         other.triangles.GetAccessMode());
-	this->triangles.SetFrom(other.triangles, memory_copy_direction);
+		: triangles(other.triangles.size(), memory_type),
+		  triangle_count(other.triangle_count),
+		  vertices(other.vertices.size(), memory_type),
+		  triangle_vertex_indices(other.triangle_vertex_indices.size(), memory_type),
+		  vertex_count(other.vertex_count),
+		  indexed(other.indexed) {
+	if (indexed) {
+		this->vertices.SetFrom(other.vertices,
+		                       DetermineMemoryCopyDirection(memory_type, other.vertices.GetAccessMode()));
+		this->triangle_vertex_indices.SetFrom(other.triangle_vertex_indices,
+		                                      DetermineMemoryCopyDirection(memory_type, other.triangle_vertex_indices.GetAccessMode()));
+	} else {
+		MemoryCopyDirection memory_copy_direction = DetermineMemoryCopyDirection(memory_type,
+		                                                                         other.triangles.GetAccessMode());
+		this->triangles.SetFrom(other.triangles, memory_copy_direction);
+	}
 }
 
 Mesh::Mesh(ORUtils::MemoryBlock<Triangle>& triangles, unsigned int triangle_count)
-		: triangles(triangles), triangle_count(triangle_count) {}
+		: triangles(triangles), triangle_count(triangle_count), vertex_count(0), indexed(false) {}
+
+Mesh::Mesh(ORUtils::MemoryBlock<Triangle>&& triangles, unsigned int triangle_count)
+		: triangles(std::move(triangles)), triangle_count(triangle_count), vertex_count(0), indexed(false) {}
+
+Mesh::Mesh(ORUtils::MemoryBlock<Vector3f>&& vertices, unsigned int vertex_count,
+           ORUtils::MemoryBlock<unsigned int>&& triangle_vertex_indices, unsigned int triangle_count)
+		: triangle_count(triangle_count),
+		  vertices(std::move(vertices)),
+		  triangle_vertex_indices(std::move(triangle_vertex_indices)),
+		  vertex_count(vertex_count),
+		  indexed(true) {}
 
 MemoryDeviceType Mesh::GetMemoryDeviceType() const {
-	return this->triangles.GetAccessMode();
+	return indexed ? this->vertices.GetAccessMode() : this->triangles.GetAccessMode();
+}
+
+bool Mesh::IsIndexed() const {
+	return indexed;
+}
+
+unsigned int Mesh::GetTriangleCount() const {
+	return triangle_count;
+}
+
+unsigned int Mesh::GetVertexCount() const {
+	return indexed ? vertex_count : triangle_count * 3;
+}
+
+const ORUtils::MemoryBlock<Vector3f>& Mesh::GetVertices() const {
+	return vertices;
+}
+
+const ORUtils::MemoryBlock<unsigned int>& Mesh::GetTriangleVertexIndices() const {
+	return triangle_vertex_indices;
 }
 
 void Mesh::WriteOBJ(const std::string& path) {
+	if (indexed) {
+		this->GenericWriteIndexedToDisk(
+				[&path, this](const Vector3f* vertex_array, const unsigned int* index_array) {
+					FILE* f = fopen(path.c_str(), "w+");
+					if (f != nullptr) {
+						for (uint i = 0; i < vertex_count; i++) {
+							fprintf(f, "v %f %f %f\n", vertex_array[i].x, vertex_array[i].y, vertex_array[i].z);
+						}
+						for (uint i = 0; i < triangle_count; i++) {
+							fprintf(f, "f %u %u %u\n", index_array[i * 3 + 2] + 1, index_array[i * 3 + 1] + 1,
+							        index_array[i * 3 + 0] + 1);
+						}
+						fclose(f);
+					}
+				}
+		);
+		return;
+	}
 	this->GenericWriteToDisk(
 			[&path, this](Triangle* triangle_array) {
 				FILE* f = fopen(path.c_str(), "w+");
@@ -72,50 +131,75 @@ void Mesh::WriteOBJ(const std::string& path) {
 }
 
 void Mesh::WriteSTL(const std::string& path) {
-	this->GenericWriteToDisk(
-			[&path, this](Triangle* triangle_array) {
-				FILE* f = fopen(path.c_str(), "wb+");
+	auto write_triangle_array = [&path, this](Triangle* triangle_array) {
+		FILE* f = fopen(path.c_str(), "wb+");
 
-				if (f != nullptr) {
-					for (int i = 0; i < 80; i++) fwrite(" ", sizeof(char), 1, f);
+		if (f != nullptr) {
+			for (int i = 0; i < 80; i++) fwrite(" ", sizeof(char), 1, f);
 
-					fwrite(&triangle_count, sizeof(int), 1, f);
+			fwrite(&triangle_count, sizeof(int), 1, f);
 
-					float zero = 0.0f;
-					short attribute = 0;
-					for (uint i = 0; i < triangle_count; i++) {
-						fwrite(&zero, sizeof(float), 1, f);
-						fwrite(&zero, sizeof(float), 1, f);
-						fwrite(&zero, sizeof(float), 1, f);
+			float zero = 0.0f;
+			short attribute = 0;
+			for (uint i = 0; i < triangle_count; i++) {
+				fwrite(&zero, sizeof(float), 1, f);
+				fwrite(&zero, sizeof(float), 1, f);
+				fwrite(&zero, sizeof(float), 1, f);
 
-						fwrite(&triangle_array[i].p2.x, sizeof(float), 1, f);
-						fwrite(&triangle_array[i].p2.y, sizeof(float), 1, f);
-						fwrite(&triangle_array[i].p2.z, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p2.x, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p2.y, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p2.z, sizeof(float), 1, f);
 
-						fwrite(&triangle_array[i].p1.x, sizeof(float), 1, f);
-						fwrite(&triangle_array[i].p1.y, sizeof(float), 1, f);
-						fwrite(&triangle_array[i].p1.z, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p1.x, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p1.y, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p1.z, sizeof(float), 1, f);
 
-						fwrite(&triangle_array[i].p0.x, sizeof(float), 1, f);
-						fwrite(&triangle_array[i].p0.y, sizeof(float), 1, f);
-						fwrite(&triangle_array[i].p0.z, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p0.x, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p0.y, sizeof(float), 1, f);
+				fwrite(&triangle_array[i].p0.z, sizeof(float), 1, f);
 
-						fwrite(&attribute, sizeof(short), 1, f);
+				fwrite(&attribute, sizeof(short), 1, f);
 
-						//fprintf(f, "v %f %f %f\n", triangleArray[i].p0.x, triangleArray[i].p0.y, triangleArray[i].p0.z);
-						//fprintf(f, "v %f %f %f\n", triangleArray[i].p1.x, triangleArray[i].p1.y, triangleArray[i].p1.z);
-						//fprintf(f, "v %f %f %f\n", triangleArray[i].p2.x, triangleArray[i].p2.y, triangleArray[i].p2.z);
-					}
-
-					//for (uint i = 0; i<noTotalTriangles; i++) fprintf(f, "f %d %d %d\n", i * 3 + 2 + 1, i * 3 + 1 + 1, i * 3 + 0 + 1);
-					fclose(f);
-				}
+				//fprintf(f, "v %f %f %f\n", triangleArray[i].p0.x, triangleArray[i].p0.y, triangleArray[i].p0.z);
+				//fprintf(f, "v %f %f %f\n", triangleArray[i].p1.x, triangleArray[i].p1.y, triangleArray[i].p1.z);
+				//fprintf(f, "v %f %f %f\n", triangleArray[i].p2.x, triangleArray[i].p2.y, triangleArray[i].p2.z);
 			}
-	);
+
+			//for (uint i = 0; i<noTotalTriangles; i++) fprintf(f, "f %d %d %d\n", i * 3 + 2 + 1, i * 3 + 1 + 1, i * 3 + 0 + 1);
+			fclose(f);
+		}
+	};
+	if (indexed) {
+		// STL has no notion of shared vertices
+		std::vector<Triangle> triangle_vector = GetTrianglesOnCPU();
+		write_triangle_array(triangle_vector.data());
+	} else {
+		this->GenericWriteToDisk(write_triangle_array);
+	}
 }
 
 void Mesh::WritePLY(const std::string& path, bool ascii, bool use_compression) {
 	using namespace tinyply;
+	if (indexed) {
+		this->GenericWriteIndexedToDisk(
+				[&path, ascii, use_compression, this](const Vector3f* vertex_array, const unsigned int* index_array) {
+					ORUtils::OStreamWrapper file(path, use_compression);
+					if (!file) return;
+					PlyFile mesh_file;
+					mesh_file.add_properties_to_element(
+							"vertex", {"x", "y", "z"},
+							Type::FLOAT32, vertex_count, reinterpret_cast<uint8_t*>(const_cast<Vector3f*>(vertex_array)),
+							Type::INVALID, 0
+					);
+					mesh_file.add_properties_to_element(
+							"face", {"vertex_indices"}, Type::UINT32, triangle_count,
+							reinterpret_cast<uint8_t*>(const_cast<unsigned int*>(index_array)), Type::UINT8, 3
+					);
+					mesh_file.write(file.OStream(), !ascii);
+				}
+		);
+		return;
+	}
 	this->GenericWriteToDisk(
 			[&path, ascii, use_compression, this](Triangle* triangle_array) {
 				ORUtils::OStreamWrapper file(path, use_compression);
@@ -156,6 +240,45 @@ void Mesh::GenericWriteToDisk(TWriteTriangleArrayFunction&& write_triangle_array
 	if (temporary_memory_used) delete cpu_triangles;
 }
 
+namespace {
+template<typename TElement, typename TUseArrayFunction>
+void UseArrayOnCPU(const ORUtils::MemoryBlock<TElement>& memory_block, TUseArrayFunction&& use_array) {
+	if (memory_block.GetAccessMode() == MEMORYDEVICE_CUDA) {
+		ORUtils::MemoryBlock<TElement> cpu_memory_block(memory_block.size(), MEMORYDEVICE_CPU);
+		cpu_memory_block.SetFrom(memory_block, MemoryCopyDirection::CUDA_TO_CPU);
+		std::forward<TUseArrayFunction>(use_array)(cpu_memory_block.GetData(MEMORYDEVICE_CPU));
+	} else {
+		std::forward<TUseArrayFunction>(use_array)(memory_block.GetData(MEMORYDEVICE_CPU));
+	}
+}
+} // anonymous namespace
+
+template<typename TWriteIndexedMeshFunction>
+void Mesh::GenericWriteIndexedToDisk(TWriteIndexedMeshFunction&& write_vertex_and_index_arrays) {
+	UseArrayOnCPU(vertices, [this, &write_vertex_and_index_arrays](const Vector3f* vertex_array) {
+		UseArrayOnCPU(triangle_vertex_indices, [&vertex_array, &write_vertex_and_index_arrays](const unsigned int* index_array) {
+			write_vertex_and_index_arrays(vertex_array, index_array);
+		});
+	});
+}
+
+std::vector<Mesh::Triangle> Mesh::GetTrianglesOnCPU() const {
+	if (!indexed) {
+		return ORUtils_MemoryBlock_to_std_vector(triangles, GetMemoryDeviceType(), triangle_count);
+	}
+	std::vector<Triangle> triangle_vector(triangle_count);
+	UseArrayOnCPU(vertices, [this, &triangle_vector](const Vector3f* vertex_array) {
+		UseArrayOnCPU(triangle_vertex_indices, [this, &vertex_array, &triangle_vector](const unsigned int* index_array) {
+			for (unsigned int i_triangle = 0; i_triangle < triangle_count; i_triangle++) {
+				triangle_vector[i_triangle].p0 = vertex_array[index_array[i_triangle * 3]];
+				triangle_vector[i_triangle].p1 = vertex_array[index_array[i_triangle * 3 + 1]];
+				triangle_vector[i_triangle].p2 = vertex_array[index_array[i_triangle * 3 + 2]];
+			}
+		});
+	});
+	return triangle_vector;
+}
+
 namespace ITMLib {
 _CPU_AND_GPU_CODE_
 bool operator==(const Mesh::Triangle& triangle1, const Mesh::Triangle& triangle2) {
@@ -180,12 +303,8 @@ bool AlmostEqual(const Mesh& mesh1, const Mesh& mesh2, const float tolerance, bo
 	if (mesh1.triangle_count != mesh2.triangle_count) return false;
 	const int triangle_count = mesh1.triangle_count;
 
-	std::vector<Mesh::Triangle> triangles1 = ORUtils_MemoryBlock_to_std_vector(mesh1.triangles,
-	                                                                           mesh1.GetMemoryDeviceType(),
-	                                                                           triangle_count);
-	std::vector<Mesh::Triangle> triangles2 = ORUtils_MemoryBlock_to_std_vector(mesh2.triangles,
-	                                                                           mesh2.GetMemoryDeviceType(),
-	                                                                           triangle_count);
+	std::vector<Mesh::Triangle> triangles1 = mesh1.GetTrianglesOnCPU();
+	std::vector<Mesh::Triangle> triangles2 = mesh2.GetTrianglesOnCPU();
 
 	if (presort_triangles) {
 		//TODO: uncomment when officially-supported compilers supply C++17 parallel execution policies for sorting
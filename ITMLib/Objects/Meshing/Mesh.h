@@ -16,6 +16,9 @@
 
 #pragma once
 
+//stdlib
+#include <vector>
+
 //local
 #include "../../Utils/Math.h"
 #include "../../../ORUtils/MemoryBlock.h"
@@ -50,12 +53,34 @@ public: // instance variables
 private: // instance variables
 	ORUtils::MemoryBlock<Triangle> triangles;
 	unsigned int triangle_count;
+	// used instead of triangles by indexed meshes, where every triangle refers to three shared vertices
+	ORUtils::MemoryBlock<Vector3f> vertices;
+	ORUtils::MemoryBlock<unsigned int> triangle_vertex_indices;
+	unsigned int vertex_count;
+	bool indexed;
 public: // instance functions
 	Mesh();
 	Mesh(const Mesh& other, MemoryDeviceType memory_type);
 	Mesh(ORUtils::MemoryBlock<Triangle>& triangles, unsigned int triangle_count);
+	Mesh(ORUtils::MemoryBlock<Triangle>&& triangles, unsigned int triangle_count);
+	/**
+	 * \brief Construct an indexed mesh
+	 * \param vertices vertex positions
+	 * \param vertex_count number of vertices
+	 * \param triangle_vertex_indices three consecutive vertex indices for every triangle
+	 * \param triangle_count number of triangles
+	 */
+	Mesh(ORUtils::MemoryBlock<Vector3f>&& vertices, unsigned int vertex_count,
+	     ORUtils::MemoryBlock<unsigned int>&& triangle_vertex_indices, unsigned int triangle_count);
 	MemoryDeviceType GetMemoryDeviceType() const;
 
+	bool IsIndexed() const;
+	unsigned int GetTriangleCount() const;
+	/** \brief Vertex count of an indexed mesh, or three vertices per triangle for meshes that aren't indexed. */
+	unsigned int GetVertexCount() const;
+	const ORUtils::MemoryBlock<Vector3f>& GetVertices() const;
+	const ORUtils::MemoryBlock<unsigned int>& GetTriangleVertexIndices() const;
+
 	friend bool AlmostEqual(const Mesh& mesh1, const Mesh& mesh2, const float tolerance, bool presort_triangles);
 
 	void WriteOBJ(const std::string& path);
@@ -67,6 +92,9 @@ public: // instance functions
 private: // instance functions
 	template<typename TWriteTriangleArrayFunction>
 	void GenericWriteToDisk(TWriteTriangleArrayFunction&& write_triangle_array);
+	template<typename TWriteIndexedMeshFunction>
+	void GenericWriteIndexedToDisk(TWriteIndexedMeshFunction&& write_vertex_and_index_arrays);
+	std::vector<Triangle> GetTrianglesOnCPU() const;
 };
 
 bool AlmostEqual(const Mesh& mesh1, const Mesh& mesh2, const float tolerance, bool presort_triangles = true);
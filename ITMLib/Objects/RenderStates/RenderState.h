@@ -6,6 +6,7 @@
 
 #include "../../Utils/Math.h"
 #include "../../../ORUtils/Image.h"
+#include "../../Engines/Rendering/Shared/RenderingBlock.h"
 
 namespace ITMLib
 {
@@ -44,6 +45,21 @@ namespace ITMLib
 
 		ORUtils::Image<Vector4u> *raycastImage;
 
+		/** @brief
+		Image-space tiles with depth ranges that voxel blocks
+		get projected to while computing the renderingRangeImage.
+		Allocated on first use, then reused.
+		*/
+		ORUtils::MemoryBlock<RenderingBlock> *renderingBlocks;
+
+		/** @brief
+		Hash codes of the voxel blocks that may be in view,
+		gathered on the CPU while computing the
+		renderingRangeImage and reused between computations
+		(only used for CPU volumes).
+		*/
+		ORUtils::MemoryBlock<int> *candidateBlockHashCodes;
+
 		RenderState(const Vector2i& image_size, float near_clipping_distance, float far_clipping_distance, MemoryDeviceType memory_type)
 		{
 			renderingRangeImage = new ORUtils::Image<Vector2f>(image_size, memory_type);
@@ -51,6 +67,8 @@ namespace ITMLib
 			forwardProjection = new ORUtils::Image<Vector4f>(image_size, memory_type);
 			fwdProjMissingPoints = new ORUtils::Image<int>(image_size, memory_type);
 			raycastImage = new ORUtils::Image<Vector4u>(image_size, memory_type);
+			renderingBlocks = new ORUtils::MemoryBlock<RenderingBlock>(0, memory_type);
+			candidateBlockHashCodes = new ORUtils::MemoryBlock<int>(0, MEMORYDEVICE_CPU);
 
 			ORUtils::Image<Vector2f> buffer_image(image_size, MEMORYDEVICE_CPU);
 
@@ -75,6 +93,8 @@ namespace ITMLib
 			delete forwardProjection;
 			delete fwdProjMissingPoints;
 			delete raycastImage;
+			delete renderingBlocks;
+			delete candidateBlockHashCodes;
 		}
 	};
 }
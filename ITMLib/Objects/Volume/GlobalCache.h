@@ -7,9 +7,11 @@
 #endif
 
 #include <cstdio>
+#include <string>
 
 
 #include "VoxelBlockHash.h"
+#include "SparseVoxelBlockStore.h"
 #include "PlainVoxelArray.h"
 #include "../../../ORUtils/CUDADefines.h"
 
@@ -40,8 +42,7 @@ private:
 	//TODO: rename vars to something more descriptive &/ document them
 	int hash_entry_count;
 
-	bool* has_stored_data;
-	TVoxel* stored_voxel_blocks;
+	SparseVoxelBlockStore<TVoxel> stored_voxel_blocks;
 	HashSwapState* swap_states_host;
 	HashSwapState* swap_states_device;
 
@@ -55,9 +56,16 @@ private:
 
 public:
 	GlobalCache();
-	explicit GlobalCache(const int hash_entry_count);
+	/**
+	 * \param hash_entry_count number of entries in the hash table of the swapped volume
+	 * \param host_block_budget maximum number of voxel blocks to keep in host memory, 0 or less for no limit;
+	 * blocks beyond it are paged out to a spill file on disk
+	 * \param spill_directory directory for the spill file, system temporary directory when empty
+	 */
+	GlobalCache(const int hash_entry_count, const int host_block_budget, const std::string& spill_directory);
 
-	explicit GlobalCache(const VoxelBlockHash& index) : GlobalCache(index.hash_entry_count) {}
+	/** Set up for the given index, with the host block budget & spill directory from the configuration. */
+	explicit GlobalCache(const VoxelBlockHash& index);
 
 	explicit GlobalCache(const GlobalCache& other);
 	GlobalCache(GlobalCache&& other);
@@ -75,14 +83,14 @@ public:
 		lhs.Swap(rhs);
 	}
 
-	inline void SetStoredData(int address, TVoxel* data) {
-		has_stored_data[address] = true;
-		memcpy(stored_voxel_blocks + address * VOXEL_BLOCK_SIZE3, data, sizeof(TVoxel) * VOXEL_BLOCK_SIZE3);
-	}
+	inline void SetStoredData(int address, const TVoxel* data) { stored_voxel_blocks.Store(address, data); }
+
+	inline bool HasStoredData(int address) const { return stored_voxel_blocks.Contains(address); }
 
-	inline bool HasStoredData(int address) const { return has_stored_data[address]; }
+	/** \return the stored block (paged in from disk if necessary), valid until the next Get/SetStored... call. */
+	inline const TVoxel* GetStoredVoxelBlock(int address) { return stored_voxel_blocks.Load(address); }
 
-	inline TVoxel* GetStoredVoxelBlock(int address) { return stored_voxel_blocks + address * VOXEL_BLOCK_SIZE3; }
+	const SparseVoxelBlockStore<TVoxel>& GetStoredVoxelBlocks() const { return stored_voxel_blocks; }
 
 	bool* GetHasSyncedData(bool useGPU) const { return useGPU ? has_synced_data_device : has_synced_data_host; }
 
@@ -96,34 +104,11 @@ public:
 
 	int GetHashEntryCount() const;
 
-	void SaveToFile(char* path) const {
-		TVoxel* stored_data = stored_voxel_blocks;
-
-		FILE* f = fopen(path, "wb");
+	/** Write the stored blocks, as hash code & block pairs, to the file at path. */
+	void SaveToFile(const std::string& path);
 
-		fwrite(has_stored_data, sizeof(bool), hash_entry_count, f);
-		for (int i = 0; i < hash_entry_count; i++) {
-			fwrite(stored_data, sizeof(TVoxel) * VOXEL_BLOCK_SIZE3, 1, f);
-			stored_data += VOXEL_BLOCK_SIZE3;
-		}
-
-		fclose(f);
-	}
-
-	void ReadFromFile(char* path) {
-		TVoxel* stored_data = stored_voxel_blocks;
-		FILE* f = fopen(path, "rb");
-
-		size_t tmp = fread(has_stored_data, sizeof(bool), hash_entry_count, f);
-		if (tmp == (size_t) hash_entry_count) {
-			for (int i = 0; i < hash_entry_count; i++) {
-				fread(stored_data, sizeof(TVoxel) * VOXEL_BLOCK_SIZE3, 1, f);
-				stored_data += VOXEL_BLOCK_SIZE3;
-			}
-		}
-
-		fclose(f);
-	}
+	/** Replace the stored blocks with the ones in the file at path (see SaveToFile). */
+	void ReadFromFile(const std::string& path);
 
 };
 } // namespace ITMLib
@@ -15,6 +15,8 @@
 //  ================================================================
 
 #include "GlobalCache.h"
+#include "SparseVoxelBlockStore.tpp"
+#include "../../Utils/Configuration/Configuration.h"
 
 using namespace ITMLib;
 
@@ -26,8 +28,6 @@ template<typename TVoxel>
 GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache() :
 		hash_entry_count(0),
 
-		has_stored_data(nullptr),
-		stored_voxel_blocks(nullptr),
 		swap_states_host(nullptr),
 		swap_states_device(nullptr),
 
@@ -40,11 +40,15 @@ GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache() :
 		needed_hash_codes_device(nullptr) {}
 
 template<typename TVoxel>
-GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(const int hash_entry_count) : hash_entry_count(hash_entry_count) {
-	has_stored_data = (bool*) malloc(hash_entry_count * sizeof(bool));
-	stored_voxel_blocks = (TVoxel*) malloc(hash_entry_count * sizeof(TVoxel) * VOXEL_BLOCK_SIZE3);
-	memset(has_stored_data, 0, hash_entry_count);
+GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(const VoxelBlockHash& index) :
+		GlobalCache(index.hash_entry_count, configuration::Get().swapping_host_block_budget,
+		            configuration::Get().swapping_spill_directory) {}
 
+template<typename TVoxel>
+GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(const int hash_entry_count, const int host_block_budget,
+                                                 const std::string& spill_directory) :
+		hash_entry_count(hash_entry_count),
+		stored_voxel_blocks(hash_entry_count, host_block_budget, spill_directory) {
 	swap_states_host = (HashSwapState*) malloc(hash_entry_count * sizeof(HashSwapState));
 	memset(swap_states_host, 0, sizeof(HashSwapState) * hash_entry_count);
 
@@ -70,7 +74,9 @@ GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(const int hash_entry_count) : h
 }
 
 template<typename TVoxel>
-GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(const GlobalCache& other) : GlobalCache(other.hash_entry_count) {
+GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(const GlobalCache& other) :
+		GlobalCache(other.hash_entry_count, other.stored_voxel_blocks.GetResidentBlockBudget(),
+		            other.stored_voxel_blocks.GetSpillDirectory()) {
 	if (other.hash_entry_count > 0) {
 
 #ifndef COMPILE_WITHOUT_CUDA
@@ -100,9 +106,6 @@ GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(const GlobalCache& other) : Glo
 
 template<typename TVoxel>
 GlobalCache<TVoxel, VoxelBlockHash>::~GlobalCache() {
-	free(has_stored_data);
-	free(stored_voxel_blocks);
-
 	free(swap_states_host);
 
 #ifndef COMPILE_WITHOUT_CUDA
@@ -127,7 +130,6 @@ void GlobalCache<TVoxel, VoxelBlockHash>::Swap(GlobalCache<TVoxel, VoxelBlockHas
 
 	swap(this->hash_entry_count, rhs.hash_entry_count);
 
-	swap(this->has_stored_data, rhs.has_stored_data);
 	swap(this->stored_voxel_blocks, rhs.stored_voxel_blocks);
 	swap(this->swap_states_host, rhs.swap_states_host);
 	swap(this->swap_states_device, rhs.swap_states_device);
@@ -145,8 +147,7 @@ template<typename TVoxel>
 GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(GlobalCache&& other) :
 		hash_entry_count(other.hash_entry_count),
 
-		has_stored_data(other.has_stored_data),
-		stored_voxel_blocks(other.stored_voxel_blocks),
+		stored_voxel_blocks(std::move(other.stored_voxel_blocks)),
 		swap_states_host(other.swap_states_host),
 		swap_states_device(other.swap_states_device),
 
@@ -157,8 +158,6 @@ GlobalCache<TVoxel, VoxelBlockHash>::GlobalCache(GlobalCache&& other) :
 
 		needed_hash_codes_host(other.needed_hash_codes_host),
 		needed_hash_codes_device(other.needed_hash_codes_device) {
-	other.has_stored_data = nullptr;
-	other.stored_voxel_blocks = nullptr;
 	other.swap_states_host = nullptr;
 	other.swap_states_device = nullptr;
 
@@ -176,4 +175,51 @@ int GlobalCache<TVoxel, VoxelBlockHash>::GetHashEntryCount() const {
 	return this->hash_entry_count;
 }
 
+template<typename TVoxel>
+void GlobalCache<TVoxel, VoxelBlockHash>::SaveToFile(const std::string& path) {
+	FILE* f = fopen(path.c_str(), "wb");
+	if (f == nullptr) {
+		DIEWITHEXCEPTION("Could not open file " + path + " for writing.");
+	}
+
+	const int stored_block_count = stored_voxel_blocks.GetStoredBlockCount();
+	fwrite(&hash_entry_count, sizeof(int), 1, f);
+	fwrite(&stored_block_count, sizeof(int), 1, f);
+	for (int hash_code = 0; hash_code < hash_entry_count; hash_code++) {
+		if (!stored_voxel_blocks.Contains(hash_code)) continue;
+		fwrite(&hash_code, sizeof(int), 1, f);
+		fwrite(stored_voxel_blocks.Load(hash_code), sizeof(TVoxel) * VOXEL_BLOCK_SIZE3, 1, f);
+	}
+
+	fclose(f);
+}
+
+template<typename TVoxel>
+void GlobalCache<TVoxel, VoxelBlockHash>::ReadFromFile(const std::string& path) {
+	FILE* f = fopen(path.c_str(), "rb");
+	if (f == nullptr) {
+		DIEWITHEXCEPTION("Could not open file " + path + " for reading.");
+	}
+
+	int file_hash_entry_count = 0, stored_block_count = 0;
+	if (fread(&file_hash_entry_count, sizeof(int), 1, f) != 1 || fread(&stored_block_count, sizeof(int), 1, f) != 1 ||
+	    file_hash_entry_count != hash_entry_count) {
+		fclose(f);
+		DIEWITHEXCEPTION("Global cache file " + path + " is corrupt or does not match the hash table size.");
+	}
+
+	stored_voxel_blocks = SparseVoxelBlockStore<TVoxel>(hash_entry_count, stored_voxel_blocks.GetResidentBlockBudget(),
+	                                                    stored_voxel_blocks.GetSpillDirectory());
+	std::unique_ptr<TVoxel[]> block(new TVoxel[VOXEL_BLOCK_SIZE3]);
+	for (int i_block = 0; i_block < stored_block_count; i_block++) {
+		int hash_code;
+		if (fread(&hash_code, sizeof(int), 1, f) != 1 || hash_code < 0 || hash_code >= hash_entry_count ||
+		    fread(block.get(), sizeof(TVoxel) * VOXEL_BLOCK_SIZE3, 1, f) != 1) {
+			fclose(f);
+			DIEWITHEXCEPTION("Global cache file " + path + " is truncated or corrupt.");
+		}
+		stored_voxel_blocks.Store(hash_code, block.get());
+	}
 
+	fclose(f);
+}
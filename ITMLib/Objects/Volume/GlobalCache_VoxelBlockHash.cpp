@@ -18,6 +18,9 @@
 #include "../../GlobalTemplateDefines.h"
 
 namespace ITMLib {
+template class SparseVoxelBlockStore<TSDFVoxel_f_flags>;
+template class SparseVoxelBlockStore<TSDFVoxel_f_rgb>;
+template class SparseVoxelBlockStore<WarpVoxel>;
 template class GlobalCache<TSDFVoxel_f_flags, VoxelBlockHash>;
 template class GlobalCache<TSDFVoxel_f_rgb, VoxelBlockHash>;
 template class GlobalCache<WarpVoxel, VoxelBlockHash>;
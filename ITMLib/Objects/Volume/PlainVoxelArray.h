@@ -78,6 +78,8 @@ public:
 	const void *getIndexData_MB() const { return index_data.GetMetalBuffer(); }
 #endif
 
+	PlainVoxelArray(PlainVoxelArray&&) = default;
+
 	// Suppress the default copy constructor and assignment operator
 	PlainVoxelArray(const PlainVoxelArray&) = delete;
 	PlainVoxelArray& operator=(const PlainVoxelArray&) = delete;
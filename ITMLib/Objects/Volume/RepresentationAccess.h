@@ -9,6 +9,52 @@ template<typename T> _CPU_AND_GPU_CODE_ inline int HashCodeFromBlockPosition(con
 	return (((uint)blockPos.x * 73856093u) ^ ((uint)blockPos.y * 19349669u) ^ ((uint)blockPos.z * 83492791u)) & (uint)VOXEL_HASH_MASK;
 }
 
+// region ========================== OCCUPANCY BITS (see VoxelBlockHash::GetBlockOccupancyBits) ===========================
+
+#define BLOCK_OCCUPANCY_WORD_COUNT ((1u << BLOCK_OCCUPANCY_BIT_COUNT_LOG2) / 32u)
+#define CELL_OCCUPANCY_WORD_COUNT ((1u << CELL_OCCUPANCY_BIT_COUNT_LOG2) / 32u)
+
+/** \brief Position of the coarse block grid cell containing the block at the given position (rounding down) */
+template<typename T> _CPU_AND_GPU_CODE_ inline T BlockPositionToCoarseCellPosition(const THREADPTR(T) & blockPos) {
+	T cellPos;
+	cellPos.x = ((blockPos.x < 0) ? blockPos.x - COARSE_BLOCK_GRID_CELL_SIZE + 1 : blockPos.x) / COARSE_BLOCK_GRID_CELL_SIZE;
+	cellPos.y = ((blockPos.y < 0) ? blockPos.y - COARSE_BLOCK_GRID_CELL_SIZE + 1 : blockPos.y) / COARSE_BLOCK_GRID_CELL_SIZE;
+	cellPos.z = ((blockPos.z < 0) ? blockPos.z - COARSE_BLOCK_GRID_CELL_SIZE + 1 : blockPos.z) / COARSE_BLOCK_GRID_CELL_SIZE;
+	return cellPos;
+}
+
+template<typename T> _CPU_AND_GPU_CODE_ inline unsigned int BlockOccupancyBitIndex(const THREADPTR(T) & blockPos) {
+	return (((uint)blockPos.x * 73856093u) ^ ((uint)blockPos.y * 19349669u) ^ ((uint)blockPos.z * 83492791u)) &
+	       ((1u << BLOCK_OCCUPANCY_BIT_COUNT_LOG2) - 1u);
+}
+
+template<typename T> _CPU_AND_GPU_CODE_ inline unsigned int CellOccupancyBitIndex(const THREADPTR(T) & cellPos) {
+	// cell bits follow the block bits
+	return (1u << BLOCK_OCCUPANCY_BIT_COUNT_LOG2) +
+	       ((((uint)cellPos.x * 73856093u) ^ ((uint)cellPos.y * 19349669u) ^ ((uint)cellPos.z * 83492791u)) &
+	        ((1u << CELL_OCCUPANCY_BIT_COUNT_LOG2) - 1u));
+}
+
+_CPU_AND_GPU_CODE_ inline void SetOccupancyBit(DEVICEPTR(unsigned int)* occupancy_bits, unsigned int bit_index) {
+	occupancy_bits[bit_index >> 5u] |= 1u << (bit_index & 31u);
+}
+
+_CPU_AND_GPU_CODE_ inline bool OccupancyBitIsSet(const CONSTPTR(unsigned int)* occupancy_bits, unsigned int bit_index) {
+	return (occupancy_bits[bit_index >> 5u] >> (bit_index & 31u)) & 1u;
+}
+
+/** \return false if the block at the given position is definitely not allocated */
+template<typename T> _CPU_AND_GPU_CODE_ inline bool BlockMayBeOccupied(const CONSTPTR(unsigned int)* occupancy_bits, const THREADPTR(T) & blockPos) {
+	return OccupancyBitIsSet(occupancy_bits, BlockOccupancyBitIndex(blockPos));
+}
+
+/** \return false if none of the blocks in the coarse block grid cell at the given position are allocated */
+template<typename T> _CPU_AND_GPU_CODE_ inline bool CellMayBeOccupied(const CONSTPTR(unsigned int)* occupancy_bits, const THREADPTR(T) & cellPos) {
+	return OccupancyBitIsSet(occupancy_bits, CellOccupancyBitIndex(cellPos));
+}
+
+// endregion ===========================================================================================================
+
 //TODO: replace usages with FindHashAtPosition
 /**
  * \brief find the hash block at the specified spatial coordinates (in blocks, not voxels!) and return its hash
@@ -193,6 +239,54 @@ _CPU_AND_GPU_CODE_ inline TVoxel readVoxel(const CONSTPTR(TVoxel) *voxelData, co
 	return result;
 }
 
+/**
+ * \brief Find a voxel via a precomputed hash block neighborhood, avoiding hash lookups for voxels within the 3x3x3 block
+ * neighborhood of the central block.
+ * \return linear index of the voxel in the voxel array, -1 if the voxel is not allocated
+ */
+_CPU_AND_GPU_CODE_ inline int findVoxel(const CONSTPTR(ITMLib::HashBlockNeighborhood) *neighborhood, const THREADPTR(Vector3i) & point,
+	THREADPTR(int) &vmIndex)
+{
+	// position relative to the first voxel of the neighborhood
+	Vector3i neighborhood_point = point - neighborhood->block_origin + Vector3i(VOXEL_BLOCK_SIZE);
+	if (neighborhood_point.x < 0 || neighborhood_point.y < 0 || neighborhood_point.z < 0 ||
+	    neighborhood_point.x >= 3 * VOXEL_BLOCK_SIZE || neighborhood_point.y >= 3 * VOXEL_BLOCK_SIZE ||
+	    neighborhood_point.z >= 3 * VOXEL_BLOCK_SIZE) {
+		return findVoxel(neighborhood->hash_table, point, vmIndex);
+	}
+	const int neighbor_index = neighborhood_point.x / VOXEL_BLOCK_SIZE + (neighborhood_point.y / VOXEL_BLOCK_SIZE) * 3 +
+	                           (neighborhood_point.z / VOXEL_BLOCK_SIZE) * 9;
+	const int block_offset = neighborhood->neighbor_block_offsets[neighbor_index];
+	if (block_offset < 0) {
+		vmIndex = false;
+		return -1;
+	}
+	vmIndex = true;
+	return block_offset + neighborhood_point.x % VOXEL_BLOCK_SIZE +
+	       (neighborhood_point.y % VOXEL_BLOCK_SIZE) * VOXEL_BLOCK_SIZE +
+	       (neighborhood_point.z % VOXEL_BLOCK_SIZE) * VOXEL_BLOCK_SIZE * VOXEL_BLOCK_SIZE;
+}
+
+/**
+ * \brief Read a voxel via a precomputed hash block neighborhood, avoiding hash lookups for voxels within the 3x3x3 block
+ * neighborhood of the central block.
+ */
+template<class TVoxel>
+_CPU_AND_GPU_CODE_ inline TVoxel readVoxel(const CONSTPTR(TVoxel) *voxelData, const CONSTPTR(ITMLib::HashBlockNeighborhood) *neighborhood,
+	const THREADPTR(Vector3i) & point, THREADPTR(int) &vmIndex)
+{
+	int voxel_address = findVoxel(neighborhood, point, vmIndex);
+	return vmIndex ? voxelData[voxel_address] : TVoxel();
+}
+
+/** \brief Neighborhood-based voxel read that ignores the cache, which is only accepted for interface parity with other indices */
+template<class TVoxel, class TCache>
+_CPU_AND_GPU_CODE_ inline TVoxel readVoxel(const CONSTPTR(TVoxel) *voxelData, const CONSTPTR(ITMLib::HashBlockNeighborhood) *neighborhood,
+	const THREADPTR(Vector3i) & point, THREADPTR(int) &vmIndex, THREADPTR(TCache) & cache)
+{
+	return readVoxel(voxelData, neighborhood, point, vmIndex);
+}
+
 template<class TVoxel, class TIndex>
 _CPU_AND_GPU_CODE_ inline float readFromSDF_float_uninterpolated(const CONSTPTR(TVoxel) *voxelData,
 	const CONSTPTR(TIndex) *voxelIndex, Vector3f point, THREADPTR(int) &vmIndex)
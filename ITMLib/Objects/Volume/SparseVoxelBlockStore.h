@@ -0,0 +1,94 @@
+#pragma once
+
+//stdlib
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+//local
+#include "VoxelBlockHash.h"
+
+// number of voxel blocks allocated at once when the resident part of a SparseVoxelBlockStore grows
+#define SPARSE_STORE_CHUNK_BLOCK_COUNT 64
+
+namespace ITMLib {
+
+/**
+ * \brief Host-side store of voxel blocks keyed by hash code, allocated on demand and bounded in memory.
+ * \details At most resident_block_budget blocks are kept in host memory. When a block has to be brought in beyond
+ * that, a resident block is chosen by the CLOCK (second chance) policy and paged out to a spill file on local disk,
+ * from which it is paged back in on the next access. Blocks are only written out when they have changed since they
+ * were last paged in. The spill file is created on first page-out and removed when the store is destroyed.
+ */
+template<typename TVoxel>
+class SparseVoxelBlockStore {
+public: // instance functions
+	SparseVoxelBlockStore();
+	/**
+	 * \param hash_entry_count number of hash codes that may be used as keys
+	 * \param resident_block_budget maximum number of blocks to keep in host memory, 0 or less for no limit
+	 * \param spill_directory directory to create the spill file in, system temporary directory when empty
+	 */
+	SparseVoxelBlockStore(int hash_entry_count, int resident_block_budget, const std::string& spill_directory);
+
+	SparseVoxelBlockStore(SparseVoxelBlockStore&& other) noexcept = default;
+	SparseVoxelBlockStore& operator=(SparseVoxelBlockStore&& other) noexcept = default;
+	SparseVoxelBlockStore(const SparseVoxelBlockStore&) = delete;
+	SparseVoxelBlockStore& operator=(const SparseVoxelBlockStore&) = delete;
+
+	bool Contains(int hash_code) const { return resident_slots[hash_code] >= 0 || spill_slots[hash_code] >= 0; }
+
+	/** Copy VOXEL_BLOCK_SIZE3 voxels from block into the store under hash_code, replacing anything stored there. */
+	void Store(int hash_code, const TVoxel* block);
+
+	/**
+	 * \brief Get the block stored under hash_code, paging it in from disk if necessary.
+	 * \return pointer to the block, valid until the next call to Store or Load, or nullptr if nothing is stored
+	 */
+	const TVoxel* Load(int hash_code);
+
+	int GetHashEntryCount() const { return static_cast<int>(resident_slots.size()); }
+	int GetResidentBlockBudget() const { return resident_block_budget; }
+	const std::string& GetSpillDirectory() const { return spill_directory; }
+	int GetResidentBlockCount() const { return static_cast<int>(slot_hash_codes.size()); }
+	int GetStoredBlockCount() const { return stored_block_count; }
+	/** Number of block-sized records in the spill file, i.e. number of distinct blocks ever paged out. */
+	int GetSpilledBlockCount() const { return spill_file ? spill_file->block_count : 0; }
+
+private: // types
+	struct SpillFile {
+		explicit SpillFile(const std::string& directory);
+		~SpillFile();
+		std::string path;
+		std::fstream stream;
+		int block_count;
+	};
+
+private: // instance functions
+	int AcquireResidentSlot(int hash_code);
+	int EvictResidentBlock();
+	TVoxel* GetResidentBlock(int slot) {
+		return resident_chunks[slot / SPARSE_STORE_CHUNK_BLOCK_COUNT].get() +
+		       (slot % SPARSE_STORE_CHUNK_BLOCK_COUNT) * VOXEL_BLOCK_SIZE3;
+	}
+
+private: // instance variables
+	int resident_block_budget;
+	std::string spill_directory;
+	int stored_block_count;
+
+	// per hash code
+	std::vector<int> resident_slots;
+	std::vector<int> spill_slots;
+
+	// per resident slot
+	std::vector<std::unique_ptr<TVoxel[]>> resident_chunks;
+	std::vector<int> slot_hash_codes;
+	std::vector<unsigned char> slot_flags;
+	int clock_hand;
+
+	std::unique_ptr<SpillFile> spill_file;
+};
+
+} // namespace ITMLib
@@ -0,0 +1,136 @@
+//stdlib
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+//local
+#include "SparseVoxelBlockStore.h"
+#include "../../../ORUtils/PlatformIndependence.h"
+
+namespace fs = std::filesystem;
+
+namespace ITMLib {
+
+namespace internal {
+enum SparseStoreSlotFlag : unsigned char {
+	SLOT_REFERENCED = 1u,
+	SLOT_DIRTY = 2u
+};
+} // namespace internal
+
+template<typename TVoxel>
+SparseVoxelBlockStore<TVoxel>::SparseVoxelBlockStore() : SparseVoxelBlockStore(0, 0, "") {}
+
+template<typename TVoxel>
+SparseVoxelBlockStore<TVoxel>::SparseVoxelBlockStore(int hash_entry_count, int resident_block_budget,
+                                                     const std::string& spill_directory)
+		: resident_block_budget(resident_block_budget),
+		  spill_directory(spill_directory),
+		  stored_block_count(0),
+		  resident_slots(hash_entry_count, -1),
+		  spill_slots(hash_entry_count, -1),
+		  clock_hand(0) {}
+
+template<typename TVoxel>
+void SparseVoxelBlockStore<TVoxel>::Store(int hash_code, const TVoxel* block) {
+	if (!Contains(hash_code)) stored_block_count++;
+	const int slot = AcquireResidentSlot(hash_code);
+	memcpy(GetResidentBlock(slot), block, sizeof(TVoxel) * VOXEL_BLOCK_SIZE3);
+	slot_flags[slot] = internal::SLOT_REFERENCED | internal::SLOT_DIRTY;
+}
+
+template<typename TVoxel>
+const TVoxel* SparseVoxelBlockStore<TVoxel>::Load(int hash_code) {
+	int slot = resident_slots[hash_code];
+	if (slot >= 0) {
+		slot_flags[slot] |= internal::SLOT_REFERENCED;
+		return GetResidentBlock(slot);
+	}
+	const int spill_slot = spill_slots[hash_code];
+	if (spill_slot < 0) return nullptr;
+	slot = AcquireResidentSlot(hash_code);
+	TVoxel* block = GetResidentBlock(slot);
+	const std::streamsize block_byte_count = sizeof(TVoxel) * VOXEL_BLOCK_SIZE3;
+	spill_file->stream.seekg(static_cast<std::streamoff>(spill_slot) * block_byte_count);
+	spill_file->stream.read(reinterpret_cast<char*>(block), block_byte_count);
+	if (!spill_file->stream) {
+		DIEWITHEXCEPTION("Could not read voxel block back from spill file " + spill_file->path);
+	}
+	// the copy on disk stays valid, so the block can be dropped again without being written out
+	slot_flags[slot] = internal::SLOT_REFERENCED;
+	return block;
+}
+
+template<typename TVoxel>
+int SparseVoxelBlockStore<TVoxel>::AcquireResidentSlot(int hash_code) {
+	int slot = resident_slots[hash_code];
+	if (slot >= 0) return slot;
+	const int resident_block_count = GetResidentBlockCount();
+	if (resident_block_budget <= 0 || resident_block_count < resident_block_budget) {
+		slot = resident_block_count;
+		if (slot % SPARSE_STORE_CHUNK_BLOCK_COUNT == 0) {
+			resident_chunks.emplace_back(new TVoxel[SPARSE_STORE_CHUNK_BLOCK_COUNT * VOXEL_BLOCK_SIZE3]);
+		}
+		slot_hash_codes.push_back(hash_code);
+		slot_flags.push_back(0u);
+	} else {
+		slot = EvictResidentBlock();
+		slot_hash_codes[slot] = hash_code;
+	}
+	resident_slots[hash_code] = slot;
+	return slot;
+}
+
+template<typename TVoxel>
+int SparseVoxelBlockStore<TVoxel>::EvictResidentBlock() {
+	const int resident_block_count = GetResidentBlockCount();
+	// second chance: recently referenced blocks get their flag cleared and are skipped once
+	while (slot_flags[clock_hand] & internal::SLOT_REFERENCED) {
+		slot_flags[clock_hand] &= ~internal::SLOT_REFERENCED;
+		clock_hand = (clock_hand + 1) % resident_block_count;
+	}
+	const int slot = clock_hand;
+	clock_hand = (clock_hand + 1) % resident_block_count;
+
+	const int evicted_hash_code = slot_hash_codes[slot];
+	if (slot_flags[slot] & internal::SLOT_DIRTY) {
+		if (!spill_file) spill_file.reset(new SpillFile(spill_directory));
+		int& spill_slot = spill_slots[evicted_hash_code];
+		if (spill_slot < 0) spill_slot = spill_file->block_count++;
+		const std::streamsize block_byte_count = sizeof(TVoxel) * VOXEL_BLOCK_SIZE3;
+		spill_file->stream.seekp(static_cast<std::streamoff>(spill_slot) * block_byte_count);
+		spill_file->stream.write(reinterpret_cast<const char*>(GetResidentBlock(slot)), block_byte_count);
+		if (!spill_file->stream) {
+			DIEWITHEXCEPTION("Could not write voxel block out to spill file " + spill_file->path);
+		}
+	}
+	resident_slots[evicted_hash_code] = -1;
+	slot_flags[slot] = 0u;
+	return slot;
+}
+
+template<typename TVoxel>
+SparseVoxelBlockStore<TVoxel>::SpillFile::SpillFile(const std::string& directory) : block_count(0) {
+	static std::atomic<unsigned int> spill_file_counter(0);
+	const fs::path directory_path = directory.empty() ? fs::temp_directory_path() : fs::path(directory);
+	std::error_code error_code;
+	fs::create_directories(directory_path, error_code);
+	path = (directory_path / ("voxel_block_spill_" +
+	                          std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_" +
+	                          std::to_string(spill_file_counter++) + ".dat")).string();
+	stream.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!stream) {
+		DIEWITHEXCEPTION("Could not create voxel block spill file " + path);
+	}
+}
+
+template<typename TVoxel>
+SparseVoxelBlockStore<TVoxel>::SpillFile::~SpillFile() {
+	stream.close();
+	std::error_code error_code;
+	fs::remove(path, error_code);
+}
+
+} // namespace ITMLib
@@ -14,7 +14,14 @@
 //  limitations under the License.
 //  ================================================================
 
+//stdlib
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
+//local
 #include "VoxelBlockHash.h"
+#include "RepresentationAccess.h"
 #include "../../GlobalTemplateDefines.h"
 #include "../../Engines/Indexing/VBH/CPU/IndexingEngine_VoxelBlockHash_CPU.h"
 #include "../../Engines/Indexing/VBH/CUDA/IndexingEngine_VoxelBlockHash_CUDA.h"
@@ -36,7 +43,10 @@ VoxelBlockHash::VoxelBlockHash()
 		  visible_block_count(0),
 
 		  hash_entries(), hash_entry_allocation_states(), allocation_block_coordinates(), block_allocation_list(),
-		  excess_entry_list(), visible_block_hash_codes(), utilized_block_hash_codes(), block_visibility_types(){}
+		  excess_entry_list(), visible_block_hash_codes(), utilized_block_hash_codes(), block_visibility_types(),
+		  block_neighbor_table(), block_neighbor_table_row_count(-1),
+		  block_neighbor_table_layout_id(0), block_neighbor_table_reference_layout_id(0),
+		  block_layout_id(GenerateBlockLayoutId()) {}
 
 HashEntry VoxelBlockHash::GetHashEntryAt(const Vector3s& pos, int& hash_code) const {
 	const HashEntry* entries = this->GetEntries();
@@ -96,11 +106,49 @@ VoxelBlockHash::VoxelBlockHash(VoxelBlockHashParameters parameters, MemoryDevice
 		block_allocation_list(voxel_block_count, memory_type),
 		excess_entry_list(excess_list_size, memory_type),
 		utilized_block_count(0),
-		visible_block_count(0) {
+		visible_block_count(0),
+		block_neighbor_table(0, memory_type),
+		block_neighbor_table_row_count(-1),
+		block_neighbor_table_layout_id(0), block_neighbor_table_reference_layout_id(0),
+		block_layout_id(GenerateBlockLayoutId()) {
 	hash_entry_allocation_states.Clear(NEEDS_NO_CHANGE);
 
 }
 
+VoxelBlockHash::VoxelBlockHash(const ExternalHostData& data) :
+		voxel_block_count(data.utilized_block_count),
+		excess_list_size(data.excess_list_size),
+		hash_entry_count(ORDERED_LIST_SIZE + data.excess_list_size),
+		last_free_block_list_id(-1),
+		last_free_excess_list_id(data.last_free_excess_list_id),
+		hash_entry_allocation_states(ORDERED_LIST_SIZE + data.excess_list_size, MEMORYDEVICE_CPU),
+		allocation_block_coordinates(ORDERED_LIST_SIZE + data.excess_list_size, MEMORYDEVICE_CPU),
+		utilized_block_hash_codes(data.utilized_block_hash_codes, data.utilized_block_count),
+		visible_block_hash_codes(data.visible_block_hash_codes, data.visible_block_count),
+		block_visibility_types(ORDERED_LIST_SIZE + data.excess_list_size, MEMORYDEVICE_CPU),
+		memory_type(MEMORYDEVICE_CPU),
+		hash_entries(data.hash_entries, ORDERED_LIST_SIZE + data.excess_list_size),
+		block_allocation_list(data.utilized_block_count, MEMORYDEVICE_CPU),
+		excess_entry_list(data.excess_entry_list, data.excess_list_size),
+		utilized_block_count(data.utilized_block_count),
+		visible_block_count(data.visible_block_count),
+		block_neighbor_table(0, MEMORYDEVICE_CPU),
+		block_neighbor_table_row_count(-1),
+		block_neighbor_table_layout_id(0), block_neighbor_table_reference_layout_id(0),
+		block_layout_id(GenerateBlockLayoutId()) {
+	hash_entry_allocation_states.Clear(NEEDS_NO_CHANGE);
+	// all blocks are in use, but keep the allocation list consistent with the blocks in it anyway
+	int* block_allocation_list_data = block_allocation_list.GetData(MEMORYDEVICE_CPU);
+	for (int i_block = 0; i_block < voxel_block_count; i_block++) {
+		block_allocation_list_data[i_block] = i_block;
+	}
+}
+
+unsigned long long VoxelBlockHash::GenerateBlockLayoutId() {
+	static std::atomic<unsigned long long> next_block_layout_id(0);
+	return next_block_layout_id++;
+}
+
 void VoxelBlockHash::SetFrom(const VoxelBlockHash& other) {
 	MemoryCopyDirection memory_copy_direction = DetermineMemoryCopyDirection(this->memory_type, other.memory_type);
 	this->hash_entry_allocation_states.SetFrom(other.hash_entry_allocation_states, memory_copy_direction);
@@ -112,6 +160,58 @@ void VoxelBlockHash::SetFrom(const VoxelBlockHash& other) {
 	this->last_free_block_list_id = other.last_free_block_list_id;
 	this->last_free_excess_list_id = other.last_free_excess_list_id;
 	this->utilized_block_count = other.utilized_block_count;
+	this->block_layout_id = other.block_layout_id;
+	this->block_neighbor_table_row_count = -1;
+	this->coarse_block_grid.up_to_date = false;
+	this->block_occupancy_bits_up_to_date = false;
+}
+
+void VoxelBlockHash::CoarseBlockGrid::Rebuild(const Vector3s* block_positions, const int* hash_codes, int block_count) {
+	std::unordered_map<Vector3s, int> cell_indices;
+	std::vector<int> block_cell_indices(block_count);
+	this->cell_positions.clear();
+	std::vector<int> cell_block_counts;
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		const Vector3s& block_position = block_positions[i_block];
+		const Vector3s cell_position = BlockPositionToCoarseCellPosition(block_position);
+		auto cell_iterator = cell_indices.find(cell_position);
+		if (cell_iterator == cell_indices.end()) {
+			cell_iterator = cell_indices.emplace(cell_position, static_cast<int>(this->cell_positions.size())).first;
+			this->cell_positions.push_back(cell_position);
+			cell_block_counts.push_back(0);
+		}
+		block_cell_indices[i_block] = cell_iterator->second;
+		cell_block_counts[cell_iterator->second]++;
+	}
+
+	const int cell_count = static_cast<int>(this->cell_positions.size());
+	this->cell_block_starts.resize(cell_count + 1);
+	this->cell_block_starts[0] = 0;
+	for (int i_cell = 0; i_cell < cell_count; i_cell++) {
+		this->cell_block_starts[i_cell + 1] = this->cell_block_starts[i_cell] + cell_block_counts[i_cell];
+	}
+	std::vector<int> cell_fill_positions(this->cell_block_starts.begin(), this->cell_block_starts.end() - 1);
+	this->block_hash_codes.resize(block_count);
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		this->block_hash_codes[cell_fill_positions[block_cell_indices[i_block]]++] = hash_codes[i_block];
+	}
+	this->up_to_date = true;
+}
+
+void VoxelBlockHash::RebuildBlockOccupancyBits(const Vector3s* block_positions, int block_count) const {
+	if (block_occupancy_bits.size() != BLOCK_OCCUPANCY_WORD_COUNT + CELL_OCCUPANCY_WORD_COUNT) {
+		block_occupancy_bits = ORUtils::MemoryBlock<unsigned int>(BLOCK_OCCUPANCY_WORD_COUNT + CELL_OCCUPANCY_WORD_COUNT, true,
+		                                                         memory_type == MEMORYDEVICE_CUDA);
+	}
+	unsigned int* bits = block_occupancy_bits.GetData(MEMORYDEVICE_CPU);
+	std::fill(bits, bits + block_occupancy_bits.size(), 0u);
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		const Vector3s& block_position = block_positions[i_block];
+		SetOccupancyBit(bits, BlockOccupancyBitIndex(block_position));
+		SetOccupancyBit(bits, CellOccupancyBitIndex(BlockPositionToCoarseCellPosition(block_position)));
+	}
+	if (memory_type == MEMORYDEVICE_CUDA) block_occupancy_bits.UpdateDeviceFromHost();
+	block_occupancy_bits_up_to_date = true;
 }
 
 HashEntry VoxelBlockHash::GetHashEntry(int hash_code) const {
@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <vector>
 #endif
 
 //ITMLib
@@ -28,6 +29,17 @@
 // Maximum number of blocks transfered in one swap operation
 #define SWAP_OPERATION_BLOCK_COUNT 0x1000
 
+// Count of blocks in the 3x3x3 block neighborhood of a voxel hash block (including the block itself)
+#define VOXEL_BLOCK_NEIGHBORHOOD_SIZE 27
+
+// Edge length, in voxel hash blocks, of the cells of the coarse block grid (see VoxelBlockHash::CoarseBlockGrid)
+#define COARSE_BLOCK_GRID_CELL_SIZE 8
+
+// Sizes (log2) of the hashed occupancy bitmaps over blocks and over coarse block grid cells, respectively
+// (see VoxelBlockHash::GetBlockOccupancyBits)
+#define BLOCK_OCCUPANCY_BIT_COUNT_LOG2 22
+#define CELL_OCCUPANCY_BIT_COUNT_LOG2 16
+
 namespace ITMLib {
 
 /** \brief
@@ -57,6 +69,20 @@ struct HashEntry {
 	}
 };
 
+/**
+ * \brief Neighbor-aware view of a single utilized voxel hash block, handed to functors by neighborhood traversals.
+ * \details Voxels in the 3x3x3 block neighborhood centered on the block are resolved through a precomputed row of the
+ * block neighbor table (see VoxelBlockHash::GetBlockNeighborTable), voxels beyond it through the hash table.
+ */
+struct HashBlockNeighborhood {
+	/** VOXEL_BLOCK_NEIGHBORHOOD_SIZE voxel offsets of the neighbor blocks (-1 for unallocated blocks), x varying fastest */
+	const CONSTPTR(int)* neighbor_block_offsets;
+	/** Hash table used to look up voxels beyond the neighborhood */
+	const CONSTPTR(HashEntry)* hash_table;
+	/** Position of the first voxel of the central block, in voxels */
+	Vector3i block_origin;
+};
+
 #define VOXEL_BLOCK_HASH_PARAMETERS_STRUCT_DESCRIPTION \
     VoxelBlockHashParameters, \
     (int, voxel_block_count, 0x40000, PRIMITIVE, "Total count of voxel hash blocks to preallocate."), \
@@ -118,6 +144,58 @@ private:
 	ORUtils::MemoryBlock<int> utilized_block_hash_codes;
 	/** Visibility types of "visible entries", ordered by hashCode */
 	ORUtils::MemoryBlock<HashBlockVisibility> block_visibility_types;
+	/**
+	 * Optional table of voxel offsets to the VOXEL_BLOCK_NEIGHBORHOOD_SIZE blocks around each block of some
+	 * utilized block list, one row per list entry. Allocated lazily, see BuildBlockNeighborTable.
+	 */
+	ORUtils::MemoryBlock<int> block_neighbor_table;
+	/** Count of rows in the block neighbor table, -1 when the table is out of date with the utilized blocks */
+	int block_neighbor_table_row_count;
+	/** Block layout ids of this index and of the reference index at the time the block neighbor table was built */
+	unsigned long long block_neighbor_table_layout_id;
+	unsigned long long block_neighbor_table_reference_layout_id;
+	/**
+	 * Identifies the current assignment of blocks to hash entries and voxel storage. A new one is generated whenever
+	 * blocks may have been allocated or deallocated (see SetLastFreeBlockListId and SetUtilizedBlockCount), SetFrom
+	 * copies it along with the tables.
+	 */
+	unsigned long long block_layout_id;
+
+	static unsigned long long GenerateBlockLayoutId();
+
+public:
+	/**
+	 * \brief Utilized blocks grouped by the cells of a coarse grid over block space, kept on the CPU, so that
+	 * operations concerned with some region only (e.g. the view frustum) can skip entire cells of blocks at once.
+	 * \details Only maintained for indices in host memory: for CUDA indices, rebuilding it would require copying the
+	 * utilized block positions from the device after every change in allocation, so CUDA engines go through all
+	 * utilized blocks on the device instead.
+	 */
+	struct CoarseBlockGrid {
+		/** Positions of the nonempty cells, in cells */
+		std::vector<Vector3s> cell_positions;
+		/** Index of the first block of each cell in block_hash_codes, followed by the total block count */
+		std::vector<int> cell_block_starts;
+		/** Hash codes of the utilized blocks, grouped by cell */
+		std::vector<int> block_hash_codes;
+		/** False when the grid is out of date with the utilized blocks */
+		bool up_to_date = false;
+
+		/**
+		 * \brief Regroup the given blocks by grid cell, making the grid up to date.
+		 * \param block_positions positions of the utilized blocks (in host memory)
+		 * \param hash_codes hash codes of the utilized blocks (in host memory), in the same order
+		 */
+		void Rebuild(const Vector3s* block_positions, const int* hash_codes, int block_count);
+	};
+
+private:
+	/** Cache derived from the utilized blocks, hence rebuilt on demand even for otherwise read-only indices */
+	mutable CoarseBlockGrid coarse_block_grid;
+	/** Cache derived from the utilized blocks, see GetBlockOccupancyBits */
+	mutable ORUtils::MemoryBlock<unsigned int> block_occupancy_bits;
+	/** False when the block occupancy bits are out of date with the utilized blocks */
+	mutable bool block_occupancy_bits_up_to_date = false;
 
 public:
 	const MemoryDeviceType memory_type;
@@ -129,6 +207,31 @@ public:
 	explicit VoxelBlockHash(MemoryDeviceType memory_type) : VoxelBlockHash(VoxelBlockHashParameters(),
 	                                                                       memory_type) {}
 
+	/**
+	 * \brief Host memory holding a complete hash table that is owned elsewhere (e.g. mapped in from a file), along with
+	 * the lists needed to traverse and look up the blocks in it.
+	 */
+	struct ExternalHostData {
+		/** ORDERED_LIST_SIZE + excess_list_size entries, whose ptr fields are all less than utilized_block_count */
+		HashEntry* hash_entries;
+		/** excess_list_size entries */
+		int* excess_entry_list;
+		int excess_list_size;
+		int last_free_excess_list_id;
+		int* utilized_block_hash_codes;
+		int utilized_block_count;
+		int* visible_block_hash_codes;
+		int visible_block_count;
+	};
+
+	/**
+	 * \brief Wrap an existing hash table in host memory without copying it. Only the temporary buffers used during
+	 * allocation are allocated.
+	 * \details The index is full: its voxel_block_count is the count of utilized blocks, so no further blocks can be
+	 * allocated in it.
+	 */
+	explicit VoxelBlockHash(const ExternalHostData& data);
+
 	VoxelBlockHash(const VoxelBlockHash& other, MemoryDeviceType memory_type) :
 			VoxelBlockHash({other.voxel_block_count, other.excess_list_size}, memory_type) {
 		this->SetFrom(other);
@@ -209,15 +312,83 @@ public:
 	int GetLastFreeExcessListId() const { return last_free_excess_list_id; }
 
 	void
-	SetLastFreeBlockListId(int last_free_block_list_id) { this->last_free_block_list_id = last_free_block_list_id; }
+	SetLastFreeBlockListId(int last_free_block_list_id) {
+		this->last_free_block_list_id = last_free_block_list_id;
+		this->block_layout_id = GenerateBlockLayoutId();
+	}
 	void
 	SetLastFreeExcessListId(int last_free_excess_list_id) { this->last_free_excess_list_id = last_free_excess_list_id; }
 
 
 	int GetUtilizedBlockCount() const { return this->utilized_block_count; }
 
-	void SetUtilizedBlockCount(
-			int utilized_hash_block_count) { this->utilized_block_count = utilized_hash_block_count; }
+	/**
+	 * \brief Set the count of utilized blocks. Invalidates the block neighbor table and the coarse block grid, since the
+	 * utilized blocks may have changed.
+	 */
+	void SetUtilizedBlockCount(int utilized_hash_block_count) {
+		this->utilized_block_count = utilized_hash_block_count;
+		this->block_layout_id = GenerateBlockLayoutId();
+		this->block_neighbor_table_row_count = -1;
+		this->coarse_block_grid.up_to_date = false;
+		this->block_occupancy_bits_up_to_date = false;
+	}
+
+	/** \return the coarse block grid (see CoarseBlockGrid), which has to be rebuilt by the caller if it's out of date */
+	CoarseBlockGrid& GetCoarseBlockGrid() const { return coarse_block_grid; }
+
+	/**
+	 * \return hashed occupancy bitmaps over blocks and over coarse block grid cells, in the memory of the index, or nullptr
+	 * if they are out of date with the utilized blocks. A cleared bit guarantees that the block (or every block in the cell)
+	 * is unallocated, while a set bit means it might be allocated. See BlockMayBeOccupied and CellMayBeOccupied.
+	 */
+	const unsigned int* GetBlockOccupancyBits() const {
+		return block_occupancy_bits_up_to_date ? block_occupancy_bits.GetData(memory_type) : nullptr;
+	}
+
+	/**
+	 * \brief Rebuild the block occupancy bits (see GetBlockOccupancyBits), making them up to date.
+	 * \param block_positions positions of the utilized blocks (in host memory)
+	 */
+	void RebuildBlockOccupancyBits(const Vector3s* block_positions, int block_count) const;
+
+	const int* GetBlockNeighborTable() const { return block_neighbor_table.GetData(memory_type); }
+
+	int* GetBlockNeighborTable() { return block_neighbor_table.GetData(memory_type); }
+
+	/** \brief Makes sure the block neighbor table has room for at least the specified count of rows. */
+	void ReserveBlockNeighborTable(int row_count) {
+		if (block_neighbor_table.size() < static_cast<size_t>(row_count) * VOXEL_BLOCK_NEIGHBORHOOD_SIZE) {
+			block_neighbor_table.Resize(static_cast<size_t>(row_count) * VOXEL_BLOCK_NEIGHBORHOOD_SIZE);
+		}
+	}
+
+	/** \return count of rows in the block neighbor table, or -1 if it needs to be rebuilt */
+	int GetBlockNeighborTableRowCount() const { return this->block_neighbor_table_row_count; }
+
+	/** \brief Mark the block neighbor table as freshly built from the utilized block list of the reference index. */
+	void SetBlockNeighborTableBuiltFrom(const VoxelBlockHash& reference_index) {
+		this->block_neighbor_table_row_count = reference_index.utilized_block_count;
+		this->block_neighbor_table_layout_id = this->block_layout_id;
+		this->block_neighbor_table_reference_layout_id = reference_index.block_layout_id;
+	}
+
+	/**
+	 * \return whether the block neighbor table is up to date and was built from the current utilized block list of the
+	 * reference index, i.e. neither index had blocks allocated or deallocated since it was built
+	 */
+	bool BlockNeighborTableMatches(const VoxelBlockHash& reference_index) const {
+		return this->block_neighbor_table_row_count == reference_index.utilized_block_count &&
+		       this->block_neighbor_table_layout_id == this->block_layout_id &&
+		       this->block_neighbor_table_reference_layout_id == reference_index.block_layout_id;
+	}
+
+	/**
+	 * \brief Whether the other index assigns the very same blocks to the very same hash entries and voxel storage
+	 * offsets as this one, e.g. because it was mirrored from this one (see MirrorIndexOfOtherVolume), so that voxel
+	 * arrays indexed by either can be walked in lockstep without matching up block positions.
+	 */
+	bool SharesBlockLayoutWith(const VoxelBlockHash& other) const { return this->block_layout_id == other.block_layout_id; }
 
 	int GetVisibleBlockCount() const { return this->visible_block_count; }
 
@@ -237,6 +408,8 @@ public:
 		       * static_cast<unsigned int>(this->voxel_block_size);
 	}
 
+	VoxelBlockHash(VoxelBlockHash&&) = default;
+
 	// Suppress the default copy constructor and assignment operator
 	VoxelBlockHash(const VoxelBlockHash&) = delete;
 	VoxelBlockHash& operator=(const VoxelBlockHash&) = delete;
@@ -46,6 +46,12 @@ public:
 	explicit VoxelVolume(MemoryDeviceType memory_type,
 	                     typename TIndex::InitializationParameters index_parameters = typename TIndex::InitializationParameters());
 	VoxelVolume(const VoxelVolume& other, MemoryDeviceType memory_type);
+	/**
+	 * \brief Assemble a volume (with swapping disabled) from an index and voxel storage set up elsewhere, e.g. ones
+	 * wrapping memory mapped in from a file.
+	 */
+	VoxelVolume(const VoxelVolumeParameters& volume_parameters, TIndex&& prepared_index,
+	            ORUtils::MemoryBlock<TVoxel>&& prepared_voxels);
 
 
 	void Reset();
@@ -67,6 +67,14 @@ VoxelVolume<TVoxel, TIndex>::VoxelVolume(const VoxelVolume& other, MemoryDeviceT
 }
 
 
+template<class TVoxel, class TIndex>
+VoxelVolume<TVoxel, TIndex>::VoxelVolume(const VoxelVolumeParameters& volume_parameters, TIndex&& prepared_index,
+                                         ORUtils::MemoryBlock<TVoxel>&& prepared_voxels)
+		: parameters(volume_parameters),
+		  index(std::move(prepared_index)),
+		  voxels(std::move(prepared_voxels)),
+		  swapping_enabled(false),
+		  global_cache(this->index) {}
 
 template<class TVoxel, class TIndex>
 void VoxelVolume<TVoxel, TIndex>::Reset() {
@@ -73,7 +73,7 @@ bool CompareRawArrays_Generic(const TElement* left, MemoryDeviceType memory_devi
 				right_prepared = right;
 			}
 #ifdef WITH_OPENMP
-#pragma omp parallel for default(none) shared(left_prepared, right_prepared, compare_elements, mismatch_found, report_mismatch)
+#pragma omp parallel for default(none) shared(left_prepared, right_prepared, element_count, compare_elements, mismatch_found, report_mismatch)
 #endif
 			for (int i_element = 0; i_element < element_count; i_element++) {
 				if (mismatch_found) {
@@ -26,7 +26,9 @@ namespace ITMLib {
     (bool, save_volumes_and_camera_matrix_after_processing, false, PRIMITIVE, "Whether to save volume(s) after automatic processing"), \
     (bool, save_meshes_after_processing, false, PRIMITIVE, "Whether to save result mesh(es) after automatic processing"), \
     (bool, exit_if_main_processing_turns_off, false, PRIMITIVE, "Whether to save result mesh(es) after automatic processing"), \
-    (bool, exit_after_automatic_processing, false, PRIMITIVE, "Whether to exit the program after the automatic run.")
+    (bool, exit_after_automatic_processing, false, PRIMITIVE, "Whether to exit the program after the automatic run."), \
+    (bool, pipeline_frame_processing, false, PRIMITIVE, "(CLI only) Whether to read and preprocess the next frame while " \
+    "the current one is being aligned and fused. Favors throughput over per-frame latency, which is no longer timed exactly.")
 
 DECLARE_DEFERRABLE_SERIALIZABLE_STRUCT(AUTOMATIC_RUN_SETTINGS_STRUCT_DESCRIPTION);
 
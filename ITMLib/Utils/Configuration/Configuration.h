@@ -150,6 +150,11 @@ DECLARE_SERIALIZABLE_STRUCT(SPECIFIC_VOLUME_PARAMETERS_STRUCT_DESCRIPTION);
     (bool, use_bilateral_filter, false, PRIMITIVE, "Enables or disables bilateral filtering on depth input images."),\
     (FailureMode, behavior_on_failure, FAILUREMODE_IGNORE, ENUM, "What to do on tracker failure: ignore, relocalize or stop integration - not supported in loop closure or dynamic libmode"),\
     (SwappingMode, swapping_mode, SWAPPINGMODE_DISABLED, ENUM, "Determines how swapping works: disabled, fully enabled (still with dragons) and delete what's not visible - not supported in loop closure version"),\
+    (int, swapping_host_block_budget, 0x40000, PRIMITIVE, "Maximum number of voxel blocks the swapping mechanism keeps in host memory. Blocks beyond it are paged out to a spill file on disk. 0 or less means no limit."),\
+    (std::string, swapping_spill_directory, "", PATH, "Directory for the swapping spill file. The system temporary directory is used when empty."),\
+    (int, swapping_block_budget_per_frame, 0x1000, PRIMITIVE, "Maximum number of voxel blocks swapped in, swapped out or cleaned up per frame (by each of these operations) by CPU swapping. 0 or less means no limit."),\
+    (int, multi_map_concurrent_tracking_limit, 4, PRIMITIVE, "Maximum number of local maps the multi-map (loop closure) engine tracks and fuses into concurrently, e.g. while trying relocalisation and loop closure candidates. Values below 1 are treated as 1."),\
+    (bool, multi_map_incremental_global_adjustment, false, PRIMITIVE, "Keep the pose graph of the multi-map (loop closure) engine's global adjustment between runs and only update the parts of it that changed, reusing the symbolic factorisation while the graph structure stays the same."),\
     (std::string, tracker_configuration, TrackerConfigurationStringPresets::default_depth_only_extended_tracker_configuration, PRIMITIVE, "Tracker configuration. (Better description still needs to be provided for this, already in TODO / issues)")
 
 
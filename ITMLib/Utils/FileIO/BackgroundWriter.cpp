@@ -0,0 +1,53 @@
+//stdlib
+#include <algorithm>
+
+//local
+#include "BackgroundWriter.h"
+
+using namespace ITMLib;
+
+BackgroundWriter::BackgroundWriter(int max_pending_task_count)
+		: max_pending_task_count(static_cast<std::size_t>(std::max(max_pending_task_count, 1))),
+		  task_running(false),
+		  stopping(false),
+		  thread(&BackgroundWriter::Run, this) {}
+
+BackgroundWriter::~BackgroundWriter() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	task_submitted.notify_all();
+	thread.join();
+}
+
+void BackgroundWriter::Submit(std::function<void()> task) {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		task_finished.wait(lock, [this] { return pending_tasks.size() < max_pending_task_count; });
+		pending_tasks.push_back(std::move(task));
+	}
+	task_submitted.notify_one();
+}
+
+void BackgroundWriter::Flush() {
+	std::unique_lock<std::mutex> lock(mutex);
+	task_finished.wait(lock, [this] { return pending_tasks.empty() && !task_running; });
+}
+
+void BackgroundWriter::Run() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		task_submitted.wait(lock, [this] { return stopping || !pending_tasks.empty(); });
+		// finish whatever is pending even when stopping
+		if (pending_tasks.empty()) return;
+		std::function<void()> task = std::move(pending_tasks.front());
+		pending_tasks.pop_front();
+		task_running = true;
+		lock.unlock();
+		task();
+		lock.lock();
+		task_running = false;
+		task_finished.notify_all();
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+//stdlib
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ITMLib {
+
+/**
+ * \brief Runs write tasks (e.g. saving meshes or images to disk) one by one, in the order they were submitted, on a
+ * dedicated thread, so that they don't hold up frame processing.
+ * \details Submitting blocks while max_pending_task_count tasks are already waiting, which bounds the memory held by
+ * data queued up for writing. Pending tasks are finished before the writer is destroyed.
+ */
+class BackgroundWriter {
+public: // instance functions
+	explicit BackgroundWriter(int max_pending_task_count = 4);
+	~BackgroundWriter();
+
+	BackgroundWriter(const BackgroundWriter&) = delete;
+	BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+	void Submit(std::function<void()> task);
+	/** \brief Block until all tasks submitted so far are finished. */
+	void Flush();
+
+private: // instance functions
+	void Run();
+
+private: // instance variables
+	const std::size_t max_pending_task_count;
+	std::deque<std::function<void()>> pending_tasks;
+	bool task_running;
+	bool stopping;
+
+	std::mutex mutex;
+	std::condition_variable task_submitted;
+	std::condition_variable task_finished;
+	std::thread thread;
+};
+
+} // namespace ITMLib
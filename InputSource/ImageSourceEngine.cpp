@@ -11,6 +11,16 @@
 using namespace InputSource;
 using namespace ITMLib;
 
+void ImageSourceEngine::SkipImages(int image_count)
+{
+	UChar4Image rgb(true, false);
+	ShortImage raw_depth(true, false);
+	for (int i_image = 0; i_image < image_count && HasMoreImages(); i_image++)
+	{
+		GetImages(rgb, raw_depth);
+	}
+}
+
 BaseImageSourceEngine::BaseImageSourceEngine(const char *calibFilename)
 {
 	if(!calibFilename || strlen(calibFilename) == 0)
@@ -117,37 +127,44 @@ ImageFileReader<PathGenerator>::ImageFileReader(const char *calibration_file_nam
 }
 
 template <typename PathGenerator>
-void ImageFileReader<PathGenerator>::LoadIntoCache(){
-	if (current_frame_number == cached_frame_number) return;
-	cached_frame_number = current_frame_number;
+bool InputSource::ReadFrameImages(const PathGenerator& path_generator, size_t frame_number, UChar4Image& rgb,
+                                  ShortImage& depth, UCharImage& mask){
+	bool frame_is_valid = true;
 
-	cache_is_valid = true;
-
-	std::string rgb_path = path_generator.GetRgbImagePath(current_frame_number);
-	if (!ReadImageFromFile(cached_rgb, rgb_path.c_str())){
-		if (cached_rgb.dimensions.x > 0) cache_is_valid = false;
+	std::string rgb_path = path_generator.GetRgbImagePath(frame_number);
+	if (!ReadImageFromFile(rgb, rgb_path.c_str())){
+		if (rgb.dimensions.x > 0) frame_is_valid = false;
 		printf("error reading file '%s'\n", rgb_path.c_str());
 	}
 
-	std::string depth_path = path_generator.GetDepthImagePath(current_frame_number);
-	if (!ReadImageFromFile(cached_depth, depth_path.c_str())){
-		if (cached_depth.dimensions.x > 0) cache_is_valid = false;
+	std::string depth_path = path_generator.GetDepthImagePath(frame_number);
+	if (!ReadImageFromFile(depth, depth_path.c_str())){
+		if (depth.dimensions.x > 0) frame_is_valid = false;
 		printf("error reading file '%s'\n", depth_path.c_str());
 	}
 
-	if ((cached_rgb.dimensions.x <= 0) && (cached_depth.dimensions.x <= 0)) cache_is_valid = false;
+	if ((rgb.dimensions.x <= 0) && (depth.dimensions.x <= 0)) frame_is_valid = false;
 
 	if(path_generator.has_mask_image_paths){
-		std::string mask_path = path_generator.GetMaskImagePath(current_frame_number);
-		if (!ReadImageFromFile(cached_mask, mask_path.c_str())){
-			if (cached_mask.dimensions.x > 0) cache_is_valid = false;
+		std::string mask_path = path_generator.GetMaskImagePath(frame_number);
+		if (!ReadImageFromFile(mask, mask_path.c_str())){
+			if (mask.dimensions.x > 0) frame_is_valid = false;
 			printf("error reading file '%s'\n", mask_path.c_str());
 		}else{
 			Vector4u blackRGB((unsigned char)0);
-			cached_depth.ApplyMask(cached_mask, 0);
-			cached_rgb.ApplyMask(cached_mask,blackRGB);
+			depth.ApplyMask(mask, 0);
+			rgb.ApplyMask(mask,blackRGB);
 		}
 	}
+	return frame_is_valid;
+}
+
+template <typename PathGenerator>
+void ImageFileReader<PathGenerator>::LoadIntoCache(){
+	if (current_frame_number == cached_frame_number) return;
+	cached_frame_number = current_frame_number;
+
+	cache_is_valid = ReadFrameImages(path_generator, current_frame_number, cached_rgb, cached_depth, cached_mask);
 }
 
 template <typename PathGenerator>
@@ -166,6 +183,14 @@ void ImageFileReader<PathGenerator>::GetImages(UChar4Image& rgb, ShortImage& raw
 	++current_frame_number;
 }
 
+template <typename PathGenerator>
+void ImageFileReader<PathGenerator>::SkipImages(int image_count)
+{
+	if (!cache_is_valid) return;
+	current_frame_number += image_count;
+	LoadIntoCache();
+}
+
 template <typename PathGenerator>
 Vector2i ImageFileReader<PathGenerator>::GetDepthImageSize() const
 {
@@ -299,5 +324,9 @@ void BlankImageGenerator::GetImages(UChar4Image& rgb, ShortImage& raw_depth)
 	raw_depth.Clear();
 }
 
+template bool InputSource::ReadFrameImages<ImageMaskPathGenerator>(const ImageMaskPathGenerator& path_generator,
+		size_t frame_number, UChar4Image& rgb, ShortImage& depth, UCharImage& mask);
+template bool InputSource::ReadFrameImages<ImageListPathGenerator>(const ImageListPathGenerator& path_generator,
+		size_t frame_number, UChar4Image& rgb, ShortImage& depth, UCharImage& mask);
 template class InputSource::ImageFileReader<ImageMaskPathGenerator>;
 template class InputSource::ImageFileReader<ImageListPathGenerator>;
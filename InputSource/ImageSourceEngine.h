@@ -64,6 +64,16 @@ namespace InputSource {
 		 * \return  true, if the image source engine is able to yield more RGB-D images, or false otherwise.
 		 */
 		virtual bool HasMoreImages() const = 0;
+
+		/**
+		 * \brief Advances past the next RGB-D images (if any) without handing them out.
+		 *
+		 * By default, the skipped images are read like any others and discarded, but image source engines that can
+		 * seek (e.g. those reading image files) should override this to avoid decoding images no one will use.
+		 *
+		 * \param image_count  The number of images to skip.
+		 */
+		virtual void SkipImages(int image_count);
 	};
 
 	class BaseImageSourceEngine : public ImageSourceEngine
@@ -115,6 +125,17 @@ namespace InputSource {
 		std::string GetMaskImagePath(size_t currentFrameNo) const;
 	};
 
+	/**
+	 * \brief Reads the RGB, depth, and (if the path generator provides them) mask images of one frame from disk, and
+	 * applies the mask to the other two.
+	 * \details rgb and depth are expected to hold the images of a previously read frame, if any: failing to read an image
+	 * counts as the end of the sequence only if an image of that kind was read before.
+	 * \return true if the frame is valid, i.e. is still part of the sequence
+	 */
+	template <typename PathGenerator>
+	bool ReadFrameImages(const PathGenerator& path_generator, size_t frame_number, UChar4Image& rgb, ShortImage& depth,
+	                     UCharImage& mask);
+
 	template <typename PathGenerator>
 	class ImageFileReader : public BaseImageSourceEngine
 	{
@@ -136,6 +157,7 @@ namespace InputSource {
 		bool HasMaskImages() const;
 		bool HasMoreImages() const override;
 		void GetImages(UChar4Image& rgb, ShortImage& raw_depth);
+		void SkipImages(int image_count) override;
 		Vector2i GetDepthImageSize() const override;
 		Vector2i GetRGBImageSize() const override;
 	};
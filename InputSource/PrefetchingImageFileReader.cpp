@@ -0,0 +1,153 @@
+//stdlib
+#include <algorithm>
+#include <limits>
+
+//local
+#include "PrefetchingImageFileReader.h"
+
+using namespace InputSource;
+
+template<typename PathGenerator>
+PrefetchingImageFileReader<PathGenerator>::FrameSlot::FrameSlot()
+		: frame_number(std::numeric_limits<size_t>::max()),
+		  is_valid(false),
+		  rgb(true, false),
+		  depth(true, false) {}
+
+template<typename PathGenerator>
+PrefetchingImageFileReader<PathGenerator>::PrefetchingImageFileReader(const char* calibration_file_name,
+                                                                      const PathGenerator& path_generator,
+                                                                      size_t initial_frame_number,
+                                                                      int prefetch_frame_count, int worker_thread_count)
+		: BaseImageSourceEngine(calibration_file_name),
+		  path_generator(path_generator),
+		  frame_slots(std::max(prefetch_frame_count, 1)),
+		  current_frame_number(initial_frame_number),
+		  next_frame_number_to_decode(initial_frame_number),
+		  end_frame_number(std::numeric_limits<size_t>::max()),
+		  rgb_image_size(0, 0),
+		  depth_image_size(0, 0),
+		  stopping(false) {
+	for (int i_thread = 0; i_thread < std::max(worker_thread_count, 1); i_thread++) {
+		worker_threads.emplace_back(&PrefetchingImageFileReader::RunWorker, this);
+	}
+}
+
+template<typename PathGenerator>
+PrefetchingImageFileReader<PathGenerator>::~PrefetchingImageFileReader() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	slot_released.notify_all();
+	for (std::thread& worker_thread : worker_threads) {
+		worker_thread.join();
+	}
+}
+
+template<typename PathGenerator>
+void PrefetchingImageFileReader<PathGenerator>::RunWorker() {
+	// images decoded by this worker get swapped with the contents of a ring buffer slot, so buffers are recycled
+	UChar4Image rgb(true, false);
+	ShortImage depth(true, false);
+	UCharImage mask(true, false);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		slot_released.wait(lock, [this] {
+			return stopping || (next_frame_number_to_decode < current_frame_number + frame_slots.size() &&
+			                    next_frame_number_to_decode < end_frame_number);
+		});
+		if (stopping) return;
+		const size_t frame_number = next_frame_number_to_decode++;
+
+		lock.unlock();
+		const bool frame_is_valid = ReadFrameImages(path_generator, frame_number, rgb, depth, mask);
+		lock.lock();
+
+		bool frame_waiters_need_notification = false;
+		if (!frame_is_valid && frame_number < end_frame_number) {
+			// readers waiting on any frame at or beyond the new end, including frames skipped to while this one was
+			// being decoded, can stop waiting now
+			end_frame_number = frame_number;
+			frame_waiters_need_notification = true;
+		}
+		// the frame might have been skipped while it was being decoded
+		if (frame_number >= current_frame_number) {
+			FrameSlot& slot = frame_slots[frame_number % frame_slots.size()];
+			slot.frame_number = frame_number;
+			slot.is_valid = frame_is_valid;
+			slot.rgb.Swap(rgb);
+			slot.depth.Swap(depth);
+			frame_waiters_need_notification = true;
+		}
+		if (frame_waiters_need_notification) {
+			frame_decoded.notify_all();
+		}
+	}
+}
+
+template<typename PathGenerator>
+const typename PrefetchingImageFileReader<PathGenerator>::FrameSlot*
+PrefetchingImageFileReader<PathGenerator>::WaitForCurrentFrame(std::unique_lock<std::mutex>& lock) const {
+	const FrameSlot& slot = frame_slots[current_frame_number % frame_slots.size()];
+	frame_decoded.wait(lock, [this, &slot] {
+		return slot.frame_number == current_frame_number || current_frame_number >= end_frame_number;
+	});
+	if (slot.frame_number != current_frame_number || !slot.is_valid) return nullptr;
+	rgb_image_size = slot.rgb.dimensions;
+	depth_image_size = slot.depth.dimensions;
+	return &slot;
+}
+
+template<typename PathGenerator>
+bool PrefetchingImageFileReader<PathGenerator>::HasMaskImages() const {
+	return path_generator.has_mask_image_paths;
+}
+
+template<typename PathGenerator>
+bool PrefetchingImageFileReader<PathGenerator>::HasMoreImages() const {
+	std::unique_lock<std::mutex> lock(mutex);
+	return WaitForCurrentFrame(lock) != nullptr;
+}
+
+template<typename PathGenerator>
+void PrefetchingImageFileReader<PathGenerator>::GetImages(UChar4Image& rgb, ShortImage& raw_depth) {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		const FrameSlot* slot = WaitForCurrentFrame(lock);
+		if (slot != nullptr) {
+			rgb.SetFrom(slot->rgb, MemoryCopyDirection::CPU_TO_CPU);
+			raw_depth.SetFrom(slot->depth, MemoryCopyDirection::CPU_TO_CPU);
+		}
+		++current_frame_number;
+	}
+	slot_released.notify_all();
+}
+
+template<typename PathGenerator>
+void PrefetchingImageFileReader<PathGenerator>::SkipImages(int image_count) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		current_frame_number += image_count;
+		next_frame_number_to_decode = std::max(next_frame_number_to_decode, current_frame_number);
+	}
+	slot_released.notify_all();
+}
+
+template<typename PathGenerator>
+Vector2i PrefetchingImageFileReader<PathGenerator>::GetDepthImageSize() const {
+	std::unique_lock<std::mutex> lock(mutex);
+	WaitForCurrentFrame(lock);
+	return depth_image_size;
+}
+
+template<typename PathGenerator>
+Vector2i PrefetchingImageFileReader<PathGenerator>::GetRGBImageSize() const {
+	std::unique_lock<std::mutex> lock(mutex);
+	WaitForCurrentFrame(lock);
+	return rgb_image_size;
+}
+
+template class InputSource::PrefetchingImageFileReader<ImageMaskPathGenerator>;
+template class InputSource::PrefetchingImageFileReader<ImageListPathGenerator>;
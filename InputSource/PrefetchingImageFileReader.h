@@ -0,0 +1,71 @@
+#pragma once
+
+//stdlib
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//local
+#include "ImageSourceEngine.h"
+
+namespace InputSource {
+
+/**
+ * \brief Reads the same image files as ImageFileReader does, but decodes (and masks) the upcoming frames on
+ * background threads, so that reading and decoding overlap with the processing of the current frame.
+ * \details Decoded frames are kept in a bounded ring buffer: frame i goes into slot i % prefetch_frame_count, and no
+ * frame is decoded before the one prefetch_frame_count frames ahead of it has been handed out or skipped.
+ * Skipping frames just moves the read position forward, so frames that haven't been decoded yet by then never will be.
+ */
+template<typename PathGenerator>
+class PrefetchingImageFileReader : public BaseImageSourceEngine {
+public: // instance functions
+	PrefetchingImageFileReader(const char* calibration_file_name, const PathGenerator& path_generator,
+	                           size_t initial_frame_number = 0, int prefetch_frame_count = 8, int worker_thread_count = 2);
+	~PrefetchingImageFileReader() override;
+
+	PrefetchingImageFileReader(const PrefetchingImageFileReader&) = delete;
+	PrefetchingImageFileReader& operator=(const PrefetchingImageFileReader&) = delete;
+
+	bool HasMaskImages() const;
+	bool HasMoreImages() const override;
+	void GetImages(UChar4Image& rgb, ShortImage& raw_depth) override;
+	void SkipImages(int image_count) override;
+	Vector2i GetDepthImageSize() const override;
+	Vector2i GetRGBImageSize() const override;
+
+private: // inner classes
+	struct FrameSlot {
+		FrameSlot();
+		size_t frame_number;
+		bool is_valid;
+		UChar4Image rgb;
+		ShortImage depth;
+	};
+
+private: // instance functions
+	void RunWorker();
+	/** \brief Block until the frame at the read position is decoded (or known to lie past the end of the sequence). */
+	const FrameSlot* WaitForCurrentFrame(std::unique_lock<std::mutex>& lock) const;
+
+private: // instance variables
+	const PathGenerator path_generator;
+	std::vector<FrameSlot> frame_slots;
+
+	// all of the below are guarded by the mutex
+	size_t current_frame_number;
+	size_t next_frame_number_to_decode;
+	// number of the first frame found to be past the end of the sequence
+	size_t end_frame_number;
+	mutable Vector2i rgb_image_size;
+	mutable Vector2i depth_image_size;
+	bool stopping;
+
+	mutable std::mutex mutex;
+	mutable std::condition_variable frame_decoded;
+	std::condition_variable slot_released;
+	std::vector<std::thread> worker_threads;
+};
+
+} // namespace InputSource
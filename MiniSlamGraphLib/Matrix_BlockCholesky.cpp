@@ -0,0 +1,324 @@
+// Copyright 2014-2017 Oxford University Innovation Limited and the authors of InfiniTAM
+
+#include "Matrix_BlockCholesky.h"
+
+#include <algorithm>
+#include <iterator>
+#include <math.h>
+#include <set>
+#include <utility>
+
+using namespace MiniSlamGraph;
+
+// minimum number of blocks in a column of the factor before its updates are spread over threads
+static const int MIN_PARALLEL_COLUMN_BLOCKS = 16;
+
+/** Minimum degree ordering of the graph with an edge for each off-diagonal
+	block. Every vertex is a whole block (i.e. a local map for pose graphs),
+	so the graph is small enough to track the exact degrees. Ties go to the
+	lowest index, which keeps the ordering deterministic.
+*/
+static void minimumDegreeOrdering(int numBlocks, const std::vector<int> & blockRows, const std::vector<int> & blockCols, std::vector<int> & perm)
+{
+	std::vector<std::set<int> > adjacency(numBlocks);
+	for (size_t i = 0; i < blockRows.size(); ++i) {
+		if (blockRows[i] == blockCols[i]) continue;
+		adjacency[blockRows[i]].insert(blockCols[i]);
+		adjacency[blockCols[i]].insert(blockRows[i]);
+	}
+
+	std::set<std::pair<int, int> > queue;
+	for (int v = 0; v < numBlocks; ++v) queue.insert(std::make_pair((int)adjacency[v].size(), v));
+
+	perm.clear();
+	perm.reserve(numBlocks);
+	while (!queue.empty()) {
+		int v = queue.begin()->second;
+		queue.erase(queue.begin());
+		perm.push_back(v);
+
+		// eliminating v connects all of its neighbours with each other
+		std::vector<int> neighbours(adjacency[v].begin(), adjacency[v].end());
+		for (size_t a = 0; a < neighbours.size(); ++a) {
+			int u = neighbours[a];
+			queue.erase(std::make_pair((int)adjacency[u].size(), u));
+			adjacency[u].erase(v);
+			for (size_t b = 0; b < neighbours.size(); ++b) if (b != a) adjacency[u].insert(neighbours[b]);
+			queue.insert(std::make_pair((int)adjacency[u].size(), u));
+		}
+		adjacency[v].clear();
+	}
+}
+
+bool Matrix_BlockCholesky::Pattern::matches(int _numBlocks, const std::vector<int> & blockRows, const std::vector<int> & blockCols) const
+{
+	return (numBlocks == _numBlocks) && (sourceBlockRows == blockRows) && (sourceBlockCols == blockCols);
+}
+
+Matrix_BlockCholesky::Pattern* Matrix_BlockCholesky::computePattern(int numBlocks, const std::vector<int> & blockRows, const std::vector<int> & blockCols)
+{
+	Pattern *pattern = new Pattern();
+	pattern->numBlocks = numBlocks;
+	pattern->sourceBlockRows = blockRows;
+	pattern->sourceBlockCols = blockCols;
+
+	minimumDegreeOrdering(numBlocks, blockRows, blockCols, pattern->perm);
+	pattern->invPerm.resize(numBlocks);
+	for (int j = 0; j < numBlocks; ++j) pattern->invPerm[pattern->perm[j]] = j;
+
+	// blocks below the diagonal of the reordered matrix, by column
+	std::vector<std::vector<int> > columns(numBlocks);
+	for (size_t i = 0; i < blockRows.size(); ++i) {
+		int r = pattern->invPerm[blockRows[i]];
+		int c = pattern->invPerm[blockCols[i]];
+		if (r > c) columns[c].push_back(r);
+	}
+
+	// symbolic factorisation: the structure of column j of the factor is the one of the matrix plus that of its
+	// children in the elimination tree, less j itself
+	std::vector<std::vector<int> > children(numBlocks);
+	for (int j = 0; j < numBlocks; ++j) {
+		std::vector<int> & column = columns[j];
+		std::sort(column.begin(), column.end());
+		column.erase(std::unique(column.begin(), column.end()), column.end());
+		for (size_t c = 0; c < children[j].size(); ++c) {
+			const std::vector<int> & childColumn = columns[children[j][c]];
+			std::vector<int> merged;
+			std::set_union(column.begin(), column.end(), childColumn.begin() + 1, childColumn.end(), std::back_inserter(merged));
+			column.swap(merged);
+		}
+		if (!column.empty()) children[column[0]].push_back(j);
+	}
+
+	pattern->colStart.resize(numBlocks + 1);
+	pattern->colStart[0] = 0;
+	for (int j = 0; j < numBlocks; ++j) {
+		pattern->colStart[j + 1] = pattern->colStart[j] + (int)columns[j].size();
+		pattern->rowIndex.insert(pattern->rowIndex.end(), columns[j].begin(), columns[j].end());
+	}
+
+	// the same blocks by row, visiting the columns in ascending order keeps every row sorted
+	pattern->rowStart.assign(numBlocks + 1, 0);
+	for (size_t p = 0; p < pattern->rowIndex.size(); ++p) pattern->rowStart[pattern->rowIndex[p] + 1]++;
+	for (int i = 0; i < numBlocks; ++i) pattern->rowStart[i + 1] += pattern->rowStart[i];
+	pattern->rowCol.resize(pattern->rowIndex.size());
+	pattern->rowEntry.resize(pattern->rowIndex.size());
+	std::vector<int> rowFill(pattern->rowStart.begin(), pattern->rowStart.end() - 1);
+	for (int j = 0; j < numBlocks; ++j) {
+		for (int p = pattern->colStart[j]; p < pattern->colStart[j + 1]; ++p) {
+			int t = rowFill[pattern->rowIndex[p]]++;
+			pattern->rowCol[t] = j;
+			pattern->rowEntry[t] = numBlocks + p;
+		}
+	}
+
+	pattern->sourceEntry.resize(blockRows.size());
+	for (size_t i = 0; i < blockRows.size(); ++i) {
+		int r = pattern->invPerm[blockRows[i]];
+		int c = pattern->invPerm[blockCols[i]];
+		if (r == c) pattern->sourceEntry[i] = r;
+		else if (r < c) pattern->sourceEntry[i] = -1;
+		else {
+			const int *column = &(pattern->rowIndex[0]);
+			int p = (int)(std::lower_bound(column + pattern->colStart[c], column + pattern->colStart[c + 1], r) - column);
+			pattern->sourceEntry[i] = numBlocks + p;
+		}
+	}
+
+	return pattern;
+}
+
+Matrix_BlockCholesky::Matrix_BlockCholesky(const SparseBlockMatrix & src, int size, Pattern * &sparsityPattern)
+{
+	mBlockSize = 0;
+	src.getRegularBlockSize(mBlockSize);
+	int blockElements = mBlockSize * mBlockSize;
+	int numBlocks = (mBlockSize > 0) ? size / mBlockSize : 0;
+
+	int numSourceBlocks = src.numBlocks();
+	std::vector<int> blockRows(numSourceBlocks), blockCols(numSourceBlocks);
+	std::vector<double> blockData(numSourceBlocks * blockElements);
+	if (numSourceBlocks > 0) src.toBlockTriplets(&(blockRows[0]), &(blockCols[0]), &(blockData[0]));
+
+	if (sparsityPattern == nullptr) sparsityPattern = computePattern(numBlocks, blockRows, blockCols);
+	if (sparsityPattern->matches(numBlocks, blockRows, blockCols)) {
+		mPattern = sparsityPattern;
+	}
+	else {
+		mPrivatePattern.reset(computePattern(numBlocks, blockRows, blockCols));
+		mPattern = mPrivatePattern.get();
+	}
+
+	// blocks of the upper triangle are skipped, their transposes are part of the lower one
+	mValues.assign((numBlocks + mPattern->rowIndex.size()) * blockElements, 0.0);
+	for (int i = 0; i < numSourceBlocks; ++i) {
+		int entry = mPattern->sourceEntry[i];
+		if (entry < 0) continue;
+		const double *block = &(blockData[i * blockElements]);
+		double *dest = &(mValues[entry * blockElements]);
+		for (int k = 0; k < blockElements; ++k) dest[k] = block[k];
+	}
+}
+
+void Matrix_BlockCholesky::multiply(const double *b, double *x) const
+{
+	const int bs = mBlockSize;
+	const int blockElements = bs * bs;
+	const int numBlocks = mPattern->numBlocks;
+	for (int i = 0; i < numRows(); ++i) x[i] = 0.0;
+
+	for (int j = 0; j < numBlocks; ++j) {
+		const double *b_j = &(b[mPattern->perm[j] * bs]);
+		double *x_j = &(x[mPattern->perm[j] * bs]);
+
+		// diagonal block, only its lower half is used, as in the factorisation
+		const double *A_jj = &(mValues[j * blockElements]);
+		for (int r = 0; r < bs; ++r) for (int c = 0; c < bs; ++c) {
+			double value = (c <= r) ? A_jj[r * bs + c] : A_jj[c * bs + r];
+			x_j[r] += value * b_j[c];
+		}
+
+		// each block below the diagonal stands for itself and its transpose
+		for (int p = mPattern->colStart[j]; p < mPattern->colStart[j + 1]; ++p) {
+			int i = mPattern->rowIndex[p];
+			const double *A_ij = &(mValues[(numBlocks + p) * blockElements]);
+			const double *b_i = &(b[mPattern->perm[i] * bs]);
+			double *x_i = &(x[mPattern->perm[i] * bs]);
+			for (int r = 0; r < bs; ++r) for (int c = 0; c < bs; ++c) {
+				x_i[r] += A_ij[r * bs + c] * b_j[c];
+				x_j[c] += A_ij[r * bs + c] * b_i[r];
+			}
+		}
+	}
+}
+
+/** dest -= a * b^T for row-major square blocks */
+static inline void subtractProductTransposed(double *dest, const double *a, const double *b, int bs)
+{
+	for (int r = 0; r < bs; ++r) for (int c = 0; c < bs; ++c) {
+		double sum = 0.0;
+		for (int k = 0; k < bs; ++k) sum += a[r * bs + k] * b[c * bs + k];
+		dest[r * bs + c] -= sum;
+	}
+}
+
+/** In-place Cholesky decomposition of the lower half of a block, returns false if it is not positive definite */
+static inline bool choleskyBlock(double *block, int bs)
+{
+	for (int c = 0; c < bs; ++c) {
+		double diagonal = block[c * bs + c];
+		for (int k = 0; k < c; ++k) diagonal -= block[c * bs + k] * block[c * bs + k];
+		if (!(diagonal > 0.0)) return false;
+		diagonal = sqrt(diagonal);
+		block[c * bs + c] = diagonal;
+
+		for (int r = c + 1; r < bs; ++r) {
+			double value = block[r * bs + c];
+			for (int k = 0; k < c; ++k) value -= block[r * bs + k] * block[c * bs + k];
+			block[r * bs + c] = value / diagonal;
+		}
+	}
+	return true;
+}
+
+/** block := block * L^-T for a lower triangular L */
+static inline void solveLowerTransposedRight(double *block, const double *L, int bs)
+{
+	for (int r = 0; r < bs; ++r) for (int c = 0; c < bs; ++c) {
+		double value = block[r * bs + c];
+		for (int k = 0; k < c; ++k) value -= block[r * bs + k] * L[c * bs + k];
+		block[r * bs + c] = value / L[c * bs + c];
+	}
+}
+
+bool Matrix_BlockCholesky::factorize(std::vector<double> & factor) const
+{
+	const int bs = mBlockSize;
+	const int blockElements = bs * bs;
+	const int numBlocks = mPattern->numBlocks;
+	const Pattern & pattern = *mPattern;
+	factor = mValues;
+
+	// left-looking: column j receives the updates from all columns k < j with a block in row j
+	for (int j = 0; j < numBlocks; ++j) {
+		double *L_jj = &(factor[j * blockElements]);
+		for (int t = pattern.rowStart[j]; t < pattern.rowStart[j + 1]; ++t) {
+			const double *L_jk = &(factor[pattern.rowEntry[t] * blockElements]);
+			subtractProductTransposed(L_jj, L_jk, L_jk, bs);
+		}
+		if (!choleskyBlock(L_jj, bs)) return false;
+
+		// the blocks below the diagonal only depend on finished columns, so they are updated independently
+		const int columnStart = pattern.colStart[j];
+		const int columnEnd = pattern.colStart[j + 1];
+#ifdef WITH_OPENMP
+#pragma omp parallel for if (columnEnd - columnStart >= MIN_PARALLEL_COLUMN_BLOCKS)
+#endif
+		for (int p = columnStart; p < columnEnd; ++p) {
+			int i = pattern.rowIndex[p];
+			double *L_ij = &(factor[(numBlocks + p) * blockElements]);
+
+			// L_ij -= sum over k < j of L_ik * L_jk^T, where both blocks exist
+			int ti = pattern.rowStart[i], tj = pattern.rowStart[j];
+			while ((ti < pattern.rowStart[i + 1]) && (tj < pattern.rowStart[j + 1])) {
+				int ki = pattern.rowCol[ti], kj = pattern.rowCol[tj];
+				if (ki < kj) ++ti;
+				else if (kj < ki) ++tj;
+				else {
+					subtractProductTransposed(L_ij, &(factor[pattern.rowEntry[ti] * blockElements]), &(factor[pattern.rowEntry[tj] * blockElements]), bs);
+					++ti;
+					++tj;
+				}
+			}
+			solveLowerTransposedRight(L_ij, L_jj, bs);
+		}
+	}
+	return true;
+}
+
+bool Matrix_BlockCholesky::solve(const double *b, double *x) const
+{
+	const int bs = mBlockSize;
+	const int blockElements = bs * bs;
+	const int numBlocks = mPattern->numBlocks;
+	const Pattern & pattern = *mPattern;
+
+	std::vector<double> factor;
+	if (!factorize(factor)) return false;
+
+	std::vector<double> y(numRows());
+	for (int j = 0; j < numBlocks; ++j) for (int r = 0; r < bs; ++r) y[j * bs + r] = b[pattern.perm[j] * bs + r];
+
+	// y := L^-1 y
+	for (int j = 0; j < numBlocks; ++j) {
+		const double *L_jj = &(factor[j * blockElements]);
+		double *y_j = &(y[j * bs]);
+		for (int r = 0; r < bs; ++r) {
+			for (int k = 0; k < r; ++k) y_j[r] -= L_jj[r * bs + k] * y_j[k];
+			y_j[r] /= L_jj[r * bs + r];
+		}
+		for (int p = pattern.colStart[j]; p < pattern.colStart[j + 1]; ++p) {
+			const double *L_ij = &(factor[(numBlocks + p) * blockElements]);
+			double *y_i = &(y[pattern.rowIndex[p] * bs]);
+			for (int r = 0; r < bs; ++r) for (int c = 0; c < bs; ++c) y_i[r] -= L_ij[r * bs + c] * y_j[c];
+		}
+	}
+
+	// y := L^-T y
+	for (int j = numBlocks - 1; j >= 0; --j) {
+		const double *L_jj = &(factor[j * blockElements]);
+		double *y_j = &(y[j * bs]);
+		for (int p = pattern.colStart[j]; p < pattern.colStart[j + 1]; ++p) {
+			const double *L_ij = &(factor[(numBlocks + p) * blockElements]);
+			const double *y_i = &(y[pattern.rowIndex[p] * bs]);
+			for (int r = 0; r < bs; ++r) for (int c = 0; c < bs; ++c) y_j[c] -= L_ij[r * bs + c] * y_i[r];
+		}
+		for (int r = bs - 1; r >= 0; --r) {
+			for (int k = r + 1; k < bs; ++k) y_j[r] -= L_jj[k * bs + r] * y_j[k];
+			y_j[r] /= L_jj[r * bs + r];
+		}
+	}
+
+	for (int j = 0; j < numBlocks; ++j) for (int r = 0; r < bs; ++r) x[pattern.perm[j] * bs + r] = y[j * bs + r];
+	return true;
+}
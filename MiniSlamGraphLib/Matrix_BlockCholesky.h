@@ -0,0 +1,112 @@
+// Copyright 2014-2017 Oxford University Innovation Limited and the authors of InfiniTAM
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "MatrixWrapper.h"
+#include "SparseBlockMatrix.h"
+
+namespace MiniSlamGraph {
+
+	/** This is a reimplementation of Matrix for symmetric, positive definite
+		matrices made of small dense square blocks, like the Hessian of a pose
+		graph. The method solve() uses a sparse Cholesky decomposition working
+		on whole blocks, with the blocks reordered to reduce fill-in.
+
+		Everything that only depends on which blocks are present (the ordering,
+		the elimination tree and the block structure of the factor) is computed
+		once and kept in a Pattern, so that repeated solves with the same
+		structure, like the iterations of an optimisation, only redo the
+		numeric factorisation.
+	*/
+	class Matrix_BlockCholesky : public Matrix {
+	public:
+		/** Symbolic analysis of a block structure. All block indices other
+			than in sourceBlockRows/sourceBlockCols refer to the reordered
+			matrix.
+		*/
+		struct Pattern {
+			int numBlocks;
+			/** block structure of the matrix this pattern was computed for */
+			std::vector<int> sourceBlockRows, sourceBlockCols;
+			/** storage index of each source block in the factor, -1 for blocks of the upper triangle */
+			std::vector<int> sourceEntry;
+
+			/** reordered block index -> original block index and back */
+			std::vector<int> perm, invPerm;
+
+			/** off-diagonal blocks of the factor by column: rows rowIndex[colStart[j]] to
+				rowIndex[colStart[j+1]-1] in ascending order, stored at numBlocks + position
+			*/
+			std::vector<int> colStart, rowIndex;
+			/** same blocks by row: columns rowCol[rowStart[i]] to rowCol[rowStart[i+1]-1] in
+				ascending order, stored at rowEntry[...]
+			*/
+			std::vector<int> rowStart, rowCol, rowEntry;
+
+			bool matches(int numBlocks, const std::vector<int> & blockRows, const std::vector<int> & blockCols) const;
+		};
+
+		static Pattern* computePattern(int numBlocks, const std::vector<int> & blockRows, const std::vector<int> & blockCols);
+		static void freePattern(Pattern *pattern)
+		{
+			delete pattern;
+		}
+
+		/** Both triangles of @p src have to be present, as assembled by
+			SlamGraph. If @p sparsityPattern is nullptr, it is computed and
+			handed back to the caller, who then owns it. If it does not fit the
+			structure of @p src, a private pattern is used instead.
+		*/
+		Matrix_BlockCholesky(const SparseBlockMatrix & src, int size, Pattern * &sparsityPattern);
+
+		Matrix_BlockCholesky* clone() const
+		{
+			return new Matrix_BlockCholesky(*this);
+		}
+
+		void multiply(const double *b, double *x) const;
+
+		/** Returns false if the matrix is not positive definite. */
+		bool solve(const double *b, double *x) const;
+
+		const double & diag(int i) const
+		{
+			return mValues[diagonalIndex(i)];
+		}
+		double & diag(int i)
+		{
+			return mValues[diagonalIndex(i)];
+		}
+
+		int numRows() const
+		{
+			return mPattern->numBlocks * mBlockSize;
+		}
+
+		int numCols() const
+		{
+			return mPattern->numBlocks * mBlockSize;
+		}
+
+	private:
+		int diagonalIndex(int i) const
+		{
+			int block = mPattern->invPerm[i / mBlockSize];
+			int offset = i % mBlockSize;
+			return block * mBlockSize * mBlockSize + offset * mBlockSize + offset;
+		}
+
+		bool factorize(std::vector<double> & factor) const;
+
+		int mBlockSize;
+		const Pattern *mPattern;
+		// set if the pattern passed in did not fit and one had to be computed for this matrix alone
+		std::shared_ptr<const Pattern> mPrivatePattern;
+
+		// lower triangle of the reordered matrix, in the block layout of the factor
+		std::vector<double> mValues;
+	};
+}
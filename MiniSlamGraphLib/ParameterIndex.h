@@ -25,6 +25,12 @@ namespace MiniSlamGraph
 			numPara += num;
 		}
 
+		void clear()
+		{
+			mIdx.clear();
+			numPara = 0;
+		}
+
 		int findIndex(int id) const
 		{
 			Index::const_iterator it = mIdx.find(id);
@@ -2,6 +2,8 @@
 
 #include "SlamGraph.h"
 
+#include <algorithm>
+
 #include "SparseRegularBlockMatrix.h"
 
 using namespace MiniSlamGraph;
@@ -42,8 +44,25 @@ void SlamGraph::addEdge(GraphEdge *edge)
 	mEdges.push_back(edge);
 }
 
+void SlamGraph::removeNode(int id)
+{
+	NodeIndex::iterator it = mNodes.find(id);
+	if (it == mNodes.end()) return;
+	delete it->second;
+	mNodes.erase(it);
+}
+
+void SlamGraph::removeEdge(GraphEdge *edge)
+{
+	EdgeList::iterator it = std::find(mEdges.begin(), mEdges.end(), edge);
+	if (it == mEdges.end()) return;
+	delete *it;
+	mEdges.erase(it);
+}
+
 void SlamGraph::prepareEvaluations()
 {
+	mParameterIndex.clear();
 	for (NodeIndex::const_iterator it = mNodes.begin(); it != mNodes.end(); ++it) {
 		if (it->second->isFixed()) continue;
 
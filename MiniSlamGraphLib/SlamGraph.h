@@ -26,6 +26,12 @@ namespace MiniSlamGraph
 
 		void addNode(GraphNode *node);
 		void addEdge(GraphEdge *edge);
+		/** Remove and delete the node with the given id, if any. Edges
+			attached to it have to be removed separately.
+		*/
+		void removeNode(int id);
+		/** Remove and delete the given edge, if it is part of the graph. */
+		void removeEdge(GraphEdge *edge);
 
 		const NodeIndex & getNodeIndex() const { return mNodes; }
 		void setNodeIndex(const NodeIndex & src);
@@ -33,7 +39,8 @@ namespace MiniSlamGraph
 		/** Before any calls to evaluateF() or related functions, the
 			evaluations have to be initialized with prepareEvaluations().
 			This will internally assign the parameters of all nodes to places
-			in the gradient vector and hessian matrix.
+			in the gradient vector and hessian matrix. It has to be called
+			again whenever nodes were added or removed since.
 		*/
 		void prepareEvaluations();
 		const ParameterIndex & getParameters() const
@@ -6,6 +6,8 @@
 
 #ifdef COMPILE_WITH_CSPARSE
 #include "Matrix_CSparse.h"
+#else
+#include "Matrix_BlockCholesky.h"
 #endif
 
 //#define DEBUG_DERIVATIVES
@@ -116,10 +118,16 @@ void SlamGraphErrorFunction::EvaluationPoint::cacheGH()
 #ifdef COMPILE_WITH_CSPARSE
 	cacheH = new Matrix_CSparse(*H_tmp, (Matrix_CSparse::Pattern*&)(const_cast<SlamGraphErrorFunction*>(mParent)->getHessianSparsityPattern()));
 #else
-	MatrixSymPosDef *H = new MatrixSymPosDef(cacheG->getOverallSize());
-	cacheH = H;
-	for (int i = 0; i < H->numRows()*H->numCols(); ++i) H->getMemory()[i] = 0.0f;
-	H_tmp->densify(H->getMemory(), H->numCols());
+	int blockSize;
+	if (H_tmp->getRegularBlockSize(blockSize) && (cacheG->getOverallSize() % blockSize == 0)) {
+		cacheH = new Matrix_BlockCholesky(*H_tmp, cacheG->getOverallSize(), (Matrix_BlockCholesky::Pattern*&)(const_cast<SlamGraphErrorFunction*>(mParent)->getHessianSparsityPattern()));
+	}
+	else {
+		MatrixSymPosDef *H = new MatrixSymPosDef(cacheG->getOverallSize());
+		cacheH = H;
+		for (int i = 0; i < H->numRows()*H->numCols(); ++i) H->getMemory()[i] = 0.0f;
+		H_tmp->densify(H->getMemory(), H->numCols());
+	}
 #endif
 	delete H_tmp;
 
@@ -145,9 +153,16 @@ SlamGraphErrorFunction::SlamGraphErrorFunction(const SlamGraph & graph)
 }
 
 SlamGraphErrorFunction::~SlamGraphErrorFunction()
+{
+	freeHessianSparsityPattern(mSparsityPattern);
+}
+
+void SlamGraphErrorFunction::freeHessianSparsityPattern(void *pattern)
 {
 #ifdef COMPILE_WITH_CSPARSE
-	if (mSparsityPattern) Matrix_CSparse::freePattern((Matrix_CSparse::Pattern*)mSparsityPattern);
+	if (pattern) Matrix_CSparse::freePattern((Matrix_CSparse::Pattern*)pattern);
+#else
+	Matrix_BlockCholesky::freePattern((Matrix_BlockCholesky::Pattern*)pattern);
 #endif
 }
 
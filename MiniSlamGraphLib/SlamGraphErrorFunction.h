@@ -65,11 +65,19 @@ namespace MiniSlamGraph {
 
 		void applyDelta(const /*K_OPTIM::Optimization*/Parameters & para_old, const double *delta, /*K_OPTIM::Optimization*/Parameters & para_new) const;
 
-		//Matrix_CSparse::Pattern* & getHessianSparsityPattern()
+		//Matrix_CSparse::Pattern* & getHessianSparsityPattern() (or Matrix_BlockCholesky::Pattern* without CSparse)
+		/** The symbolic factorisation of the Hessian, computed on first use
+			and freed with this object. It stays valid for any graph with the
+			same nodes and the same node pairs connected by edges, so it may be
+			handed over to another error function: take it out and set the
+			reference to nullptr to keep it alive, then release it with
+			freeHessianSparsityPattern().
+		*/
 		void* & getHessianSparsityPattern()
 		{
 			return mSparsityPattern;
 		}
+		static void freeHessianSparsityPattern(void *pattern);
 
 		const SlamGraph* getGraph() const
 		{
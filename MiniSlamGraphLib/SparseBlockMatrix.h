@@ -20,6 +20,22 @@ namespace MiniSlamGraph
 		/** Convert to Compressed Columns format. */
 		virtual void toCompressedColumns(int *rowIndices, int *colPointers, double *data) const = 0;
 
+		/** If the matrix consists of square blocks of one size only, write
+			that size to @p blockSize and return true.
+		*/
+		virtual bool getRegularBlockSize(int & blockSize) const { return false; }
+
+		/** Get number of allocated blocks. Only meaningful if
+			getRegularBlockSize() returns true.
+		*/
+		virtual int numBlocks() const { return 0; }
+
+		/** For each allocated block, write block row, block column and the
+			row-major block data to the given arrays. Only meaningful if
+			getRegularBlockSize() returns true.
+		*/
+		virtual int toBlockTriplets(int *blockRows, int *blockCols, double *data) const { return 0; }
+
 		/** Convert to dense matrix. */
 		virtual void densify(double *dest, int rowStride) const = 0;
 
@@ -78,6 +78,30 @@ namespace MiniSlamGraph
 			numCols = (numCols + 1) * BlockSizeCols;
 		}
 
+		bool getRegularBlockSize(int & blockSize) const
+		{
+			if (BlockSizeRows != BlockSizeCols) return false;
+			blockSize = BlockSizeRows;
+			return true;
+		}
+
+		int numBlocks() const
+		{
+			return (int)mData.size();
+		}
+
+		int toBlockTriplets(int *blockRows, int *blockCols, double *data) const
+		{
+			int numEntries = 0;
+			typename MatrixData::const_iterator it = mData.begin();
+			for (; it != mData.end(); ++it, ++numEntries) {
+				blockRows[numEntries] = it->first.block_r;
+				blockCols[numEntries] = it->first.block_c;
+				for (int i = 0; i < BlockSizeRows*BlockSizeCols; ++i) data[numEntries*BlockSizeRows*BlockSizeCols + i] = it->second[i];
+			}
+			return numEntries;
+		}
+
 		int toTriplets(int *rowIndices, int *colIndices, double *data) const
 		{
 			// TODO: untested. should be fine!
@@ -0,0 +1,103 @@
+//stdlib
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//local
+#include "MappedFile.h"
+#include "PlatformIndependence.h"
+
+using namespace ORUtils;
+
+namespace {
+
+[[noreturn]] void ThrowMappingError(const std::string& path, const char* reason) {
+	std::stringstream ss;
+	ss << "Could not map file \"" << path << "\" into memory: " << reason << ".\n[" __FILE__ ":" TOSTRING(__LINE__) "]";
+	throw std::runtime_error(ss.str());
+}
+
+} // anonymous namespace
+
+MappedFile::MappedFile(const std::string& path) : data(nullptr), size(0) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) ThrowMappingError(path, "could not open file");
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size)) {
+		CloseHandle(file);
+		ThrowMappingError(path, "could not determine file size");
+	}
+	size = static_cast<std::size_t>(file_size.QuadPart);
+	if (size == 0) {
+		CloseHandle(file);
+		return;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr) ThrowMappingError(path, "could not create file mapping");
+	data = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, size));
+	CloseHandle(mapping);
+	if (data == nullptr) ThrowMappingError(path, "could not map view of file");
+#else
+	const int file_descriptor = open(path.c_str(), O_RDONLY);
+	if (file_descriptor == -1) ThrowMappingError(path, "could not open file");
+	struct stat file_status{};
+	if (fstat(file_descriptor, &file_status) == -1) {
+		close(file_descriptor);
+		ThrowMappingError(path, "could not determine file size");
+	}
+	size = static_cast<std::size_t>(file_status.st_size);
+	if (size == 0) {
+		close(file_descriptor);
+		return;
+	}
+	void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor, 0);
+	// the mapping stays valid after the descriptor is closed
+	close(file_descriptor);
+	if (mapped == MAP_FAILED) ThrowMappingError(path, "mmap failed");
+	data = static_cast<unsigned char*>(mapped);
+#endif
+}
+
+MappedFile::~MappedFile() {
+	Unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept: data(other.data), size(other.size) {
+	other.data = nullptr;
+	other.size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		Unmap();
+		data = other.data;
+		size = other.size;
+		other.data = nullptr;
+		other.size = 0;
+	}
+	return *this;
+}
+
+void MappedFile::Unmap() {
+	if (data != nullptr) {
+#ifdef _WIN32
+		UnmapViewOfFile(data);
+#else
+		munmap(data, size);
+#endif
+		data = nullptr;
+		size = 0;
+	}
+}
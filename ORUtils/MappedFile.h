@@ -0,0 +1,36 @@
+#pragma once
+//stdlib
+#include <cstddef>
+#include <string>
+
+namespace ORUtils {
+
+/**
+ * \brief Maps an entire file into memory for reading.
+ * \details The mapping is copy-on-write: the mapped memory may be modified, but modifications only ever affect
+ * private copies of the touched pages and never make it to the file. Pages are read in from disk lazily, on first
+ * access, and can be evicted by the OS under memory pressure, since they are backed by the file.
+ */
+class MappedFile {
+public:
+	MappedFile() : data(nullptr), size(0) {};
+	explicit MappedFile(const std::string& path);
+	~MappedFile();
+
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	unsigned char* Data() { return data; }
+	const unsigned char* Data() const { return data; }
+	std::size_t Size() const { return size; }
+
+private:
+	void Unmap();
+
+	unsigned char* data;
+	std::size_t size;
+};
+
+} // namespace ORUtils
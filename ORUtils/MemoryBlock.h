@@ -194,6 +194,20 @@ public:
 	}
 
 
+	/**
+	 * Wrap host memory owned elsewhere (e.g. a memory-mapped file) without copying it. The memory has to outlive the
+	 * block, which never frees it. Resizing the block makes it allocate (and own) memory of its own.
+	*/
+	MemoryBlock(T* external_data_cpu, size_type element_count)
+			: element_count(element_count),
+			  is_allocated_for_CPU(true),
+			  is_allocated_for_CUDA(false),
+			  is_metal_compatible(false),
+			  data_cpu(external_data_cpu),
+			  data_cuda(nullptr),
+			  access_mode(MEMORYDEVICE_CPU),
+			  wraps_external_data(true) {}
+
 	virtual ~MemoryBlock() {
 		this->Free();
 	}
@@ -213,7 +227,8 @@ public:
 #ifdef COMPILE_WITH_METAL
 			data_metal_buffer(other.data_metal_buffer),
 #endif
-			access_mode(other.access_mode) {
+			access_mode(other.access_mode),
+			wraps_external_data(other.wraps_external_data) {
 		other.element_count = 0;
 		other.is_allocated_for_CPU = false;
 		other.is_allocated_for_CUDA = false;
@@ -221,6 +236,7 @@ public:
 		other.data_cpu = nullptr;
 		other.data_cuda = nullptr;
 		other.access_mode = MEMORYDEVICE_NONE;
+		other.wraps_external_data = false;
 	}
 
 	MemoryBlock(const MemoryBlock& other) :
@@ -461,6 +477,7 @@ public:
 		swap(this->data_metal_buffer, rhs.data_metal_buffer);
 #endif
 		swap(this->access_mode, rhs.access_mode);
+		swap(this->wraps_external_data, rhs.wraps_external_data);
 	}
 
 	friend void swap(MemoryBlock<T>& lhs, MemoryBlock<T>& rhs) { // nothrow
@@ -479,6 +496,8 @@ protected:
 	void *data_metal_buffer;
 #endif
 	MemoryDeviceType access_mode;
+	/** Whether data_cpu points to memory owned elsewhere, which must not be freed */
+	bool wraps_external_data = false;
 
 private:
 	enum AllocationMethod {
@@ -540,6 +559,11 @@ private:
 	}
 
 	void Free() {
+		if (wraps_external_data) {
+			data_cpu = nullptr;
+			is_allocated_for_CPU = false;
+			wraps_external_data = false;
+		}
 		if (is_allocated_for_CPU) {
 			AllocationMethod allocation_method = ALLOCATION_ON_CPU_WITHOUT_CUDA_OR_METAL;
 
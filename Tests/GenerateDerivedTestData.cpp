@@ -456,16 +456,22 @@ configuration::Configuration GenerateDefaultSnoopyConfiguration() {
 			false,
 			configuration::FAILUREMODE_IGNORE,
 			configuration::SWAPPINGMODE_DISABLED,
+			0x40000,
+			"",
+			0x1000,
+			4,
+			false,
 			configuration::TrackerConfigurationStringPresets::default_intensity_depth_extended_tracker_configuration
 	);
 	default_snoopy_configuration.source_tree = default_snoopy_configuration.ToPTree();
-	MainEngineSettings default_snoopy_main_engine_settings(true, LIBMODE_DYNAMIC, INDEX_HASH, false, true);
+	MainEngineSettings default_snoopy_main_engine_settings(true, LIBMODE_DYNAMIC, INDEX_HASH, false, true, false, false, false);
 	TelemetrySettings default_snoopy_telemetry_settings;
 	IndexingSettings default_snoopy_indexing_settings;
 	RenderingSettings default_snoopy_rendering_settings;
-	AutomaticRunSettings default_snoopy_automatic_run_settings(716, 16, false, false, false, false, false);
+	AutomaticRunSettings default_snoopy_automatic_run_settings(716, 16, false, false, false, false, false, false);
 	LevelSetAlignmentParameters default_snoopy_level_set_evolution_parameters(
 			ExecutionMode::OPTIMIZED,
+			false,
 			LevelSetAlignmentWeights(
 					0.2f,
 					0.1f,
@@ -32,11 +32,9 @@
 #include "../../../ITMLib/Engines/Indexing/IndexingEngineFactory.h"
 #include "../../../ITMLib/Engines/Indexing/VBH/CPU/IndexingEngine_VoxelBlockHash_CPU.h"
 #include "../../../ITMLib/Utils/Analytics/VoxelVolumeComparison/VoxelVolumeComparison.h"
+#include "../../../ITMLib/Utils/Logging/Logging.h"
 #ifndef COMPILE_WITHOUT_CUDA
 #include "../../../ITMLib/Engines/Indexing/VBH/CUDA/IndexingEngine_VoxelBlockHash_CUDA.h"
-
-#include "../../../ITMLib/Utils/Logging/Logging.h"
-
 #endif
 
 using namespace ITMLib;
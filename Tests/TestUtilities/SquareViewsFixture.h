@@ -0,0 +1,50 @@
+#pragma once
+
+//stdlib
+#include <string>
+
+//ITMLib
+#include "../../ITMLib/Engines/ViewBuilder/Interface/ViewBuilder.h"
+#include "../../ITMLib/Engines/ViewBuilder/ViewBuilderFactory.h"
+#include "../../ITMLib/Objects/Tracking/CameraTrackingState.h"
+#include "../../ORUtils/FileUtils.h"
+//test_utilities
+#include <TestUtilitiesConfig.h>
+#include "TestDataUtilities.h"
+
+using namespace ITMLib;
+
+namespace test {
+/**
+ * \brief Views of the two synthetic frames with a flat square facing the camera, the second square slightly further
+ * away than the first, along with an identity tracking state.
+ */
+template<MemoryDeviceType TMemoryDeviceType>
+struct SquareViewsFixture {
+public: // instance variables
+	ViewBuilder* view_builder;
+	View* view_square_1 = nullptr;
+	View* view_square_2 = nullptr;
+	CameraTrackingState* tracking_state;
+
+public: // instance functions
+	SquareViewsFixture() : view_builder(ViewBuilderFactory::Build(std::string(snoopy::calibration_path), TMemoryDeviceType)) {
+		UChar4Image rgb(true, false);
+		ShortImage depth(true, false);
+		ReadImageFromFile(rgb, STATIC_TEST_DATA_PREFIX "TestData/frames/square1_color.png");
+		ReadImageFromFile(depth, STATIC_TEST_DATA_PREFIX "TestData/frames/square1_depth.png");
+		view_builder->UpdateView(&view_square_1, &rgb, &depth, false, false, false, true);
+		ReadImageFromFile(rgb, STATIC_TEST_DATA_PREFIX "TestData/frames/square2_color.png");
+		ReadImageFromFile(depth, STATIC_TEST_DATA_PREFIX "TestData/frames/square2_depth.png");
+		view_builder->UpdateView(&view_square_2, &rgb, &depth, false, false, false, true);
+		tracking_state = new CameraTrackingState(depth.dimensions, TMemoryDeviceType);
+	}
+
+	~SquareViewsFixture() {
+		delete view_builder;
+		delete view_square_1;
+		delete view_square_2;
+		delete tracking_state;
+	}
+};
+} // namespace test
@@ -89,6 +89,8 @@ template void GenerateSimpleSurfaceTestVolume<MEMORYDEVICE_CPU, TSDFVoxel, Plain
 template void GenerateRandomDepthWeightSubVolume<MEMORYDEVICE_CPU, TSDFVoxel, VoxelBlockHash>(
 		VoxelVolume<TSDFVoxel, VoxelBlockHash>* volume, const Extent3Di& bounds, const Extent2Di&
 weight_range);
+template void GenerateRandomDepthWeightSubVolume<MEMORYDEVICE_CPU, TSDFVoxel, PlainVoxelArray>(
+		VoxelVolume<TSDFVoxel, PlainVoxelArray>* volume, const Extent3Di& bounds, const Extent2Di& weight_range);
 
 template void SimulateVoxelAlteration<TSDFVoxel>(TSDFVoxel& voxel, float newSdfValue);
 template void SimulateRandomVoxelAlteration<TSDFVoxel>(TSDFVoxel& voxel);
@@ -434,6 +436,11 @@ configuration::Configuration GenerateChangedUpConfiguration() {
 			true,
 			configuration::FAILUREMODE_RELOCALIZE,
 			configuration::SWAPPINGMODE_ENABLED,
+			0x10000,
+			GENERATED_TEST_DATA_PREFIX "TestData/output/swapping",
+			0x800,
+			2,
+			true,
 			"type=rgb,levels=rrbb"
 	);
 	changed_up_configuration.source_tree = changed_up_configuration.ToPTree();
@@ -448,19 +455,22 @@ configuration::Configuration GenerateChangedUpConfiguration() {
 			0.0001,
 			32,
 			true,
+			true,
 			true);
 	MainEngineSettings changed_up_main_engine_settings(
 			true, LIBMODE_BASIC,
 			INDEX_ARRAY,
-			true, false);
+			true, false, true, true, true);
 	IndexingSettings changed_up_indexing_settings(DIAGNOSTIC);
 	RenderingSettings changed_up_rendering_settings(true);
 	AutomaticRunSettings changed_up_automatic_run_settings(
 			50, 16,
 			true, true,
-			true, true, true);
+			true, true, true,
+			true);
 	LevelSetAlignmentParameters changed_up_level_set_evolution_parameters(
 			ExecutionMode::DIAGNOSTIC,
+			true,
 			LevelSetAlignmentWeights(0.11f, 0.09f, 2.0f, 0.3f, 0.1f, 1e-6f),
 			LevelSetAlignmentSwitches(false, true, false, true, false),
 			LevelSetAlignmentTerminationConditions(AVERAGE, 300, 5, 0.0002f)
@@ -122,8 +122,8 @@ private:
 };
 
 #else
-template<typename TVoxel>
-struct AssignRandomDepthWeightsInRangeFunctor<TVoxel, VoxelBlockHash, MEMORYDEVICE_CPU> {
+template<typename TVoxel, typename TIndex>
+struct AssignRandomDepthWeightsInRangeFunctor<TVoxel, TIndex, MEMORYDEVICE_CPU> {
 
 	AssignRandomDepthWeightsInRangeFunctor(const Extent2Di& range, const Extent3Di& bounds) :
 			range(range), bounds(bounds), generator(random_device()), distribution(range.from, range.to-1) {
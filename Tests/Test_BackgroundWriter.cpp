@@ -0,0 +1,42 @@
+#define BOOST_TEST_MODULE BackgroundWriter
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/Utils/FileIO/BackgroundWriter.h"
+
+using namespace ITMLib;
+
+BOOST_AUTO_TEST_CASE(Test_BackgroundWriter_RunsTasksInOrder) {
+	std::vector<int> written_values;
+	const std::thread::id submitting_thread_id = std::this_thread::get_id();
+	bool ran_on_other_thread = true;
+	{
+		BackgroundWriter writer(2);
+		for (int i_task = 0; i_task < 16; i_task++) {
+			writer.Submit([&written_values, &ran_on_other_thread, submitting_thread_id, i_task]() {
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+				ran_on_other_thread = ran_on_other_thread && std::this_thread::get_id() != submitting_thread_id;
+				written_values.push_back(i_task);
+			});
+		}
+		writer.Flush();
+		BOOST_REQUIRE_EQUAL(written_values.size(), 16u);
+		writer.Submit([&written_values]() { written_values.push_back(16); });
+		// the last task gets finished on destruction
+	}
+	BOOST_REQUIRE(ran_on_other_thread);
+	BOOST_REQUIRE_EQUAL(written_values.size(), 17u);
+	for (int i_value = 0; i_value < static_cast<int>(written_values.size()); i_value++) {
+		BOOST_REQUIRE_EQUAL(written_values[i_value], i_value);
+	}
+}
@@ -0,0 +1,179 @@
+#define BOOST_TEST_MODULE BlockCholesky
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//MiniSlamGraphLib
+#include "../MiniSlamGraphLib/Matrix_BlockCholesky.h"
+#include "../MiniSlamGraphLib/SparseRegularBlockMatrix.h"
+
+using namespace MiniSlamGraph;
+
+namespace {
+
+constexpr int block_size = 6;
+constexpr int block_elements = block_size * block_size;
+using BlockMatrix = SparseRegularBlockMatrix<block_size, block_size>;
+
+// symmetric, diagonally dominant (hence positive definite) matrix with the given off-diagonal block pairs
+BlockMatrix MakeMatrix(int block_count, const std::vector<std::pair<int, int>>& connections, std::mt19937& generator) {
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	BlockMatrix matrix;
+	std::vector<double> row_sums(block_count * block_size, 0.0);
+	for (const auto& connection : connections) {
+		double block[block_elements];
+		for (double& value : block) value = distribution(generator);
+		matrix.addBlock(connection.first * block_size, connection.second * block_size, block_size, block_size, block);
+		matrix.addBlockTranspose(connection.second * block_size, connection.first * block_size, block_size, block_size, block);
+		for (int r = 0; r < block_size; r++) {
+			for (int c = 0; c < block_size; c++) {
+				row_sums[connection.first * block_size + r] += std::abs(block[r * block_size + c]);
+				row_sums[connection.second * block_size + c] += std::abs(block[r * block_size + c]);
+			}
+		}
+	}
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		double block[block_elements];
+		for (int r = 0; r < block_size; r++) {
+			for (int c = 0; c <= r; c++) {
+				block[r * block_size + c] = block[c * block_size + r] = 0.1 * distribution(generator);
+			}
+		}
+		for (int r = 0; r < block_size; r++) {
+			block[r * block_size + r] = row_sums[i_block * block_size + r] + 1.0 + std::abs(distribution(generator));
+		}
+		matrix.addBlock(i_block * block_size, i_block * block_size, block_size, block_size, block);
+	}
+	return matrix;
+}
+
+std::vector<std::pair<int, int>> MakeLoopyChain(int block_count) {
+	std::vector<std::pair<int, int>> connections;
+	for (int i_block = 0; i_block + 1 < block_count; i_block++) connections.emplace_back(i_block, i_block + 1);
+	for (int i_block = 0; i_block + 7 < block_count; i_block += 5) connections.emplace_back(i_block + 7, i_block);
+	connections.emplace_back(block_count - 1, 0);
+	return connections;
+}
+
+std::vector<double> SolveDense(const BlockMatrix& matrix, int size, const std::vector<double>& b) {
+	MatrixSymPosDef dense(size);
+	for (int i = 0; i < size * size; i++) dense.getMemory()[i] = 0.0;
+	matrix.densify(dense.getMemory(), size);
+	std::vector<double> x(size);
+	BOOST_REQUIRE(dense.solve(b.data(), x.data()));
+	return x;
+}
+
+void RequireSmallResidual(const Matrix& matrix, const std::vector<double>& x, const std::vector<double>& b) {
+	std::vector<double> product(b.size());
+	matrix.multiply(x.data(), product.data());
+	for (size_t i = 0; i < b.size(); i++) {
+		BOOST_REQUIRE_SMALL(product[i] - b[i], 1e-9);
+	}
+}
+
+std::vector<double> RandomVector(int size, std::mt19937& generator) {
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<double> vector(size);
+	for (double& value : vector) value = distribution(generator);
+	return vector;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Test_BlockCholesky_MatchesDense) {
+	std::mt19937 generator(42);
+	// a loopy chain like a pose graph, and a clique that is wide enough to make the factorisation use several threads
+	std::vector<std::pair<int, int>> clique;
+	for (int i_block = 0; i_block < 20; i_block++) {
+		for (int j_block = i_block + 1; j_block < 20; j_block++) clique.emplace_back(j_block, i_block);
+	}
+	for (const auto& connections : {MakeLoopyChain(40), clique}) {
+		const int block_count = connections == clique ? 20 : 40;
+		const int size = block_count * block_size;
+		BlockMatrix matrix = MakeMatrix(block_count, connections, generator);
+		std::vector<double> b = RandomVector(size, generator);
+
+		Matrix_BlockCholesky::Pattern* pattern = nullptr;
+		Matrix_BlockCholesky sparse(matrix, size, pattern);
+		BOOST_REQUIRE(pattern != nullptr);
+		BOOST_REQUIRE_EQUAL(sparse.numRows(), size);
+
+		std::vector<double> x(size);
+		BOOST_REQUIRE(sparse.solve(b.data(), x.data()));
+		RequireSmallResidual(sparse, x, b);
+
+		std::vector<double> x_dense = SolveDense(matrix, size, b);
+		for (int i = 0; i < size; i++) {
+			BOOST_REQUIRE_SMALL(x[i] - x_dense[i], 1e-9);
+		}
+		Matrix_BlockCholesky::freePattern(pattern);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Test_BlockCholesky_PatternReuse) {
+	std::mt19937 generator(7);
+	const int block_count = 25;
+	const int size = block_count * block_size;
+	std::vector<std::pair<int, int>> connections = MakeLoopyChain(block_count);
+
+	Matrix_BlockCholesky::Pattern* pattern = nullptr;
+	BlockMatrix matrix1 = MakeMatrix(block_count, connections, generator);
+	Matrix_BlockCholesky sparse1(matrix1, size, pattern);
+	Matrix_BlockCholesky::Pattern* first_pattern = pattern;
+
+	// same structure, new values: the symbolic analysis is kept
+	BlockMatrix matrix2 = MakeMatrix(block_count, connections, generator);
+	Matrix_BlockCholesky sparse2(matrix2, size, pattern);
+	BOOST_REQUIRE_EQUAL(pattern, first_pattern);
+	std::vector<double> b = RandomVector(size, generator);
+	std::vector<double> x(size);
+	BOOST_REQUIRE(sparse2.solve(b.data(), x.data()));
+	RequireSmallResidual(sparse2, x, b);
+
+	// damping through the diagonal, as done by Levenberg-Marquardt, on a copy
+	Matrix* damped = sparse2.clone();
+	damped->multDiagonal(0.5);
+	BOOST_REQUIRE_CLOSE(damped->diag(7), sparse2.diag(7) * 1.5, 1e-12);
+	BOOST_REQUIRE(damped->solve(b.data(), x.data()));
+	RequireSmallResidual(*damped, x, b);
+	delete damped;
+
+	// different structure: the pattern passed in is left alone and the result is still correct
+	connections.emplace_back(20, 3);
+	BlockMatrix matrix3 = MakeMatrix(block_count, connections, generator);
+	Matrix_BlockCholesky sparse3(matrix3, size, pattern);
+	BOOST_REQUIRE_EQUAL(pattern, first_pattern);
+	BOOST_REQUIRE(sparse3.solve(b.data(), x.data()));
+	RequireSmallResidual(sparse3, x, b);
+	std::vector<double> x_dense = SolveDense(matrix3, size, b);
+	for (int i = 0; i < size; i++) {
+		BOOST_REQUIRE_SMALL(x[i] - x_dense[i], 1e-9);
+	}
+
+	Matrix_BlockCholesky::freePattern(pattern);
+}
+
+BOOST_AUTO_TEST_CASE(Test_BlockCholesky_NotPositiveDefinite) {
+	std::mt19937 generator(3);
+	const int block_count = 4;
+	const int size = block_count * block_size;
+	BlockMatrix matrix = MakeMatrix(block_count, MakeLoopyChain(block_count), generator);
+
+	Matrix_BlockCholesky::Pattern* pattern = nullptr;
+	Matrix_BlockCholesky sparse(matrix, size, pattern);
+	sparse.diag(2 * block_size + 1) = -1.0;
+	std::vector<double> b = RandomVector(size, generator);
+	std::vector<double> x(size);
+	BOOST_REQUIRE(!sparse.solve(b.data(), x.data()));
+	Matrix_BlockCholesky::freePattern(pattern);
+}
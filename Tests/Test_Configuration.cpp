@@ -87,7 +87,7 @@ BOOST_AUTO_TEST_CASE(ConfigurationFileTest) {
 	DeferrableStructCollection deferrables1(configuration1);
 
 #ifdef COMPILE_WITHOUT_CUDA
-	configuration::load_configuration_from_json_file( GENERATED_TEST_DATA_PREFIX "TestData/configuration/default_config_cpu.json");
+	configuration::LoadConfigurationFromJSONFile( GENERATED_TEST_DATA_PREFIX "TestData/configuration/default_config_cpu.json");
 #else
 	configuration::LoadConfigurationFromJSONFile(GENERATED_TEST_DATA_PREFIX "TestData/configuration/default_config_cuda.json");
 #endif
@@ -206,6 +206,7 @@ BOOST_AUTO_TEST_CASE(ConfigurationTestLong_CLI_Only) {
 	                      " --specific_volume_parameters.hash.warp.excess_list_size=131072"
 
 	                      " --level_set_evolution.execution_mode=diagnostic"
+	                      " --level_set_evolution.fuse_optimization_step=true"
 
 	                      " --level_set_evolution.weights.learning_rate=0.11"
 	                      " --level_set_evolution.weights.Killing_dampening_factor=0.09"
@@ -253,6 +254,11 @@ BOOST_AUTO_TEST_CASE(ConfigurationTestLong_CLI_Only) {
 	                      " --use_bilateral_filter=true"
 	                      " --behavior_on_failure=relocalize"
 	                      " --swapping_mode=enabled"
+	                      " --swapping_host_block_budget=65536"
+	                      " --swapping_spill_directory=" GENERATED_TEST_DATA_PREFIX "TestData/output/swapping"
+	                      " --swapping_block_budget_per_frame=2048"
+	                      " --multi_map_concurrent_tracking_limit=2"
+	                      " --multi_map_incremental_global_adjustment=true"
 	                      " --tracker_configuration=\"type=rgb,levels=rrbb\""
 
 	                      " --main_engine_settings.draw_frame_index_labels=true"
@@ -260,6 +266,9 @@ BOOST_AUTO_TEST_CASE(ConfigurationTestLong_CLI_Only) {
 	                      " --main_engine_settings.indexing_method=array"
 					      " --main_engine_settings.halt_on_non_rigid_alignment_convergence_failure=true"
 	                      " --main_engine_settings.enable_rigid_alignment=false"
+	                      " --main_engine_settings.incremental_live_volume_allocation=true"
+	                      " --main_engine_settings.warm_start_non_rigid_alignment=true"
+	                      " --main_engine_settings.mirror_live_volume_index=true"
 
 	                      " --telemetry_settings.record_volume_memory_usage=true"
 	                      " --telemetry_settings.record_surface_tracking_optimization_energies=true"
@@ -271,6 +280,7 @@ BOOST_AUTO_TEST_CASE(ConfigurationTestLong_CLI_Only) {
 					      " --telemetry_settings.warp_update_length_histogram_bin_count=32"
 	                      " --telemetry_settings.use_CPU_for_mesh_recording=true"
 	                      " --telemetry_settings.record_camera_matrices=true"
+	                      " --telemetry_settings.write_meshes_in_background=true"
 
 	                      " --indexing_settings.execution_mode=diagnostic"
 
@@ -283,6 +293,7 @@ BOOST_AUTO_TEST_CASE(ConfigurationTestLong_CLI_Only) {
 	                      " --automatic_run_settings.save_meshes_after_processing=true"
 					      " --automatic_run_settings.exit_if_main_processing_turns_off=true"
 	                      " --automatic_run_settings.exit_after_automatic_processing=true"
+	                      " --automatic_run_settings.pipeline_frame_processing=true"
 
 					      " --volume_fusion_settings.use_surface_thickness_cutoff=false"
 	                      " --volume_fusion_settings.surface_thickness=0.008"
@@ -0,0 +1,173 @@
+#define BOOST_TEST_MODULE GlobalAdjustment
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/Engines/MultiScene/GlobalAdjustmentEngine.h"
+
+using namespace ITMLib;
+
+namespace {
+
+// map graph without any actual volumes, only poses and constraints
+class PoseOnlyMapGraphManager : public MapGraphManager {
+public:
+	int createNewLocalMap() override {
+		estimated_global_poses.emplace_back();
+		constraints.emplace_back();
+		return static_cast<int>(estimated_global_poses.size()) - 1;
+	}
+
+	void removeLocalMap(int index) override {
+		for (auto& constraint_list : constraints) constraint_list.erase(index);
+		estimated_global_poses.erase(estimated_global_poses.begin() + index);
+		constraints.erase(constraints.begin() + index);
+	}
+
+	size_t numLocalMaps() const override { return estimated_global_poses.size(); }
+
+	const PoseConstraint& getRelation_const(int from_local_map, int to_local_map) const override {
+		return constraints[from_local_map].at(to_local_map);
+	}
+
+	PoseConstraint& getRelation(int from_local_map, int to_local_map) override {
+		return constraints[from_local_map][to_local_map];
+	}
+
+	void eraseRelation(int from_local_map, int to_local_map) override {
+		constraints[from_local_map].erase(to_local_map);
+	}
+
+	const ConstraintList& getConstraints(int local_map_id) const override { return constraints[local_map_id]; }
+
+	void setEstimatedGlobalPose(int local_map_id, const ORUtils::SE3Pose& pose) override {
+		estimated_global_poses[local_map_id] = pose;
+	}
+
+	const ORUtils::SE3Pose& getEstimatedGlobalPose(int local_map_id) const override {
+		return estimated_global_poses[local_map_id];
+	}
+
+	bool resetTracking(int local_map_id, const ORUtils::SE3Pose& pose) override { return false; }
+	const ORUtils::SE3Pose* getTrackingPose(int local_map_id) const override { return nullptr; }
+	int getLocalMapSize(int local_map_id) const override { return 0; }
+	int countVisibleBlocks(int local_map_id, int min_block_id, int max_block_id, bool invert_ids) const override { return 0; }
+
+private:
+	std::vector<ORUtils::SE3Pose> estimated_global_poses;
+	std::vector<ConstraintList> constraints;
+};
+
+ORUtils::SE3Pose GroundTruthPose(int local_map_id) {
+	const float angle = 0.3f * static_cast<float>(local_map_id);
+	return ORUtils::SE3Pose(std::cos(angle), 0.1f * static_cast<float>(local_map_id), std::sin(angle), 0.0f, angle, 0.0f);
+}
+
+// adds a local map starting out at a perturbed ground truth pose
+void AddLocalMap(PoseOnlyMapGraphManager& manager) {
+	int local_map_id = manager.createNewLocalMap();
+	const float noise = local_map_id == 0 ? 0.0f : 0.02f * static_cast<float>(local_map_id % 3 + 1);
+	ORUtils::SE3Pose perturbation(noise, -noise, noise, 0.5f * noise, 0.0f, -0.5f * noise);
+	manager.setEstimatedGlobalPose(local_map_id, ORUtils::SE3Pose(perturbation.GetM() * GroundTruthPose(local_map_id).GetM()));
+}
+
+// adds a slightly inconsistent relative pose measurement between two local maps
+void AddConstraint(PoseOnlyMapGraphManager& manager, int from_local_map, int to_local_map, float noise) {
+	ORUtils::SE3Pose perturbation(noise, 0.0f, -noise, 0.0f, noise, 0.0f);
+	ORUtils::SE3Pose relative_pose(perturbation.GetM() * GroundTruthPose(to_local_map).GetM() *
+	                               GroundTruthPose(from_local_map).GetInvM());
+	manager.getRelation(from_local_map, to_local_map).AddObservation(relative_pose);
+}
+
+bool Adjust(GlobalAdjustmentEngine& engine, PoseOnlyMapGraphManager& manager) {
+	BOOST_REQUIRE(engine.updateMeasurements(manager));
+	bool adjusted = engine.runGlobalAdjustment(true);
+	if (adjusted) BOOST_REQUIRE(engine.retrieveNewEstimates(manager));
+	return adjusted;
+}
+
+void RequireSamePoses(const PoseOnlyMapGraphManager& manager1, const PoseOnlyMapGraphManager& manager2) {
+	BOOST_REQUIRE_EQUAL(manager1.numLocalMaps(), manager2.numLocalMaps());
+	for (int local_map_id = 0; local_map_id < static_cast<int>(manager1.numLocalMaps()); local_map_id++) {
+		const Matrix4f& pose1 = manager1.getEstimatedGlobalPose(local_map_id).GetM();
+		const Matrix4f& pose2 = manager2.getEstimatedGlobalPose(local_map_id).GetM();
+		for (int i_value = 0; i_value < 16; i_value++) {
+			BOOST_REQUIRE_SMALL(pose1.values[i_value] - pose2.values[i_value], 1e-4f);
+		}
+	}
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Test_GlobalAdjustment_IncrementalMatchesFromScratch) {
+	PoseOnlyMapGraphManager from_scratch_manager;
+	for (int i_local_map = 0; i_local_map < 5; i_local_map++) AddLocalMap(from_scratch_manager);
+	for (int i_local_map = 0; i_local_map < 4; i_local_map++) AddConstraint(from_scratch_manager, i_local_map, i_local_map + 1, 0.01f);
+	AddConstraint(from_scratch_manager, 4, 0, -0.02f);
+	PoseOnlyMapGraphManager incremental_manager = from_scratch_manager;
+
+	GlobalAdjustmentEngine from_scratch_engine(false);
+	GlobalAdjustmentEngine incremental_engine(true);
+
+	ORUtils::SE3Pose initial_pose_4 = from_scratch_manager.getEstimatedGlobalPose(4);
+	BOOST_REQUIRE(Adjust(from_scratch_engine, from_scratch_manager));
+	BOOST_REQUIRE(Adjust(incremental_engine, incremental_manager));
+	BOOST_REQUIRE(from_scratch_manager.getEstimatedGlobalPose(4).GetM() != initial_pose_4.GetM());
+	RequireSamePoses(from_scratch_manager, incremental_manager);
+
+	// nothing changed since the last run: the incremental engine has nothing to do
+	BOOST_REQUIRE(!Adjust(incremental_engine, incremental_manager));
+	BOOST_REQUIRE(!incremental_engine.hasNewEstimates());
+
+	// new local map with a new loop closure, plus another observation of an existing constraint
+	for (PoseOnlyMapGraphManager* manager : {&from_scratch_manager, &incremental_manager}) {
+		AddLocalMap(*manager);
+		AddConstraint(*manager, 4, 5, 0.005f);
+		AddConstraint(*manager, 5, 1, -0.01f);
+		AddConstraint(*manager, 1, 2, -0.01f);
+	}
+	BOOST_REQUIRE(Adjust(from_scratch_engine, from_scratch_manager));
+	BOOST_REQUIRE(Adjust(incremental_engine, incremental_manager));
+	RequireSamePoses(from_scratch_manager, incremental_manager);
+
+	// removal of the newest local map along with its constraints
+	for (PoseOnlyMapGraphManager* manager : {&from_scratch_manager, &incremental_manager}) {
+		manager->removeLocalMap(5);
+	}
+	BOOST_REQUIRE(Adjust(from_scratch_engine, from_scratch_manager));
+	BOOST_REQUIRE(Adjust(incremental_engine, incremental_manager));
+	RequireSamePoses(from_scratch_manager, incremental_manager);
+}
+
+BOOST_AUTO_TEST_CASE(Test_GlobalAdjustment_IncrementalSeparateThread) {
+	PoseOnlyMapGraphManager manager;
+	for (int i_local_map = 0; i_local_map < 4; i_local_map++) AddLocalMap(manager);
+	for (int i_local_map = 0; i_local_map < 3; i_local_map++) AddConstraint(manager, i_local_map, i_local_map + 1, 0.01f);
+	AddConstraint(manager, 3, 0, 0.01f);
+	PoseOnlyMapGraphManager reference_manager = manager;
+
+	GlobalAdjustmentEngine reference_engine(false);
+	BOOST_REQUIRE(Adjust(reference_engine, reference_manager));
+
+	GlobalAdjustmentEngine engine(true);
+	BOOST_REQUIRE(engine.startSeparateThread());
+	while (!engine.updateMeasurements(manager)) {}
+	engine.wakeupSeparateThread();
+	for (int i_wait = 0; i_wait < 10000 && !engine.hasNewEstimates(); i_wait++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	BOOST_REQUIRE(engine.stopSeparateThread());
+	BOOST_REQUIRE(engine.hasNewEstimates());
+	BOOST_REQUIRE(engine.retrieveNewEstimates(manager));
+	RequireSamePoses(reference_manager, manager);
+}
@@ -0,0 +1,232 @@
+#define BOOST_TEST_MODULE GlobalCache
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/GlobalTemplateDefines.h"
+#include "../ITMLib/Objects/Volume/GlobalCache.h"
+#include "../ITMLib/Objects/Volume/VoxelVolume.h"
+#include "../ITMLib/Engines/Indexing/VBH/CPU/IndexingEngine_VoxelBlockHash_CPU.h"
+#include "../ITMLib/Engines/Swapping/CPU/SwappingEngine_CPU.h"
+#include "../ITMLib/Utils/Configuration/Configuration.h"
+
+using namespace ITMLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::vector<TSDFVoxel_f_flags> MakeTestBlock(int seed) {
+	std::vector<TSDFVoxel_f_flags> block(VOXEL_BLOCK_SIZE3);
+	for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) {
+		block[i_voxel].sdf = static_cast<float>(seed) + static_cast<float>(i_voxel) * 0.001f;
+		block[i_voxel].w_depth = static_cast<unsigned char>((seed + i_voxel) % 256);
+	}
+	return block;
+}
+
+bool BlockMatches(const TSDFVoxel_f_flags* block, int seed) {
+	std::vector<TSDFVoxel_f_flags> expected = MakeTestBlock(seed);
+	for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) {
+		if (block[i_voxel].sdf != expected[i_voxel].sdf || block[i_voxel].w_depth != expected[i_voxel].w_depth) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Test_GlobalCache_PagesBlocksBeyondBudgetToDisk) {
+	const int hash_entry_count = 0x1000;
+	const int host_block_budget = 8;
+	const int block_count = 50;
+	const fs::path spill_directory = fs::temp_directory_path() / "global_cache_test_spill";
+	{
+		GlobalCache<TSDFVoxel_f_flags, VoxelBlockHash> global_cache(hash_entry_count, host_block_budget,
+		                                                             spill_directory.string());
+		const SparseVoxelBlockStore<TSDFVoxel_f_flags>& store = global_cache.GetStoredVoxelBlocks();
+		BOOST_REQUIRE_EQUAL(store.GetResidentBlockCount(), 0);
+
+		// every 7th hash code, so that stored blocks are scattered across the hash table
+		for (int i_block = 0; i_block < block_count; i_block++) {
+			global_cache.SetStoredData(i_block * 7, MakeTestBlock(i_block).data());
+		}
+		BOOST_REQUIRE_EQUAL(store.GetStoredBlockCount(), block_count);
+		BOOST_REQUIRE_EQUAL(store.GetResidentBlockCount(), host_block_budget);
+		BOOST_REQUIRE_EQUAL(store.GetSpilledBlockCount(), block_count - host_block_budget);
+		BOOST_REQUIRE(!global_cache.HasStoredData(1));
+		BOOST_REQUIRE(global_cache.GetStoredVoxelBlock(1) == nullptr);
+
+		// read everything back (twice, in opposite orders), paging blocks in and out along the way
+		for (int i_block = 0; i_block < block_count; i_block++) {
+			BOOST_REQUIRE(global_cache.HasStoredData(i_block * 7));
+			BOOST_REQUIRE(BlockMatches(global_cache.GetStoredVoxelBlock(i_block * 7), i_block));
+		}
+		for (int i_block = block_count - 1; i_block >= 0; i_block--) {
+			BOOST_REQUIRE(BlockMatches(global_cache.GetStoredVoxelBlock(i_block * 7), i_block));
+		}
+		BOOST_REQUIRE_EQUAL(store.GetResidentBlockCount(), host_block_budget);
+		// blocks unchanged since they were paged in are not written out again
+		BOOST_REQUIRE_EQUAL(store.GetSpilledBlockCount(), block_count);
+
+		// overwrite blocks that are currently paged out
+		for (int i_block = 0; i_block < block_count; i_block += 5) {
+			global_cache.SetStoredData(i_block * 7, MakeTestBlock(i_block + 1000).data());
+		}
+		BOOST_REQUIRE_EQUAL(store.GetStoredBlockCount(), block_count);
+		for (int i_block = 0; i_block < block_count; i_block++) {
+			BOOST_REQUIRE(BlockMatches(global_cache.GetStoredVoxelBlock(i_block * 7),
+			                           i_block % 5 == 0 ? i_block + 1000 : i_block));
+		}
+		BOOST_REQUIRE_EQUAL(store.GetSpilledBlockCount(), block_count);
+
+		const std::string cache_path = (spill_directory / "global_cache.dat").string();
+		global_cache.SaveToFile(cache_path);
+		GlobalCache<TSDFVoxel_f_flags, VoxelBlockHash> loaded_cache(hash_entry_count, 0, spill_directory.string());
+		loaded_cache.ReadFromFile(cache_path);
+		BOOST_REQUIRE_EQUAL(loaded_cache.GetStoredVoxelBlocks().GetStoredBlockCount(), block_count);
+		BOOST_REQUIRE_EQUAL(loaded_cache.GetStoredVoxelBlocks().GetSpilledBlockCount(), 0);
+		for (int i_block = 0; i_block < block_count; i_block++) {
+			BOOST_REQUIRE(BlockMatches(loaded_cache.GetStoredVoxelBlock(i_block * 7),
+			                           i_block % 5 == 0 ? i_block + 1000 : i_block));
+		}
+		fs::remove(cache_path);
+	}
+	// the spill file goes away with the cache
+	BOOST_REQUIRE(fs::is_empty(spill_directory));
+	fs::remove(spill_directory);
+}
+
+BOOST_AUTO_TEST_CASE(Test_SwappingEngine_CPU_SwapsInvisibleBlocksOutAndBackInWithinBudget) {
+	const int block_count = 24;
+	const int block_budget_per_frame = 5;
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(configuration::Get().general_voxel_volume_parameters, true,
+	                                              MEMORYDEVICE_CPU, VoxelBlockHashParameters(0x800, 0x800));
+	volume.Reset();
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>& indexer =
+			IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	ORUtils::MemoryBlock<Vector3s> block_positions(block_count, MEMORYDEVICE_CPU);
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		block_positions.GetData(MEMORYDEVICE_CPU)[i_block] = Vector3s(i_block, 0, 0);
+	}
+	indexer.AllocateBlockList(&volume, block_positions, block_count);
+	BOOST_REQUIRE_EQUAL(volume.index.GetUtilizedBlockCount(), block_count);
+
+	// blocks with odd x are out of view, and all blocks hold their most recent data in active memory
+	std::vector<int> hash_codes(block_count);
+	HashEntry* hash_table = volume.index.GetEntries();
+	HashBlockVisibility* visibility_types = volume.index.GetBlockVisibilityTypes();
+	HashSwapState* swap_states = volume.global_cache.GetSwapStates(false);
+	TSDFVoxel* voxels = volume.GetVoxels();
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		indexer.FindHashEntry(volume.index, Vector3s(i_block, 0, 0), hash_codes[i_block]);
+		TSDFVoxel* block = voxels + hash_table[hash_codes[i_block]].ptr * VOXEL_BLOCK_SIZE3;
+		for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) {
+			block[i_voxel].sdf = -0.5f + 0.01f * static_cast<float>(i_block);
+			block[i_voxel].w_depth = 1;
+		}
+		visibility_types[hash_codes[i_block]] = i_block % 2 == 0 ? IN_MEMORY_AND_VISIBLE : INVISIBLE;
+		swap_states[hash_codes[i_block]].state = 2;
+	}
+
+	SwappingEngine_CPU<TSDFVoxel, VoxelBlockHash> swapping_engine(VoxelBlockHashParameters(0x800, 0x800),
+	                                                               block_budget_per_frame);
+	const int invisible_block_count = block_count / 2;
+	const int initial_last_free_block_id = volume.index.GetLastFreeBlockListId();
+	// the budget goes to the candidates with the lowest hash codes, regardless of thread scheduling
+	std::vector<int> invisible_hash_codes;
+	for (int i_block = 1; i_block < block_count; i_block += 2) invisible_hash_codes.push_back(hash_codes[i_block]);
+	std::sort(invisible_hash_codes.begin(), invisible_hash_codes.end());
+	for (int i_frame = 1; i_frame <= 3; i_frame++) {
+		swapping_engine.SaveToGlobalMemory(&volume, nullptr);
+		const int swapped_out_count = std::min(i_frame * block_budget_per_frame, invisible_block_count);
+		BOOST_REQUIRE_EQUAL(volume.index.GetUtilizedBlockCount(), block_count - swapped_out_count);
+		BOOST_REQUIRE_EQUAL(volume.index.GetLastFreeBlockListId(), initial_last_free_block_id + swapped_out_count);
+		for (int i_invisible = 0; i_invisible < invisible_block_count; i_invisible++) {
+			BOOST_REQUIRE_EQUAL(hash_table[invisible_hash_codes[i_invisible]].ptr == -1, i_invisible < swapped_out_count);
+		}
+	}
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		const int hash_code = hash_codes[i_block];
+		if (i_block % 2 == 0) {
+			BOOST_REQUIRE_GE(hash_table[hash_code].ptr, 0);
+			BOOST_REQUIRE_EQUAL(swap_states[hash_code].state, 2);
+			BOOST_REQUIRE(!volume.global_cache.HasStoredData(hash_code));
+		} else {
+			BOOST_REQUIRE_EQUAL(hash_table[hash_code].ptr, -1);
+			BOOST_REQUIRE_EQUAL(swap_states[hash_code].state, 0);
+			BOOST_REQUIRE(volume.global_cache.HasStoredData(hash_code));
+			BOOST_REQUIRE_EQUAL(volume.global_cache.GetStoredVoxelBlock(hash_code)[0].sdf,
+			                    -0.5f + 0.01f * static_cast<float>(i_block));
+		}
+	}
+
+	// the swapped-out blocks come back into view: give them fresh (empty) blocks & mark them for swapping in
+	int last_free_block_id = volume.index.GetLastFreeBlockListId();
+	const int* block_allocation_list = volume.index.GetBlockAllocationList();
+	int* visible_block_hash_codes = volume.index.GetVisibleBlockHashCodes();
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		const int hash_code = hash_codes[i_block];
+		if (i_block % 2 == 1) {
+			hash_table[hash_code].ptr = block_allocation_list[last_free_block_id--];
+			swap_states[hash_code].state = 1;
+		}
+		visibility_types[hash_code] = IN_MEMORY_AND_VISIBLE;
+		visible_block_hash_codes[i_block] = hash_code;
+	}
+	volume.index.SetLastFreeBlockListId(last_free_block_id);
+	volume.index.SetVisibleBlockCount(block_count);
+
+	for (int i_frame = 1; i_frame <= 3; i_frame++) {
+		swapping_engine.IntegrateGlobalIntoLocal(&volume, nullptr);
+		int swapped_in_count = 0;
+		for (int i_block = 1; i_block < block_count; i_block += 2) {
+			if (swap_states[hash_codes[i_block]].state == 2) swapped_in_count++;
+		}
+		BOOST_REQUIRE_EQUAL(swapped_in_count, std::min(i_frame * block_budget_per_frame, invisible_block_count));
+	}
+	for (int i_block = 1; i_block < block_count; i_block += 2) {
+		const TSDFVoxel* block = voxels + hash_table[hash_codes[i_block]].ptr * VOXEL_BLOCK_SIZE3;
+		for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) {
+			BOOST_REQUIRE_CLOSE(block[i_voxel].sdf, -0.5f + 0.01f * static_cast<float>(i_block), 1e-4f);
+			BOOST_REQUIRE_EQUAL(block[i_voxel].w_depth, 1);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Test_SwappingEngine_CPU_NonPositiveBudgetMeansNoLimit) {
+	const int block_count = 24;
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(configuration::Get().general_voxel_volume_parameters, true,
+	                                              MEMORYDEVICE_CPU, VoxelBlockHashParameters(0x800, 0x800));
+	volume.Reset();
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>& indexer =
+			IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	ORUtils::MemoryBlock<Vector3s> block_positions(block_count, MEMORYDEVICE_CPU);
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		block_positions.GetData(MEMORYDEVICE_CPU)[i_block] = Vector3s(i_block, 0, 0);
+	}
+	indexer.AllocateBlockList(&volume, block_positions, block_count);
+
+	// none of the blocks are in view
+	HashBlockVisibility* visibility_types = volume.index.GetBlockVisibilityTypes();
+	HashSwapState* swap_states = volume.global_cache.GetSwapStates(false);
+	for (int i_block = 0; i_block < block_count; i_block++) {
+		int hash_code;
+		indexer.FindHashEntry(volume.index, Vector3s(i_block, 0, 0), hash_code);
+		visibility_types[hash_code] = INVISIBLE;
+		swap_states[hash_code].state = 2;
+	}
+
+	SwappingEngine_CPU<TSDFVoxel, VoxelBlockHash> swapping_engine(VoxelBlockHashParameters(0x800, 0x800), 0);
+	swapping_engine.SaveToGlobalMemory(&volume, nullptr);
+	BOOST_REQUIRE_EQUAL(volume.index.GetUtilizedBlockCount(), 0);
+}
@@ -38,6 +38,7 @@
 #include "../ITMLib/Utils/Collections/MemoryBlock_StdContainer_Convertions.h"
 //(CPU)
 #include "../ITMLib/Engines/Indexing/VBH/CPU/IndexingEngine_VoxelBlockHash_CPU.h"
+#include "../ITMLib/Engines/Indexing/VBH/CPU/IndexingEngine_ConcurrentHashInsertion_CPU.h"
 #include "../ITMLib/Engines/Analytics/AnalyticsEngine.h"
 //(CUDA)
 #ifndef COMPILE_WITHOUT_CUDA
@@ -182,6 +183,120 @@ BOOST_FIXTURE_TEST_CASE(TestAllocateHashBlockList_CPU, CollisionHashFixture) {
 	                      "Bucket code " << bad_hash_code << " was not allocated in the spatial hash. Seed: " << seed);
 }
 
+BOOST_FIXTURE_TEST_CASE(TestConcurrentHashBlockInsertion_CPU, CollisionHashFixture) {
+	const int excess_list_size = 0x6FFFF;
+	BOOST_TEST_CONTEXT("Seed: " << seed);
+	BOOST_REQUIRE_GE(excess_list_size, required_max_excess_list_size);
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(MEMORYDEVICE_CPU, {0x80000, excess_list_size});
+	volume.Reset();
+
+	// every position gets inserted twice, so that threads also race to insert the very same block
+	std::vector<Vector3s> positions_to_insert(block_positions);
+	positions_to_insert.insert(positions_to_insert.end(), block_positions.begin(), block_positions.end());
+	const int insertion_count = static_cast<int>(positions_to_insert.size());
+	std::vector<int> resulting_hash_codes(insertion_count);
+	const Vector3s* position_data = positions_to_insert.data();
+	int* hash_code_data = resulting_hash_codes.data();
+
+	internal::ConcurrentHashBlockInserter_CPU inserter(volume.index);
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(inserter, position_data, hash_code_data) firstprivate(insertion_count)
+#endif
+	for (int i_insertion = 0; i_insertion < insertion_count; i_insertion++) {
+		hash_code_data[i_insertion] = inserter.FindOrAllocate(position_data[i_insertion]);
+	}
+	inserter.UpdateIndexCounters(volume.index);
+	BOOST_REQUIRE(!inserter.RanOutOfSpace());
+
+	const HashEntry* hash_table = volume.index.GetEntries();
+	for (int i_insertion = 0; i_insertion < insertion_count; i_insertion++) {
+		BOOST_REQUIRE_NE(resulting_hash_codes[i_insertion], -1);
+		BOOST_REQUIRE_EQUAL(hash_table[resulting_hash_codes[i_insertion]].pos, positions_to_insert[i_insertion]);
+		BOOST_REQUIRE_EQUAL(FindHashCodeAt(hash_table, positions_to_insert[i_insertion]), resulting_hash_codes[i_insertion]);
+	}
+
+	BOOST_REQUIRE_EQUAL(Analytics_CPU_VBH_Voxel::Instance().CountAllocatedHashBlocks(&volume), block_positions.size());
+	BOOST_REQUIRE_EQUAL(volume.index.GetUtilizedBlockCount(), block_positions.size());
+	BOOST_REQUIRE_EQUAL(volume.index.GetLastFreeBlockListId(),
+	                    volume.index.voxel_block_count - 1 - static_cast<int>(block_positions.size()));
+	const int* utilized_hash_codes = volume.index.GetUtilizedBlockHashCodes();
+	std::unordered_set<int> utilized_hash_code_set(utilized_hash_codes,
+	                                              utilized_hash_codes + volume.index.GetUtilizedBlockCount());
+	BOOST_REQUIRE_EQUAL(utilized_hash_code_set.size(), block_positions.size());
+}
+
+BOOST_AUTO_TEST_CASE(TestConcurrentHashBlockInsertion_OutOfSpace_CPU) {
+	// gather pairs of blocks that fall into the same hash bucket, so that half of them need excess entries
+	std::unordered_map<int, std::vector<Vector3s>> positions_by_hash_code;
+	for (short z = -32; z < 32; z++) {
+		for (short y = -32; y < 32; y++) {
+			for (short x = -32; x < 32; x++) {
+				Vector3s position(x, y, z);
+				positions_by_hash_code[HashCodeFromBlockPosition(position)].push_back(position);
+			}
+		}
+	}
+	const int bucket_count = 2000;
+	std::vector<Vector3s> positions_to_insert;
+	for (const auto& bucket : positions_by_hash_code) {
+		if (bucket.second.size() < 2) continue;
+		positions_to_insert.insert(positions_to_insert.end(), bucket.second.begin(), bucket.second.begin() + 2);
+		if (static_cast<int>(positions_to_insert.size()) == 2 * bucket_count) break;
+	}
+	BOOST_REQUIRE_EQUAL(static_cast<int>(positions_to_insert.size()), 2 * bucket_count);
+	// every position gets inserted twice, so that threads also race to insert the very same block
+	positions_to_insert.insert(positions_to_insert.end(), positions_to_insert.begin(), positions_to_insert.end());
+	const int insertion_count = static_cast<int>(positions_to_insert.size());
+	const Vector3s* position_data = positions_to_insert.data();
+
+	// the excess list runs out early on, while blocks are still being popped for the ordered entries, and then the
+	// voxel blocks run out as well
+	const int voxel_block_count = bucket_count + 50;
+	const int excess_list_size = 100;
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(MEMORYDEVICE_CPU, {voxel_block_count, excess_list_size});
+
+	for (int i_round = 0; i_round < 10; i_round++) {
+		volume.Reset();
+		std::vector<int> resulting_hash_codes(insertion_count);
+		int* hash_code_data = resulting_hash_codes.data();
+
+		internal::ConcurrentHashBlockInserter_CPU inserter(volume.index);
+#ifdef WITH_OPENMP
+#pragma omp parallel for default(none) shared(inserter, position_data, hash_code_data) firstprivate(insertion_count) \
+num_threads(16) schedule(dynamic, 1)
+#endif
+		for (int i_insertion = 0; i_insertion < insertion_count; i_insertion++) {
+			hash_code_data[i_insertion] = inserter.FindOrAllocate(position_data[i_insertion]);
+		}
+		inserter.UpdateIndexCounters(volume.index);
+		BOOST_REQUIRE(inserter.RanOutOfSpace());
+		BOOST_REQUIRE_GE(volume.index.GetLastFreeBlockListId(), -1);
+		BOOST_REQUIRE_GE(volume.index.GetLastFreeExcessListId(), -1);
+
+		const HashEntry* hash_table = volume.index.GetEntries();
+		for (int i_insertion = 0; i_insertion < insertion_count; i_insertion++) {
+			if (resulting_hash_codes[i_insertion] == -1) continue;
+			BOOST_REQUIRE_EQUAL(hash_table[resulting_hash_codes[i_insertion]].pos, positions_to_insert[i_insertion]);
+		}
+
+		std::vector<int> allocated_hash_codes = Analytics_CPU_VBH_Voxel::Instance().GetAllocatedHashCodes(&volume);
+		std::unordered_set<int> block_pointers;
+		int excess_entry_count = 0;
+		for (int hash_code : allocated_hash_codes) {
+			const int block_pointer = hash_table[hash_code].ptr;
+			BOOST_REQUIRE_GE(block_pointer, 0);
+			BOOST_REQUIRE_LT(block_pointer, voxel_block_count);
+			BOOST_REQUIRE_MESSAGE(block_pointers.insert(block_pointer).second,
+			                      "Voxel block " << block_pointer << " was handed out to more than one hash entry.");
+			if (hash_code >= ORDERED_LIST_SIZE) excess_entry_count++;
+		}
+		const int allocated_block_count = static_cast<int>(allocated_hash_codes.size());
+		BOOST_REQUIRE_EQUAL(allocated_block_count, voxel_block_count - 1 - volume.index.GetLastFreeBlockListId());
+		BOOST_REQUIRE_LE(excess_entry_count, excess_list_size - 1 - volume.index.GetLastFreeExcessListId());
+		BOOST_REQUIRE_EQUAL(volume.index.GetUtilizedBlockCount(), allocated_block_count);
+	}
+}
+
 BOOST_FIXTURE_TEST_CASE(TestDeallocateHashBlockList_CPU, CollisionHashFixture) {
 
 	// for sorting later
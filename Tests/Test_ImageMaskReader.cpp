@@ -24,6 +24,15 @@
 
 //stdlib
 #include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <thread>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //boost
 #include <boost/test/unit_test.hpp>
@@ -31,6 +40,7 @@
 //test targets
 #include "../ORUtils/FileUtils.h"
 #include "../InputSource/ImageSourceEngine.h"
+#include "../InputSource/PrefetchingImageFileReader.h"
 
 //test_utils
 #include "TestUtilities/TestDataUtilities.h"
@@ -76,4 +86,101 @@ BOOST_REQUIRE(ReadImageFromFile(masked_rgb_ground_truth, STATIC_TEST_DATA_PREFIX
 	BOOST_REQUIRE(rgb == masked_rgb_ground_truth);
 	BOOST_REQUIRE(depth == masked_depth_ground_truth);
 
-}
\ No newline at end of file
+}
+
+static InputSource::ImageMaskPathGenerator SnoopyMaskedFramePathGenerator() {
+	return InputSource::ImageMaskPathGenerator(
+			STATIC_TEST_DATA_PREFIX "TestData/frames/snoopy_color_%06i.png",
+			STATIC_TEST_DATA_PREFIX "TestData/frames/snoopy_depth_%06i.png",
+			STATIC_TEST_DATA_PREFIX "TestData/frames/snoopy_omask_%06i.png");
+}
+
+BOOST_AUTO_TEST_CASE(testPrefetchingImageFileReader) {
+	using namespace InputSource;
+	// frames 16 through 18 are available, so read until the sequence runs out
+	ImageFileReader<ImageMaskPathGenerator> reader(std::string(test::snoopy::calibration_path).c_str(),
+	                                               SnoopyMaskedFramePathGenerator(), 16);
+	PrefetchingImageFileReader<ImageMaskPathGenerator> prefetching_reader(
+			std::string(test::snoopy::calibration_path).c_str(), SnoopyMaskedFramePathGenerator(), 16, 2, 2);
+
+	BOOST_REQUIRE_EQUAL(prefetching_reader.GetRGBImageSize(), reader.GetRGBImageSize());
+	BOOST_REQUIRE_EQUAL(prefetching_reader.GetDepthImageSize(), reader.GetDepthImageSize());
+
+	UChar4Image rgb(true, false), prefetched_rgb(true, false);
+	ShortImage depth(true, false), prefetched_depth(true, false);
+	for (int i_frame = 0; i_frame < 3; i_frame++) {
+		BOOST_REQUIRE(prefetching_reader.HasMoreImages());
+		reader.GetImages(rgb, depth);
+		prefetching_reader.GetImages(prefetched_rgb, prefetched_depth);
+		BOOST_REQUIRE(prefetched_rgb == rgb);
+		BOOST_REQUIRE(prefetched_depth == depth);
+	}
+	BOOST_REQUIRE(!prefetching_reader.HasMoreImages());
+}
+
+BOOST_AUTO_TEST_CASE(testSkipImages) {
+	using namespace InputSource;
+	ImageFileReader<ImageMaskPathGenerator> reader(std::string(test::snoopy::calibration_path).c_str(),
+	                                               SnoopyMaskedFramePathGenerator(), 18);
+	ImageFileReader<ImageMaskPathGenerator> skipping_reader(std::string(test::snoopy::calibration_path).c_str(),
+	                                                        SnoopyMaskedFramePathGenerator(), 16);
+	PrefetchingImageFileReader<ImageMaskPathGenerator> prefetching_reader(
+			std::string(test::snoopy::calibration_path).c_str(), SnoopyMaskedFramePathGenerator(), 16);
+
+	skipping_reader.SkipImages(2);
+	prefetching_reader.SkipImages(2);
+
+	UChar4Image rgb(true, false), skipped_rgb(true, false), prefetched_rgb(true, false);
+	ShortImage depth(true, false), skipped_depth(true, false), prefetched_depth(true, false);
+	reader.GetImages(rgb, depth);
+	skipping_reader.GetImages(skipped_rgb, skipped_depth);
+	prefetching_reader.GetImages(prefetched_rgb, prefetched_depth);
+	BOOST_REQUIRE(skipped_rgb == rgb);
+	BOOST_REQUIRE(skipped_depth == depth);
+	BOOST_REQUIRE(prefetched_rgb == rgb);
+	BOOST_REQUIRE(prefetched_depth == depth);
+
+	// skipping past the end of the sequence
+	prefetching_reader.SkipImages(5);
+	BOOST_REQUIRE(!prefetching_reader.HasMoreImages());
+}
+
+#ifndef WIN32
+BOOST_AUTO_TEST_CASE(testSkipPastEndDuringDecode) {
+	using namespace InputSource;
+	// the only frame is read from a named pipe, which keeps the decode of that frame running until the test closes
+	// the pipe, so that the read position can be moved past the end of the sequence in the meantime
+	const std::string pipe_path = (std::filesystem::temp_directory_path() / "prefetching_reader_test_pipe.png").string();
+	std::filesystem::remove(pipe_path);
+	BOOST_REQUIRE(mkfifo(pipe_path.c_str(), 0600) == 0);
+
+	std::promise<void> decode_started, skip_done;
+	std::thread pipe_writer([&pipe_path, &decode_started, &skip_done] {
+		// opening the write end blocks until the decoding worker has opened the read end
+		const int pipe_descriptor = open(pipe_path.c_str(), O_WRONLY);
+		decode_started.set_value();
+		skip_done.get_future().wait();
+		// give the reader time to start waiting on the frame it was moved to
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		// the image reader opens the file once more if it doesn't find a PNM header, so swap in an empty regular file
+		// for it before letting the first read hit the end of the pipe
+		const std::string empty_file_path = pipe_path + ".empty";
+		std::ofstream(empty_file_path).close();
+		std::filesystem::rename(empty_file_path, pipe_path);
+		close(pipe_descriptor);
+	});
+
+	{
+		ImageListPathGenerator path_generator({pipe_path}, {pipe_path + ".missing"});
+		PrefetchingImageFileReader<ImageListPathGenerator> prefetching_reader(
+				std::string(test::snoopy::calibration_path).c_str(), path_generator, 0, 2, 1);
+		decode_started.get_future().wait();
+		prefetching_reader.SkipImages(3);
+		skip_done.set_value();
+		// frame 0 turns out to be invalid only after the skip; this must not wait forever
+		BOOST_REQUIRE(!prefetching_reader.HasMoreImages());
+	}
+	pipe_writer.join();
+	std::filesystem::remove(pipe_path);
+}
+#endif
@@ -18,6 +18,13 @@
 #define BOOST_TEST_DYN_LINK
 #endif
 
+//stdlib
+#include <cstring>
+#include <string>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 //boost
 #include <boost/test/unit_test.hpp>
 
@@ -27,9 +34,13 @@
 
 //ORUtils
 #include "../ORUtils/IStreamWrapper.h"
+#include "../ORUtils/FileUtils.h"
 
 //ITMLib
 #include "../ITMLib/Engines/ImageProcessing/ImageProcessingEngineFactory.h"
+#include "../ITMLib/Engines/ImageProcessing/CPU/LowLevelEngine_CPU.h"
+#include "../ITMLib/Engines/ViewBuilder/CPU/ViewBuilder_CPU.h"
+#include "../ITMLib/Objects/Camera/CalibIO.h"
 #include "../ITMLib/Utils/Analytics/RawArrayComparison.h"
 #include "../ITMLib/Utils/Collections/OperationsOnSTLContainers.h"
 #include "../ITMLib/Utils/Collections/MemoryBlock_StdContainer_Convertions.h"
@@ -44,4 +55,93 @@ void GenericFilterSubsampleTest() {
 
 BOOST_AUTO_TEST_CASE(Test_GenericFilterSubsampleTest_CPU) {
 	GenericFilterSubsampleTest<MEMORYDEVICE_CPU>();
-}
\ No newline at end of file
+}
+namespace {
+
+template<typename TElement>
+void RequireImagesBitwiseEqual(const ORUtils::Image<TElement>& image1, const ORUtils::Image<TElement>& image2) {
+	BOOST_REQUIRE_EQUAL(image1.dimensions, image2.dimensions);
+	BOOST_REQUIRE(std::memcmp(image1.GetData(MEMORYDEVICE_CPU), image2.GetData(MEMORYDEVICE_CPU),
+	                          image1.size() * sizeof(TElement)) == 0);
+}
+
+// outputs of all CPU image processing & depth preprocessing kernels for one snoopy frame
+struct SnoopyFrameProcessingOutputs_CPU {
+	explicit SnoopyFrameProcessingOutputs_CPU(int thread_count) {
+#ifdef WITH_OPENMP
+		const int previous_thread_count = omp_get_max_threads();
+		omp_set_num_threads(thread_count);
+#endif
+		RGBD_CalibrationInformation calibration_data;
+		readRGBDCalib(std::string(snoopy::calibration_path).c_str(), calibration_data);
+		UChar4Image rgb(true, false);
+		ShortImage raw_depth(true, false);
+		BOOST_REQUIRE(ReadImageFromFile(rgb, std::string(snoopy::frame_16_color_path).c_str()));
+		BOOST_REQUIRE(ReadImageFromFile(raw_depth, std::string(snoopy::frame_16_depth_path).c_str()));
+
+		LowLevelEngine_CPU image_processing_engine;
+		image_processing_engine.ConvertColourToIntensity(intensity, rgb);
+		image_processing_engine.FilterIntensity(filtered_intensity, intensity);
+		image_processing_engine.FilterSubsample(subsampled_rgb, rgb);
+		image_processing_engine.FilterSubsample(subsampled_intensity, filtered_intensity);
+		image_processing_engine.GradientX(gradient_x, rgb);
+		image_processing_engine.GradientY(gradient_y, rgb);
+		image_processing_engine.GradientXY(gradient_xy, filtered_intensity);
+
+		ViewBuilder_CPU view_builder(calibration_data);
+		const Vector2i depth_dimensions = raw_depth.dimensions;
+		for (FloatImage* image : {&depth, &disparity_depth, &bilateral_filtered_depth, &threshold_filtered_depth, &sigma_z}) {
+			image->ChangeDims(depth_dimensions);
+			image->Clear();
+		}
+		normals.ChangeDims(depth_dimensions);
+		normals.Clear();
+		view_builder.ConvertDepthAffineToFloat(depth, raw_depth, calibration_data.disparityCalib.GetParams());
+		view_builder.ConvertDisparityToDepth(disparity_depth, raw_depth, calibration_data.intrinsics_d,
+		                                     calibration_data.disparityCalib.GetParams());
+		view_builder.DepthFiltering(bilateral_filtered_depth, depth);
+		view_builder.ThresholdFiltering(threshold_filtered_depth, depth);
+		view_builder.ComputeNormalAndWeights(normals, sigma_z, depth, calibration_data.intrinsics_d.projectionParamsSimple.all);
+		image_processing_engine.FilterSubsampleWithHoles(subsampled_depth, depth);
+		image_processing_engine.FilterSubsampleWithHoles(subsampled_normals, normals);
+		valid_depth_count = image_processing_engine.CountValidDepths(depth);
+#ifdef WITH_OPENMP
+		omp_set_num_threads(previous_thread_count);
+#endif
+	}
+
+	FloatImage intensity{true, false}, filtered_intensity{true, false}, subsampled_intensity{true, false};
+	UChar4Image subsampled_rgb{true, false};
+	Short4Image gradient_x{true, false}, gradient_y{true, false};
+	Float2Image gradient_xy{true, false};
+	FloatImage depth{true, false}, disparity_depth{true, false}, bilateral_filtered_depth{true, false},
+			threshold_filtered_depth{true, false}, sigma_z{true, false}, subsampled_depth{true, false};
+	Float4Image normals{true, false}, subsampled_normals{true, false};
+	int valid_depth_count = 0;
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Test_ImageProcessing_CPU_MultiThreadedMatchesSingleThreaded) {
+	// the kernels split work by rows, so results must not depend on how many threads the rows are spread across
+	SnoopyFrameProcessingOutputs_CPU single_threaded(1);
+	SnoopyFrameProcessingOutputs_CPU multi_threaded(4);
+
+	RequireImagesBitwiseEqual(single_threaded.intensity, multi_threaded.intensity);
+	RequireImagesBitwiseEqual(single_threaded.filtered_intensity, multi_threaded.filtered_intensity);
+	RequireImagesBitwiseEqual(single_threaded.subsampled_intensity, multi_threaded.subsampled_intensity);
+	RequireImagesBitwiseEqual(single_threaded.subsampled_rgb, multi_threaded.subsampled_rgb);
+	RequireImagesBitwiseEqual(single_threaded.gradient_x, multi_threaded.gradient_x);
+	RequireImagesBitwiseEqual(single_threaded.gradient_y, multi_threaded.gradient_y);
+	RequireImagesBitwiseEqual(single_threaded.gradient_xy, multi_threaded.gradient_xy);
+	RequireImagesBitwiseEqual(single_threaded.depth, multi_threaded.depth);
+	RequireImagesBitwiseEqual(single_threaded.disparity_depth, multi_threaded.disparity_depth);
+	RequireImagesBitwiseEqual(single_threaded.bilateral_filtered_depth, multi_threaded.bilateral_filtered_depth);
+	RequireImagesBitwiseEqual(single_threaded.threshold_filtered_depth, multi_threaded.threshold_filtered_depth);
+	RequireImagesBitwiseEqual(single_threaded.sigma_z, multi_threaded.sigma_z);
+	RequireImagesBitwiseEqual(single_threaded.normals, multi_threaded.normals);
+	RequireImagesBitwiseEqual(single_threaded.subsampled_depth, multi_threaded.subsampled_depth);
+	RequireImagesBitwiseEqual(single_threaded.subsampled_normals, multi_threaded.subsampled_normals);
+	BOOST_REQUIRE_EQUAL(single_threaded.valid_depth_count, multi_threaded.valid_depth_count);
+	BOOST_REQUIRE_GT(single_threaded.valid_depth_count, 0);
+}
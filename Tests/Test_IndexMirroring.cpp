@@ -0,0 +1,150 @@
+#define BOOST_TEST_MODULE IndexMirroring
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <atomic>
+#include <functional>
+#include <set>
+#include <tuple>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/GlobalTemplateDefines.h"
+#include "../ITMLib/Objects/Volume/VoxelVolume.h"
+#include "../ITMLib/Engines/DepthFusion/DepthFusionEngine.h"
+#include "../ITMLib/Engines/Indexing/VBH/CPU/IndexingEngine_VoxelBlockHash_CPU.h"
+#include "../ITMLib/Engines/Traversal/CPU/TwoVolumeTraversal_CPU_VoxelBlockHash.h"
+//test_utilities
+#include "TestUtilities/SquareViewsFixture.h"
+
+using namespace ITMLib;
+using namespace test;
+
+typedef SquareViewsFixture<MEMORYDEVICE_CPU> SquareViewsFixture_CPU;
+
+BOOST_FIXTURE_TEST_CASE(Test_MirrorIndexOfOtherVolume_CPU, SquareViewsFixture_CPU) {
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> source_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	source_volume.Reset();
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>& indexer = IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	indexer.AllocateNearSurface(&source_volume, view_square_1, tracking_state);
+	DepthFusionEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU> depth_fusion_engine;
+	depth_fusion_engine.IntegrateDepthImageIntoTsdfVolume(&source_volume, view_square_1, tracking_state);
+
+	// mirrored volume starts out with unrelated blocks & garbage in all of voxel memory
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> mirrored_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	mirrored_volume.Reset();
+	ORUtils::MemoryBlock<Vector3s> stale_block_positions(2, MEMORYDEVICE_CPU);
+	stale_block_positions.GetData(MEMORYDEVICE_CPU)[0] = Vector3s(100, 100, 100);
+	stale_block_positions.GetData(MEMORYDEVICE_CPU)[1] = Vector3s(-30, 20, 4);
+	indexer.AllocateBlockList(&mirrored_volume, stale_block_positions);
+	TSDFVoxel* mirrored_voxels = mirrored_volume.GetVoxels();
+	for (unsigned int i_voxel = 0; i_voxel < mirrored_volume.index.GetMaxVoxelCount(); i_voxel++) {
+		mirrored_voxels[i_voxel].sdf = 0.5f;
+		mirrored_voxels[i_voxel].w_depth = 3;
+	}
+
+	BOOST_REQUIRE(!mirrored_volume.index.SharesBlockLayoutWith(source_volume.index));
+	MirrorIndexOfOtherVolume(&mirrored_volume, &source_volume, MEMORYDEVICE_CPU);
+	BOOST_REQUIRE(mirrored_volume.index.SharesBlockLayoutWith(source_volume.index));
+	BOOST_REQUIRE_EQUAL(mirrored_volume.index.GetUtilizedBlockCount(), source_volume.index.GetUtilizedBlockCount());
+	BOOST_REQUIRE_EQUAL(mirrored_volume.index.GetLastFreeBlockListId(), source_volume.index.GetLastFreeBlockListId());
+
+	const HashEntry* source_hash_table = source_volume.index.GetEntries();
+	const HashEntry* mirrored_hash_table = mirrored_volume.index.GetEntries();
+	for (int hash_code = 0; hash_code < source_volume.index.hash_entry_count; hash_code++) {
+		BOOST_REQUIRE_EQUAL(mirrored_hash_table[hash_code].pos, source_hash_table[hash_code].pos);
+		BOOST_REQUIRE_EQUAL(mirrored_hash_table[hash_code].ptr, source_hash_table[hash_code].ptr);
+	}
+
+	// all blocks the mirrored volume got are new to it, so they have to be cleared
+	auto check_utilized_voxels = [&](const std::function<void(const TSDFVoxel&, const TSDFVoxel&)>& check) {
+		const int* utilized_hash_codes = source_volume.index.GetUtilizedBlockHashCodes();
+		const TSDFVoxel* source_voxels = source_volume.GetVoxels();
+		for (int i_block = 0; i_block < source_volume.index.GetUtilizedBlockCount(); i_block++) {
+			const int block_offset = source_hash_table[utilized_hash_codes[i_block]].ptr * VOXEL_BLOCK_SIZE3;
+			for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) {
+				check(source_voxels[block_offset + i_voxel], mirrored_voxels[block_offset + i_voxel]);
+			}
+		}
+	};
+	check_utilized_voxels([](const TSDFVoxel& source_voxel, const TSDFVoxel& mirrored_voxel) {
+		BOOST_REQUIRE_EQUAL(mirrored_voxel.sdf, TSDFVoxel::SDF_initialValue());
+		BOOST_REQUIRE_EQUAL(mirrored_voxel.w_depth, 0);
+	});
+
+	// the mirrored layout stays valid until either volume's allocation changes
+	depth_fusion_engine.IntegrateDepthImageIntoTsdfVolume(&mirrored_volume, view_square_1, tracking_state);
+	BOOST_REQUIRE(mirrored_volume.index.SharesBlockLayoutWith(source_volume.index));
+	indexer.UpdateAllocationNearAndBetweenTwoSurfaces(&source_volume, view_square_2, tracking_state);
+	BOOST_REQUIRE(!mirrored_volume.index.SharesBlockLayoutWith(source_volume.index));
+
+	// blocks kept in place keep their voxels, new ones are cleared, matching what happened to the source volume
+	MirrorIndexOfOtherVolume(&mirrored_volume, &source_volume, MEMORYDEVICE_CPU);
+	BOOST_REQUIRE(mirrored_volume.index.SharesBlockLayoutWith(source_volume.index));
+	check_utilized_voxels([](const TSDFVoxel& source_voxel, const TSDFVoxel& mirrored_voxel) {
+		BOOST_REQUIRE_EQUAL(mirrored_voxel.sdf, source_voxel.sdf);
+		BOOST_REQUIRE_EQUAL(mirrored_voxel.w_depth, source_voxel.w_depth);
+	});
+
+	// lockstep traversal visits the same voxels as traversal that matches blocks by position
+	std::atomic<int> mismatch_count(0);
+	auto count_mismatches = [&mismatch_count](TSDFVoxel& source_voxel, TSDFVoxel& mirrored_voxel) {
+		if (source_voxel.sdf != mirrored_voxel.sdf || source_voxel.w_depth != mirrored_voxel.w_depth) mismatch_count++;
+	};
+	TwoVolumeTraversalEngine<TSDFVoxel, TSDFVoxel, VoxelBlockHash, VoxelBlockHash, MEMORYDEVICE_CPU>::TraverseUtilized(
+			&source_volume, &mirrored_volume, count_mismatches);
+	BOOST_REQUIRE_EQUAL(mismatch_count.load(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(Test_WarpFieldCarryOverForWarmStart_CPU, SquareViewsFixture_CPU) {
+	// follows the per-frame reallocation DynamicSceneVoxelEngine performs when warm_start_non_rigid_alignment is on
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> live_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	live_volume.Reset();
+	VoxelVolume<WarpVoxel, VoxelBlockHash> warp_field(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	warp_field.Reset();
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>& indexer = IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+
+	indexer.AllocateNearAndBetweenTwoSurfaces(&live_volume, view_square_1, tracking_state);
+	DeallocateUsingOtherVolume(&warp_field, &live_volume, MEMORYDEVICE_CPU);
+	AllocateUsingOtherVolume(&warp_field, &live_volume, MEMORYDEVICE_CPU);
+
+	// stand-in for the warps the first frame's alignment leaves behind: non-zero and distinct per block
+	auto block_warp = [](const HashEntry& entry) { return entry.pos.toFloat() + Vector3f(0.5f); };
+	std::set<std::tuple<short, short, short>> first_frame_blocks;
+	WarpVoxel* warps = warp_field.GetVoxels();
+	const HashEntry* warp_hash_table = warp_field.index.GetEntries();
+	const int* first_frame_hash_codes = warp_field.index.GetUtilizedBlockHashCodes();
+	for (int i_block = 0; i_block < warp_field.index.GetUtilizedBlockCount(); i_block++) {
+		const HashEntry& entry = warp_hash_table[first_frame_hash_codes[i_block]];
+		first_frame_blocks.emplace(entry.pos.x, entry.pos.y, entry.pos.z);
+		for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) {
+			warps[entry.ptr * VOXEL_BLOCK_SIZE3 + i_voxel].warp_update = block_warp(entry);
+		}
+	}
+
+	live_volume.Reset();
+	indexer.AllocateNearAndBetweenTwoSurfaces(&live_volume, view_square_2, tracking_state);
+	DeallocateUsingOtherVolume(&warp_field, &live_volume, MEMORYDEVICE_CPU);
+	AllocateUsingOtherVolume(&warp_field, &live_volume, MEMORYDEVICE_CPU);
+	BOOST_REQUIRE_EQUAL(warp_field.index.GetUtilizedBlockCount(), live_volume.index.GetUtilizedBlockCount());
+
+	// blocks kept from the previous frame keep their warps, blocks allocated for this frame start out at zero
+	int kept_block_count = 0;
+	int new_block_count = 0;
+	const int* second_frame_hash_codes = warp_field.index.GetUtilizedBlockHashCodes();
+	for (int i_block = 0; i_block < warp_field.index.GetUtilizedBlockCount(); i_block++) {
+		const HashEntry& entry = warp_hash_table[second_frame_hash_codes[i_block]];
+		const bool kept = first_frame_blocks.count(std::make_tuple(entry.pos.x, entry.pos.y, entry.pos.z)) > 0;
+		const Vector3f expected_warp = kept ? block_warp(entry) : Vector3f(0.0f);
+		(kept ? kept_block_count : new_block_count)++;
+		for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel++) {
+			BOOST_REQUIRE_EQUAL(warps[entry.ptr * VOXEL_BLOCK_SIZE3 + i_voxel].warp_update, expected_warp);
+		}
+	}
+	BOOST_REQUIRE_GT(kept_block_count, 0);
+	BOOST_REQUIRE_GT(new_block_count, 0);
+}
@@ -0,0 +1,197 @@
+#define BOOST_TEST_MODULE LevelSetAlignment_Fused_vs_Unfused
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <limits>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/GlobalTemplateDefines.h"
+#include "../ITMLib/Objects/Volume/VoxelVolume.h"
+#include "../ITMLib/Engines/LevelSetAlignment/Interface/LevelSetAlignmentEngine.h"
+#include "../ITMLib/Engines/ViewBuilder/ViewBuilderFactory.h"
+#include "../ITMLib/Engines/DepthFusion/DepthFusionEngine.h"
+#include "../ITMLib/Engines/Indexing/Interface/IndexingEngine.h"
+#include "../ITMLib/Engines/Traversal/Interface/VolumeTraversal.h"
+#include "../ITMLib/Utils/Analytics/VoxelVolumeComparison/VoxelVolumeComparison.h"
+#include "../ORUtils/FileUtils.h"
+//(CPU)
+#include "../ITMLib/Engines/Indexing/VBH/CPU/IndexingEngine_VoxelBlockHash_CPU.h"
+#include "../ITMLib/Engines/Indexing/PVA/IndexingEngine_PlainVoxelArray.h"
+#include "../ITMLib/Engines/Traversal/CPU/VolumeTraversal_CPU_PlainVoxelArray.h"
+#include "../ITMLib/Engines/Traversal/CPU/VolumeTraversal_CPU_VoxelBlockHash.h"
+#include "../ITMLib/Engines/Analytics/AnalyticsEngine.h"
+
+//test_utilities
+#include "TestUtilities/TestUtilities.h"
+#include "TestUtilities/TestDataUtilities.h"
+
+using namespace ITMLib;
+
+// level set alignment functors are declared outside of the ITMLib namespace
+#include "../ITMLib/Engines/LevelSetAlignment/Shared/LevelSetAlignmentSharedFunctors.h"
+
+namespace {
+
+template<typename TIndex>
+typename TIndex::InitializationParameters SquareVolumeInitializationParameters();
+
+template<>
+PlainVoxelArray::InitializationParameters SquareVolumeInitializationParameters<PlainVoxelArray>() {
+	// encloses both squares from the test frames, including the truncation band
+	return {Vector3i(128, 128, 96), Vector3i(-64, -64, 464)};
+}
+
+template<>
+VoxelBlockHash::InitializationParameters SquareVolumeInitializationParameters<VoxelBlockHash>() {
+	return {0x8000, 0x20000};
+}
+
+// .gradient0 retains different results in the fused and the unfused optimization step by design: the fused step leaves
+// the raw energy gradient there, the unfused smoothing passes leave the intermediate (X- and Y-smoothed) result.
+// Everything else, i.e. .gradient1, the warp updates and the live volume warped in the step's separate final pass, has
+// to match.
+struct ClearOutGradient0StaticFunctor {
+	static inline void run(WarpVoxel& voxel) {
+		voxel.gradient0 = Vector3f(0.0f);
+	}
+};
+
+template<typename TIndex>
+struct SquareAlignmentData {
+	SquareAlignmentData(const View* canonical_view, const View* live_view, CameraTrackingState* tracking_state) :
+			canonical_volume(MEMORYDEVICE_CPU, SquareVolumeInitializationParameters<TIndex>()),
+			live_volume(MEMORYDEVICE_CPU, SquareVolumeInitializationParameters<TIndex>()),
+			target_live_volume(MEMORYDEVICE_CPU, SquareVolumeInitializationParameters<TIndex>()),
+			warp_field(MEMORYDEVICE_CPU, SquareVolumeInitializationParameters<TIndex>()) {
+		canonical_volume.Reset();
+		live_volume.Reset();
+		target_live_volume.Reset();
+		warp_field.Reset();
+
+		IndexingEngine<TSDFVoxel, TIndex, MEMORYDEVICE_CPU>& indexer = IndexingEngine<TSDFVoxel, TIndex, MEMORYDEVICE_CPU>::Instance();
+		DepthFusionEngine<TSDFVoxel, TIndex, MEMORYDEVICE_CPU> depth_fusion_engine;
+
+		indexer.AllocateNearSurface(&live_volume, live_view, tracking_state);
+		depth_fusion_engine.IntegrateDepthImageIntoTsdfVolume(&live_volume, live_view, tracking_state);
+		indexer.AllocateNearSurface(&canonical_volume, canonical_view, tracking_state);
+		AllocateUsingOtherVolume(&canonical_volume, &live_volume, MEMORYDEVICE_CPU);
+		depth_fusion_engine.IntegrateDepthImageIntoTsdfVolume(&canonical_volume, canonical_view, tracking_state);
+		AllocateUsingOtherVolume(&target_live_volume, &live_volume, MEMORYDEVICE_CPU);
+		AllocateUsingOtherVolume(&warp_field, &live_volume, MEMORYDEVICE_CPU);
+	}
+
+	VoxelVolume<TSDFVoxel, TIndex>* Align(bool fuse_optimization_step, const LevelSetAlignmentSwitches& switches,
+	                                      const LevelSetAlignmentTerminationConditions& termination =
+	                                      LevelSetAlignmentTerminationConditions(MAXIMUM, 5, 5, 1e-6f)) {
+		LevelSetAlignmentParameters parameters(ExecutionMode::OPTIMIZED, fuse_optimization_step, LevelSetAlignmentWeights(),
+		                                       switches, termination);
+		LevelSetAlignmentEngine<TSDFVoxel, WarpVoxel, TIndex, MEMORYDEVICE_CPU, OPTIMIZED> level_set_aligner(parameters);
+		VoxelVolume<TSDFVoxel, TIndex>* live_volume_pair[2] = {&live_volume, &target_live_volume};
+		return level_set_aligner.Align(&warp_field, live_volume_pair, &canonical_volume);
+	}
+
+	VoxelVolume<TSDFVoxel, TIndex> canonical_volume;
+	VoxelVolume<TSDFVoxel, TIndex> live_volume;
+	VoxelVolume<TSDFVoxel, TIndex> target_live_volume;
+	VoxelVolume<WarpVoxel, TIndex> warp_field;
+};
+
+struct SquareViews {
+	SquareViews() {
+		ViewBuilder* view_builder = ViewBuilderFactory::Build(std::string(test::snoopy::calibration_path), MEMORYDEVICE_CPU);
+		UChar4Image rgb(true, false);
+		ShortImage depth(true, false);
+		ReadImageFromFile(rgb, STATIC_TEST_DATA_PREFIX "TestData/frames/square1_color.png");
+		ReadImageFromFile(depth, STATIC_TEST_DATA_PREFIX "TestData/frames/square1_depth.png");
+		view_builder->UpdateView(&view_square_1, &rgb, &depth, false, false, false, true);
+		ReadImageFromFile(rgb, STATIC_TEST_DATA_PREFIX "TestData/frames/square2_color.png");
+		ReadImageFromFile(depth, STATIC_TEST_DATA_PREFIX "TestData/frames/square2_depth.png");
+		view_builder->UpdateView(&view_square_2, &rgb, &depth, false, false, false, true);
+		tracking_state = new CameraTrackingState(depth.dimensions, MEMORYDEVICE_CPU);
+		delete view_builder;
+	}
+
+	~SquareViews() {
+		delete view_square_1;
+		delete view_square_2;
+		delete tracking_state;
+	}
+
+	View* view_square_1 = nullptr;
+	View* view_square_2 = nullptr;
+	CameraTrackingState* tracking_state;
+};
+
+} // anonymous namespace
+
+template<typename TIndex>
+void GenericFusedVsUnfusedOptimizationStepTest(const LevelSetAlignmentSwitches& switches) {
+	SquareViews views;
+	SquareAlignmentData<TIndex> unfused_data(views.view_square_1, views.view_square_2, views.tracking_state);
+	SquareAlignmentData<TIndex> fused_data(views.view_square_1, views.view_square_2, views.tracking_state);
+
+	VoxelVolume<TSDFVoxel, TIndex>* unfused_result = unfused_data.Align(false, switches);
+	VoxelVolume<TSDFVoxel, TIndex>* fused_result = fused_data.Align(true, switches);
+
+	auto& analytics_engine = AnalyticsEngine<WarpVoxel, TIndex, MEMORYDEVICE_CPU>::Instance();
+	BOOST_REQUIRE_GT(analytics_engine.CountAlteredWarpUpdates(&unfused_data.warp_field), 0u);
+
+	VolumeTraversalEngine<WarpVoxel, TIndex, MEMORYDEVICE_CPU>::template
+	TraverseUtilized<ClearOutGradient0StaticFunctor>(&unfused_data.warp_field);
+	VolumeTraversalEngine<WarpVoxel, TIndex, MEMORYDEVICE_CPU>::template
+	TraverseUtilized<ClearOutGradient0StaticFunctor>(&fused_data.warp_field);
+
+	const float absolute_tolerance = 1e-6f;
+	BOOST_REQUIRE(ContentAlmostEqual_Verbose(&unfused_data.warp_field, &fused_data.warp_field, absolute_tolerance, MEMORYDEVICE_CPU));
+	BOOST_REQUIRE(ContentAlmostEqual_Verbose(unfused_result, fused_result, absolute_tolerance, MEMORYDEVICE_CPU));
+}
+
+BOOST_AUTO_TEST_CASE(Test_FusedVsUnfused_DataAndTikhonovAndSobolevSmoothing_CPU_VBH) {
+	GenericFusedVsUnfusedOptimizationStepTest<VoxelBlockHash>(LevelSetAlignmentSwitches(true, false, true, false, true));
+}
+
+BOOST_AUTO_TEST_CASE(Test_FusedVsUnfused_DataAndTikhonov_CPU_VBH) {
+	GenericFusedVsUnfusedOptimizationStepTest<VoxelBlockHash>(LevelSetAlignmentSwitches(true, false, true, false, false));
+}
+
+BOOST_AUTO_TEST_CASE(Test_FusedVsUnfused_DataAndTikhonovAndSobolevSmoothing_CPU_PVA) {
+	GenericFusedVsUnfusedOptimizationStepTest<PlainVoxelArray>(LevelSetAlignmentSwitches(true, false, true, false, true));
+}
+
+BOOST_AUTO_TEST_CASE(Test_Fused_Deterministic_CPU_VBH) {
+	SquareViews views;
+	SquareAlignmentData<VoxelBlockHash> data1(views.view_square_1, views.view_square_2, views.tracking_state);
+	SquareAlignmentData<VoxelBlockHash> data2(views.view_square_1, views.view_square_2, views.tracking_state);
+
+	// the average gradient length decides when to stop, so any run-to-run variation in it would show in the results
+	const LevelSetAlignmentSwitches switches(true, false, true, false, true);
+	const LevelSetAlignmentTerminationConditions termination(AVERAGE, 30, 1, 1e-3f);
+	VoxelVolume<TSDFVoxel, VoxelBlockHash>* result1 = data1.Align(true, switches, termination);
+	VoxelVolume<TSDFVoxel, VoxelBlockHash>* result2 = data2.Align(true, switches, termination);
+
+	// the comparison is strict (difference < tolerance), the smallest tolerance possible amounts to exact equality
+	const float tolerance = std::numeric_limits<float>::denorm_min();
+	BOOST_REQUIRE(ContentAlmostEqual_Verbose(&data1.warp_field, &data2.warp_field, tolerance, MEMORYDEVICE_CPU));
+	BOOST_REQUIRE(ContentAlmostEqual_Verbose(result1, result2, tolerance, MEMORYDEVICE_CPU));
+}
+
+BOOST_AUTO_TEST_CASE(Test_Fused_AverageGradientLengthOfEmptyVolume_CPU_VBH) {
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> canonical_volume(MEMORYDEVICE_CPU, SquareVolumeInitializationParameters<VoxelBlockHash>());
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> live_volume(MEMORYDEVICE_CPU, SquareVolumeInitializationParameters<VoxelBlockHash>());
+	VoxelVolume<WarpVoxel, VoxelBlockHash> warp_field(MEMORYDEVICE_CPU, SquareVolumeInitializationParameters<VoxelBlockHash>());
+	canonical_volume.Reset();
+	live_volume.Reset();
+	warp_field.Reset();
+
+	// no voxel has a non-zero gradient, so the average has to come out as zero rather than 0 / 0
+	std::vector<TiledGradientSmoothingWorkspace> workspaces(2);
+	TiledGradientSmoothingAndWarpUpdateFunctor<TSDFVoxel, WarpVoxel, VoxelBlockHash, MEMORYDEVICE_CPU, true>
+			tile_functor(&warp_field, &canonical_volume, &live_volume, 0.1f, workspaces);
+	BOOST_REQUIRE_EQUAL(tile_functor.GetAverageGradientLength(), 0.0f);
+	BOOST_REQUIRE_EQUAL(tile_functor.GetMaximumGradientLength(), 0.0f);
+}
@@ -18,6 +18,10 @@
 #define BOOST_TEST_DYN_LINK
 #endif
 
+//stdlib
+#include <algorithm>
+#include <vector>
+
 //boost
 #include <boost/test/unit_test.hpp>
 
@@ -31,6 +35,7 @@
 #include "../ITMLib/GlobalTemplateDefines.h"
 #include "../ITMLib/Objects/Meshing/Mesh.h"
 #include "../ITMLib/Engines/Meshing/MeshingEngineFactory.h"
+#include "../ITMLib/Engines/Meshing/CPU/IncrementalMeshingEngine_CPU.h"
 
 using namespace ITMLib;
 using namespace test;
@@ -99,6 +104,100 @@ BOOST_AUTO_TEST_CASE(Test_MeshGeneration_CPU_VBH) {
 	GenericMeshSavingTest<VoxelBlockHash, MEMORYDEVICE_CPU>();
 }
 
+// sphere spanning several voxel hash blocks
+static void GenerateSphere(VoxelVolume<TSDFVoxel, VoxelBlockHash>& volume, const float sphere_radius) {
+	const Vector3f sphere_center(0.5f, 0.25f, -0.25f);
+	for (int z = -16; z < 16; z++) {
+		for (int y = -16; y < 16; y++) {
+			for (int x = -16; x < 16; x++) {
+				TSDFVoxel voxel;
+				const float distance = ORUtils::length(Vector3f(x, y, z) - sphere_center);
+				voxel.sdf = ORUTILS_MAX(-1.0f, ORUTILS_MIN(1.0f, (distance - sphere_radius) / 4.0f));
+				voxel.w_depth = 1;
+				volume.SetValueAt(x, y, z, voxel);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Test_IndexedMeshGeneration_CPU_VBH) {
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(MEMORYDEVICE_CPU, {0x800, 0x20000});
+	volume.Reset();
+	GenerateSphere(volume, 10.0f);
+
+	MeshingEngine<TSDFVoxel, VoxelBlockHash>* meshing_engine =
+			MeshingEngineFactory::Build<TSDFVoxel, VoxelBlockHash>(MEMORYDEVICE_CPU);
+	Mesh triangle_soup = meshing_engine->MeshVolume(&volume);
+	Mesh indexed_mesh = meshing_engine->MeshVolumeIndexed(&volume);
+	delete meshing_engine;
+
+	BOOST_REQUIRE(!triangle_soup.IsIndexed());
+	BOOST_REQUIRE(indexed_mesh.IsIndexed());
+	BOOST_REQUIRE_GT(triangle_soup.GetTriangleCount(), 0u);
+	// both meshes list the triangles in the same order
+	BOOST_REQUIRE(AlmostEqual(triangle_soup, indexed_mesh, 1e-6f, false));
+
+	// on a closed surface, there are about half as many vertices as there are triangles
+	const unsigned int vertex_count = indexed_mesh.GetVertexCount();
+	BOOST_REQUIRE_LT(vertex_count, indexed_mesh.GetTriangleCount());
+	const unsigned int* indices = indexed_mesh.GetTriangleVertexIndices().GetData(MEMORYDEVICE_CPU);
+	for (unsigned int i_index = 0; i_index < indexed_mesh.GetTriangleCount() * 3; i_index++) {
+		BOOST_REQUIRE_LT(indices[i_index], vertex_count);
+	}
+	const Vector3f* vertex_data = indexed_mesh.GetVertices().GetData(MEMORYDEVICE_CPU);
+	std::vector<Vector3f> vertices(vertex_data, vertex_data + vertex_count);
+	std::sort(vertices.begin(), vertices.end());
+	BOOST_REQUIRE(std::adjacent_find(vertices.begin(), vertices.end()) == vertices.end());
+
+	ConstructGeneratedMeshDirectoryIfMissing();
+	indexed_mesh.WritePLY(std::string(test::generated_mesh_directory) + "indexed_sphere_CPU.ply");
+}
+
+BOOST_AUTO_TEST_CASE(Test_IncrementalMeshGeneration_CPU_VBH) {
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(MEMORYDEVICE_CPU, {0x800, 0x20000});
+	volume.Reset();
+	GenerateSphere(volume, 10.0f);
+
+	MeshingEngine<TSDFVoxel, VoxelBlockHash>* meshing_engine =
+			MeshingEngineFactory::Build<TSDFVoxel, VoxelBlockHash>(MEMORYDEVICE_CPU);
+	IncrementalMeshingEngine_CPU<TSDFVoxel> incremental_meshing_engine;
+
+	// first update meshes everything
+	const int utilized_block_count = volume.index.GetUtilizedBlockCount();
+	BOOST_REQUIRE_EQUAL(incremental_meshing_engine.UpdateMesh(&volume), utilized_block_count);
+	Mesh full_mesh = meshing_engine->MeshVolume(&volume);
+	BOOST_REQUIRE_GT(full_mesh.GetTriangleCount(), 0u);
+	BOOST_REQUIRE(AlmostEqual(incremental_meshing_engine.GetMesh(), full_mesh, 1e-6f));
+
+	// nothing changed, nothing to remesh
+	BOOST_REQUIRE_EQUAL(incremental_meshing_engine.UpdateMesh(&volume), 0);
+	BOOST_REQUIRE(incremental_meshing_engine.GetChangedChunks().empty());
+
+	// dent the sphere within the block at (1, 0, 0), which affects that block and the ones at -x, -y, -z from it
+	for (int z = 0; z < VOXEL_BLOCK_SIZE; z++) {
+		for (int y = 0; y < VOXEL_BLOCK_SIZE; y++) {
+			for (int x = VOXEL_BLOCK_SIZE; x < 2 * VOXEL_BLOCK_SIZE; x++) {
+				TSDFVoxel voxel = volume.GetValueAt(x, y, z);
+				voxel.sdf = ORUTILS_MIN(1.0f, voxel.sdf + 0.25f);
+				volume.SetValueAt(x, y, z, voxel);
+			}
+		}
+	}
+	const int changed_block_count = incremental_meshing_engine.UpdateMesh(&volume);
+	BOOST_REQUIRE_GT(changed_block_count, 0);
+	BOOST_REQUIRE_LE(changed_block_count, 8);
+	for (const Vector3s& block_position : incremental_meshing_engine.GetChangedBlockPositions()) {
+		BOOST_REQUIRE(block_position.x >= 0 && block_position.x <= 1);
+		BOOST_REQUIRE(block_position.y >= -1 && block_position.y <= 0);
+		BOOST_REQUIRE(block_position.z >= -1 && block_position.z <= 0);
+	}
+	Mesh changed_full_mesh = meshing_engine->MeshVolume(&volume);
+	BOOST_REQUIRE(!AlmostEqual(changed_full_mesh, full_mesh, 1e-6f));
+	BOOST_REQUIRE(AlmostEqual(incremental_meshing_engine.GetMesh(), changed_full_mesh, 1e-6f));
+
+	delete meshing_engine;
+}
+
 #ifndef COMPILE_WITHOUT_CUDA
 BOOST_AUTO_TEST_CASE(Test_MeshGeneration_CUDA_VBH) {
 	GenericMeshSavingTest<VoxelBlockHash, MEMORYDEVICE_CUDA>();
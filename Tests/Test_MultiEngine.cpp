@@ -0,0 +1,72 @@
+#define BOOST_TEST_MODULE MultiEngine
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <string>
+#include <vector>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/GlobalTemplateDefines.h"
+#include "../ITMLib/Engines/Main/MultiEngine.h"
+#include "../ITMLib/Engines/Analytics/AnalyticsEngine.h"
+#include "../ITMLib/Utils/Analytics/VoxelVolumeComparison/VoxelVolumeComparison.h"
+#include "../ORUtils/FileUtils.h"
+//test_utilities
+#include "TestUtilities/TestDataUtilities.h"
+
+using namespace ITMLib;
+
+struct MultiEngineTestAccess {
+	template<typename TVoxel, typename TIndex>
+	static std::vector<LocalMap<TVoxel, TIndex>*> FuseIntoNewLocalMaps(MultiEngine<TVoxel, TIndex>& engine, int local_map_count) {
+		return engine.FuseIntoNewLocalMaps(local_map_count);
+	}
+};
+
+BOOST_AUTO_TEST_CASE(Test_MultiEngine_FusesLocalMapsConcurrently_CPU) {
+	RGBD_CalibrationInformation calibration_data;
+	readRGBDCalib(std::string(test::snoopy::calibration_path).c_str(), calibration_data);
+	UChar4Image rgb(true, false);
+	ShortImage depth(true, false);
+	BOOST_REQUIRE(ReadImageFromFile(rgb, std::string(test::snoopy::frame_16_color_path).c_str()));
+	BOOST_REQUIRE(ReadImageFromFile(depth, std::string(test::snoopy::frame_16_depth_path).c_str()));
+
+	MultiEngine<TSDFVoxel, VoxelBlockHash> engine(calibration_data, rgb.dimensions, depth.dimensions);
+	engine.ProcessFrame(&rgb, &depth);
+
+#ifdef WITH_OPENMP
+	const int thread_count = omp_get_max_threads();
+#endif
+	// each new local map starts out at the same pose, so all of them end up with the same content
+	std::vector<LocalMap<TSDFVoxel, VoxelBlockHash>*> local_maps = MultiEngineTestAccess::FuseIntoNewLocalMaps(engine, 2);
+#ifdef WITH_OPENMP
+	// the thread count set for the tasks does not leak into the caller
+	BOOST_REQUIRE_EQUAL(omp_get_max_threads(), thread_count);
+#endif
+
+	auto& analytics_engine = AnalyticsEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	const unsigned int block_count = analytics_engine.CountAllocatedHashBlocks(local_maps[0]->volume);
+	BOOST_REQUIRE_GT(block_count, 0u);
+	for (LocalMap<TSDFVoxel, VoxelBlockHash>* local_map : local_maps) {
+		BOOST_REQUIRE_EQUAL(analytics_engine.CountAllocatedHashBlocks(local_map->volume), block_count);
+	}
+	BOOST_REQUIRE(ContentAlmostEqual(local_maps[0]->volume, local_maps[1]->volume, 1e-6f, MEMORYDEVICE_CPU));
+
+	// the raycasts prepared for tracking match as well
+	const Vector4f* raycast_0 = local_maps[0]->renderState->raycastResult->GetData(MEMORYDEVICE_CPU);
+	const Vector4f* raycast_1 = local_maps[1]->renderState->raycastResult->GetData(MEMORYDEVICE_CPU);
+	int hit_count = 0;
+	for (int i_pixel = 0; i_pixel < static_cast<int>(local_maps[0]->renderState->raycastResult->size()); i_pixel++) {
+		BOOST_REQUIRE_EQUAL(raycast_0[i_pixel], raycast_1[i_pixel]);
+		if (raycast_0[i_pixel].w > 0) hit_count++;
+	}
+	BOOST_REQUIRE_GT(hit_count, 0);
+}
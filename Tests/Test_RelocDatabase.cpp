@@ -0,0 +1,105 @@
+#define BOOST_TEST_MODULE RelocDatabase
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//FernRelocLib
+#include "../FernRelocLib/RelocDatabase.h"
+
+using namespace FernRelocLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int code_length = 75; // deliberately not a multiple of the packed row width
+constexpr int code_fragment_dim = 16;
+
+std::vector<char> MakeRandomCode(std::mt19937& generator) {
+	std::uniform_int_distribution<int> code_distribution(-1, code_fragment_dim - 1);
+	std::vector<char> code(code_length);
+	for (char& fragment : code) {
+		fragment = static_cast<char>(code_distribution(generator));
+	}
+	return code;
+}
+
+// straightforward search with the ordering the database is expected to produce: by distance, newer entries first
+void FindMostSimilarReference(const std::vector<std::vector<char>>& entries, const std::vector<char>& query,
+                              std::vector<int>& nearest_neighbors, std::vector<float>& distances, int k) {
+	std::vector<std::pair<int, int>> candidates;
+	for (int i_entry = 0; i_entry < static_cast<int>(entries.size()); i_entry++) {
+		int similarity = 0;
+		for (int i_fern = 0; i_fern < code_length; i_fern++) {
+			if (query[i_fern] >= 0 && query[i_fern] == entries[i_entry][i_fern]) similarity++;
+		}
+		candidates.emplace_back(similarity, i_entry);
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+		return a.first != b.first ? a.first > b.first : a.second > b.second;
+	});
+	nearest_neighbors.assign(k, -1);
+	distances.assign(k, 1.0f);
+	for (int i = 0; i < k && i < static_cast<int>(candidates.size()); i++) {
+		nearest_neighbors[i] = candidates[i].second;
+		distances[i] = (static_cast<float>(code_length) - static_cast<float>(candidates[i].first)) /
+		               static_cast<float>(code_length);
+	}
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Test_RelocDatabase_FindMostSimilar_MatchesReference) {
+	std::mt19937 generator(7);
+	RelocDatabase database(code_length, code_fragment_dim);
+	std::vector<std::vector<char>> entries;
+
+	const int k = 5;
+	std::vector<int> nearest_neighbors(k), expected_nearest_neighbors;
+	std::vector<float> distances(k), expected_distances;
+
+	BOOST_REQUIRE_EQUAL(database.findMostSimilar(MakeRandomCode(generator).data(), nearest_neighbors.data(),
+	                                             distances.data(), k), 0);
+	BOOST_REQUIRE_EQUAL(nearest_neighbors[0], -1);
+
+	for (int i_entry = 0; i_entry < 300; i_entry++) {
+		// every few entries, repeat an earlier one, so that ties occur
+		entries.push_back(i_entry % 7 == 6 ? entries[i_entry / 2] : MakeRandomCode(generator));
+		BOOST_REQUIRE_EQUAL(database.addEntry(entries.back().data()), i_entry);
+
+		std::vector<char> query = i_entry % 3 == 0 ? entries[i_entry / 3] : MakeRandomCode(generator);
+		int found = database.findMostSimilar(query.data(), nearest_neighbors.data(), distances.data(), k);
+		FindMostSimilarReference(entries, query, expected_nearest_neighbors, expected_distances, k);
+
+		BOOST_REQUIRE_EQUAL(found, std::min(k, i_entry + 1));
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(nearest_neighbors.begin(), nearest_neighbors.end(),
+		                                expected_nearest_neighbors.begin(), expected_nearest_neighbors.end());
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(distances.begin(), distances.end(),
+		                                expected_distances.begin(), expected_distances.end());
+	}
+
+	// saving and loading keeps the search results
+	const std::string path = (fs::temp_directory_path() / "test_reloc_database.txt").string();
+	database.SaveToFile(path);
+	RelocDatabase loaded_database(code_length, code_fragment_dim);
+	loaded_database.LoadFromFile(path);
+	fs::remove(path);
+
+	std::vector<int> loaded_nearest_neighbors(k);
+	std::vector<float> loaded_distances(k);
+	for (int i_query = 0; i_query < 20; i_query++) {
+		std::vector<char> query = MakeRandomCode(generator);
+		database.findMostSimilar(query.data(), nearest_neighbors.data(), distances.data(), k);
+		loaded_database.findMostSimilar(query.data(), loaded_nearest_neighbors.data(), loaded_distances.data(), k);
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(nearest_neighbors.begin(), nearest_neighbors.end(),
+		                                loaded_nearest_neighbors.begin(), loaded_nearest_neighbors.end());
+	}
+}
@@ -33,6 +33,12 @@
 #include "../ITMLib/Utils/Analytics/RawArrayComparison.h"
 #include "../ITMLib/Utils/Collections/OperationsOnSTLContainers.h"
 #include "../ITMLib/Utils/Collections/MemoryBlock_StdContainer_Convertions.h"
+#include "../ITMLib/Engines/Indexing/VBH/CPU/IndexingEngine_VoxelBlockHash_CPU.h"
+#include "../ITMLib/Engines/DepthFusion/DepthFusionEngine.h"
+#include "../ITMLib/Engines/Rendering/Shared/RenderingEngine_Functors.h"
+#include "../ITMLib/Engines/Traversal/CPU/HashTableTraversal_CPU.h"
+#include "../ITMLib/Engines/Traversal/CPU/ImageTraversal_CPU.h"
+#include "../ITMLib/Engines/Traversal/CPU/Regular2DSubGridArrayTraversal_CPU.h"
 
 
 template<MemoryDeviceType TMemoryDeviceType>
@@ -406,6 +412,137 @@ void GenericRenderImageTest() {
 	}
 }
 
+// computes the expected depths the way CreateExpectedDepths did before frustum culling, i.e. by projecting every utilized block
+static void ComputeExpectedDepthsFromAllUtilizedBlocks_CPU(ORUtils::Image<Vector2f>& range_image, const VoxelVolume<TSDFVoxel, VoxelBlockHash>& volume,
+                                                           const ORUtils::SE3Pose& pose, const Intrinsics& intrinsics) {
+	FillExpectedDepthsWithClippingDistancesFunctor<MEMORYDEVICE_CPU> fill_with_clipping_planes_functor(FAR_AWAY, VERY_CLOSE);
+	ImageTraversalEngine<MEMORYDEVICE_CPU>::Traverse(&range_image, fill_with_clipping_planes_functor);
+	ORUtils::MemoryBlock<RenderingBlock> rendering_blocks(MAX_RENDERING_BLOCKS, MEMORYDEVICE_CPU);
+	ProjectAndSplitBlocksFunctor<MEMORYDEVICE_CPU> project_and_split_blocks_functor(
+			rendering_blocks, pose.GetM(), intrinsics.projectionParamsSimple.all, range_image.dimensions, volume.GetParameters().voxel_size);
+	HashTableTraversalEngine<MEMORYDEVICE_CPU>::TraverseUtilized_Padded(volume.index, project_and_split_blocks_functor);
+	// when the rendering blocks overflow, which blocks make it depends on the traversal order, so results aren't comparable
+	const unsigned int rendering_block_count = project_and_split_blocks_functor.GetRenderingBlockCount();
+	BOOST_REQUIRE_LT(rendering_block_count, static_cast<unsigned int>(MAX_RENDERING_BLOCKS));
+	FillBlocksFunctor<MEMORYDEVICE_CPU> fill_blocks_functor(range_image);
+	Regular2DSubGridArrayTraversal<MEMORYDEVICE_CPU>::Traverse<rendering_block_size_x, rendering_block_size_y>(
+			rendering_blocks, rendering_block_count, fill_blocks_functor,
+			[](const RenderingBlock& block, int& start_x, int& end_x, int& start_y, int& end_y) {
+				start_x = block.upper_left.x, end_x = block.lower_right.x, start_y = block.upper_left.y, end_y = block.lower_right.y;
+			});
+}
+
+// compares the parts of the range images that ray casting reads, i.e. the upper-left image size / subsampling factor pixels
+static bool RayDepthRangesEqual(const ORUtils::Image<Vector2f>& range_image1, const ORUtils::Image<Vector2f>& range_image2) {
+	const Vector2i& image_size = range_image1.dimensions;
+	const Vector2f* ranges1 = range_image1.GetData(MEMORYDEVICE_CPU);
+	const Vector2f* ranges2 = range_image2.GetData(MEMORYDEVICE_CPU);
+	for (int y = 0; y < (image_size.y - 1) / ray_depth_image_subsampling_factor + 1; y++) {
+		for (int x = 0; x < (image_size.x - 1) / ray_depth_image_subsampling_factor + 1; x++) {
+			const int i_pixel = x + y * image_size.x;
+			if (ranges1[i_pixel] != ranges2[i_pixel]) {
+				std::cerr << "Ray depth range mismatch at (" << x << ", " << y << "): " << ranges1[i_pixel] << " vs. " << ranges2[i_pixel]
+				          << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+BOOST_AUTO_TEST_CASE(Test_CreateExpectedDepths_FrustumCulling_CPU) {
+	CameraPoseAndRenderingEngineFixture<MEMORYDEVICE_CPU> fixture;
+	const Intrinsics& intrinsics = fixture.calibration_data.intrinsics_d;
+
+	// a sparse lattice of blocks that spans many coarse grid cells on all sides of the viewpoints, including behind them
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	volume.Reset();
+	const int lattice_step = 4;
+	std::vector<Vector3s> lattice_block_positions;
+	for (short z = -24; z < 24; z += lattice_step) {
+		for (short y = -24; y < 24; y += lattice_step) {
+			for (short x = -24; x < 24; x += lattice_step) {
+				lattice_block_positions.emplace_back(x, y, z);
+			}
+		}
+	}
+	ORUtils::MemoryBlock<Vector3s> block_positions(lattice_block_positions.size(), MEMORYDEVICE_CPU);
+	std::copy(lattice_block_positions.begin(), lattice_block_positions.end(), block_positions.GetData(MEMORYDEVICE_CPU));
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>& indexer = IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	indexer.AllocateBlockList(&volume, block_positions);
+	BOOST_REQUIRE_EQUAL(volume.index.GetUtilizedBlockCount(), static_cast<int>(lattice_block_positions.size()));
+
+	std::vector<ORUtils::SE3Pose> poses = GenerateCameraTrajectoryAroundPoint(fixture.original_viewpoint, fixture.target, fixture.degree_increment);
+	std::shared_ptr<RenderState> render_state = fixture.MakeRenderState();
+	ORUtils::Image<Vector2f>& range_image = *render_state->renderingRangeImage;
+	ORUtils::Image<Vector2f> range_image_ground_truth(range_image.dimensions, MEMORYDEVICE_CPU);
+	for (const ORUtils::SE3Pose& pose : poses) {
+		fixture.rendering_engine->CreateExpectedDepths(&volume, &pose, &intrinsics, render_state.get());
+		BOOST_REQUIRE(volume.index.GetCoarseBlockGrid().up_to_date);
+		ComputeExpectedDepthsFromAllUtilizedBlocks_CPU(range_image_ground_truth, volume, pose, intrinsics);
+		BOOST_REQUIRE(RayDepthRangesEqual(range_image_ground_truth, range_image));
+	}
+
+	// changing allocation invalidates the coarse block grid, which then gets rebuilt to include the new blocks
+	ORUtils::MemoryBlock<Vector3s> new_block_positions(1, MEMORYDEVICE_CPU);
+	new_block_positions.GetData(MEMORYDEVICE_CPU)[0] = Vector3s(1, 2, 25);
+	indexer.AllocateBlockList(&volume, new_block_positions);
+	BOOST_REQUIRE(!volume.index.GetCoarseBlockGrid().up_to_date);
+	fixture.rendering_engine->CreateExpectedDepths(&volume, &poses[0], &intrinsics, render_state.get());
+	BOOST_REQUIRE_EQUAL(volume.index.GetCoarseBlockGrid().block_hash_codes.size(), lattice_block_positions.size() + 1);
+	ComputeExpectedDepthsFromAllUtilizedBlocks_CPU(range_image_ground_truth, volume, poses[0], intrinsics);
+	BOOST_REQUIRE(RayDepthRangesEqual(range_image_ground_truth, range_image));
+}
+
+BOOST_AUTO_TEST_CASE(Test_CastRay_EmptySpaceSkipping_CPU) {
+	CameraPoseAndRenderingEngineFixture<MEMORYDEVICE_CPU> fixture;
+	const Intrinsics& intrinsics = fixture.calibration_data.intrinsics_d;
+
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(MEMORYDEVICE_CPU, test::snoopy::InitializationParameters_Fr16andFr17<VoxelBlockHash>());
+	volume.Reset();
+	std::shared_ptr<CameraTrackingState> tracking_state = fixture.MakeCameraTrackingState();
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance().AllocateNearSurface(&volume, fixture.view_17, tracking_state.get());
+	DepthFusionEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU> depth_fusion_engine;
+	depth_fusion_engine.IntegrateDepthImageIntoTsdfVolume(&volume, fixture.view_17, tracking_state.get());
+
+	std::vector<ORUtils::SE3Pose> poses = GenerateCameraTrajectoryAroundPoint(fixture.original_viewpoint, fixture.target, fixture.degree_increment);
+	std::shared_ptr<RenderState> render_state = fixture.MakeRenderState();
+	const Vector2i image_size = render_state->raycastResult->dimensions;
+	const Vector2f* ray_depth_ranges = render_state->renderingRangeImage->GetData(MEMORYDEVICE_CPU);
+	const float voxel_size_reciprocal = 1.0f / volume.GetParameters().voxel_size;
+	const float truncation_distance = volume.GetParameters().truncation_distance;
+	const Vector4f inverted_projection_parameters = InvertProjectionParams(intrinsics.projectionParamsSimple.all);
+
+	int found_point_count = 0;
+	for (const ORUtils::SE3Pose& pose : poses) {
+		fixture.rendering_engine->CreateExpectedDepths(&volume, &pose, &intrinsics, render_state.get());
+		const unsigned int* occupancy_bits = volume.index.GetBlockOccupancyBits();
+		BOOST_REQUIRE(occupancy_bits != nullptr);
+		for (int y = 0; y < image_size.height; y++) {
+			for (int x = 0; x < image_size.width; x++) {
+				const Vector2f& ray_depth_range = ray_depth_ranges[x / ray_depth_image_subsampling_factor +
+				                                                   (y / ray_depth_image_subsampling_factor) * image_size.width];
+				Vector4f point_with_skipping, point_without_skipping;
+				const bool found_with_skipping = CastRay<TSDFVoxel, VoxelBlockHash, false>(
+						point_with_skipping, nullptr, x, y, volume.GetVoxels(), volume.index.GetIndexData(), pose.GetInvM(),
+						inverted_projection_parameters, voxel_size_reciprocal, truncation_distance, ray_depth_range, occupancy_bits);
+				const bool found_without_skipping = CastRay<TSDFVoxel, VoxelBlockHash, false>(
+						point_without_skipping, nullptr, x, y, volume.GetVoxels(), volume.index.GetIndexData(), pose.GetInvM(),
+						inverted_projection_parameters, voxel_size_reciprocal, truncation_distance, ray_depth_range);
+				BOOST_REQUIRE_EQUAL(found_with_skipping, found_without_skipping);
+				if (found_with_skipping) {
+					// leaps land on the same samples as single steps do, but accumulate the rounding errors differently,
+					// which may change the steps taken near the surface slightly (the points are in voxels)
+					BOOST_REQUIRE_LE(ORUtils::length(TO_VECTOR3(point_with_skipping) - TO_VECTOR3(point_without_skipping)), 0.5f);
+					found_point_count++;
+				}
+			}
+		}
+	}
+	// views from behind the single fused frame see no surface, but the rest must hit it
+	BOOST_REQUIRE_GT(found_point_count, 0);
+}
+
 BOOST_AUTO_TEST_CASE(Test_FindAndCountVisibleBlocks_CPU) {
 	GenericFindAndCountVisibleBlocksTest<MEMORYDEVICE_CPU>();
 }
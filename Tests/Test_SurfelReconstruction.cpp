@@ -0,0 +1,74 @@
+#define BOOST_TEST_MODULE SurfelReconstruction
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <functional>
+#include <vector>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/Objects/Volume/SurfelTypes.h"
+#include "../ITMLib/Engines/Reconstruction/CPU/SurfelSceneReconstructionEngine_CPU.h"
+
+using namespace ITMLib;
+
+namespace {
+
+// each surfel's timestamp holds its original index, so that the survivors can be identified after the removal
+void AddSurfels(SurfelScene<Surfel_grey>& scene, int surfel_count) {
+	Surfel_grey* surfels = scene.AllocateSurfels(surfel_count);
+	BOOST_REQUIRE(surfels != nullptr);
+	for (int i_surfel = 0; i_surfel < surfel_count; i_surfel++) {
+		surfels[i_surfel].timestamp = i_surfel;
+		surfels[i_surfel].position = Vector3f(static_cast<float>(i_surfel), 0.0f, 0.0f);
+	}
+}
+
+void RequireRemovalMatchesFilter(int surfel_count, const std::function<bool(int)>& marked) {
+	SurfelVolumeParameters parameters;
+	SurfelScene<Surfel_grey> scene(&parameters, MEMORYDEVICE_CPU);
+	AddSurfels(scene, surfel_count);
+	std::vector<int> expected_survivors;
+	for (int i_surfel = 0; i_surfel < surfel_count; i_surfel++) {
+		if (!marked(i_surfel)) expected_survivors.push_back(i_surfel);
+	}
+
+	std::vector<unsigned int> surfel_removal_mask(surfel_count);
+	for (int i_surfel = 0; i_surfel < surfel_count; i_surfel++) {
+		surfel_removal_mask[i_surfel] = marked(i_surfel) ? 1u : 0u;
+	}
+	RemoveMarkedSurfels_CPU(&scene, surfel_removal_mask.data());
+
+	BOOST_REQUIRE_EQUAL(scene.GetSurfelCount(), expected_survivors.size());
+	const Surfel_grey* surfels = scene.GetSurfels()->GetData(MEMORYDEVICE_CPU);
+	for (int i_surfel = 0; i_surfel < static_cast<int>(expected_survivors.size()); i_surfel++) {
+		BOOST_REQUIRE_EQUAL(surfels[i_surfel].timestamp, expected_survivors[i_surfel]);
+		BOOST_REQUIRE_EQUAL(surfels[i_surfel].position.x, static_cast<float>(expected_survivors[i_surfel]));
+	}
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Test_RemoveMarkedSurfels_CPU_KeepsOrderOfSurvivors) {
+	// spans several of the chunks the removal mask is scanned in
+	const int surfel_count = 150000;
+	RequireRemovalMatchesFilter(surfel_count, [](int i_surfel) {
+		return i_surfel % 7 == 3 || (i_surfel >= 65000 && i_surfel < 72000) || i_surfel >= surfel_count - 10;
+	});
+}
+
+BOOST_AUTO_TEST_CASE(Test_RemoveMarkedSurfels_CPU_EdgeCases) {
+	const int surfel_count = 1000;
+	// nothing marked
+	RequireRemovalMatchesFilter(surfel_count, [](int i_surfel) { return false; });
+	// everything marked
+	RequireRemovalMatchesFilter(surfel_count, [](int i_surfel) { return true; });
+	// only the first surfel
+	RequireRemovalMatchesFilter(surfel_count, [](int i_surfel) { return i_surfel == 0; });
+	// all but the last surfel
+	RequireRemovalMatchesFilter(surfel_count, [&](int i_surfel) { return i_surfel < surfel_count - 1; });
+}
@@ -0,0 +1,128 @@
+#define BOOST_TEST_MODULE ThreeVolumeTraversal
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <atomic>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/GlobalTemplateDefines.h"
+#include "../ITMLib/Objects/Volume/VoxelVolume.h"
+#include "../ITMLib/Objects/Volume/RepresentationAccess.h"
+#include "../ITMLib/Engines/DepthFusion/DepthFusionEngine.h"
+#include "../ITMLib/Engines/Indexing/VBH/CPU/IndexingEngine_VoxelBlockHash_CPU.h"
+#include "../ITMLib/Engines/Traversal/CPU/ThreeVolumeTraversal_CPU_VoxelBlockHash.h"
+//test_utilities
+#include "TestUtilities/SquareViewsFixture.h"
+
+using namespace ITMLib;
+using namespace test;
+
+typedef SquareViewsFixture<MEMORYDEVICE_CPU> SquareViewsFixture_CPU;
+
+namespace {
+struct CountingNeighborhoodFunctor {
+	std::atomic<int> voxel_count{0};
+
+	void operator()(TSDFVoxel& voxel1, TSDFVoxel& voxel2, TSDFVoxel& voxel3, const Vector3i& voxel_position,
+	                const HashBlockNeighborhood& neighborhood1, const HashBlockNeighborhood& neighborhood2,
+	                const HashBlockNeighborhood& neighborhood3) {
+		voxel_count++;
+	}
+};
+} // anonymous namespace
+
+BOOST_FIXTURE_TEST_CASE(Test_BlockNeighborTable_CPU, SquareViewsFixture_CPU) {
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> reference_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	reference_volume.Reset();
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>& indexer = IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	indexer.AllocateNearAndBetweenTwoSurfaces(&reference_volume, view_square_2, tracking_state);
+
+	// same blocks, but (likely) allocated in a different order & in different locations in voxel memory
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	volume.Reset();
+	indexer.AllocateNearSurface(&volume, view_square_1, tracking_state);
+	AllocateUsingOtherVolume(&volume, &reference_volume, MEMORYDEVICE_CPU);
+	DepthFusionEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU> depth_fusion_engine;
+	depth_fusion_engine.IntegrateDepthImageIntoTsdfVolume(&volume, view_square_2, tracking_state);
+
+	BOOST_REQUIRE_EQUAL(volume.index.GetBlockNeighborTableRowCount(), -1);
+	BuildBlockNeighborTable(&volume, &reference_volume, MEMORYDEVICE_CPU);
+	const int utilized_block_count = reference_volume.index.GetUtilizedBlockCount();
+	BOOST_REQUIRE_EQUAL(volume.index.GetBlockNeighborTableRowCount(), utilized_block_count);
+	BOOST_REQUIRE(volume.index.BlockNeighborTableMatches(reference_volume.index));
+
+	const TSDFVoxel* voxels = volume.GetVoxels();
+	const HashEntry* hash_table = volume.index.GetEntries();
+	const int* reference_utilized_hash_codes = reference_volume.index.GetUtilizedBlockHashCodes();
+	const HashEntry* reference_hash_table = reference_volume.index.GetEntries();
+	// covers all neighbor blocks & reaches beyond the neighborhood to test the fallback
+	const Vector3i offsets[] = {Vector3i(0, 0, 0), Vector3i(-1, 0, 0), Vector3i(0, 1, 0), Vector3i(0, 0, -3),
+	                            Vector3i(-1, -1, -1), Vector3i(1, 1, 1), Vector3i(5, -2, 7), Vector3i(-13, 4, 1)};
+
+	for (int i_block = 0; i_block < utilized_block_count; i_block++) {
+		Vector3i block_origin = reference_hash_table[reference_utilized_hash_codes[i_block]].pos.toInt() * VOXEL_BLOCK_SIZE;
+		HashBlockNeighborhood neighborhood{volume.index.GetBlockNeighborTable() + i_block * VOXEL_BLOCK_NEIGHBORHOOD_SIZE,
+		                                   hash_table, block_origin};
+		for (int i_voxel = 0; i_voxel < VOXEL_BLOCK_SIZE3; i_voxel += 37) {
+			Vector3i voxel_position = block_origin + Vector3i(i_voxel % VOXEL_BLOCK_SIZE,
+			                                                  (i_voxel / VOXEL_BLOCK_SIZE) % VOXEL_BLOCK_SIZE,
+			                                                  i_voxel / (VOXEL_BLOCK_SIZE * VOXEL_BLOCK_SIZE));
+			for (const Vector3i& offset : offsets) {
+				int found_via_neighborhood, found_via_hash_table;
+				TSDFVoxel voxel_via_neighborhood = readVoxel(voxels, &neighborhood, voxel_position + offset, found_via_neighborhood);
+				TSDFVoxel voxel_via_hash_table = readVoxel(voxels, hash_table, voxel_position + offset, found_via_hash_table);
+				BOOST_REQUIRE_EQUAL(found_via_neighborhood != 0, found_via_hash_table != 0);
+				BOOST_REQUIRE_EQUAL(voxel_via_neighborhood.sdf, voxel_via_hash_table.sdf);
+				BOOST_REQUIRE_EQUAL(voxel_via_neighborhood.w_depth, voxel_via_hash_table.w_depth);
+			}
+		}
+	}
+
+	// changing allocation invalidates the table
+	ORUtils::MemoryBlock<Vector3s> new_block_positions(1, MEMORYDEVICE_CPU);
+	new_block_positions.GetData(MEMORYDEVICE_CPU)[0] = Vector3s(100, 100, 100);
+	indexer.AllocateBlockList(&volume, new_block_positions);
+	BOOST_REQUIRE_EQUAL(volume.index.GetBlockNeighborTableRowCount(), -1);
+	BOOST_REQUIRE(!volume.index.BlockNeighborTableMatches(reference_volume.index));
+}
+
+BOOST_FIXTURE_TEST_CASE(Test_TraverseUtilizedWithNeighborhood_StaleTables_CPU, SquareViewsFixture_CPU) {
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>& indexer = IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume1(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume2(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume3(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	for (auto volume : {&volume1, &volume2, &volume3}) {
+		volume->Reset();
+		indexer.AllocateNearSurface(volume, view_square_1, tracking_state);
+	}
+	typedef ThreeVolumeTraversalEngine<TSDFVoxel, TSDFVoxel, TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU> TraversalEngine;
+	auto build_tables = [&](VoxelVolume<TSDFVoxel, VoxelBlockHash>& reference_volume) {
+		for (auto volume : {&volume1, &volume2, &volume3}) {
+			BuildBlockNeighborTable(volume, &reference_volume, MEMORYDEVICE_CPU);
+		}
+	};
+
+	build_tables(volume1);
+	CountingNeighborhoodFunctor functor;
+	TraversalEngine::TraverseUtilizedWithNeighborhood(&volume1, &volume2, &volume3, functor);
+	BOOST_REQUIRE_EQUAL(functor.voxel_count.load(), volume1.index.GetUtilizedBlockCount() * VOXEL_BLOCK_SIZE3);
+
+	// same block count, but built with another volume as reference
+	build_tables(volume2);
+	BOOST_REQUIRE_EQUAL(volume3.index.GetBlockNeighborTableRowCount(), volume1.index.GetUtilizedBlockCount());
+	BOOST_REQUIRE_THROW(TraversalEngine::TraverseUtilizedWithNeighborhood(&volume1, &volume2, &volume3, functor),
+	                    std::runtime_error);
+
+	// the utilized block list of volume 1 was recomputed (to the same length), but only its own table was rebuilt
+	build_tables(volume1);
+	volume1.index.SetUtilizedBlockCount(volume1.index.GetUtilizedBlockCount());
+	BuildBlockNeighborTable(&volume1, &volume1, MEMORYDEVICE_CPU);
+	BOOST_REQUIRE_EQUAL(volume2.index.GetBlockNeighborTableRowCount(), volume1.index.GetUtilizedBlockCount());
+	BOOST_REQUIRE_THROW(TraversalEngine::TraverseUtilizedWithNeighborhood(&volume1, &volume2, &volume3, functor),
+	                    std::runtime_error);
+}
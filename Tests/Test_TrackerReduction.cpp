@@ -0,0 +1,83 @@
+#define BOOST_TEST_MODULE TrackerReduction
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/CameraTrackers/CPU/TrackerReduction_CPU.h"
+
+using namespace ITMLib;
+
+namespace {
+
+TrackerGradientHessianSums ReduceTestPoints(const std::vector<float>& values) {
+	return ReduceInChunks_CPU<TrackerGradientHessianSums>(
+			static_cast<int>(values.size()), [&](TrackerGradientHessianSums& chunk_sums, int begin, int end) {
+				float local_nabla[6], local_hessian[21];
+				for (int i_point = begin; i_point < end; i_point++) {
+					const float value = values[i_point];
+					if (value < 0.0f) continue; // invalid point
+					for (int i = 0; i < 6; i++) local_nabla[i] = value * static_cast<float>(i + 1);
+					for (int i = 0; i < 21; i++) local_hessian[i] = value * value + static_cast<float>(i);
+					chunk_sums.AddPoint(value * value, local_nabla, local_hessian, 6, 21);
+				}
+			});
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Test_ReduceInChunks_CPU_IsIndependentOfThreadCount) {
+	std::mt19937 generator(5);
+	std::uniform_real_distribution<float> distribution(-0.5f, 1.0f);
+	std::vector<float> values(640 * 480 + 123);
+	for (float& value : values) value = distribution(generator);
+
+	int expected_valid_point_count = 0;
+	double expected_f = 0.0;
+	for (float value : values) {
+		if (value >= 0.0f) {
+			expected_valid_point_count++;
+			expected_f += static_cast<double>(value) * value;
+		}
+	}
+
+#ifdef WITH_OPENMP
+	const int max_thread_count = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	TrackerGradientHessianSums single_thread_sums = ReduceTestPoints(values);
+#ifdef WITH_OPENMP
+	omp_set_num_threads(max_thread_count > 1 ? max_thread_count : 4);
+#endif
+	TrackerGradientHessianSums multi_thread_sums = ReduceTestPoints(values);
+#ifdef WITH_OPENMP
+	omp_set_num_threads(max_thread_count);
+#endif
+
+	BOOST_REQUIRE_EQUAL(single_thread_sums.valid_point_count, expected_valid_point_count);
+	BOOST_REQUIRE_CLOSE(static_cast<double>(single_thread_sums.f), expected_f, 1e-3);
+
+	// bitwise-identical results regardless of how the chunks were scheduled
+	BOOST_REQUIRE_EQUAL(multi_thread_sums.valid_point_count, single_thread_sums.valid_point_count);
+	BOOST_REQUIRE_EQUAL(multi_thread_sums.f, single_thread_sums.f);
+	for (int i = 0; i < 6; i++) BOOST_REQUIRE_EQUAL(multi_thread_sums.nabla[i], single_thread_sums.nabla[i]);
+	for (int i = 0; i < 21; i++) BOOST_REQUIRE_EQUAL(multi_thread_sums.hessian[i], single_thread_sums.hessian[i]);
+
+	float full_hessian[36];
+	multi_thread_sums.CopyHessianTo(full_hessian, 6, 6);
+	for (int r = 0; r < 6; r++) {
+		for (int c = 0; c < 6; c++) BOOST_REQUIRE_EQUAL(full_hessian[r + c * 6], full_hessian[c + r * 6]);
+	}
+}
@@ -212,6 +212,90 @@ BOOST_FIXTURE_TEST_CASE(Test_TwoSurfaceAllocation_CPU, TestData_CPU) {
 	delete visualization_engine;
 }
 
+BOOST_FIXTURE_TEST_CASE(Test_TwoSurfaceAllocation_Incremental_CPU, TestData_CPU) {
+
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> square_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	square_volume.Reset();
+	DepthFusionEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU> depth_fusion_engine;
+
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>& indexer = IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	indexer.AllocateNearSurface(&square_volume, view_square_1, tracking_state);
+	depth_fusion_engine.IntegrateDepthImageIntoTsdfVolume(&square_volume, view_square_1, tracking_state);
+
+	RenderingEngineBase<TSDFVoxel, VoxelBlockHash>* visualization_engine = RenderingEngineFactory::Build<TSDFVoxel, VoxelBlockHash>(
+			MEMORYDEVICE_CPU);
+
+	// builds the point cloud
+	visualization_engine->CreateICPMaps(&square_volume, view_square_1, tracking_state, render_state);
+
+	// simulate the allocation left over from a "previous frame": some of the blocks will still be needed, some won't
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> span_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	span_volume.Reset();
+	indexer.AllocateNearSurface(&span_volume, view_square_1, tracking_state);
+	ORUtils::MemoryBlock<Vector3s> stale_block_positions(2, MEMORYDEVICE_CPU);
+	stale_block_positions.GetData(MEMORYDEVICE_CPU)[0] = Vector3s(100, 100, 100);
+	stale_block_positions.GetData(MEMORYDEVICE_CPU)[1] = Vector3s(-30, 20, 4);
+	indexer.AllocateBlockList(&span_volume, stale_block_positions);
+
+	indexer.UpdateAllocationNearAndBetweenTwoSurfaces(&span_volume, view_square_2, tracking_state);
+
+	std::vector<Vector3s> hash_block_positions_span = Analytics_CPU_VBH_Voxel::Instance().GetAllocatedHashBlockPositions(
+			&span_volume);
+	std::unordered_set<Vector3s> hash_block_positions_span_set(hash_block_positions_span.begin(),
+	                                                           hash_block_positions_span.end());
+	int test_volume_block_count = Analytics_CPU_VBH_Voxel::Instance().CountAllocatedHashBlocks(&span_volume);
+
+	BOOST_REQUIRE_EQUAL(test_volume_block_count, ground_truth_block_positions.size());
+	BOOST_REQUIRE_EQUAL(span_volume.index.GetUtilizedBlockCount(), ground_truth_block_positions.size());
+
+	check_positions(ground_truth_block_positions, hash_block_positions_span_set, hash_block_positions_span);
+
+	// make another volume match the updated one
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> matched_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	matched_volume.Reset();
+	indexer.AllocateBlockList(&matched_volume, stale_block_positions);
+	DeallocateUsingOtherVolume(&matched_volume, &span_volume, MEMORYDEVICE_CPU);
+	AllocateUsingOtherVolume(&matched_volume, &span_volume, MEMORYDEVICE_CPU);
+
+	hash_block_positions_span = Analytics_CPU_VBH_Voxel::Instance().GetAllocatedHashBlockPositions(&matched_volume);
+	hash_block_positions_span_set = std::unordered_set<Vector3s>(hash_block_positions_span.begin(),
+	                                                             hash_block_positions_span.end());
+	test_volume_block_count = Analytics_CPU_VBH_Voxel::Instance().CountAllocatedHashBlocks(&matched_volume);
+	BOOST_REQUIRE_EQUAL(test_volume_block_count, ground_truth_block_positions.size());
+	check_positions(ground_truth_block_positions, hash_block_positions_span_set, hash_block_positions_span);
+
+	delete visualization_engine;
+}
+
+BOOST_FIXTURE_TEST_CASE(Test_SinglePassAllocation_vs_MultiPassAllocation_CPU, TestData_CPU) {
+	// on the CPU, the optimized indexer inserts blocks in a single concurrent pass, while the diagnostic one still marks
+	// allocation states & allocates the marked blocks in separate passes
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU, OPTIMIZED>& single_pass_indexer =
+			IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU, OPTIMIZED>::Instance();
+	IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU, DIAGNOSTIC>& multi_pass_indexer =
+			IndexingEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU, DIAGNOSTIC>::Instance();
+
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> single_pass_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	single_pass_volume.Reset();
+	single_pass_indexer.AllocateNearSurface(&single_pass_volume, view_square_1, tracking_state);
+	single_pass_indexer.AllocateNearSurface(&single_pass_volume, view_square_2, tracking_state);
+
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> multi_pass_volume(MEMORYDEVICE_CPU, {0x8000, 0x20000});
+	multi_pass_volume.Reset();
+	multi_pass_indexer.AllocateNearSurface(&multi_pass_volume, view_square_1, tracking_state);
+	multi_pass_indexer.AllocateNearSurface(&multi_pass_volume, view_square_2, tracking_state);
+
+	std::vector<Vector3s> single_pass_block_positions =
+			Analytics_CPU_VBH_Voxel::Instance().GetAllocatedHashBlockPositions(&single_pass_volume);
+	std::vector<Vector3s> multi_pass_block_positions =
+			Analytics_CPU_VBH_Voxel::Instance().GetAllocatedHashBlockPositions(&multi_pass_volume);
+	BOOST_REQUIRE_EQUAL(single_pass_block_positions.size(), multi_pass_block_positions.size());
+	BOOST_REQUIRE_EQUAL(single_pass_volume.index.GetUtilizedBlockCount(), multi_pass_volume.index.GetUtilizedBlockCount());
+	BOOST_REQUIRE_EQUAL(single_pass_volume.index.GetLastFreeBlockListId(), multi_pass_volume.index.GetLastFreeBlockListId());
+	BOOST_REQUIRE(std::unordered_set<Vector3s>(single_pass_block_positions.begin(), single_pass_block_positions.end()) ==
+	              std::unordered_set<Vector3s>(multi_pass_block_positions.begin(), multi_pass_block_positions.end()));
+}
+
 #ifndef COMPILE_WITHOUT_CUDA
 typedef TestData<MEMORYDEVICE_CUDA> TestData_CUDA;
 
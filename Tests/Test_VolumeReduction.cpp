@@ -18,6 +18,11 @@
 #define BOOST_TEST_DYN_LINK
 #endif
 
+//stdlib
+#include <algorithm>
+#include <array>
+#include <cfloat>
+
 //boost
 #include <boost/test/unit_test.hpp>
 
@@ -31,6 +36,8 @@
 #include "TestUtilities/LevelSetAlignment/LevelSetAlignmentTestUtilities.h"
 #include "../ITMLib/Engines/Indexing/IndexingEngineFactory.h"
 #include "TestUtilities/LevelSetAlignment/TestCaseOrganizationBySwitches.h"
+#include "../ITMLib/Engines/Reduction/CPU/VolumeReduction_CPU_VoxelBlockHash.h"
+#include "../ITMLib/Engines/Reduction/CPU/VolumeReduction_CPU_PlainVoxelArray.h"
 
 using namespace ITMLib;
 using namespace test;
@@ -44,6 +51,11 @@ VoxelBlockHash::InitializationParameters GetTestSpecificInitializationParameters
 	return {65536, 32768};
 }
 
+template<>
+PlainVoxelArray::InitializationParameters GetTestSpecificInitializationParameters<PlainVoxelArray>() {
+	return {{48, 48, 48}, {0, 0, 0}};
+}
+
 
 template<typename TIndex, MemoryDeviceType TMemoryDeviceType>
 void GenericVolumeReductionCountWeightRangeTest1() {
@@ -255,6 +267,147 @@ BOOST_AUTO_TEST_CASE(Test_VolumeReduction_MaxWarpUpdate_PVA_CUDA) {
 
 #endif
 
+template<typename TIndex, MemoryDeviceType TMemoryDeviceType>
+void GenericTestVolumeReductionSinglePassDepthWeightCounts() {
+	VoxelVolume<TSDFVoxel, TIndex> volume(TMemoryDeviceType, GetTestSpecificInitializationParameters<TIndex>());
+	volume.Reset();
+
+	GenerateRandomDepthWeightSubVolume<TMemoryDeviceType>(&volume, Extent3Di(0, 0, 0, 48, 48, 48), Extent2Di(0, 50));
+	GenerateRandomDepthWeightSubVolume<TMemoryDeviceType>(&volume, Extent3Di(32, 32, 32, 48, 48, 48), Extent2Di(56, 100));
+	TSDFVoxel alternative_weight_voxel;
+	alternative_weight_voxel.w_depth = 55;
+	EditAndCopyEngineFactory::Instance<TSDFVoxel, TIndex, TMemoryDeviceType>()
+			.SetVoxel(&volume, Vector3i(12, 12, 12), alternative_weight_voxel);
+	EditAndCopyEngineFactory::Instance<TSDFVoxel, TIndex, TMemoryDeviceType>()
+			.SetVoxel(&volume, Vector3i(40, 33, 45), alternative_weight_voxel);
+
+	auto& analytics_engine = AnalyticsEngine<TSDFVoxel, TIndex, TMemoryDeviceType>::Instance();
+	const std::array<Extent2Di, depth_weight_range_count> ranges = {Extent2Di(0, 50), Extent2Di(50, 56), Extent2Di(56, 100)};
+	std::array<unsigned int, depth_weight_range_count> voxel_counts, hash_block_counts;
+	analytics_engine.CountVoxelsAndHashBlocksWithDepthWeightInRanges(&volume, ranges, voxel_counts, hash_block_counts);
+
+	BOOST_REQUIRE_EQUAL(voxel_counts[1], 2u);
+	BOOST_REQUIRE_EQUAL(voxel_counts[0] + voxel_counts[1] + voxel_counts[2], 48u * 48u * 48u);
+	for (int i_range = 0; i_range < depth_weight_range_count; i_range++) {
+		BOOST_REQUIRE_EQUAL(voxel_counts[i_range], analytics_engine.CountVoxelsWithDepthWeightInRange(&volume, ranges[i_range]));
+		BOOST_REQUIRE_EQUAL(hash_block_counts[i_range], analytics_engine.CountHashBlocksWithDepthWeightInRange(&volume, ranges[i_range]));
+	}
+	// 8 blocks in [32, 48)^3, one of which contains a voxel with weight outside of the range
+	BOOST_REQUIRE_EQUAL(hash_block_counts[2], 7u);
+}
+
+BOOST_AUTO_TEST_CASE(Test_VolumeReduction_SinglePassDepthWeightCounts_VBH_CPU) {
+	GenericTestVolumeReductionSinglePassDepthWeightCounts<VoxelBlockHash, MEMORYDEVICE_CPU>();
+}
+
+#ifndef COMPILE_WITHOUT_CUDA
+BOOST_AUTO_TEST_CASE(Test_VolumeReduction_SinglePassDepthWeightCounts_VBH_CUDA) {
+	GenericTestVolumeReductionSinglePassDepthWeightCounts<VoxelBlockHash, MEMORYDEVICE_CUDA>();
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(Test_VolumeReduction_SinglePassVoxelCategoryStatistics_VBH_CPU) {
+	if (!TSDFVoxel::hasSemanticInformation) return;
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> volume(MEMORYDEVICE_CPU, GetTestSpecificInitializationParameters<VoxelBlockHash>());
+	GenerateSimpleSurfaceTestVolume<MEMORYDEVICE_CPU>(&volume);
+
+	auto& analytics_engine = AnalyticsEngine<TSDFVoxel, VoxelBlockHash, MEMORYDEVICE_CPU>::Instance();
+	unsigned int non_truncated_voxel_count, plus_one_voxel_count;
+	double non_truncated_abs_sdf_sum, truncated_abs_sdf_sum;
+	analytics_engine.ComputeVoxelCategoryStatistics(&volume, non_truncated_voxel_count, plus_one_voxel_count,
+	                                                non_truncated_abs_sdf_sum, truncated_abs_sdf_sum);
+
+	BOOST_REQUIRE_EQUAL(non_truncated_voxel_count, analytics_engine.CountNonTruncatedVoxels(&volume));
+	BOOST_REQUIRE_EQUAL(plus_one_voxel_count, analytics_engine.CountVoxelsWithSpecificSdfValue(&volume, 1.0f));
+	BOOST_REQUIRE_CLOSE(non_truncated_abs_sdf_sum, analytics_engine.SumNonTruncatedVoxelAbsSdf(&volume), 1e-6);
+	BOOST_REQUIRE_CLOSE(truncated_abs_sdf_sum, analytics_engine.SumTruncatedVoxelAbsSdf(&volume), 1e-6);
+	BOOST_REQUIRE_GT(non_truncated_voxel_count, 0u);
+}
+
+struct RetrieveDepthWeight {
+	_CPU_AND_GPU_CODE_
+	inline float retrieve(const TSDFVoxel& voxel) const {
+		return static_cast<float>(voxel.w_depth);
+	}
+};
+
+template<typename TIndex>
+void GenericTestVolumeReductionSinglePassExtremaAndHistogram_CPU() {
+	VoxelVolume<TSDFVoxel, TIndex> volume(MEMORYDEVICE_CPU, GetTestSpecificInitializationParameters<TIndex>());
+	volume.Reset();
+	const Extent3Di bounds(0, 0, 0, 48, 48, 48);
+	GenerateRandomDepthWeightSubVolume<MEMORYDEVICE_CPU>(&volume, bounds, Extent2Di(10, 50));
+	// ties for the maximum, the first voxel in z-major order should be reported
+	TSDFVoxel heavy_voxel;
+	heavy_voxel.w_depth = 80;
+	volume.SetValueAt(Vector3i(30, 2, 20), heavy_voxel);
+	volume.SetValueAt(Vector3i(5, 40, 20), heavy_voxel);
+	volume.SetValueAt(Vector3i(1, 1, 41), heavy_voxel);
+
+	constexpr int bin_count = 8;
+	SumStatistic<RetrieveDepthWeight, double> sum;
+	MinimumStatistic<RetrieveDepthWeight, float> minimum;
+	MaximumStatistic<RetrieveDepthWeight, float> maximum;
+	HistogramStatistic<RetrieveDepthWeight, bin_count> histogram(RetrieveDepthWeight(), 0.0f, 64.0f);
+	VolumeReductionEngine<TSDFVoxel, TIndex, MEMORYDEVICE_CPU>::ReduceUtilizedStatistics(&volume, sum, minimum, maximum, histogram);
+
+	double sum_gt = 0.0;
+	float minimum_gt = FLT_MAX, maximum_gt = -FLT_MAX;
+	Vector3i minimum_position_gt, maximum_position_gt;
+	unsigned int bin_counts_gt[bin_count] = {};
+	unsigned int out_of_range_count_gt = 0u;
+	for (int z = bounds.min_z; z < bounds.max_z; z++) {
+		for (int y = bounds.min_y; y < bounds.max_y; y++) {
+			for (int x = bounds.min_x; x < bounds.max_x; x++) {
+				const float weight = static_cast<float>(volume.GetValueAt(x, y, z).w_depth);
+				sum_gt += weight;
+				if (weight < minimum_gt) {
+					minimum_gt = weight;
+					minimum_position_gt = Vector3i(x, y, z);
+				}
+				if (weight > maximum_gt) {
+					maximum_gt = weight;
+					maximum_position_gt = Vector3i(x, y, z);
+				}
+				if (weight > 64.0f) {
+					out_of_range_count_gt++;
+				} else {
+					bin_counts_gt[std::min(bin_count - 1, static_cast<int>(weight * bin_count / 64.0f))]++;
+				}
+			}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(sum.sum, sum_gt);
+	BOOST_REQUIRE(minimum.found);
+	BOOST_REQUIRE_EQUAL(minimum.value, minimum_gt);
+	BOOST_REQUIRE_EQUAL(minimum.position, minimum_position_gt);
+	BOOST_REQUIRE_EQUAL(maximum.value, 80.0f);
+	BOOST_REQUIRE_EQUAL(maximum.position, Vector3i(30, 2, 20));
+	BOOST_REQUIRE_EQUAL(maximum.position, maximum_position_gt);
+	for (int i_bin = 0; i_bin < bin_count; i_bin++) {
+		BOOST_REQUIRE_EQUAL(histogram.bin_counts[i_bin], bin_counts_gt[i_bin]);
+	}
+	BOOST_REQUIRE_EQUAL(histogram.out_of_range_count, out_of_range_count_gt);
+	BOOST_REQUIRE_EQUAL(histogram.out_of_range_count, 3u);
+
+	// statistics that go in non-empty get added to once, independently of the thread count
+	VolumeReductionEngine<TSDFVoxel, TIndex, MEMORYDEVICE_CPU>::ReduceUtilizedStatistics(&volume, sum, histogram);
+	BOOST_REQUIRE_EQUAL(sum.sum, 2.0 * sum_gt);
+	for (int i_bin = 0; i_bin < bin_count; i_bin++) {
+		BOOST_REQUIRE_EQUAL(histogram.bin_counts[i_bin], 2u * bin_counts_gt[i_bin]);
+	}
+	BOOST_REQUIRE_EQUAL(histogram.out_of_range_count, 2u * out_of_range_count_gt);
+}
+
+BOOST_AUTO_TEST_CASE(Test_VolumeReduction_SinglePassExtremaAndHistogram_VBH_CPU) {
+	GenericTestVolumeReductionSinglePassExtremaAndHistogram_CPU<VoxelBlockHash>();
+}
+
+BOOST_AUTO_TEST_CASE(Test_VolumeReduction_SinglePassExtremaAndHistogram_PVA_CPU) {
+	GenericTestVolumeReductionSinglePassExtremaAndHistogram_CPU<PlainVoxelArray>();
+}
+
 template<typename TIndex>
 typename TIndex::InitializationParameters GetTestLargeVolumeInitializationParameters();
 
@@ -77,4 +77,33 @@ BOOST_AUTO_TEST_CASE(testSaveSceneCompact_CPU) {
 	BOOST_REQUIRE_EQUAL(Analytics_CPU_VBH_Voxel::Instance().CountNonTruncatedVoxels(&loaded_test_scene_VBH), 19456);
 	BOOST_REQUIRE(contentAlmostEqual_CPU(&generated_test_scene_VBH, &loaded_test_scene_VBH, tolerance));
 	BOOST_REQUIRE(contentAlmostEqual_CPU_Verbose(&generated_test_volume_PVA, &loaded_test_scene_VBH, tolerance));
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(testSaveLoadVolumeMapped_CPU) {
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> generated_test_volume(MEMORYDEVICE_CPU);
+	GenerateSimpleSurfaceTestVolume<MEMORYDEVICE_CPU>(&generated_test_volume);
+	std::string path = GENERATED_TEST_DATA_PREFIX "TestData/volumes/VBH/generated_test_volume_mapped_CPU.dat";
+	SceneFileIOEngine_VBH::SaveVolumeMapped(generated_test_volume, path);
+
+	float tolerance = 1e-8;
+
+	VoxelVolume<TSDFVoxel, VoxelBlockHash> loaded_test_volume(MEMORYDEVICE_CPU);
+	loaded_test_volume.Reset();
+	SceneFileIOEngine_VBH::LoadVolumeMapped(loaded_test_volume, path);
+	BOOST_REQUIRE_EQUAL(loaded_test_volume.index.GetUtilizedBlockCount(),
+	                    generated_test_volume.index.GetUtilizedBlockCount());
+	BOOST_REQUIRE_EQUAL(Analytics_CPU_VBH_Voxel::Instance().CountNonTruncatedVoxels(&loaded_test_volume), 19456);
+	BOOST_REQUIRE(contentAlmostEqual_CPU(&generated_test_volume, &loaded_test_volume, tolerance));
+
+	// blocks allocated after loading must not overlap the loaded ones
+	const int utilized_block_count = loaded_test_volume.index.GetUtilizedBlockCount();
+	BOOST_REQUIRE_EQUAL(loaded_test_volume.index.GetLastFreeBlockListId(),
+	                    loaded_test_volume.index.voxel_block_count - utilized_block_count - 1);
+	const int next_allocated_block = loaded_test_volume.index.GetBlockAllocationList()[
+			loaded_test_volume.index.GetLastFreeBlockListId()];
+	BOOST_REQUIRE_GE(next_allocated_block, utilized_block_count);
+
+	MappedVolume<TSDFVoxel> mapped_test_volume(path);
+	BOOST_REQUIRE_EQUAL(mapped_test_volume.Get().index.GetUtilizedBlockCount(), utilized_block_count);
+	BOOST_REQUIRE_EQUAL(Analytics_CPU_VBH_Voxel::Instance().CountNonTruncatedVoxels(&mapped_test_volume.Get()), 19456);
+	BOOST_REQUIRE(contentAlmostEqual_CPU(&generated_test_volume, &mapped_test_volume.Get(), tolerance));
+}
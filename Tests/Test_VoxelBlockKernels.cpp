@@ -0,0 +1,165 @@
+#define BOOST_TEST_MODULE VoxelBlockKernels
+#ifndef WIN32
+#define BOOST_TEST_DYN_LINK
+#endif
+
+//stdlib
+#include <random>
+#include <vector>
+
+//boost
+#include <boost/test/unit_test.hpp>
+
+//ITMLib
+#include "../ITMLib/GlobalTemplateDefines.h"
+#include "../ITMLib/Engines/Common/VoxelBlockKernels_CPU.h"
+#include "../ITMLib/Engines/VolumeFusion/VolumeFusionFunctors.h"
+
+using namespace ITMLib;
+
+// level set alignment functors are declared outside of the ITMLib namespace
+#include "../ITMLib/Engines/LevelSetAlignment/Shared/LevelSetAlignmentSharedFunctors.h"
+
+namespace {
+
+// not a multiple of the row length, so that the per-voxel remainder gets exercised as well
+constexpr int test_voxel_count = VOXEL_BLOCK_SIZE3 - 3;
+
+Vector3f RandomVector(std::mt19937& generator) {
+	std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+	return {distribution(generator), distribution(generator), distribution(generator)};
+}
+
+std::vector<WarpVoxel> RandomWarps(std::mt19937& generator) {
+	std::vector<WarpVoxel> warps(test_voxel_count);
+	for (WarpVoxel& warp : warps) {
+		warp.warp_update = RandomVector(generator);
+		warp.gradient0 = RandomVector(generator);
+		warp.gradient1 = RandomVector(generator);
+	}
+	return warps;
+}
+
+std::vector<TSDFVoxel> RandomTsdfVoxels(std::mt19937& generator) {
+	std::uniform_real_distribution<float> sdf_distribution(-1.0f, 1.0f);
+	std::uniform_int_distribution<int> weight_distribution(0, 200);
+	std::uniform_int_distribution<int> flag_distribution(VOXEL_UNKNOWN, VOXEL_NONTRUNCATED);
+	std::uniform_int_distribution<int> edge_case_distribution(0, 9);
+	std::vector<TSDFVoxel> voxels(test_voxel_count);
+	for (TSDFVoxel& voxel : voxels) {
+		voxel.sdf = sdf_distribution(generator);
+		// exercise truncation
+		if (edge_case_distribution(generator) == 0) voxel.sdf = voxel.sdf > 0.0f ? 1.0f : -1.0f;
+		voxel.w_depth = static_cast<uchar>(weight_distribution(generator));
+		voxel.flags = static_cast<uchar>(flag_distribution(generator));
+	}
+	return voxels;
+}
+
+bool Vector3fEqual(const Vector3f& a, const Vector3f& b, float tolerance) {
+	return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance;
+}
+
+template<typename TStaticFunctor>
+void CheckStaticBlockKernelMatchesPerVoxelVersion(std::vector<WarpVoxel> warps) {
+	std::vector<WarpVoxel> per_voxel_warps = warps;
+	for (WarpVoxel& warp : per_voxel_warps) {
+		TStaticFunctor::run(warp);
+	}
+	TStaticFunctor::ProcessBlock(warps.data(), test_voxel_count);
+	for (int i_voxel = 0; i_voxel < test_voxel_count; i_voxel++) {
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].warp_update, per_voxel_warps[i_voxel].warp_update, 0.0f));
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].gradient0, per_voxel_warps[i_voxel].gradient0, 0.0f));
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].gradient1, per_voxel_warps[i_voxel].gradient1, 0.0f));
+	}
+}
+
+template<bool TUseGradient1>
+void CheckWarpUpdateBlockKernelMatchesPerVoxelVersion(std::mt19937& generator) {
+	std::vector<WarpVoxel> warps = RandomWarps(generator);
+	std::vector<TSDFVoxel> canonical_voxels = RandomTsdfVoxels(generator);
+	std::vector<TSDFVoxel> live_voxels = RandomTsdfVoxels(generator);
+	std::vector<WarpVoxel> per_voxel_warps = warps;
+
+	WarpUpdateFunctor<TSDFVoxel, WarpVoxel, MEMORYDEVICE_CPU, TUseGradient1> functor(0.1f);
+	BOOST_REQUIRE((HasBlockKernel<decltype(functor), WarpVoxel*, TSDFVoxel*, TSDFVoxel*>::value));
+	for (int i_voxel = 0; i_voxel < test_voxel_count; i_voxel++) {
+		functor(per_voxel_warps[i_voxel], canonical_voxels[i_voxel], live_voxels[i_voxel], Vector3i(0));
+	}
+	functor.ProcessBlock(warps.data(), canonical_voxels.data(), live_voxels.data(), test_voxel_count);
+
+	const float tolerance = 1e-6f;
+	for (int i_voxel = 0; i_voxel < test_voxel_count; i_voxel++) {
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].warp_update, per_voxel_warps[i_voxel].warp_update, tolerance));
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].gradient0, per_voxel_warps[i_voxel].gradient0, 0.0f));
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].gradient1, per_voxel_warps[i_voxel].gradient1, 0.0f));
+	}
+}
+
+template<bool TUseSurfaceThicknessCutoff>
+void CheckFusionBlockKernelMatchesPerVoxelVersion(std::mt19937& generator) {
+	std::vector<TSDFVoxel> source_voxels = RandomTsdfVoxels(generator);
+	std::vector<TSDFVoxel> target_voxels = RandomTsdfVoxels(generator);
+	std::vector<TSDFVoxel> per_voxel_target_voxels = target_voxels;
+
+	TSDFFusionFunctor<TSDFVoxel, MEMORYDEVICE_CPU, TUseSurfaceThicknessCutoff> functor(100, 0, -0.25f);
+	BOOST_REQUIRE((HasBlockKernel<decltype(functor), TSDFVoxel*, TSDFVoxel*>::value));
+	for (int i_voxel = 0; i_voxel < test_voxel_count; i_voxel++) {
+		functor(source_voxels[i_voxel], per_voxel_target_voxels[i_voxel]);
+	}
+	functor.ProcessBlock(source_voxels.data(), target_voxels.data(), test_voxel_count);
+
+	for (int i_voxel = 0; i_voxel < test_voxel_count; i_voxel++) {
+		BOOST_REQUIRE_CLOSE(target_voxels[i_voxel].sdf, per_voxel_target_voxels[i_voxel].sdf, 1e-4f);
+		BOOST_REQUIRE_EQUAL(target_voxels[i_voxel].w_depth, per_voxel_target_voxels[i_voxel].w_depth);
+		BOOST_REQUIRE_EQUAL(target_voxels[i_voxel].flags, per_voxel_target_voxels[i_voxel].flags);
+	}
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Test_BlockKernelDetection) {
+	BOOST_REQUIRE((HasBlockKernel<ClearOutWarpStaticFunctor<WarpVoxel, WARP_UPDATE>, WarpVoxel*>::value));
+	// WarpVoxel has no cumulative warps, hence no block kernel to clear them
+	BOOST_REQUIRE((!HasBlockKernel<ClearOutWarpStaticFunctor<WarpVoxel, WARP_CUMULATIVE>, WarpVoxel*>::value));
+	// block kernels don't apply to volumes that are traversed read-only
+	BOOST_REQUIRE((!HasBlockKernel<ClearOutWarpStaticFunctor<WarpVoxel, WARP_UPDATE>, const WarpVoxel*>::value));
+	BOOST_REQUIRE((!HasBlockKernel<ClearOutGradientStaticFunctor<WarpVoxel>, WarpVoxel*>::value));
+}
+
+BOOST_AUTO_TEST_CASE(Test_WarpBlockKernels_MatchPerVoxelFunctors) {
+	std::mt19937 generator(7);
+	CheckStaticBlockKernelMatchesPerVoxelVersion<ClearOutWarpStaticFunctor<WarpVoxel, WARP_UPDATE>>(RandomWarps(generator));
+	CheckStaticBlockKernelMatchesPerVoxelVersion<AddFramewiseWarpToWarpStaticFunctor<WarpVoxel, WarpVoxel::hasCumulativeWarp>>(
+			RandomWarps(generator));
+	CheckWarpUpdateBlockKernelMatchesPerVoxelVersion<false>(generator);
+	CheckWarpUpdateBlockKernelMatchesPerVoxelVersion<true>(generator);
+}
+
+BOOST_AUTO_TEST_CASE(Test_Vector3fFieldKernel_OtherVoxelLayout) {
+	std::mt19937 generator(13);
+	std::vector<WarpVoxel_f_UF> warps(test_voxel_count);
+	for (WarpVoxel_f_UF& warp : warps) {
+		warp.framewise_warp = RandomVector(generator);
+		warp.gradient0 = RandomVector(generator);
+		warp.gradient1 = RandomVector(generator);
+	}
+	std::vector<WarpVoxel_f_UF> expected_warps = warps;
+	for (WarpVoxel_f_UF& warp : expected_warps) {
+		warp.framewise_warp += warp.gradient1;
+	}
+
+	Vector3fFieldKernel<WarpVoxel_f_UF> kernel(&WarpVoxel_f_UF::framewise_warp, &WarpVoxel_f_UF::gradient1);
+	kernel.Add(warps.data(), test_voxel_count);
+	for (int i_voxel = 0; i_voxel < test_voxel_count; i_voxel++) {
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].framewise_warp, expected_warps[i_voxel].framewise_warp, 0.0f));
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].gradient0, expected_warps[i_voxel].gradient0, 0.0f));
+		BOOST_REQUIRE(Vector3fEqual(warps[i_voxel].gradient1, expected_warps[i_voxel].gradient1, 0.0f));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Test_FusionBlockKernel_MatchesPerVoxelFunctor) {
+	std::mt19937 generator(42);
+	CheckFusionBlockKernelMatchesPerVoxelVersion<false>(generator);
+	CheckFusionBlockKernelMatchesPerVoxelVersion<true>(generator);
+}